@@ -174,6 +174,56 @@ NM_UTILS_LOOKUP_STR_DEFINE(nm_device_ip_state_to_string,
 
 /*****************************************************************************/
 
+/**
+ * nm_device_concheck_get_jitter_max_ns:
+ * @interval: the interval of the periodic connectivity check in seconds
+ *
+ * Each periodic check is delayed by a random time of up to 1/8 of its
+ * interval, so that devices that started checking at the same time don't
+ * keep checking in lockstep.
+ *
+ * Returns: the maximum jitter in nanoseconds.
+ */
+gint64
+nm_device_concheck_get_jitter_max_ns(guint interval)
+{
+    return ((gint64) NM_MIN(interval, NM_DEVICE_CONCHECK_INTERVAL_MAX) * NM_UTILS_NSEC_PER_SEC)
+           / 8;
+}
+
+/**
+ * nm_device_concheck_get_bumped_interval:
+ * @cur_interval: the current interval in seconds
+ * @max_interval: the interval to back off to at most
+ *
+ * Returns: the interval for the next periodic check, after one more check
+ *   returned the same result. It doubles, up to @max_interval.
+ */
+guint
+nm_device_concheck_get_bumped_interval(guint cur_interval, guint max_interval)
+{
+    if (cur_interval > max_interval / 2u)
+        return max_interval;
+    return NM_MIN(NM_MAX(cur_interval * 2u, 1u), max_interval);
+}
+
+/**
+ * nm_device_concheck_get_full_max_interval:
+ * @interval: the configured "[connectivity].interval"
+ * @max_interval: the configured "[connectivity].max-interval"
+ *
+ * Returns: the interval up to which the checks back off, while the device
+ *   has full connectivity. It is never shorter than @interval.
+ */
+guint
+nm_device_concheck_get_full_max_interval(guint interval, guint max_interval)
+{
+    interval = NM_MIN(interval, NM_DEVICE_CONCHECK_INTERVAL_MAX);
+    return NM_CLAMP(max_interval, interval, NM_DEVICE_CONCHECK_INTERVAL_MAX);
+}
+
+/*****************************************************************************/
+
 #define SD_RESOLVED_DNS (1UL << 0)
 /* Don't answer request from locally synthesized records (which includes /etc/hosts) */
 #define SD_RESOLVED_NO_SYNTHESIZE (1UL << 11)
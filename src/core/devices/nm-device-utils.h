@@ -84,6 +84,17 @@ const char *nm_device_ip_state_to_string(NMDeviceIPState ip_state);
 
 /*****************************************************************************/
 
+/* The longest interval between periodic connectivity checks, in seconds. */
+#define NM_DEVICE_CONCHECK_INTERVAL_MAX (7u * 24u * 3600u)
+
+gint64 nm_device_concheck_get_jitter_max_ns(guint interval);
+
+guint nm_device_concheck_get_bumped_interval(guint cur_interval, guint max_interval);
+
+guint nm_device_concheck_get_full_max_interval(guint interval, guint max_interval);
+
+/*****************************************************************************/
+
 void nm_device_resolve_address(int                 addr_family,
                                gconstpointer       address,
                                GCancellable       *cancellable,
@@ -317,6 +317,7 @@ struct _NMDeviceConnectivityHandle {
     bool                         is_periodic : 1;
     bool                         is_periodic_bump : 1;
     bool                         is_periodic_bump_on_complete : 1;
+    bool                         is_probe : 1;
     int                          addr_family;
 };
 
@@ -415,6 +416,8 @@ NM_GOBJECT_PROPERTIES_DEFINE(NMDevice,
                              PROP_STATISTICS_RX_BYTES,
                              PROP_IP4_CONNECTIVITY,
                              PROP_IP6_CONNECTIVITY,
+                             PROP_IP4_CONNECTIVITY_NEXT_CHECK,
+                             PROP_IP6_CONNECTIVITY_NEXT_CHECK,
                              PROP_INTERFACE_FLAGS,
                              PROP_PORTS,
                              PROP_CONTROLLER, );
@@ -760,6 +763,10 @@ typedef struct _NMDevicePrivate {
         /* the currently configured max periodic interval. */
         guint p_max_interval;
 
+        /* while we have full connectivity, the interval backs off up to this
+         * value. It's never smaller than p_max_interval. */
+        guint p_full_max_interval;
+
         /* the current interval. If we are probing, the interval might be lower
          * then the configured max interval. */
         guint p_cur_interval;
@@ -768,6 +775,21 @@ typedef struct _NMDevicePrivate {
          * p_cur_interval. */
         gint64 p_cur_basetime_ns;
 
+        /* the timestamp when p_cur_id expires (including the jitter), or zero. */
+        gint64 p_next_ns;
+
+        /* the jitter for the check scheduled at p_jitter_basetime_ns with
+         * p_jitter_interval. Rescheduling the same check keeps it, so that
+         * p_next_ns doesn't change. */
+        gint64 p_jitter_ns;
+        gint64 p_jitter_basetime_ns;
+        guint  p_jitter_interval;
+
+        /* the gateway of the best default route. When it changes, we check
+         * right away. */
+        NMIPAddr default_route_gw;
+        bool     has_default_route : 1;
+
         NMConnectivityState state;
     } concheck_x[2];
 
@@ -903,6 +925,8 @@ static void concheck_update_state(NMDevice           *self,
                                   NMConnectivityState state,
                                   gboolean            is_periodic);
 
+static void concheck_check_default_route(NMDevice *self);
+
 static void sriov_op_cb(GError *error, gpointer user_data);
 
 static void device_ifindex_changed_cb(NMManager *manager, NMDevice *device_changed, NMDevice *self);
@@ -5012,14 +5036,13 @@ _dev_l3_cfg_notify_cb(NML3Cfg *l3cfg, const NML3ConfigNotifyData *notify_data, N
         }
         _dev_ip_state_check_async(self, AF_UNSPEC);
         _dev_ipmanual_check_ready(self);
+        concheck_check_default_route(self);
         return;
     case NM_L3_CONFIG_NOTIFY_TYPE_IPV4LL_EVENT:
         nm_assert(NM_IS_L3_IPV4LL(notify_data->ipv4ll_event.ipv4ll));
         if (priv->ipll_data_4.v4.ipv4ll == notify_data->ipv4ll_event.ipv4ll)
             _dev_ipll4_notify_event(self);
         return;
-    case NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE:
-        return;
     case NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE:
         if (NM_FLAGS_ANY(notify_data->platform_change_on_idle.obj_type_flags,
                          nmp_object_type_to_flags(NMP_OBJECT_TYPE_LINK)
@@ -5125,6 +5148,17 @@ nm_device_get_iface(NMDevice *self)
     return NM_DEVICE_GET_PRIVATE(self)->iface;
 }
 
+static void
+_manager_device_index_update(NMDevice *self)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+
+    /* The manager indexes the devices by ifindex, iface, ip_iface and permanent
+     * MAC address. Tell it right away when one of them changes. */
+    if (priv->manager)
+        nm_manager_device_index_update(priv->manager, self);
+}
+
 static gboolean
 _set_ifindex(NMDevice *self, int ifindex, gboolean is_ip_ifindex)
 {
@@ -5211,6 +5245,8 @@ _set_ifindex(NMDevice *self, int ifindex, gboolean is_ip_ifindex)
                               ")",
                               ""));
 
+    _manager_device_index_update(self);
+
     if (priv->manager)
         nm_manager_emit_device_ifindex_changed(priv->manager, self);
 
@@ -5421,6 +5457,7 @@ _set_ip_ifindex(NMDevice *self, int ifindex, const char *ifname)
     if (!eq_name) {
         g_free(priv->ip_iface_);
         priv->ip_iface_ = g_strdup(ifname);
+        _manager_device_index_update(self);
         update_prop_ip_iface(self);
     }
     _set_ifindex(self, ifindex, TRUE);
@@ -6207,6 +6244,22 @@ nm_device_get_type_description(NMDevice *self)
     return NM_DEVICE_GET_CLASS(self)->get_type_description(self);
 }
 
+/**
+ * nm_device_get_connection_type_compatible:
+ * @self: the #NMDevice
+ *
+ * Returns: the connection type of all profiles that are compatible
+ *   with @self, or %NULL if @self is compatible with profiles of
+ *   different types.
+ */
+const char *
+nm_device_get_connection_type_compatible(NMDevice *self)
+{
+    g_return_val_if_fail(NM_IS_DEVICE(self), NULL);
+
+    return NM_DEVICE_GET_CLASS(self)->connection_type_check_compatible;
+}
+
 static const char *
 get_type_description(NMDevice *self)
 {
@@ -6423,6 +6476,55 @@ concheck_is_possible(NMDevice *self)
     return TRUE;
 }
 
+static void
+concheck_set_next(NMDevice *self, int addr_family, gint64 next_ns)
+{
+    NMDevicePrivate *priv    = NM_DEVICE_GET_PRIVATE(self);
+    const int        IS_IPv4 = NM_IS_IPv4(addr_family);
+
+    if (priv->concheck_x[IS_IPv4].p_next_ns == next_ns)
+        return;
+    priv->concheck_x[IS_IPv4].p_next_ns = next_ns;
+    _notify(self, IS_IPv4 ? PROP_IP4_CONNECTIVITY_NEXT_CHECK : PROP_IP6_CONNECTIVITY_NEXT_CHECK);
+}
+
+static gint64
+concheck_get_next_check(NMDevice *self, int addr_family)
+{
+    NMDevicePrivate *priv    = NM_DEVICE_GET_PRIVATE(self);
+    const int        IS_IPv4 = NM_IS_IPv4(addr_family);
+
+    if (priv->concheck_x[IS_IPv4].p_next_ns <= 0)
+        return -1;
+
+    return nm_utils_monotonic_timestamp_as_boottime(priv->concheck_x[IS_IPv4].p_next_ns
+                                                        / NM_UTILS_NSEC_PER_MSEC,
+                                                    NM_UTILS_NSEC_PER_MSEC);
+}
+
+static gint64
+concheck_get_jitter_ns(NMDevice *self, int addr_family)
+{
+    NMDevicePrivate *priv     = NM_DEVICE_GET_PRIVATE(self);
+    const int        IS_IPv4  = NM_IS_IPv4(addr_family);
+    const gint64     basetime = priv->concheck_x[IS_IPv4].p_cur_basetime_ns;
+    const guint      interval = priv->concheck_x[IS_IPv4].p_cur_interval;
+
+    /* Delay each periodic check by a random time (see nm_device_concheck_get_jitter_max_ns()).
+     * Otherwise, devices that started checking at the same time (for example,
+     * after the carrier of many links came up) would keep checking in lockstep.
+     *
+     * The jitter is not added to p_cur_basetime_ns, so it doesn't accumulate. */
+    if (priv->concheck_x[IS_IPv4].p_jitter_basetime_ns != basetime
+        || priv->concheck_x[IS_IPv4].p_jitter_interval != interval) {
+        priv->concheck_x[IS_IPv4].p_jitter_basetime_ns = basetime;
+        priv->concheck_x[IS_IPv4].p_jitter_interval    = interval;
+        priv->concheck_x[IS_IPv4].p_jitter_ns =
+            nm_random_u64_range(0, nm_device_concheck_get_jitter_max_ns(interval) + 1);
+    }
+    return priv->concheck_x[IS_IPv4].p_jitter_ns;
+}
+
 static gboolean
 concheck_periodic_schedule_do(NMDevice *self, int addr_family, gint64 now_ns)
 {
@@ -6453,7 +6555,8 @@ concheck_periodic_schedule_do(NMDevice *self, int addr_family, gint64 now_ns)
      * correct. */
 
     expiry = priv->concheck_x[IS_IPv4].p_cur_basetime_ns
-             + (priv->concheck_x[IS_IPv4].p_cur_interval * NM_UTILS_NSEC_PER_SEC);
+             + (priv->concheck_x[IS_IPv4].p_cur_interval * NM_UTILS_NSEC_PER_SEC)
+             + concheck_get_jitter_ns(self, addr_family);
     tdiff = expiry - now_ns;
 
     _LOGT(LOGD_CONCHECK,
@@ -6468,8 +6571,10 @@ concheck_periodic_schedule_do(NMDevice *self, int addr_family, gint64 now_ns)
         g_timeout_add(NM_MAX((gint64) 0, tdiff) / NM_UTILS_NSEC_PER_MSEC,
                       IS_IPv4 ? concheck_ip4_periodic_timeout_cb : concheck_ip6_periodic_timeout_cb,
                       self);
+    concheck_set_next(self, addr_family, NM_MAX(expiry, now_ns));
     return TRUE;
 out:
+    concheck_set_next(self, addr_family, 0);
     if (periodic_check_disabled) {
         _LOGT(LOGD_CONCHECK,
               "connectivity: [IPv%c] periodic-check: unscheduled",
@@ -6480,12 +6585,26 @@ out:
 
 #define CONCHECK_P_PROBE_INTERVAL 1u
 
+static guint
+concheck_get_bump_max_interval(NMDevice *self, int addr_family)
+{
+    NMDevicePrivate *priv    = NM_DEVICE_GET_PRIVATE(self);
+    const int        IS_IPv4 = NM_IS_IPv4(addr_family);
+
+    /* while we have full connectivity, we back off beyond the configured
+     * interval, up to the configured max-interval. */
+    if (priv->concheck_x[IS_IPv4].state == NM_CONNECTIVITY_FULL)
+        return priv->concheck_x[IS_IPv4].p_full_max_interval;
+    return priv->concheck_x[IS_IPv4].p_max_interval;
+}
+
 static void
 concheck_periodic_schedule_set(NMDevice *self, int addr_family, ConcheckScheduleMode mode)
 {
     NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
     gint64           new_expiry, exp_expiry, cur_expiry, tdiff;
     gint64           now_ns  = 0;
+    guint            bump_max_interval;
     const int        IS_IPv4 = NM_IS_IPv4(addr_family);
 
     if (priv->concheck_x[IS_IPv4].p_max_interval == 0) {
@@ -6522,7 +6641,9 @@ concheck_periodic_schedule_set(NMDevice *self, int addr_family, ConcheckSchedule
         nm_assert(priv->concheck_x[IS_IPv4].p_max_interval > 0);
         nm_assert(priv->concheck_x[IS_IPv4].p_cur_interval > 0);
 
-        if (priv->concheck_x[IS_IPv4].p_cur_interval <= priv->concheck_x[IS_IPv4].p_max_interval) {
+        bump_max_interval = concheck_get_bump_max_interval(self, addr_family);
+
+        if (priv->concheck_x[IS_IPv4].p_cur_interval <= bump_max_interval) {
             /* we currently have a shorter interval set, than what we now have. Either,
              * because we are probing, or because the previous max interval was shorter.
              *
@@ -6532,10 +6653,10 @@ concheck_periodic_schedule_set(NMDevice *self, int addr_family, ConcheckSchedule
         }
 
         cur_expiry = priv->concheck_x[IS_IPv4].p_cur_basetime_ns
-                     + (priv->concheck_x[IS_IPv4].p_max_interval * NM_UTILS_NSEC_PER_SEC);
+                     + (bump_max_interval * NM_UTILS_NSEC_PER_SEC);
         nm_utils_get_monotonic_timestamp_nsec_cached(&now_ns);
 
-        priv->concheck_x[IS_IPv4].p_cur_interval = priv->concheck_x[IS_IPv4].p_max_interval;
+        priv->concheck_x[IS_IPv4].p_cur_interval = bump_max_interval;
         if (cur_expiry <= now_ns) {
             /* Since the last time we scheduled a periodic check, already more than the
              * new max_interval passed. We need to start a check right away (and
@@ -6582,7 +6703,9 @@ concheck_periodic_schedule_set(NMDevice *self, int addr_family, ConcheckSchedule
              * have period requests pending that didn't complete yet. We need to bump the
              * interval already. */
             priv->concheck_x[IS_IPv4].p_cur_interval =
-                NM_MIN(old_interval * 2, priv->concheck_x[IS_IPv4].p_max_interval);
+                nm_device_concheck_get_bumped_interval(
+                    old_interval,
+                    concheck_get_bump_max_interval(self, addr_family));
         }
 
         /* we just reached a timeout. The expected expiry (exp_expiry) should be
@@ -6621,9 +6744,12 @@ concheck_periodic_schedule_set(NMDevice *self, int addr_family, ConcheckSchedule
         priv->concheck_x[IS_IPv4].p_cur_interval = priv->concheck_x[IS_IPv4].p_max_interval;
         break;
     case CONCHECK_SCHEDULE_RETURNED_BUMP:
+        /* note that for a stable full connectivity, we keep bumping beyond
+         * p_max_interval (see concheck_get_bump_max_interval()). */
         priv->concheck_x[IS_IPv4].p_cur_interval =
-            NM_MIN(priv->concheck_x[IS_IPv4].p_cur_interval * 2,
-                   priv->concheck_x[IS_IPv4].p_max_interval);
+            nm_device_concheck_get_bumped_interval(
+                priv->concheck_x[IS_IPv4].p_cur_interval,
+                concheck_get_bump_max_interval(self, addr_family));
         break;
     }
 
@@ -6650,7 +6776,11 @@ concheck_update_interval(NMDevice *self, int addr_family, gboolean check_now)
 
     new_interval = nm_connectivity_get_interval(concheck_get_mgr(self));
 
-    new_interval = NM_MIN(new_interval, 7u * 24u * 3600u);
+    new_interval = NM_MIN(new_interval, NM_DEVICE_CONCHECK_INTERVAL_MAX);
+
+    priv->concheck_x[IS_IPv4].p_full_max_interval = nm_device_concheck_get_full_max_interval(
+        new_interval,
+        nm_connectivity_get_max_interval(concheck_get_mgr(self)));
 
     if (new_interval != priv->concheck_x[IS_IPv4].p_max_interval) {
         _LOGT(LOGD_CONCHECK,
@@ -6687,6 +6817,103 @@ nm_device_check_connectivity_update_interval(NMDevice *self)
     concheck_update_interval(self, AF_INET6, TRUE);
 }
 
+/**
+ * nm_device_check_connectivity_probe:
+ * @self: the #NMDevice
+ * @addr_family: the address family to check, or %AF_UNSPEC for both.
+ * @reason: the reason for logging
+ *
+ * Something changed that might affect the connectivity of the device.
+ * Start a check right away, like an external check does. The current
+ * interval of the periodic checks is kept, it only changes if the check
+ * returns a different state. While such a check is pending, further
+ * events don't start another one.
+ *
+ * If periodic checks are not running, they get started.
+ */
+void
+nm_device_check_connectivity_probe(NMDevice *self, int addr_family, const char *reason)
+{
+    NMDevicePrivate            *priv = NM_DEVICE_GET_PRIVATE(self);
+    NMDeviceConnectivityHandle *handle;
+    int                         IS_IPv4;
+
+    for (IS_IPv4 = 1; IS_IPv4 >= 0; IS_IPv4--) {
+        const int addr_family_i = IS_IPv4 ? AF_INET : AF_INET6;
+        gboolean  pending       = FALSE;
+
+        if (!NM_IN_SET(addr_family, AF_UNSPEC, addr_family_i))
+            continue;
+
+        if (!priv->concheck_x[IS_IPv4].p_cur_id) {
+            _LOGT(LOGD_CONCHECK,
+                  "connectivity: [IPv%c] periodic-check: start due to %s",
+                  nm_utils_addr_family_to_char(addr_family_i),
+                  reason);
+            concheck_update_interval(self, addr_family_i, TRUE);
+            continue;
+        }
+
+        c_list_for_each_entry (handle, &priv->concheck_lst_head, concheck_lst) {
+            if (handle->addr_family == addr_family_i && handle->is_probe) {
+                pending = TRUE;
+                break;
+            }
+        }
+        if (pending) {
+            _LOGT(LOGD_CONCHECK,
+                  "connectivity: [IPv%c] periodic-check: ignore %s, a check is pending",
+                  nm_utils_addr_family_to_char(addr_family_i),
+                  reason);
+            continue;
+        }
+
+        _LOGT(LOGD_CONCHECK,
+              "connectivity: [IPv%c] periodic-check: check now due to %s",
+              nm_utils_addr_family_to_char(addr_family_i),
+              reason);
+
+        /* this delays the next periodic check, but doesn't reset the interval. */
+        concheck_periodic_schedule_set(self, addr_family_i, CONCHECK_SCHEDULE_CHECK_EXTERNAL);
+        if (!priv->concheck_x[IS_IPv4].p_cur_id) {
+            /* the check is no longer possible. */
+            continue;
+        }
+
+        handle           = concheck_start(self, addr_family_i, NULL, NULL, FALSE);
+        handle->is_probe = TRUE;
+    }
+}
+
+static void
+concheck_check_default_route(NMDevice *self)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+    int              IS_IPv4;
+
+    for (IS_IPv4 = 1; IS_IPv4 >= 0; IS_IPv4--) {
+        const int        addr_family = IS_IPv4 ? AF_INET : AF_INET6;
+        const NMPObject *route       = nm_device_get_best_default_route(self, addr_family);
+        gconstpointer    gateway;
+
+        /* only compare the gateway, not the metric. The metric changes with the
+         * connectivity state, which would trigger a new check. */
+        gateway = nm_platform_ip_route_get_gateway(addr_family, NMP_OBJECT_CAST_IP_ROUTE(route));
+        if (!gateway == !priv->concheck_x[IS_IPv4].has_default_route
+            && (!gateway
+                || nm_ip_addr_equal(addr_family,
+                                    gateway,
+                                    &priv->concheck_x[IS_IPv4].default_route_gw)))
+            continue;
+
+        priv->concheck_x[IS_IPv4].has_default_route = !!gateway;
+        nm_ip_addr_set(addr_family,
+                       &priv->concheck_x[IS_IPv4].default_route_gw,
+                       gateway ?: &nm_ip_addr_zero);
+        nm_device_check_connectivity_probe(self, addr_family, "default route change");
+    }
+}
+
 static void
 concheck_update_state(NMDevice           *self,
                       int                 addr_family,
@@ -7523,6 +7750,8 @@ nm_device_set_carrier(NMDevice *self, gboolean carrier)
 
     nm_gobject_notify_together(self, PROP_CARRIER, notify_flags ? PROP_INTERFACE_FLAGS : PROP_0);
 
+    nm_device_check_connectivity_probe(self, AF_UNSPEC, "carrier change");
+
     if (priv->carrier) {
         _LOGI(LOGD_DEVICE, "carrier: link connected");
         carrier_disconnected_action_cancel(self);
@@ -7804,6 +8033,7 @@ device_link_changed(gpointer user_data)
               pllink->name);
         g_free(priv->iface_);
         priv->iface_ = g_strdup(pllink->name);
+        _manager_device_index_update(self);
 
         /* If the device has no explicit ip_iface, then changing iface changes ip_iface too. */
         ip_ifname_changed = !priv->ip_iface;
@@ -7977,6 +8207,7 @@ device_ip_link_changed(gpointer user_data)
               ip_iface);
         g_free(priv->ip_iface_);
         priv->ip_iface_ = g_strdup(ip_iface);
+        _manager_device_index_update(self);
         update_prop_ip_iface(self);
 
         nm_device_update_dynamic_ip_setup(self, "interface renamed");
@@ -8227,8 +8458,10 @@ nm_device_update_from_platform_link(NMDevice *self, const NMPlatformLink *plink)
         _notify(self, PROP_PATH);
     }
 
-    if (plink && !nm_str_is_empty(plink->name) && nm_strdup_reset(&priv->iface_, plink->name))
+    if (plink && !nm_str_is_empty(plink->name) && nm_strdup_reset(&priv->iface_, plink->name)) {
+        _manager_device_index_update(self);
         _notify(self, PROP_IFACE);
+    }
 
     str = plink ? plink->driver : NULL;
     if (!nm_streq0(str, priv->driver)) {
@@ -8776,6 +9009,8 @@ nm_device_unrealize(NMDevice *self, gboolean remove_resources, GError **error)
         _notify(self, PROP_PERM_HW_ADDRESS);
     nm_clear_g_free(&priv->hw_addr_initial);
 
+    _manager_device_index_update(self);
+
     priv->capabilities = NM_DEVICE_CAP_NM_SUPPORTED;
     if (NM_DEVICE_GET_CLASS(self)->get_generic_capabilities)
         priv->capabilities |= NM_DEVICE_GET_CLASS(self)->get_generic_capabilities(self);
@@ -18600,6 +18835,7 @@ nm_device_update_permanent_hw_address(NMDevice *self, gboolean force_freeze)
     priv->hw_addr_perm = g_strdup(priv->hw_addr);
 
 notify_and_out:
+    _manager_device_index_update(self);
     _notify(self, PROP_PERM_HW_ADDRESS);
 }
 
@@ -19773,6 +20009,12 @@ get_property(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
     case PROP_IP6_CONNECTIVITY:
         g_value_set_uint(value, priv->concheck_x[0].state);
         break;
+    case PROP_IP4_CONNECTIVITY_NEXT_CHECK:
+        g_value_set_int64(value, concheck_get_next_check(self, AF_INET));
+        break;
+    case PROP_IP6_CONNECTIVITY_NEXT_CHECK:
+        g_value_set_int64(value, concheck_get_next_check(self, AF_INET6));
+        break;
     case PROP_INTERFACE_FLAGS:
         g_value_set_uint(value, priv->interface_flags);
         break;
@@ -20252,6 +20494,12 @@ static const NMDBusInterfaceInfoExtended interface_info_device = {
             NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE("Ip6Connectivity",
                                                            "u",
                                                            NM_DEVICE_IP6_CONNECTIVITY),
+            NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE("Ip4ConnectivityNextCheck",
+                                                           "x",
+                                                           NM_DEVICE_IP4_CONNECTIVITY_NEXT_CHECK),
+            NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE("Ip6ConnectivityNextCheck",
+                                                           "x",
+                                                           NM_DEVICE_IP6_CONNECTIVITY_NEXT_CHECK),
             NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE("InterfaceFlags",
                                                            "u",
                                                            NM_DEVICE_INTERFACE_FLAGS),
@@ -20600,6 +20848,22 @@ nm_device_class_init(NMDeviceClass *klass)
                           NM_CONNECTIVITY_FULL,
                           NM_CONNECTIVITY_UNKNOWN,
                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+    obj_properties[PROP_IP4_CONNECTIVITY_NEXT_CHECK] =
+        g_param_spec_int64(NM_DEVICE_IP4_CONNECTIVITY_NEXT_CHECK,
+                           "",
+                           "",
+                           -1,
+                           G_MAXINT64,
+                           -1,
+                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+    obj_properties[PROP_IP6_CONNECTIVITY_NEXT_CHECK] =
+        g_param_spec_int64(NM_DEVICE_IP6_CONNECTIVITY_NEXT_CHECK,
+                           "",
+                           "",
+                           -1,
+                           G_MAXINT64,
+                           -1,
+                           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
     obj_properties[PROP_INTERFACE_FLAGS] =
         g_param_spec_uint(NM_DEVICE_INTERFACE_FLAGS,
                           "",
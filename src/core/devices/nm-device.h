@@ -85,9 +85,11 @@
 #define NM_DEVICE_STATISTICS_TX_BYTES        "tx-bytes"
 #define NM_DEVICE_STATISTICS_RX_BYTES        "rx-bytes"
 
-#define NM_DEVICE_IP4_CONNECTIVITY "ip4-connectivity"
-#define NM_DEVICE_IP6_CONNECTIVITY "ip6-connectivity"
-#define NM_DEVICE_INTERFACE_FLAGS  "interface-flags"
+#define NM_DEVICE_IP4_CONNECTIVITY            "ip4-connectivity"
+#define NM_DEVICE_IP6_CONNECTIVITY            "ip6-connectivity"
+#define NM_DEVICE_IP4_CONNECTIVITY_NEXT_CHECK "ip4-connectivity-next-check"
+#define NM_DEVICE_IP6_CONNECTIVITY_NEXT_CHECK "ip6-connectivity-next-check"
+#define NM_DEVICE_INTERFACE_FLAGS             "interface-flags"
 
 #define NM_TYPE_DEVICE            (nm_device_get_type())
 #define NM_DEVICE(obj)            (_NM_G_TYPE_CHECK_INSTANCE_CAST((obj), NM_TYPE_DEVICE, NMDevice))
@@ -464,6 +466,7 @@ const char  *nm_device_get_driver_version(NMDevice *dev);
 const char  *nm_device_get_type_desc(NMDevice *dev);
 const char  *nm_device_get_type_desc_for_log(NMDevice *dev);
 const char  *nm_device_get_type_description(NMDevice *dev);
+const char  *nm_device_get_connection_type_compatible(NMDevice *dev);
 NMDeviceType nm_device_get_device_type(NMDevice *dev);
 NMLinkType   nm_device_get_link_type(NMDevice *dev);
 NMMetered    nm_device_get_metered(NMDevice *dev);
@@ -811,6 +814,8 @@ typedef void (*NMDeviceConnectivityCallback)(NMDevice                   *self,
 
 void nm_device_check_connectivity_update_interval(NMDevice *self);
 
+void nm_device_check_connectivity_probe(NMDevice *self, int addr_family, const char *reason);
+
 NMDeviceConnectivityHandle *nm_device_check_connectivity(NMDevice                    *self,
                                                          int                          addr_family,
                                                          NMDeviceConnectivityCallback callback,
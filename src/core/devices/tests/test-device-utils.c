@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "devices/nm-device-utils.h"
+
+#include "nm-test-utils-core.h"
+
+/*****************************************************************************/
+
+static void
+test_concheck_jitter(void)
+{
+    g_assert_cmpint(nm_device_concheck_get_jitter_max_ns(0), ==, 0);
+    g_assert_cmpint(nm_device_concheck_get_jitter_max_ns(1), ==, NM_UTILS_NSEC_PER_SEC / 8);
+    g_assert_cmpint(nm_device_concheck_get_jitter_max_ns(300), ==, 37500 * NM_UTILS_NSEC_PER_MSEC);
+
+    /* the longest interval doesn't overflow. */
+    g_assert_cmpint(nm_device_concheck_get_jitter_max_ns(NM_DEVICE_CONCHECK_INTERVAL_MAX),
+                    ==,
+                    ((gint64) NM_DEVICE_CONCHECK_INTERVAL_MAX) * NM_UTILS_NSEC_PER_SEC / 8);
+    g_assert_cmpint(nm_device_concheck_get_jitter_max_ns(G_MAXUINT),
+                    ==,
+                    nm_device_concheck_get_jitter_max_ns(NM_DEVICE_CONCHECK_INTERVAL_MAX));
+}
+
+static void
+test_concheck_bump(void)
+{
+    static const guint expected[] = {1, 2, 4, 8, 16, 32, 64, 128, 256, 300, 300};
+    guint              interval   = 1;
+    guint              i;
+
+    for (i = 0; i < G_N_ELEMENTS(expected); i++) {
+        g_assert_cmpuint(interval, ==, expected[i]);
+        interval = nm_device_concheck_get_bumped_interval(interval, 300);
+    }
+
+    g_assert_cmpuint(nm_device_concheck_get_bumped_interval(0, 300), ==, 1);
+    g_assert_cmpuint(nm_device_concheck_get_bumped_interval(1, 3), ==, 2);
+    g_assert_cmpuint(nm_device_concheck_get_bumped_interval(2, 3), ==, 3);
+    g_assert_cmpuint(nm_device_concheck_get_bumped_interval(1, 1), ==, 1);
+
+    /* after the max interval got shorter, the next bump goes down to it. */
+    g_assert_cmpuint(nm_device_concheck_get_bumped_interval(3600, 300), ==, 300);
+
+    /* doubling doesn't overflow. */
+    g_assert_cmpuint(nm_device_concheck_get_bumped_interval(G_MAXUINT / 2u + 1u, G_MAXUINT),
+                     ==,
+                     G_MAXUINT);
+}
+
+static void
+test_concheck_full_max_interval(void)
+{
+    g_assert_cmpuint(nm_device_concheck_get_full_max_interval(300, 3600), ==, 3600);
+    g_assert_cmpuint(nm_device_concheck_get_full_max_interval(300, 0), ==, 300);
+    g_assert_cmpuint(nm_device_concheck_get_full_max_interval(300, 60), ==, 300);
+    g_assert_cmpuint(nm_device_concheck_get_full_max_interval(300, G_MAXUINT),
+                     ==,
+                     NM_DEVICE_CONCHECK_INTERVAL_MAX);
+    g_assert_cmpuint(nm_device_concheck_get_full_max_interval(G_MAXUINT, 0),
+                     ==,
+                     NM_DEVICE_CONCHECK_INTERVAL_MAX);
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE();
+
+int
+main(int argc, char **argv)
+{
+    nmtst_init_with_logging(&argc, &argv, NULL, "ALL");
+
+    g_test_add_func("/device-utils/concheck/jitter", test_concheck_jitter);
+    g_test_add_func("/device-utils/concheck/bump", test_concheck_bump);
+    g_test_add_func("/device-utils/concheck/full-max-interval", test_concheck_full_max_interval);
+
+    return g_test_run();
+}
@@ -34,6 +34,7 @@
 #include "nm-setting-ip4-config.h"
 #include "nm-setting-ip6-config.h"
 #include "libnm-platform/nm-platform.h"
+#include "libnm-platform/wifi/nm-wifi-utils.h"
 #include "nm-auth-utils.h"
 #include "settings/nm-settings-connection.h"
 #include "settings/nm-settings.h"
@@ -81,12 +82,19 @@ typedef struct {
     CList       aps_lst_head;
     GHashTable *aps_idx_by_supplicant_path;
 
+    /* The APs indexed by SSID and by BSSID. */
+    NMWifiAPIndex *aps_idx;
+
     CList scanning_prohibited_lst_head;
 
     GCancellable *scan_request_cancellable;
 
     GSource *scan_request_delay_source;
     GSource *roam_supplicant_wait_source;
+    GSource *nl80211_scan_results_source;
+    GSource *recheck_available_connections_source;
+
+    gulong nl80211_scan_results_id;
 
     NMWifiAP *current_ap;
 
@@ -138,6 +146,10 @@ typedef struct {
 
     bool addressing_running_indicated : 1;
 
+    /* whether the APs are populated from the nl80211 scan results of the
+     * kernel, instead of the BSS signals of the supplicant. */
+    bool nl80211_scan_results : 1;
+
 } NMDeviceWifiPrivate;
 
 struct _NMDeviceWifi {
@@ -160,6 +172,8 @@ G_DEFINE_TYPE(NMDeviceWifi, nm_device_wifi, NM_TYPE_DEVICE)
 
 static void supplicant_iface_state_down(NMDeviceWifi *self);
 
+static void remove_all_aps(NMDeviceWifi *self, gboolean disposing);
+
 static void cleanup_association_attempt(NMDeviceWifi *self, gboolean disconnect);
 
 static void supplicant_iface_state(NMDeviceWifi              *self,
@@ -179,6 +193,8 @@ static void supplicant_iface_bss_changed_cb(NMSupplicantInterface *iface,
                                             gboolean               is_present,
                                             NMDeviceWifi          *self);
 
+static void nl80211_scan_results_cb(NMPlatform *platform, int ifindex, NMDeviceWifi *self);
+
 static void supplicant_iface_wps_credentials_cb(NMSupplicantInterface *iface,
                                                 GVariant              *credentials,
                                                 NMDeviceWifi          *self);
@@ -587,6 +603,7 @@ supplicant_interface_acquire_cb(NMSupplicantManager         *supplicant_manager,
 {
     NMDeviceWifi        *self = user_data;
     NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE(self);
+    gboolean             nl80211_scan_results;
 
     if (nm_utils_error_is_cancelled(error))
         return;
@@ -606,6 +623,18 @@ supplicant_interface_acquire_cb(NMSupplicantManager         *supplicant_manager,
 
     priv->sup_iface = g_object_ref(iface);
 
+    nl80211_scan_results = nm_config_data_get_device_config_boolean_by_device(
+        NM_CONFIG_GET_DATA,
+        NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_NL80211_SCAN_RESULTS,
+        NM_DEVICE(self),
+        FALSE,
+        FALSE);
+    if (priv->nl80211_scan_results != nl80211_scan_results) {
+        /* The APs are tracked by a different path, drop the ones we have. */
+        remove_all_aps(self, FALSE);
+        priv->nl80211_scan_results = nl80211_scan_results;
+    }
+
     g_signal_connect(priv->sup_iface,
                      NM_SUPPLICANT_INTERFACE_STATE,
                      G_CALLBACK(supplicant_iface_state_cb),
@@ -639,6 +668,17 @@ supplicant_interface_acquire_cb(NMSupplicantManager         *supplicant_manager,
                      G_CALLBACK(supplicant_iface_notify_wpa_sae_mismatch_cb),
                      self);
 
+    if (priv->nl80211_scan_results) {
+        _LOGD(LOGD_WIFI_SCAN, "reading scan results via nl80211");
+        priv->nl80211_scan_results_id = g_signal_connect(nm_device_get_platform(NM_DEVICE(self)),
+                                                         NM_PLATFORM_WIFI_SCAN_RESULTS,
+                                                         G_CALLBACK(nl80211_scan_results_cb),
+                                                         self);
+        nm_platform_wifi_watch_scan_results(nm_device_get_platform(NM_DEVICE(self)), TRUE);
+        /* pick up the results that the kernel already has. */
+        nl80211_scan_results_cb(NULL, 0, self);
+    }
+
     _scan_notify_is_scanning(self);
 
     if (nm_supplicant_interface_get_state(priv->sup_iface)
@@ -690,6 +730,11 @@ supplicant_interface_release(NMDeviceWifi *self)
 
     nm_clear_g_source(&priv->ap_dump_id);
 
+    nm_clear_g_source_inst(&priv->nl80211_scan_results_source);
+    if (nm_clear_g_signal_handler(nm_device_get_platform(NM_DEVICE(self)),
+                                  &priv->nl80211_scan_results_id))
+        nm_platform_wifi_watch_scan_results(nm_device_get_platform(NM_DEVICE(self)), FALSE);
+
     if (priv->sup_iface) {
         /* Clear supplicant interface signal handlers */
         g_signal_handlers_disconnect_by_data(priv->sup_iface, self);
@@ -832,6 +877,43 @@ periodic_update_cb(gpointer user_data)
     return TRUE;
 }
 
+static NMWifiAP *
+aps_find_first_compatible(NMDeviceWifi *self, NMConnection *connection)
+{
+    NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE(self);
+
+    return nm_wifi_ap_index_find_first_compatible(priv->aps_idx, &priv->aps_lst_head, connection);
+}
+
+static void
+recheck_available_connections_now(NMDeviceWifi *self)
+{
+    NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE(self);
+
+    nm_clear_g_source_inst(&priv->recheck_available_connections_source);
+    nm_device_recheck_available_connections(NM_DEVICE(self));
+}
+
+static gboolean
+_recheck_available_connections_cb(gpointer user_data)
+{
+    recheck_available_connections_now(user_data);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+recheck_available_connections_schedule(NMDeviceWifi *self)
+{
+    NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE(self);
+
+    /* A scan result can add and remove many APs at once. Recheck the
+     * available connections only once for all of them. Other changes
+     * (like the fake AP of an activation) recheck right away. */
+    if (!priv->recheck_available_connections_source)
+        priv->recheck_available_connections_source =
+            nm_g_idle_add_source(_recheck_available_connections_cb, self);
+}
+
 static void
 ap_add_remove(NMDeviceWifi *self,
               gboolean      is_adding, /* or else removing */
@@ -849,6 +931,7 @@ ap_add_remove(NMDeviceWifi *self,
                                  nm_wifi_ap_get_supplicant_path(ap),
                                  ap))
             nm_assert_not_reached();
+        nm_wifi_ap_index_update(priv->aps_idx, ap, FALSE);
         nm_dbus_object_export(NM_DBUS_OBJECT(ap));
         _ap_dump(self, LOGL_DEBUG, ap, "added", 0);
         nm_device_wifi_emit_signal_access_point(NM_DEVICE(self), ap, TRUE);
@@ -858,6 +941,7 @@ ap_add_remove(NMDeviceWifi *self,
         if (!g_hash_table_remove(priv->aps_idx_by_supplicant_path,
                                  nm_wifi_ap_get_supplicant_path(ap)))
             nm_assert_not_reached();
+        nm_wifi_ap_index_update(priv->aps_idx, ap, TRUE);
         _ap_dump(self, LOGL_DEBUG, ap, "removed", 0);
     }
 
@@ -871,7 +955,7 @@ ap_add_remove(NMDeviceWifi *self,
     if (recheck_auto_activate)
         nm_device_recheck_auto_activate_schedule(NM_DEVICE(self));
     if (recheck_available_connections)
-        nm_device_recheck_available_connections(NM_DEVICE(self));
+        recheck_available_connections_now(self);
 }
 
 static void
@@ -888,8 +972,10 @@ remove_all_aps(NMDeviceWifi *self, gboolean disposing)
     while ((ap = c_list_first_entry(&priv->aps_lst_head, NMWifiAP, aps_lst)))
         ap_add_remove(self, FALSE, ap, FALSE, !disposing);
 
-    if (!disposing)
-        nm_device_recheck_available_connections(NM_DEVICE(self));
+    if (disposing)
+        nm_clear_g_source_inst(&priv->recheck_available_connections_source);
+    else
+        recheck_available_connections_now(self);
 }
 
 static gboolean
@@ -1187,7 +1273,7 @@ check_connection_available(NMDevice                      *device,
         || NM_FLAGS_HAS(flags, _NM_DEVICE_CHECK_CON_AVAILABLE_FOR_USER_REQUEST_IGNORE_AP))
         return TRUE;
 
-    if (!nm_wifi_aps_find_first_compatible(&priv->aps_lst_head, connection)) {
+    if (!aps_find_first_compatible(self, connection)) {
         nm_utils_error_set_literal(error,
                                    NM_UTILS_ERROR_CONNECTION_AVAILABLE_TEMPORARY,
                                    "no compatible access point found");
@@ -1240,7 +1326,7 @@ complete_connection(NMDevice            *device,
 
         if (!nm_streq0(mode, NM_SETTING_WIRELESS_MODE_AP)) {
             /* Find a compatible AP in the scan list */
-            ap = nm_wifi_aps_find_first_compatible(&priv->aps_lst_head, connection);
+            ap = aps_find_first_compatible(self, connection);
 
             /* If we still don't have an AP, then the WiFI settings needs to be
              * fully specified by the client.  Might not be able to find an AP
@@ -1393,7 +1479,7 @@ can_auto_connect(NMDevice *device, NMSettingsConnection *sett_conn, char **speci
     else if (!auto4 && !auto6 && nm_streq0(mode, NM_SETTING_WIRELESS_MODE_MESH))
         return TRUE;
 
-    ap = nm_wifi_aps_find_first_compatible(&priv->aps_lst_head, connection);
+    ap = aps_find_first_compatible(self, connection);
     if (ap) {
         /* All good; connection is usable */
         NM_SET_OUT(specific_object, g_strdup(nm_dbus_object_get_path(NM_DBUS_OBJECT(ap))));
@@ -2002,10 +2088,30 @@ try_fill_ssid_for_hidden_ap(NMDeviceWifi *self, NMWifiAP *ap)
 }
 
 static void
-supplicant_iface_bss_changed_cb(NMSupplicantInterface *iface,
-                                NMSupplicantBssInfo   *bss_info,
-                                gboolean               is_present,
-                                NMDeviceWifi          *self)
+ap_remove_unless_current(NMDeviceWifi *self, NMWifiAP *ap)
+{
+    NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE(self);
+
+    if (ap == priv->current_ap) {
+        /* The current AP cannot be removed (to prevent NM indicating that
+         * it is connected, but to nothing), but it must be removed later
+         * when the current AP is changed or cleared.  Set 'fake' to
+         * indicate that this AP is now unknown to the supplicant.
+         */
+        if (nm_wifi_ap_set_fake(ap, TRUE))
+            _ap_dump(self, LOGL_DEBUG, ap, "updated", 0);
+    } else {
+        ap_add_remove(self, FALSE, ap, FALSE, TRUE);
+        recheck_available_connections_schedule(self);
+        schedule_ap_list_dump(self);
+    }
+}
+
+/* Returns: %TRUE if an AP was added or updated from @bss_info. */
+static gboolean
+ap_update_from_bss_info(NMDeviceWifi              *self,
+                        const NMSupplicantBssInfo *bss_info,
+                        gboolean                   is_present)
 {
     NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE(self);
     NMWifiAP            *found_ap;
@@ -2014,26 +2120,15 @@ supplicant_iface_bss_changed_cb(NMSupplicantInterface *iface,
     found_ap = g_hash_table_lookup(priv->aps_idx_by_supplicant_path, bss_info->bss_path);
 
     if (!is_present) {
-        if (!found_ap)
-            return;
-        if (found_ap == priv->current_ap) {
-            /* The current AP cannot be removed (to prevent NM indicating that
-             * it is connected, but to nothing), but it must be removed later
-             * when the current AP is changed or cleared.  Set 'fake' to
-             * indicate that this AP is now unknown to the supplicant.
-             */
-            if (nm_wifi_ap_set_fake(found_ap, TRUE))
-                _ap_dump(self, LOGL_DEBUG, found_ap, "updated", 0);
-        } else {
-            ap_add_remove(self, FALSE, found_ap, TRUE, TRUE);
-            schedule_ap_list_dump(self);
-        }
-        return;
+        if (found_ap)
+            ap_remove_unless_current(self, found_ap);
+        return FALSE;
     }
 
     if (found_ap) {
         if (!nm_wifi_ap_update_from_properties(found_ap, bss_info))
-            return;
+            return FALSE;
+        nm_wifi_ap_index_update(priv->aps_idx, found_ap, FALSE);
         _ap_dump(self, LOGL_DEBUG, found_ap, "updated", 0);
     } else {
         gs_unref_object NMWifiAP *ap = NULL;
@@ -2042,7 +2137,7 @@ supplicant_iface_bss_changed_cb(NMSupplicantInterface *iface,
             /* We failed to initialize the info about the AP. This can
              * happen due to an error in the D-Bus communication. In this case
              * we ignore the info. */
-            return;
+            return FALSE;
         }
 
         ap = nm_wifi_ap_new_from_properties(bss_info);
@@ -2068,9 +2163,29 @@ supplicant_iface_bss_changed_cb(NMSupplicantInterface *iface,
             }
         }
 
-        ap_add_remove(self, TRUE, ap, TRUE, TRUE);
+        ap_add_remove(self, TRUE, ap, FALSE, TRUE);
+        recheck_available_connections_schedule(self);
     }
 
+    return TRUE;
+}
+
+static void
+supplicant_iface_bss_changed_cb(NMSupplicantInterface *iface,
+                                NMSupplicantBssInfo   *bss_info,
+                                gboolean               is_present,
+                                NMDeviceWifi          *self)
+{
+    NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE(self);
+
+    if (priv->nl80211_scan_results) {
+        /* the APs are populated from the kernel's scan results. */
+        return;
+    }
+
+    if (!ap_update_from_bss_info(self, bss_info, is_present))
+        return;
+
     /* Update the current AP if the supplicant notified a current BSS change
      * before it sent the current BSS's scan result.
      */
@@ -2080,6 +2195,80 @@ supplicant_iface_bss_changed_cb(NMSupplicantInterface *iface,
     schedule_ap_list_dump(self);
 }
 
+static void
+nl80211_scan_results_update(NMDeviceWifi *self)
+{
+    NMDeviceWifiPrivate           *priv        = NM_DEVICE_WIFI_GET_PRIVATE(self);
+    gs_unref_array GArray         *results     = NULL;
+    gs_unref_hashtable GHashTable *results_idx = NULL;
+    NMWifiAP                      *ap;
+    NMWifiAP                      *ap_safe;
+    gint64                         now_msec;
+    guint                          i;
+    int                            ifindex;
+
+    ifindex = nm_device_get_ifindex(NM_DEVICE(self));
+    if (ifindex <= 0)
+        return;
+
+    results = nm_platform_wifi_get_scan_results(nm_device_get_platform(NM_DEVICE(self)), ifindex);
+    if (!results) {
+        _LOGD(LOGD_WIFI_SCAN, "failed to read the scan results via nl80211");
+        return;
+    }
+
+    _LOGT(LOGD_WIFI_SCAN, "read %u scan results via nl80211", results->len);
+
+    results_idx = nm_wifi_ap_nl80211_scan_results_index(results);
+
+    now_msec = nm_utils_get_monotonic_timestamp_msec();
+    for (i = 0; i < results->len; i++) {
+        const NMWifiScanResult *result = &g_array_index(results, NMWifiScanResult, i);
+        NMSupplicantBssInfo     bss_info;
+
+        nm_wifi_ap_bss_info_from_scan_result(&bss_info, result, now_msec);
+        if (g_hash_table_lookup(results_idx, bss_info.bss_path) == result)
+            ap_update_from_bss_info(self, &bss_info, TRUE);
+        nm_wifi_ap_bss_info_clear(&bss_info);
+    }
+
+    c_list_for_each_entry_safe (ap, ap_safe, &priv->aps_lst_head, aps_lst) {
+        if (nm_wifi_ap_nl80211_is_stale(ap, results_idx))
+            ap_remove_unless_current(self, ap);
+    }
+
+    if (priv->sup_iface && nm_supplicant_interface_get_current_bss(priv->sup_iface))
+        supplicant_iface_notify_current_bss(priv->sup_iface, NULL, self);
+
+    schedule_ap_list_dump(self);
+}
+
+static gboolean
+nl80211_scan_results_idle_cb(gpointer user_data)
+{
+    NMDeviceWifi        *self = user_data;
+    NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE(self);
+
+    nm_clear_g_source_inst(&priv->nl80211_scan_results_source);
+    nl80211_scan_results_update(self);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+nl80211_scan_results_cb(NMPlatform *platform, int ifindex, NMDeviceWifi *self)
+{
+    NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE(self);
+
+    if (platform && ifindex != nm_device_get_ifindex(NM_DEVICE(self)))
+        return;
+
+    /* The kernel notifies once per completed scan. Read the results on idle,
+     * so that several notifications result in only one dump. */
+    if (!priv->nl80211_scan_results_source)
+        priv->nl80211_scan_results_source =
+            nm_g_idle_add_source(nl80211_scan_results_idle_cb, self);
+}
+
 static void
 cleanup_association_attempt(NMDeviceWifi *self, gboolean disconnect)
 {
@@ -2711,7 +2900,21 @@ supplicant_iface_notify_current_bss(NMSupplicantInterface *iface,
     NMActRequest        *req;
 
     current_bss = nm_supplicant_interface_get_current_bss(iface);
-    if (current_bss)
+    if (current_bss && priv->nl80211_scan_results) {
+        NMEtherAddr bssid;
+
+        /* The supplicant's BSS path is unknown to us, find the AP by the
+         * BSSID of the station instead. */
+        if (nm_platform_wifi_get_station(nm_device_get_platform(NM_DEVICE(self)),
+                                         nm_device_get_ifindex(NM_DEVICE(self)),
+                                         &bssid,
+                                         NULL,
+                                         NULL)) {
+            nm_auto_ref_string NMRefString *bss_path = nm_wifi_ap_nl80211_bss_path_new(&bssid);
+
+            new_ap = g_hash_table_lookup(priv->aps_idx_by_supplicant_path, bss_path);
+        }
+    } else if (current_bss)
         new_ap = g_hash_table_lookup(priv->aps_idx_by_supplicant_path, current_bss);
 
     if (new_ap != priv->current_ap) {
@@ -3285,7 +3488,7 @@ act_stage1_prepare(NMDevice *device, NMDeviceStateReason *out_failure_reason)
         ap      = ap_path ? nm_wifi_ap_lookup_for_device(NM_DEVICE(self), ap_path) : NULL;
     }
     if (!ap)
-        ap = nm_wifi_aps_find_first_compatible(&priv->aps_lst_head, connection);
+        ap = aps_find_first_compatible(self, connection);
 
     if (!ap) {
         /* If the user is trying to connect to an AP that NM doesn't yet know about
@@ -3649,8 +3852,10 @@ activation_success_handler(NMDevice *device)
                     ap_changed |= nm_wifi_ap_set_max_bitrate(priv->current_ap, rate);
             }
 
-            if (ap_changed)
+            if (ap_changed) {
+                nm_wifi_ap_index_update(priv->aps_idx, priv->current_ap, FALSE);
                 _ap_dump(self, LOGL_DEBUG, priv->current_ap, "updated", 0);
+            }
         }
 
         nm_active_connection_set_specific_object(
@@ -3911,6 +4116,7 @@ nm_device_wifi_init(NMDeviceWifi *self)
     c_list_init(&priv->scanning_prohibited_lst_head);
     c_list_init(&priv->scan_request_ssids_lst_head);
     priv->aps_idx_by_supplicant_path = g_hash_table_new(nm_direct_hash, NULL);
+    priv->aps_idx                    = nm_wifi_ap_index_new();
 
     priv->scan_last_request_started_at_msec = G_MININT64;
     priv->hidden_probe_scan_warn            = TRUE;
@@ -3960,6 +4166,7 @@ dispose(GObject *object)
 
     nm_clear_g_source(&priv->periodic_update_id);
     nm_clear_g_source_inst(&priv->roam_supplicant_wait_source);
+    nm_clear_g_source_inst(&priv->recheck_available_connections_source);
 
     wifi_secrets_cancel(self);
 
@@ -3990,6 +4197,7 @@ finalize(GObject *object)
     nm_assert(g_hash_table_size(priv->aps_idx_by_supplicant_path) == 0);
 
     g_hash_table_unref(priv->aps_idx_by_supplicant_path);
+    nm_wifi_ap_index_free(priv->aps_idx);
 
     G_OBJECT_CLASS(nm_device_wifi_parent_class)->finalize(object);
 }
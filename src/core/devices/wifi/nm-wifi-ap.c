@@ -20,6 +20,7 @@
 #include "nm-utils.h"
 #include "nm-wifi-utils.h"
 #include "libnm-platform/nm-platform.h"
+#include "libnm-platform/wifi/nm-wifi-utils.h"
 #include "supplicant/nm-supplicant-interface.h"
 
 #define PROTO_WPA "wpa"
@@ -440,6 +441,160 @@ nm_wifi_ap_update_from_properties(NMWifiAP *ap, const NMSupplicantBssInfo *bss_i
     return changed;
 }
 
+/**
+ * nm_wifi_ap_nl80211_bss_path_new:
+ * @bssid: the BSSID of the BSS
+ *
+ * When the scan results are read from the kernel via nl80211, there is no
+ * supplicant D-Bus path for the BSS. Instead, the AP is identified by a
+ * path that is derived from the BSSID.
+ *
+ * Returns: (transfer full): the path for the BSS.
+ */
+NMRefString *
+nm_wifi_ap_nl80211_bss_path_new(const NMEtherAddr *bssid)
+{
+    char buf[NM_STRLEN("nl80211:") + sizeof(NMEtherAddr) * 3];
+
+    nm_assert(bssid);
+
+    memcpy(buf, "nl80211:", NM_STRLEN("nl80211:"));
+    nm_ether_addr_to_string(bssid, &buf[NM_STRLEN("nl80211:")]);
+    return nm_ref_string_new(buf);
+}
+
+/**
+ * nm_wifi_ap_bss_info_from_scan_result:
+ * @bss_info: the #NMSupplicantBssInfo to initialize
+ * @result: the scan result from the kernel
+ * @now_msec: the current monotonic timestamp in milliseconds
+ *
+ * Fills @bss_info from @result, the same way as NMSupplicantInterface does
+ * from the D-Bus properties of the BSS. Afterwards, @bss_info can be passed to
+ * nm_wifi_ap_new_from_properties() and nm_wifi_ap_update_from_properties(). It
+ * must be released with nm_wifi_ap_bss_info_clear().
+ */
+void
+nm_wifi_ap_bss_info_from_scan_result(NMSupplicantBssInfo    *bss_info,
+                                     const NMWifiScanResult *result,
+                                     gint64                  now_msec)
+{
+    const guint8 *ies;
+    const guint8 *ssid;
+    gsize         ies_len;
+    gsize         ssid_len;
+    gsize         mesh_id_len;
+    guint32       max_rate;
+    guint32       bandwidth;
+    gboolean      metered;
+    gboolean      owe_transition_mode;
+
+    nm_assert(bss_info);
+    nm_assert(result);
+
+    *bss_info = (NMSupplicantBssInfo){
+        .bss_path       = nm_wifi_ap_nl80211_bss_path_new(&result->bssid),
+        .last_seen_msec = now_msec - ((gint64) result->seen_ms_ago),
+        .frequency      = result->frequency,
+        .bssid          = result->bssid,
+        .bssid_valid    = !nm_ether_addr_is_zero(&result->bssid),
+        .signal_percent =
+            result->signal_valid ? nm_wifi_utils_level_to_quality(result->signal_level) : 0,
+    };
+
+    ies = result->ies ? g_bytes_get_data(result->ies, &ies_len) : NULL;
+    if (!ies)
+        ies_len = 0;
+
+    /* IEEE 802.11 capability information, ESS (0x1), IBSS (0x2) and
+     * Privacy (0x10). */
+    if (NM_FLAGS_HAS(result->capability, 0x10))
+        bss_info->ap_flags = NM_802_11_AP_FLAGS_PRIVACY;
+    bss_info->ap_flags |= nm_wifi_utils_parse_ies_wps(ies, ies_len);
+    if (nm_wifi_utils_ies_find(ies, ies_len, 114 /* Mesh ID */, &mesh_id_len))
+        bss_info->mode = _NM_802_11_MODE_MESH;
+    else if (NM_FLAGS_HAS(result->capability, 0x1))
+        bss_info->mode = _NM_802_11_MODE_INFRA;
+    else if (NM_FLAGS_HAS(result->capability, 0x2))
+        bss_info->mode = _NM_802_11_MODE_ADHOC;
+    else
+        bss_info->mode = _NM_802_11_MODE_UNKNOWN;
+
+    ssid     = nm_wifi_utils_ies_find(ies, ies_len, 0 /* SSID */, &ssid_len);
+    ssid_len = NM_MIN(32u, ssid_len);
+    if (ssid && ssid_len > 0
+        && !(NM_IN_SET(ssid_len, 8, 9) && memcmp(ssid, "<hidden>", ssid_len) == 0)
+        && !nm_utils_is_empty_ssid(ssid, ssid_len))
+        bss_info->ssid = g_bytes_new(ssid, ssid_len);
+
+    nm_wifi_utils_parse_ies_security(ies, ies_len, &bss_info->wpa_flags, &bss_info->rsn_flags);
+
+    nm_wifi_utils_parse_ies(ies, ies_len, &max_rate, &bandwidth, &metered, &owe_transition_mode);
+    max_rate = NM_MAX(max_rate, nm_wifi_utils_parse_ies_legacy_rate(ies, ies_len));
+    if (owe_transition_mode)
+        bss_info->rsn_flags |= NM_802_11_AP_SEC_KEY_MGMT_OWE_TM;
+
+    bss_info->max_rate  = max_rate / 1000u;
+    bss_info->bandwidth = bandwidth;
+    bss_info->metered   = metered;
+}
+
+void
+nm_wifi_ap_bss_info_clear(NMSupplicantBssInfo *bss_info)
+{
+    nm_clear_pointer(&bss_info->bss_path, nm_ref_string_unref);
+    nm_clear_pointer(&bss_info->ssid, g_bytes_unref);
+}
+
+/**
+ * nm_wifi_ap_nl80211_scan_results_index:
+ * @results: a #GArray of #NMWifiScanResult
+ *
+ * The kernel might report the same BSSID more than once (for example, on
+ * different frequencies). Only the most recently seen one is indexed.
+ *
+ * Returns: (transfer full): a hash table from the path of the BSS (see
+ *   nm_wifi_ap_nl80211_bss_path_new()) to its #NMWifiScanResult in @results.
+ */
+GHashTable *
+nm_wifi_ap_nl80211_scan_results_index(const GArray *results)
+{
+    GHashTable *idx;
+    guint       i;
+
+    idx = g_hash_table_new_full(nm_direct_hash, NULL, (GDestroyNotify) nm_ref_string_unref, NULL);
+    for (i = 0; i < results->len; i++) {
+        const NMWifiScanResult *result = &g_array_index(results, NMWifiScanResult, i);
+        const NMWifiScanResult *prev;
+        NMRefString            *bss_path;
+
+        bss_path = nm_wifi_ap_nl80211_bss_path_new(&result->bssid);
+        prev     = g_hash_table_lookup(idx, bss_path);
+        if (prev && prev->seen_ms_ago <= result->seen_ms_ago) {
+            nm_ref_string_unref(bss_path);
+            continue;
+        }
+        g_hash_table_insert(idx, bss_path, (gpointer) result);
+    }
+    return idx;
+}
+
+/**
+ * nm_wifi_ap_nl80211_is_stale:
+ * @ap: the #NMWifiAP
+ * @results_idx: the index from nm_wifi_ap_nl80211_scan_results_index()
+ *
+ * Returns: %TRUE if @ap was reported by the kernel before, but is no longer
+ *   in the scan results. Fake APs never are.
+ */
+gboolean
+nm_wifi_ap_nl80211_is_stale(NMWifiAP *ap, GHashTable *results_idx)
+{
+    NMRefString *bss_path = nm_wifi_ap_get_supplicant_path(ap);
+
+    return bss_path && !g_hash_table_contains(results_idx, bss_path);
+}
+
 static gboolean
 has_proto(NMSettingWirelessSecurity *sec, const char *proto)
 {
@@ -1062,6 +1217,243 @@ nm_wifi_aps_find_first_compatible(const CList *aps_lst_head, NMConnection *conne
 
 /*****************************************************************************/
 
+typedef struct {
+    /* must be the first field, the entries are hashed by nm_pdirect_hash(). */
+    NMWifiAP *ap;
+
+    /* the keys under which the AP is currently indexed. */
+    GBytes     *ssid;
+    NMEtherAddr bssid;
+
+    /* the order in which the APs were added. The buckets are sorted by it, so
+     * that they have the same order as the list of APs of the device. */
+    guint64 seq;
+
+    bool bssid_valid : 1;
+} ApIdxEntry;
+
+struct _NMWifiAPIndex {
+    GHashTable *entries;
+
+    /* the values are GPtrArray with the ApIdxEntry that have the key. */
+    GHashTable *by_ssid;
+    GHashTable *by_bssid;
+
+    guint64 seq;
+};
+
+static gpointer
+_ap_idx_bssid_dup(gpointer bssid)
+{
+    return nm_memdup(bssid, sizeof(NMEtherAddr));
+}
+
+static void
+_ap_idx_bucket_add(GHashTable *idx, gpointer key, GBoxedCopyFunc key_copy, ApIdxEntry *entry)
+{
+    GPtrArray *entries;
+    guint      i;
+
+    entries = g_hash_table_lookup(idx, key);
+    if (!entries) {
+        entries = g_ptr_array_new();
+        g_hash_table_insert(idx, key_copy(key), entries);
+    }
+
+    nm_assert(!g_ptr_array_find(entries, entry, NULL));
+
+    /* Usually, the entry is the one added last. But when the SSID or BSSID of an
+     * AP changes, it moves into a bucket with APs that were added after it. */
+    for (i = entries->len; i > 0; i--) {
+        if (((ApIdxEntry *) entries->pdata[i - 1])->seq < entry->seq)
+            break;
+    }
+    g_ptr_array_insert(entries, i, entry);
+}
+
+static void
+_ap_idx_bucket_remove(GHashTable *idx, gconstpointer key, ApIdxEntry *entry)
+{
+    GPtrArray *entries;
+
+    entries = g_hash_table_lookup(idx, key);
+    if (!entries || !g_ptr_array_remove(entries, entry))
+        nm_assert_not_reached();
+    else if (entries->len == 0)
+        g_hash_table_remove(idx, key);
+}
+
+static void
+_ap_idx_entry_free(gpointer data)
+{
+    ApIdxEntry *entry = data;
+
+    nm_assert(!entry->ssid);
+    nm_assert(!entry->bssid_valid);
+    nm_g_slice_free(entry);
+}
+
+/**
+ * nm_wifi_ap_index_new:
+ *
+ * The index keeps the APs of a device by SSID and by BSSID, so that finding
+ * the APs that are compatible with a profile does not need to look at every AP.
+ *
+ * Returns: (transfer full): the new, empty index.
+ */
+NMWifiAPIndex *
+nm_wifi_ap_index_new(void)
+{
+    NMWifiAPIndex *idx;
+
+    idx  = g_slice_new(NMWifiAPIndex);
+    *idx = (NMWifiAPIndex){
+        .entries =
+            g_hash_table_new_full(nm_pdirect_hash, nm_pdirect_equal, _ap_idx_entry_free, NULL),
+        .by_ssid  = g_hash_table_new_full(nm_g_bytes_hash,
+                                         nm_g_bytes_equal,
+                                         (GDestroyNotify) g_bytes_unref,
+                                         (GDestroyNotify) g_ptr_array_unref),
+        .by_bssid = g_hash_table_new_full((GHashFunc) nm_ether_addr_hash,
+                                          (GEqualFunc) nm_ether_addr_equal,
+                                          g_free,
+                                          (GDestroyNotify) g_ptr_array_unref),
+    };
+    return idx;
+}
+
+void
+nm_wifi_ap_index_free(NMWifiAPIndex *idx)
+{
+    nm_assert(g_hash_table_size(idx->entries) == 0);
+    nm_assert(g_hash_table_size(idx->by_ssid) == 0);
+    nm_assert(g_hash_table_size(idx->by_bssid) == 0);
+
+    g_hash_table_unref(idx->entries);
+    g_hash_table_unref(idx->by_ssid);
+    g_hash_table_unref(idx->by_bssid);
+    nm_g_slice_free(idx);
+}
+
+/**
+ * nm_wifi_ap_index_update:
+ * @idx: the #NMWifiAPIndex
+ * @ap: the #NMWifiAP
+ * @remove: whether to remove @ap from the index
+ *
+ * Adds @ap to the index, or updates it for the current SSID and BSSID
+ * of @ap. APs must be added in the order of the list of the device,
+ * that is, when they are appended to it.
+ */
+void
+nm_wifi_ap_index_update(NMWifiAPIndex *idx, NMWifiAP *ap, gboolean remove)
+{
+    ApIdxEntry *entry;
+    GBytes     *ssid = NULL;
+    NMEtherAddr bssid;
+    gboolean    bssid_valid;
+    const char *address;
+
+    entry = g_hash_table_lookup(idx->entries, &ap);
+    if (!entry) {
+        if (remove)
+            return;
+        entry  = g_slice_new(ApIdxEntry);
+        *entry = (ApIdxEntry){
+            .ap  = ap,
+            .seq = ++idx->seq,
+        };
+        g_hash_table_add(idx->entries, entry);
+    }
+
+    if (!remove) {
+        ssid        = nm_wifi_ap_get_ssid(ap);
+        address     = nm_wifi_ap_get_address(ap);
+        bssid_valid = address && nm_ether_addr_from_string(&bssid, address);
+    } else
+        bssid_valid = FALSE;
+
+    if (!nm_g_bytes_equal0(entry->ssid, ssid)) {
+        if (entry->ssid) {
+            _ap_idx_bucket_remove(idx->by_ssid, entry->ssid, entry);
+            nm_clear_pointer(&entry->ssid, g_bytes_unref);
+        }
+        if (ssid) {
+            entry->ssid = g_bytes_ref(ssid);
+            _ap_idx_bucket_add(idx->by_ssid, entry->ssid, (GBoxedCopyFunc) g_bytes_ref, entry);
+        }
+    }
+
+    if (entry->bssid_valid != bssid_valid
+        || (bssid_valid && !nm_ether_addr_equal(&entry->bssid, &bssid))) {
+        if (entry->bssid_valid) {
+            _ap_idx_bucket_remove(idx->by_bssid, &entry->bssid, entry);
+            entry->bssid_valid = FALSE;
+        }
+        if (bssid_valid) {
+            entry->bssid       = bssid;
+            entry->bssid_valid = TRUE;
+            _ap_idx_bucket_add(idx->by_bssid, &entry->bssid, _ap_idx_bssid_dup, entry);
+        }
+    }
+
+    if (remove)
+        g_hash_table_remove(idx->entries, entry);
+}
+
+/**
+ * nm_wifi_ap_index_find_first_compatible:
+ * @idx: the #NMWifiAPIndex
+ * @aps_lst_head: the list of APs, that are in @idx
+ * @connection: the profile
+ *
+ * Returns: the same as nm_wifi_aps_find_first_compatible(), but it only
+ *   checks the APs that have the BSSID (or the SSID, if there is no
+ *   BSSID) of @connection.
+ */
+NMWifiAP *
+nm_wifi_ap_index_find_first_compatible(NMWifiAPIndex *idx,
+                                       const CList   *aps_lst_head,
+                                       NMConnection  *connection)
+{
+    NMSettingWireless *s_wifi;
+    const char        *bssid_str;
+    GBytes            *ssid;
+    GPtrArray         *entries;
+    NMEtherAddr        bssid;
+    guint              i;
+
+    s_wifi = nm_connection_get_setting_wireless(connection);
+    if (!s_wifi)
+        return NULL;
+
+    /* A compatible AP has the SSID and, if the profile has one, the BSSID
+     * of the profile. Only check the APs of the more specific bucket. */
+    bssid_str = nm_setting_wireless_get_bssid(s_wifi);
+    ssid      = nm_setting_wireless_get_ssid(s_wifi);
+    if (bssid_str) {
+        if (!nm_ether_addr_from_string(&bssid, bssid_str))
+            return NULL;
+        entries = g_hash_table_lookup(idx->by_bssid, &bssid);
+    } else if (ssid)
+        entries = g_hash_table_lookup(idx->by_ssid, ssid);
+    else
+        return nm_wifi_aps_find_first_compatible(aps_lst_head, connection);
+
+    if (!entries)
+        return NULL;
+
+    for (i = 0; i < entries->len; i++) {
+        NMWifiAP *ap = ((ApIdxEntry *) entries->pdata[i])->ap;
+
+        if (nm_wifi_ap_check_compatible(ap, connection))
+            return ap;
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+
 NMWifiAP *
 nm_wifi_ap_lookup_for_device(NMDevice *device, const char *exported_path)
 {
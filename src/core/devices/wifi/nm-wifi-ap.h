@@ -40,6 +40,7 @@ typedef struct {
 } NMWifiAP;
 
 struct _NMSupplicantBssInfo;
+struct _NMWifiScanResult;
 
 typedef struct _NMWifiAPClass NMWifiAPClass;
 
@@ -51,6 +52,18 @@ NMWifiAP *nm_wifi_ap_new_fake_from_connection(NMConnection *connection);
 gboolean nm_wifi_ap_update_from_properties(NMWifiAP                          *ap,
                                            const struct _NMSupplicantBssInfo *bss_info);
 
+NMRefString *nm_wifi_ap_nl80211_bss_path_new(const NMEtherAddr *bssid);
+
+void nm_wifi_ap_bss_info_from_scan_result(struct _NMSupplicantBssInfo    *bss_info,
+                                          const struct _NMWifiScanResult *result,
+                                          gint64                          now_msec);
+
+void nm_wifi_ap_bss_info_clear(struct _NMSupplicantBssInfo *bss_info);
+
+GHashTable *nm_wifi_ap_nl80211_scan_results_index(const GArray *results);
+
+gboolean nm_wifi_ap_nl80211_is_stale(NMWifiAP *ap, GHashTable *results_idx);
+
 gboolean nm_wifi_ap_check_compatible(NMWifiAP *self, NMConnection *connection);
 
 gboolean nm_wifi_ap_complete_connection(NMWifiAP     *self,
@@ -95,6 +108,15 @@ const char **nm_wifi_aps_get_paths(const CList *aps_lst_head, gboolean include_w
 
 NMWifiAP *nm_wifi_aps_find_first_compatible(const CList *aps_lst_head, NMConnection *connection);
 
+typedef struct _NMWifiAPIndex NMWifiAPIndex;
+
+NMWifiAPIndex *nm_wifi_ap_index_new(void);
+void           nm_wifi_ap_index_free(NMWifiAPIndex *idx);
+void           nm_wifi_ap_index_update(NMWifiAPIndex *idx, NMWifiAP *ap, gboolean remove);
+NMWifiAP      *nm_wifi_ap_index_find_first_compatible(NMWifiAPIndex *idx,
+                                                      const CList   *aps_lst_head,
+                                                      NMConnection  *connection);
+
 NMWifiAP *nm_wifi_ap_lookup_for_device(NMDevice *device, const char *exported_path);
 
 #endif /* __NM_WIFI_AP_H__ */
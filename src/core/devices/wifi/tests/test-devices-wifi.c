@@ -7,7 +7,10 @@
 
 #include "devices/wifi/nm-wifi-utils.h"
 #include "devices/wifi/nm-device-wifi.h"
+#include "devices/wifi/nm-wifi-ap.h"
 #include "libnm-core-intern/nm-core-internal.h"
+#include "libnm-platform/wifi/nm-wifi-utils-nl80211.h"
+#include "supplicant/nm-supplicant-types.h"
 
 #include "nm-test-utils-core.h"
 
@@ -1503,6 +1506,377 @@ test_wps_key_to_psk(void)
 
 /*****************************************************************************/
 
+/* Messages of the nl80211 generic netlink family, as the kernel sends them for
+ * a completed scan (on the "scan" multicast group) and as reply to the
+ * following NL80211_CMD_GET_SCAN dump request. */
+static const guint8 nl80211_scan_stream[] = {
+    /* NL80211_CMD_NEW_SCAN_RESULTS notification for ifindex 7 */
+    0x24, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x22, 0x01, 0x00, 0x00, 0x08, 0x00, 0x2e, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0x08, 0x00, 0x03, 0x00, 0x07, 0x00, 0x00, 0x00,
+    /* BSS 00:11:22:33:44:55, "test-rsn", 2437 MHz, WPA2-PSK, associated */
+    0x8c, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x22, 0x01, 0x00, 0x00, 0x08, 0x00, 0x2e, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0x08, 0x00, 0x03, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x68, 0x00, 0x2f, 0x00, 0x0a, 0x00, 0x01, 0x00, 0x00, 0x11, 0x22, 0x33,
+    0x44, 0x55, 0x00, 0x00, 0x08, 0x00, 0x02, 0x00, 0x85, 0x09, 0x00, 0x00,
+    0x06, 0x00, 0x05, 0x00, 0x11, 0x04, 0x00, 0x00, 0x2e, 0x00, 0x06, 0x00,
+    0x00, 0x08, 0x74, 0x65, 0x73, 0x74, 0x2d, 0x72, 0x73, 0x6e, 0x01, 0x08,
+    0x82, 0x84, 0x8b, 0x96, 0x0c, 0x12, 0x18, 0x24, 0x30, 0x14, 0x01, 0x00,
+    0x00, 0x0f, 0xac, 0x04, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04, 0x01, 0x00,
+    0x00, 0x0f, 0xac, 0x02, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x07, 0x00,
+    0x6c, 0xee, 0xff, 0xff, 0x08, 0x00, 0x09, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x08, 0x00, 0x0a, 0x00, 0x78, 0x00, 0x00, 0x00,
+    /* BSS 00:11:22:33:44:66, "test-wpa", 5180 MHz, WPA-PSK */
+    0x84, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x22, 0x01, 0x00, 0x00, 0x08, 0x00, 0x2e, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0x08, 0x00, 0x03, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x60, 0x00, 0x2f, 0x00, 0x0a, 0x00, 0x01, 0x00, 0x00, 0x11, 0x22, 0x33,
+    0x44, 0x66, 0x00, 0x00, 0x08, 0x00, 0x02, 0x00, 0x3c, 0x14, 0x00, 0x00,
+    0x06, 0x00, 0x05, 0x00, 0x11, 0x00, 0x00, 0x00, 0x30, 0x00, 0x06, 0x00,
+    0x00, 0x08, 0x74, 0x65, 0x73, 0x74, 0x2d, 0x77, 0x70, 0x61, 0x01, 0x08,
+    0x8c, 0x12, 0x98, 0x24, 0xb0, 0x48, 0x60, 0x6c, 0xdd, 0x16, 0x00, 0x50,
+    0xf2, 0x01, 0x01, 0x00, 0x00, 0x50, 0xf2, 0x02, 0x01, 0x00, 0x00, 0x50,
+    0xf2, 0x02, 0x01, 0x00, 0x00, 0x50, 0xf2, 0x02, 0x08, 0x00, 0x07, 0x00,
+    0xa8, 0xe4, 0xff, 0xff, 0x08, 0x00, 0x0a, 0x00, 0xd0, 0x07, 0x00, 0x00,
+    /* BSS 00:11:22:33:44:77, hidden, 2412 MHz, open */
+    0x60, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x22, 0x01, 0x00, 0x00, 0x08, 0x00, 0x2e, 0x00,
+    0x15, 0x00, 0x00, 0x00, 0x08, 0x00, 0x03, 0x00, 0x07, 0x00, 0x00, 0x00,
+    0x3c, 0x00, 0x2f, 0x00, 0x0a, 0x00, 0x01, 0x00, 0x00, 0x11, 0x22, 0x33,
+    0x44, 0x77, 0x00, 0x00, 0x08, 0x00, 0x02, 0x00, 0x6c, 0x09, 0x00, 0x00,
+    0x06, 0x00, 0x05, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x06, 0x00,
+    0x00, 0x00, 0x01, 0x04, 0x82, 0x84, 0x8b, 0x96, 0x08, 0x00, 0x07, 0x00,
+    0xc0, 0xe0, 0xff, 0xff, 0x08, 0x00, 0x0a, 0x00, 0x88, 0x13, 0x00, 0x00,
+    /* NLMSG_DONE */
+    0x14, 0x00, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static void
+test_nl80211_scan_results(void)
+{
+    const gint64                    now_msec = 100000;
+    gs_free guint8                 *buf      = NULL;
+    gs_unref_ptrarray GPtrArray    *aps      = NULL;
+    nm_auto_ref_string NMRefString *bss_path = NULL;
+    struct nlmsghdr                *hdr;
+    NMWifiScanResult                result;
+    NMWifiAP                       *ap;
+    int                             remaining;
+    int                             ifindex;
+
+    if (G_BYTE_ORDER != G_LITTLE_ENDIAN) {
+        g_test_skip("the recorded netlink messages are in little endian");
+        return;
+    }
+
+    aps       = g_ptr_array_new_with_free_func(g_object_unref);
+    buf       = nm_memdup(nl80211_scan_stream, sizeof(nl80211_scan_stream));
+    remaining = sizeof(nl80211_scan_stream);
+    hdr       = (struct nlmsghdr *) buf;
+
+    g_assert(nlmsg_ok(hdr, remaining));
+    g_assert_cmpint(nm_wifi_utils_nl80211_parse_scan_event(hdr), ==, 7);
+    g_assert(!nm_wifi_utils_nl80211_parse_scan_result(hdr, NULL, &result));
+
+    for (hdr = nlmsg_next(hdr, &remaining); nlmsg_ok(hdr, remaining);
+         hdr = nlmsg_next(hdr, &remaining)) {
+        NMSupplicantBssInfo bss_info;
+
+        if (hdr->nlmsg_type == NLMSG_DONE)
+            break;
+
+        g_assert_cmpint(nm_wifi_utils_nl80211_parse_scan_event(hdr), ==, 0);
+        g_assert(nm_wifi_utils_nl80211_parse_scan_result(hdr, &ifindex, &result));
+        g_assert_cmpint(ifindex, ==, 7);
+        g_assert_cmpint(result.associated, ==, aps->len == 0);
+
+        nm_wifi_ap_bss_info_from_scan_result(&bss_info, &result, now_msec);
+        g_assert_cmpint(bss_info.last_seen_msec, ==, now_msec - result.seen_ms_ago);
+        g_ptr_array_add(aps, nm_wifi_ap_new_from_properties(&bss_info));
+        nm_wifi_ap_bss_info_clear(&bss_info);
+        nm_wifi_scan_result_clear(&result);
+    }
+    g_assert(nlmsg_ok(hdr, remaining));
+    g_assert_cmpint(hdr->nlmsg_type, ==, NLMSG_DONE);
+    g_assert_cmpint(aps->len, ==, 3);
+
+    ap = aps->pdata[0];
+    g_assert(nm_g_bytes_equal_mem(nm_wifi_ap_get_ssid(ap), "test-rsn", 8));
+    g_assert_cmpstr(nm_wifi_ap_get_address(ap), ==, "00:11:22:33:44:55");
+    g_assert_cmpint(nm_wifi_ap_get_mode(ap), ==, _NM_802_11_MODE_INFRA);
+    g_assert_cmpint(nm_wifi_ap_get_freq(ap), ==, 2437);
+    g_assert_cmpint(nm_wifi_ap_get_strength(ap), ==, nm_wifi_utils_level_to_quality(-45));
+    g_assert_cmpint(nm_wifi_ap_get_max_bitrate(ap), ==, 18000);
+    g_assert_cmpint(nm_wifi_ap_get_flags(ap), ==, NM_802_11_AP_FLAGS_PRIVACY);
+    g_assert_cmpint(nm_wifi_ap_get_wpa_flags(ap), ==, NM_802_11_AP_SEC_NONE);
+    g_assert_cmpint(nm_wifi_ap_get_rsn_flags(ap),
+                    ==,
+                    NM_802_11_AP_SEC_PAIR_CCMP | NM_802_11_AP_SEC_GROUP_CCMP
+                        | NM_802_11_AP_SEC_KEY_MGMT_PSK);
+
+    ap = aps->pdata[1];
+    g_assert(nm_g_bytes_equal_mem(nm_wifi_ap_get_ssid(ap), "test-wpa", 8));
+    g_assert_cmpstr(nm_wifi_ap_get_address(ap), ==, "00:11:22:33:44:66");
+    g_assert_cmpint(nm_wifi_ap_get_freq(ap), ==, 5180);
+    g_assert_cmpint(nm_wifi_ap_get_strength(ap), ==, nm_wifi_utils_level_to_quality(-70));
+    g_assert_cmpint(nm_wifi_ap_get_max_bitrate(ap), ==, 54000);
+    g_assert_cmpint(nm_wifi_ap_get_flags(ap), ==, NM_802_11_AP_FLAGS_PRIVACY);
+    g_assert_cmpint(nm_wifi_ap_get_wpa_flags(ap),
+                    ==,
+                    NM_802_11_AP_SEC_PAIR_TKIP | NM_802_11_AP_SEC_GROUP_TKIP
+                        | NM_802_11_AP_SEC_KEY_MGMT_PSK);
+    g_assert_cmpint(nm_wifi_ap_get_rsn_flags(ap), ==, NM_802_11_AP_SEC_NONE);
+
+    ap = aps->pdata[2];
+    g_assert(!nm_wifi_ap_get_ssid(ap));
+    g_assert_cmpstr(nm_wifi_ap_get_address(ap), ==, "00:11:22:33:44:77");
+    g_assert_cmpint(nm_wifi_ap_get_freq(ap), ==, 2412);
+    g_assert_cmpint(nm_wifi_ap_get_max_bitrate(ap), ==, 11000);
+    g_assert_cmpint(nm_wifi_ap_get_flags(ap), ==, NM_802_11_AP_FLAGS_NONE);
+    g_assert_cmpint(nm_wifi_ap_get_wpa_flags(ap), ==, NM_802_11_AP_SEC_NONE);
+    g_assert_cmpint(nm_wifi_ap_get_rsn_flags(ap), ==, NM_802_11_AP_SEC_NONE);
+
+    /* APs from nl80211 are identified by their BSSID. */
+    g_assert(nm_wifi_ap_get_supplicant_path(aps->pdata[0])
+             != nm_wifi_ap_get_supplicant_path(aps->pdata[1]));
+    bss_path =
+        nm_wifi_ap_nl80211_bss_path_new(&NM_ETHER_ADDR_INIT(0x00, 0x11, 0x22, 0x33, 0x44, 0x77));
+    g_assert(nm_wifi_ap_get_supplicant_path(ap) == bss_path);
+}
+
+/*****************************************************************************/
+
+static NMWifiAP *
+_nl80211_ap_new(const NMWifiScanResult *result)
+{
+    NMSupplicantBssInfo bss_info;
+    NMWifiAP           *ap;
+
+    nm_wifi_ap_bss_info_from_scan_result(&bss_info, result, 100000);
+    ap = nm_wifi_ap_new_from_properties(&bss_info);
+    nm_wifi_ap_bss_info_clear(&bss_info);
+    return ap;
+}
+
+static void
+test_nl80211_scan_results_index(void)
+{
+    gs_unref_array GArray          *results     = NULL;
+    gs_unref_hashtable GHashTable  *results_idx = NULL;
+    gs_unref_object NMWifiAP       *ap_a        = NULL;
+    gs_unref_object NMWifiAP       *ap_c        = NULL;
+    nm_auto_ref_string NMRefString *path_a      = NULL;
+    nm_auto_ref_string NMRefString *path_b      = NULL;
+    const NMWifiScanResult         *result;
+    NMWifiScanResult                results_data[] = {
+        {
+            .bssid       = NM_ETHER_ADDR_INIT(0x00, 0x11, 0x22, 0x33, 0x44, 0x55),
+            .frequency   = 2437,
+            .seen_ms_ago = 500,
+        },
+        {
+            .bssid       = NM_ETHER_ADDR_INIT(0x00, 0x11, 0x22, 0x33, 0x44, 0x66),
+            .frequency   = 5180,
+            .seen_ms_ago = 100,
+        },
+        {
+            /* the same BSSID again, seen more recently on another frequency. */
+            .bssid       = NM_ETHER_ADDR_INIT(0x00, 0x11, 0x22, 0x33, 0x44, 0x55),
+            .frequency   = 2412,
+            .seen_ms_ago = 200,
+        },
+        {
+            /* ... and once more, seen longer ago. */
+            .bssid       = NM_ETHER_ADDR_INIT(0x00, 0x11, 0x22, 0x33, 0x44, 0x55),
+            .frequency   = 2462,
+            .seen_ms_ago = 900,
+        },
+    };
+    const NMWifiScanResult result_c = {
+        .bssid = NM_ETHER_ADDR_INIT(0x00, 0x11, 0x22, 0x33, 0x44, 0x77),
+    };
+
+    results = g_array_sized_new(FALSE, FALSE, sizeof(NMWifiScanResult), 4);
+    g_array_append_vals(results, results_data, G_N_ELEMENTS(results_data));
+
+    results_idx = nm_wifi_ap_nl80211_scan_results_index(results);
+    g_assert_cmpint(g_hash_table_size(results_idx), ==, 2);
+
+    path_a =
+        nm_wifi_ap_nl80211_bss_path_new(&NM_ETHER_ADDR_INIT(0x00, 0x11, 0x22, 0x33, 0x44, 0x55));
+    result = g_hash_table_lookup(results_idx, path_a);
+    g_assert(result == &g_array_index(results, NMWifiScanResult, 2));
+    g_assert_cmpint(result->frequency, ==, 2412);
+
+    path_b =
+        nm_wifi_ap_nl80211_bss_path_new(&NM_ETHER_ADDR_INIT(0x00, 0x11, 0x22, 0x33, 0x44, 0x66));
+    result = g_hash_table_lookup(results_idx, path_b);
+    g_assert(result == &g_array_index(results, NMWifiScanResult, 1));
+
+    /* an AP that the kernel no longer reports gets removed. */
+    ap_a = _nl80211_ap_new(&g_array_index(results, NMWifiScanResult, 0));
+    ap_c = _nl80211_ap_new(&result_c);
+    g_assert(!nm_wifi_ap_nl80211_is_stale(ap_a, results_idx));
+    g_assert(nm_wifi_ap_nl80211_is_stale(ap_c, results_idx));
+
+    g_hash_table_remove_all(results_idx);
+    g_assert(nm_wifi_ap_nl80211_is_stale(ap_a, results_idx));
+}
+
+static void
+test_nl80211_parse_ies_wps(void)
+{
+    static const guint8 ies_none[] = {
+        /* SSID "test" */
+        0x00, 0x04, 0x74, 0x65, 0x73, 0x74,
+    };
+    static const guint8 ies_idle[] = {
+        0x00, 0x04, 0x74, 0x65, 0x73, 0x74,
+        /* WPS: version 1.0, state configured */
+        0xdd, 0x0e, 0x00, 0x50, 0xf2, 0x04, 0x10, 0x4a, 0x00, 0x01, 0x10, 0x10, 0x44, 0x00,
+        0x01, 0x02,
+    };
+    static const guint8 ies_pbc[] = {
+        /* WPS: version 1.0, selected registrar, device password ID push button */
+        0xdd, 0x14, 0x00, 0x50, 0xf2, 0x04, 0x10, 0x4a, 0x00, 0x01, 0x10, 0x10, 0x41, 0x00,
+        0x01, 0x01, 0x10, 0x12, 0x00, 0x02, 0x00, 0x04,
+    };
+    static const guint8 ies_pin_split[] = {
+        /* WPS split in two elements: version 1.0, selected registrar, and the
+         * device password ID default PIN, which continues in the second one. */
+        0xdd, 0x10, 0x00, 0x50, 0xf2, 0x04, 0x10, 0x4a, 0x00, 0x01, 0x10, 0x10, 0x41, 0x00,
+        0x01, 0x01, 0x10, 0x12,
+        0xdd, 0x08, 0x00, 0x50, 0xf2, 0x04, 0x00, 0x02, 0x00, 0x00,
+    };
+    static const guint8 ies_truncated[] = {
+        /* WPS with an attribute that exceeds the element */
+        0xdd, 0x0a, 0x00, 0x50, 0xf2, 0x04, 0x10, 0x41, 0x00, 0x08, 0x01, 0x00,
+    };
+
+    g_assert_cmpint(nm_wifi_utils_parse_ies_wps(NULL, 0), ==, NM_802_11_AP_FLAGS_NONE);
+    g_assert_cmpint(nm_wifi_utils_parse_ies_wps(ies_none, sizeof(ies_none)),
+                    ==,
+                    NM_802_11_AP_FLAGS_NONE);
+    g_assert_cmpint(nm_wifi_utils_parse_ies_wps(ies_idle, sizeof(ies_idle)),
+                    ==,
+                    NM_802_11_AP_FLAGS_WPS);
+    g_assert_cmpint(nm_wifi_utils_parse_ies_wps(ies_pbc, sizeof(ies_pbc)),
+                    ==,
+                    NM_802_11_AP_FLAGS_WPS | NM_802_11_AP_FLAGS_WPS_PBC);
+    g_assert_cmpint(nm_wifi_utils_parse_ies_wps(ies_pin_split, sizeof(ies_pin_split)),
+                    ==,
+                    NM_802_11_AP_FLAGS_WPS | NM_802_11_AP_FLAGS_WPS_PIN);
+    g_assert_cmpint(nm_wifi_utils_parse_ies_wps(ies_truncated, sizeof(ies_truncated)),
+                    ==,
+                    NM_802_11_AP_FLAGS_WPS);
+}
+
+/*****************************************************************************/
+
+static NMWifiAP *
+_ap_index_add(CList *aps_lst_head, NMWifiAPIndex *idx, const char *ssid, guint8 bssid_last)
+{
+    NMWifiScanResult result = {
+        .bssid      = NM_ETHER_ADDR_INIT(0x00, 0x11, 0x22, 0x33, 0x44, bssid_last),
+        .capability = 0x1, /* ESS */
+    };
+    guint8           ies[2 + 32];
+    NMWifiAP        *ap;
+
+    ies[0] = 0x00; /* SSID */
+    ies[1] = strlen(ssid);
+    memcpy(&ies[2], ssid, ies[1]);
+    result.ies = g_bytes_new(ies, 2u + ies[1]);
+
+    ap = _nl80211_ap_new(&result);
+    nm_wifi_scan_result_clear(&result);
+
+    c_list_link_tail(aps_lst_head, &ap->aps_lst);
+    nm_wifi_ap_index_update(idx, ap, FALSE);
+    return ap;
+}
+
+static void
+_ap_index_assert_find(NMWifiAPIndex *idx,
+                      const CList   *aps_lst_head,
+                      NMConnection  *connection,
+                      NMWifiAP      *expected)
+{
+    /* the index finds the same AP as walking the list. */
+    g_assert(nm_wifi_aps_find_first_compatible(aps_lst_head, connection) == expected);
+    g_assert(nm_wifi_ap_index_find_first_compatible(idx, aps_lst_head, connection) == expected);
+}
+
+static void
+test_ap_index(void)
+{
+    gs_unref_object NMWifiAP     *ap_a   = NULL;
+    gs_unref_object NMWifiAP     *ap_b   = NULL;
+    gs_unref_object NMWifiAP     *ap_c   = NULL;
+    gs_unref_object NMConnection *con_a  = NULL;
+    gs_unref_object NMConnection *con_b  = NULL;
+    gs_unref_object NMConnection *con_x  = NULL;
+    gs_unref_object NMConnection *con_a2 = NULL;
+    gs_unref_object NMConnection *con_a3 = NULL;
+    gs_unref_bytes GBytes        *ssid_b = NULL;
+    NMWifiAPIndex                *idx;
+    CList                         aps_lst_head;
+
+    c_list_init(&aps_lst_head);
+
+    idx  = nm_wifi_ap_index_new();
+    ap_a = _ap_index_add(&aps_lst_head, idx, "net-a", 0x01);
+    ap_b = _ap_index_add(&aps_lst_head, idx, "net-b", 0x02);
+    ap_c = _ap_index_add(&aps_lst_head, idx, "net-a", 0x03);
+
+    con_a  = create_basic("net-a", NULL, _NM_802_11_MODE_INFRA);
+    con_b  = create_basic("net-b", NULL, _NM_802_11_MODE_INFRA);
+    con_x  = create_basic("net-x", NULL, _NM_802_11_MODE_INFRA);
+    con_a2 = create_basic("net-a", "00:11:22:33:44:02", _NM_802_11_MODE_INFRA);
+    con_a3 = create_basic("net-a", "00:11:22:33:44:03", _NM_802_11_MODE_INFRA);
+
+    _ap_index_assert_find(idx, &aps_lst_head, con_a, ap_a);
+    _ap_index_assert_find(idx, &aps_lst_head, con_b, ap_b);
+    _ap_index_assert_find(idx, &aps_lst_head, con_x, NULL);
+    _ap_index_assert_find(idx, &aps_lst_head, con_a2, NULL);
+    _ap_index_assert_find(idx, &aps_lst_head, con_a3, ap_c);
+
+    /* the first AP changes its SSID. It moves to a bucket with an AP that
+     * was added after it, but it still comes first. */
+    ssid_b = g_bytes_new_static("net-b", 5);
+    g_assert(nm_wifi_ap_set_ssid(ap_a, ssid_b));
+    nm_wifi_ap_index_update(idx, ap_a, FALSE);
+    _ap_index_assert_find(idx, &aps_lst_head, con_a, ap_c);
+    _ap_index_assert_find(idx, &aps_lst_head, con_b, ap_a);
+
+    /* the last AP changes its BSSID. */
+    g_assert(nm_wifi_ap_set_address(ap_c, "00:11:22:33:44:02"));
+    nm_wifi_ap_index_update(idx, ap_c, FALSE);
+    _ap_index_assert_find(idx, &aps_lst_head, con_a2, ap_c);
+    _ap_index_assert_find(idx, &aps_lst_head, con_a3, NULL);
+
+    c_list_unlink(&ap_a->aps_lst);
+    nm_wifi_ap_index_update(idx, ap_a, TRUE);
+    _ap_index_assert_find(idx, &aps_lst_head, con_b, ap_b);
+
+    c_list_unlink(&ap_b->aps_lst);
+    nm_wifi_ap_index_update(idx, ap_b, TRUE);
+    c_list_unlink(&ap_c->aps_lst);
+    nm_wifi_ap_index_update(idx, ap_c, TRUE);
+    _ap_index_assert_find(idx, &aps_lst_head, con_a, NULL);
+    _ap_index_assert_find(idx, &aps_lst_head, con_b, NULL);
+    _ap_index_assert_find(idx, &aps_lst_head, con_a2, NULL);
+
+    /* removing an AP that isn't indexed is a no-op. */
+    nm_wifi_ap_index_update(idx, ap_c, TRUE);
+
+    nm_wifi_ap_index_free(idx);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -1651,5 +2025,11 @@ main(int argc, char **argv)
 
     g_test_add_func("/wifi/wps_key_to_psk", test_wps_key_to_psk);
 
+    g_test_add_func("/wifi/nl80211/scan-results", test_nl80211_scan_results);
+    g_test_add_func("/wifi/nl80211/scan-results-index", test_nl80211_scan_results_index);
+    g_test_add_func("/wifi/nl80211/parse-ies-wps", test_nl80211_parse_ies_wps);
+
+    g_test_add_func("/wifi/ap-index", test_ap_index);
+
     return g_test_run();
 }
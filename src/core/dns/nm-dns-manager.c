@@ -114,6 +114,10 @@ typedef struct {
     char *hostdomain;
     guint updates_queue;
 
+    /* the upstream nameservers of the last update, before they get replaced
+     * by the address of a local caching plugin. */
+    char **nameservers;
+
     guint8 hash[HASH_LEN];      /* SHA1 hash of current DNS config */
     guint8 prev_hash[HASH_LEN]; /* Hash when begin_updates() was called */
 
@@ -313,6 +317,22 @@ _update_pending_changed_cb(NMDnsPlugin *plugin, gboolean update_pending, NMDnsMa
     _update_pending_maybe_changed(self);
 }
 
+/**
+ * nm_dns_manager_get_nameservers:
+ * @self: the #NMDnsManager
+ *
+ * Returns: the upstream nameservers of the last DNS update. If a local
+ *   caching plugin is used, these are the servers it forwards to, not
+ *   the address of the plugin itself. %NULL if there are none.
+ */
+const char *const *
+nm_dns_manager_get_nameservers(NMDnsManager *self)
+{
+    g_return_val_if_fail(NM_IS_DNS_MANAGER(self), NULL);
+
+    return NM_CAST_STRV_CC(NM_DNS_MANAGER_GET_PRIVATE(self)->nameservers);
+}
+
 gboolean
 nm_dns_manager_get_update_pending(NMDnsManager *self)
 {
@@ -1842,6 +1862,11 @@ update_dns(NMDnsManager *self, gboolean no_caching, gboolean force_emit, GError
                               &nis_servers,
                               &nis_domain);
 
+    if (!nm_strv_equal(NM_CAST_STRV_CC(priv->nameservers), NM_CAST_STRV_CC(nameservers))) {
+        g_strfreev(priv->nameservers);
+        priv->nameservers = nm_strv_dup(nameservers, -1, TRUE);
+    }
+
     if (priv->plugin || priv->sd_resolve_plugin)
         _mgr_configs_data_construct(self);
 
@@ -2934,6 +2959,7 @@ finalize(GObject *object)
 
     g_free(priv->hostdomain);
     g_free(priv->mode);
+    g_strfreev(priv->nameservers);
 
     G_OBJECT_CLASS(nm_dns_manager_parent_class)->finalize(object);
 }
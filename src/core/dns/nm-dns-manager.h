@@ -142,6 +142,8 @@ NMDnsPlugin *nm_dns_manager_get_systemd_resolved(NMDnsManager *self);
 
 gboolean nm_dns_manager_get_update_pending(NMDnsManager *self);
 
+const char *const *nm_dns_manager_get_nameservers(NMDnsManager *self);
+
 /*****************************************************************************/
 
 char *nmtst_dns_create_resolv_conf(const char *const *searches,
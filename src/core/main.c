@@ -111,6 +111,29 @@ _init_nm_debug(NMConfig *config)
         _set_g_fatal_warnings();
 }
 
+static void
+_init_platform_route_ignore(NMConfig *config)
+{
+    NMConfigData  *config_data = nm_config_get_data_orig(config);
+    const guint32 *tables;
+    const guint8  *protocols;
+    guint          n_tables;
+    guint          n_protocols;
+
+    tables    = nm_config_data_get_main_ignore_route_tables(config_data, &n_tables);
+    protocols = nm_config_data_get_main_ignore_route_protocols(config_data, &n_protocols);
+    if (n_tables == 0 && n_protocols == 0)
+        return;
+
+    nm_platform_ip_route_set_ignore(NM_PLATFORM_GET,
+                                    tables,
+                                    n_tables,
+                                    protocols,
+                                    n_protocols,
+                                    NULL,
+                                    0);
+}
+
 void
 nm_main_config_reload(int signal)
 {
@@ -469,6 +492,8 @@ main(int argc, char *argv[])
 
     nm_linux_platform_setup();
 
+    _init_platform_route_ignore(config);
+
     NM_UTILS_KEEP_ALIVE(config, nm_netns_get(), "NMConfig-depends-on-NMNetns");
 
     nm_auth_manager_setup(nm_config_data_get_main_auth_polkit(nm_config_get_data_orig(config)));
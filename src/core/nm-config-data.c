@@ -6,6 +6,8 @@
 
 #include "src/core/nm-default-daemon.h"
 
+#include <linux/rtnetlink.h>
+
 #include "nm-config-data.h"
 
 #include "nm-config.h"
@@ -23,8 +25,9 @@ typedef struct {
         /* have a separate boolean field @has, because a @spec with
          * value %NULL does not necessarily mean, that the property
          * "match-device" was unspecified. */
-        gboolean has;
-        GSList  *spec;
+        gboolean           has;
+        GSList            *spec;
+        NMMatchSpecDevice *compiled;
     } match_device;
     union {
         struct {
@@ -34,11 +37,29 @@ typedef struct {
     };
     gboolean is_device;
 
+    /* The index of the match result in MatchCacheEntry. */
+    guint cache_idx;
+
     /* List of key/value pairs in the section, sorted by key */
     gsize                    lookup_len;
     const NMUtilsNamedValue *lookup_idx;
 } MatchSectionInfo;
 
+/* The number of devices for which the results of the "match-device" specs
+ * are cached. That is a bound for the memory used, if we exceed it, we start
+ * over. */
+#define MATCH_CACHE_MAX_ENTRIES 1024u
+
+typedef struct {
+    /* The data that was matched, with strings owned by the entry. Must be the
+     * first field. */
+    NMMatchSpecDeviceData data;
+
+    /* For each MatchSectionInfo with a "match-device" spec, whether the spec
+     * matches @data. NM_TERNARY_DEFAULT means, it wasn't evaluated yet. */
+    NMTernary results[];
+} MatchCacheEntry;
+
 struct _NMGlobalDnsDomain {
     char  *name;
     char **servers;
@@ -84,11 +105,21 @@ typedef struct {
      * [device] sections. This is to speed up lookup. */
     MatchSectionInfo *device_infos;
 
+    /* Caches the results of the "match-device" specs of the [connection] and
+     * [device] sections by the matched data. NMConfigData is immutable and gets
+     * replaced on reload, so the results never become outdated. When the
+     * properties of a device change, the device gets a different entry. */
+    struct {
+        GHashTable *entries;
+        guint       n_results;
+    } match_cache;
+
     struct {
         gboolean enabled;
         char    *uri;
         char    *response;
         guint    interval;
+        guint    max_interval;
         guint    timeout;
     } connectivity;
 
@@ -114,6 +145,11 @@ typedef struct {
     bool systemd_resolved : 1;
 
     char *iwd_config_path;
+
+    /* The valid values of main.ignore-route-tables (guint32) and
+     * main.ignore-route-protocols (guint8), or NULL. */
+    GArray *ignore_route_tables;
+    GArray *ignore_route_protocols;
 } NMConfigDataPrivate;
 
 struct _NMConfigData {
@@ -308,6 +344,14 @@ nm_config_data_get_connectivity_interval(const NMConfigData *self)
     return NM_CONFIG_DATA_GET_PRIVATE(self)->connectivity.interval;
 }
 
+guint
+nm_config_data_get_connectivity_max_interval(const NMConfigData *self)
+{
+    g_return_val_if_fail(self, 0);
+
+    return NM_CONFIG_DATA_GET_PRIVATE(self)->connectivity.max_interval;
+}
+
 guint
 nm_config_data_get_connectivity_timeout(const NMConfigData *self)
 {
@@ -383,6 +427,24 @@ nm_config_data_get_iwd_config_path(const NMConfigData *self)
     return NM_CONFIG_DATA_GET_PRIVATE(self)->iwd_config_path;
 }
 
+const guint32 *
+nm_config_data_get_main_ignore_route_tables(const NMConfigData *self, guint *out_len)
+{
+    const NMConfigDataPrivate *priv = NM_CONFIG_DATA_GET_PRIVATE(self);
+
+    *out_len = nm_g_array_len(priv->ignore_route_tables);
+    return *out_len > 0 ? &nm_g_array_index(priv->ignore_route_tables, guint32, 0) : NULL;
+}
+
+const guint8 *
+nm_config_data_get_main_ignore_route_protocols(const NMConfigData *self, guint *out_len)
+{
+    const NMConfigDataPrivate *priv = NM_CONFIG_DATA_GET_PRIVATE(self);
+
+    *out_len = nm_g_array_len(priv->ignore_route_protocols);
+    return *out_len > 0 ? &nm_g_array_index(priv->ignore_route_protocols, guint8, 0) : NULL;
+}
+
 gboolean
 nm_config_data_get_ignore_carrier_for_port(const NMConfigData *self,
                                            const char         *controller,
@@ -555,6 +617,64 @@ nm_config_data_get_main_auth_polkit(const NMConfigData *self)
 
 /*****************************************************************************/
 
+static gboolean
+_route_ignore_value_is_valid(gboolean is_tables, guint32 value)
+{
+    /* NetworkManager must always see the routes of the main and local table,
+     * and the routes with the protocols that it configures itself. Otherwise,
+     * it would lose track of its own routes. */
+    if (is_tables)
+        return !NM_IN_SET(value, RT_TABLE_UNSPEC, RT_TABLE_MAIN, RT_TABLE_LOCAL);
+    return !NM_IN_SET(value, RTPROT_KERNEL, RTPROT_STATIC, RTPROT_RA, RTPROT_DHCP);
+}
+
+static GArray *
+_config_data_get_main_ignore_route(GKeyFile *keyfile, gboolean is_tables, GPtrArray *warnings)
+{
+    const char          *key   = is_tables ? NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_ROUTE_TABLES
+                                           : NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_ROUTE_PROTOCOLS;
+    gs_free char        *value = NULL;
+    gs_free const char **strv  = NULL;
+    GArray              *arr   = NULL;
+    gsize                i;
+
+    value = nm_config_keyfile_get_value(keyfile,
+                                        NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                        key,
+                                        NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
+    strv  = nm_strsplit_set(value, ", \t");
+    for (i = 0; strv && strv[i]; i++) {
+        gint64 v;
+
+        v = _nm_utils_ascii_str_to_int64(strv[i], 10, 0, is_tables ? G_MAXUINT32 : G_MAXUINT8, -1);
+        if (v < 0 || !_route_ignore_value_is_valid(is_tables, v)) {
+            if (warnings) {
+                g_ptr_array_add(warnings,
+                                g_strdup_printf("invalid value \"%s\" for %s.%s is ignored",
+                                                strv[i],
+                                                NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                                key));
+            }
+            continue;
+        }
+
+        if (!arr)
+            arr = g_array_new(FALSE, FALSE, is_tables ? sizeof(guint32) : sizeof(guint8));
+        if (is_tables) {
+            guint32 v32 = v;
+
+            g_array_append_val(arr, v32);
+        } else {
+            guint8 v8 = v;
+
+            g_array_append_val(arr, v8);
+        }
+    }
+    return arr;
+}
+
+/*****************************************************************************/
+
 /**
  * nm_config_data_get_groups:
  * @self: the #NMConfigData instance
@@ -1678,14 +1798,102 @@ global_dns_equal(NMGlobalDnsConfig *old, NMGlobalDnsConfig *new)
 
 /*****************************************************************************/
 
+static guint
+_match_cache_entry_hash(gconstpointer ptr)
+{
+    const NMMatchSpecDeviceData *data = ptr;
+    NMHashState                  h;
+
+    nm_hash_init(&h, 1263458777u);
+    nm_hash_update_str0(&h, data->interface_name);
+    nm_hash_update_str0(&h, data->device_type);
+    nm_hash_update_str0(&h, data->driver);
+    nm_hash_update_str0(&h, data->driver_version);
+    nm_hash_update_str0(&h, data->dhcp_plugin);
+    nm_hash_update_str0(&h, data->hwaddr);
+    nm_hash_update_str0(&h, data->s390_subchannels);
+    return nm_hash_complete(&h);
+}
+
+static gboolean
+_match_cache_entry_equal(gconstpointer a, gconstpointer b)
+{
+    const NMMatchSpecDeviceData *data_a = a;
+    const NMMatchSpecDeviceData *data_b = b;
+
+    return nm_streq0(data_a->interface_name, data_b->interface_name)
+           && nm_streq0(data_a->device_type, data_b->device_type)
+           && nm_streq0(data_a->driver, data_b->driver)
+           && nm_streq0(data_a->driver_version, data_b->driver_version)
+           && nm_streq0(data_a->dhcp_plugin, data_b->dhcp_plugin)
+           && nm_streq0(data_a->hwaddr, data_b->hwaddr)
+           && nm_streq0(data_a->s390_subchannels, data_b->s390_subchannels);
+}
+
+static void
+_match_cache_entry_free(gpointer ptr)
+{
+    MatchCacheEntry *entry = ptr;
+
+    g_free((char *) entry->data.interface_name);
+    g_free((char *) entry->data.device_type);
+    g_free((char *) entry->data.driver);
+    g_free((char *) entry->data.driver_version);
+    g_free((char *) entry->data.dhcp_plugin);
+    g_free((char *) entry->data.hwaddr);
+    g_free((char *) entry->data.s390_subchannels);
+    g_free(entry);
+}
+
+static NMTernary *
+_match_cache_get_results(const NMConfigData *self, const NMMatchSpecDeviceData *match_data)
+{
+    NMConfigDataPrivate *priv = NM_CONFIG_DATA_GET_PRIVATE((NMConfigData *) self);
+    MatchCacheEntry     *entry;
+    guint                i;
+
+    entry = g_hash_table_lookup(priv->match_cache.entries, match_data);
+    if (entry)
+        return entry->results;
+
+    if (g_hash_table_size(priv->match_cache.entries) >= MATCH_CACHE_MAX_ENTRIES)
+        g_hash_table_remove_all(priv->match_cache.entries);
+
+    entry = g_malloc(G_STRUCT_OFFSET(MatchCacheEntry, results)
+                     + (priv->match_cache.n_results * sizeof(NMTernary)));
+
+    entry->data = (NMMatchSpecDeviceData) {
+        .interface_name   = g_strdup(match_data->interface_name),
+        .device_type      = g_strdup(match_data->device_type),
+        .driver           = g_strdup(match_data->driver),
+        .driver_version   = g_strdup(match_data->driver_version),
+        .dhcp_plugin      = g_strdup(match_data->dhcp_plugin),
+        .hwaddr           = g_strdup(match_data->hwaddr),
+        .s390_subchannels = g_strdup(match_data->s390_subchannels),
+    };
+    for (i = 0; i < priv->match_cache.n_results; i++)
+        entry->results[i] = NM_TERNARY_DEFAULT;
+
+    g_hash_table_add(priv->match_cache.entries, entry);
+    return entry->results;
+}
+
+guint
+nmtst_config_data_get_match_cache_len(const NMConfigData *self)
+{
+    return g_hash_table_size(NM_CONFIG_DATA_GET_PRIVATE(self)->match_cache.entries);
+}
+
 static const MatchSectionInfo *
-_match_section_infos_lookup(const MatchSectionInfo      *match_section_infos,
-                            GKeyFile                    *keyfile,
+_match_section_infos_lookup(const NMConfigData          *self,
+                            const MatchSectionInfo      *match_section_infos,
                             const char                  *property,
                             const NMMatchSpecDeviceData *match_data,
                             NMDevice                    *device,
                             const char                 **out_value)
 {
+    GKeyFile             *keyfile       = NM_CONFIG_DATA_GET_PRIVATE(self)->keyfile;
+    NMTernary            *match_results = NULL;
     NMMatchSpecDeviceData match_data_local;
 
     /* Caller must either provide a "match_data" or a "device" (actually,
@@ -1712,7 +1920,7 @@ _match_section_infos_lookup(const MatchSectionInfo      *match_section_infos,
             continue;
 
         if (match_section_infos->match_device.has) {
-            NMMatchSpecMatchType m;
+            NMTernary *result;
 
             if (G_UNLIKELY(!match_data)) {
                 /* In most cases, we don't actually have any matches. So we "optimize"
@@ -1721,8 +1929,18 @@ _match_section_infos_lookup(const MatchSectionInfo      *match_section_infos,
                 match_data = nm_match_spec_device_data_init_from_device(&match_data_local, device);
             }
 
-            m     = nm_match_spec_device(match_section_infos->match_device.spec, match_data);
-            match = nm_match_spec_match_type_to_bool(m, FALSE);
+            if (!match_results)
+                match_results = _match_cache_get_results(self, match_data);
+
+            result = &match_results[match_section_infos->cache_idx];
+            if (*result == NM_TERNARY_DEFAULT) {
+                NMMatchSpecMatchType m;
+
+                m = nm_match_spec_device_match(match_section_infos->match_device.compiled,
+                                               match_data);
+                *result = nm_match_spec_match_type_to_bool(m, FALSE);
+            }
+            match = *result;
         } else
             match = TRUE;
 
@@ -1758,8 +1976,8 @@ _config_data_get_device_config(const NMConfigData          *self,
 
     priv = NM_CONFIG_DATA_GET_PRIVATE(self);
 
-    connection_info = _match_section_infos_lookup(&priv->device_infos[0],
-                                                  priv->keyfile,
+    connection_info = _match_section_infos_lookup(self,
+                                                  &priv->device_infos[0],
                                                   property,
                                                   match_data,
                                                   device,
@@ -1808,8 +2026,8 @@ nm_config_data_get_device_config_by_pllink(const NMConfigData   *self,
                                                  match_device_type,
                                                  nm_dhcp_manager_get_config(nm_dhcp_manager_get()));
 
-    connection_info = _match_section_infos_lookup(&priv->device_infos[0],
-                                                  priv->keyfile,
+    connection_info = _match_section_infos_lookup(self,
+                                                  &priv->device_infos[0],
                                                   property,
                                                   &match_data,
                                                   NULL,
@@ -1868,8 +2086,8 @@ nm_config_data_get_device_allowed_connections_specs(const NMConfigData *self,
 
     priv = NM_CONFIG_DATA_GET_PRIVATE(self);
 
-    connection_info = _match_section_infos_lookup(&priv->device_infos[0],
-                                                  priv->keyfile,
+    connection_info = _match_section_infos_lookup(self,
+                                                  &priv->device_infos[0],
                                                   NM_CONFIG_KEYFILE_KEY_DEVICE_ALLOWED_CONNECTIONS,
                                                   NULL,
                                                   device,
@@ -1912,8 +2130,8 @@ nm_config_data_get_connection_default(const NMConfigData *self,
     }
 #endif
 
-    _match_section_infos_lookup(&priv->connection_infos[0],
-                                priv->keyfile,
+    _match_section_infos_lookup(self,
+                                &priv->connection_infos[0],
                                 property,
                                 NULL,
                                 device,
@@ -1975,6 +2193,10 @@ _match_section_info_init(MatchSectionInfo *connection_info,
                                  group,
                                  NM_CONFIG_KEYFILE_KEY_MATCH_DEVICE,
                                  &connection_info->match_device.has);
+    if (connection_info->match_device.has) {
+        connection_info->match_device.compiled =
+            nm_match_spec_device_compile(connection_info->match_device.spec);
+    }
     connection_info->stop_match =
         nm_config_keyfile_get_boolean(keyfile, group, NM_CONFIG_KEYFILE_KEY_STOP_MATCH, FALSE);
 
@@ -2041,6 +2263,7 @@ _match_section_infos_free(MatchSectionInfo *match_section_infos)
     for (m = match_section_infos; m->group_name; m++) {
         g_free(m->group_name);
         g_slist_free_full(m->match_device.spec, g_free);
+        nm_match_spec_device_free(m->match_device.compiled);
         if (m->is_device) {
             g_slist_free_full(m->device.allowed_connections, g_free);
         }
@@ -2124,6 +2347,18 @@ _match_section_infos_construct(GKeyFile *keyfile, gboolean is_device)
     return match_section_infos;
 }
 
+static void
+_match_section_infos_init_cache_idx(MatchSectionInfo *match_section_infos, guint *p_n_results)
+{
+    if (!match_section_infos)
+        return;
+
+    for (; match_section_infos->group_name; match_section_infos++) {
+        if (match_section_infos->match_device.has)
+            match_section_infos->cache_idx = (*p_n_results)++;
+    }
+}
+
 /*****************************************************************************/
 
 NMConfigChangeFlags
@@ -2154,6 +2389,8 @@ nm_config_data_diff(NMConfigData *old_data, NMConfigData *new_data)
             != nm_config_data_get_connectivity_enabled(new_data)
         || nm_config_data_get_connectivity_interval(old_data)
                != nm_config_data_get_connectivity_interval(new_data)
+        || nm_config_data_get_connectivity_max_interval(old_data)
+               != nm_config_data_get_connectivity_max_interval(new_data)
         || nm_config_data_get_connectivity_timeout(old_data)
                != nm_config_data_get_connectivity_timeout(new_data)
         || !nm_streq0(nm_config_data_get_connectivity_uri(old_data),
@@ -2190,7 +2427,8 @@ nm_config_data_diff(NMConfigData *old_data, NMConfigData *new_data)
 void
 nm_config_data_get_warnings(const NMConfigData *self, GPtrArray *warnings)
 {
-    gboolean invalid;
+    const NMConfigDataPrivate *priv = NM_CONFIG_DATA_GET_PRIVATE(self);
+    gboolean                   invalid;
 
     nm_assert(NM_IS_CONFIG_DATA(self));
     nm_assert(warnings);
@@ -2204,6 +2442,9 @@ nm_config_data_get_warnings(const NMConfigData *self, GPtrArray *warnings)
                 NM_CONFIG_KEYFILE_GROUP_MAIN,
                 NM_CONFIG_KEYFILE_KEY_MAIN_AUTH_POLKIT));
     }
+
+    nm_g_array_unref(_config_data_get_main_ignore_route(priv->keyfile, TRUE, warnings));
+    nm_g_array_unref(_config_data_get_main_ignore_route(priv->keyfile, FALSE, warnings));
 }
 
 /*****************************************************************************/
@@ -2339,6 +2580,13 @@ constructed(GObject *object)
     priv->connection_infos = _match_section_infos_construct(priv->keyfile, FALSE);
     priv->device_infos     = _match_section_infos_construct(priv->keyfile, TRUE);
 
+    _match_section_infos_init_cache_idx(priv->connection_infos, &priv->match_cache.n_results);
+    _match_section_infos_init_cache_idx(priv->device_infos, &priv->match_cache.n_results);
+    priv->match_cache.entries = g_hash_table_new_full(_match_cache_entry_hash,
+                                                      _match_cache_entry_equal,
+                                                      _match_cache_entry_free,
+                                                      NULL);
+
     priv->connectivity.enabled =
         nm_config_keyfile_get_boolean(priv->keyfile,
                                       NM_CONFIG_KEYFILE_GROUP_CONNECTIVITY,
@@ -2374,6 +2622,15 @@ constructed(GObject *object)
                                      NM_CONFIG_DEFAULT_CONNECTIVITY_INTERVAL);
     g_free(str);
 
+    /* On missing or invalid config value, fallback to 0, which means to not
+     * back off beyond the interval. */
+    str = g_key_file_get_string(priv->keyfile,
+                                NM_CONFIG_KEYFILE_GROUP_CONNECTIVITY,
+                                NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_MAX_INTERVAL,
+                                NULL);
+    priv->connectivity.max_interval = _nm_utils_ascii_str_to_int64(str, 10, 0, G_MAXUINT, 0);
+    g_free(str);
+
     /* On missing or invalid config value, fallback to 20. */
     str = g_key_file_get_string(priv->keyfile,
                                 NM_CONFIG_KEYFILE_GROUP_CONNECTIVITY,
@@ -2421,6 +2678,9 @@ constructed(GObject *object)
                                           NM_CONFIG_KEYFILE_KEY_MAIN_IWD_CONFIG_PATH,
                                           NULL));
 
+    priv->ignore_route_tables    = _config_data_get_main_ignore_route(priv->keyfile, TRUE, NULL);
+    priv->ignore_route_protocols = _config_data_get_main_ignore_route(priv->keyfile, FALSE, NULL);
+
     G_OBJECT_CLASS(nm_config_data_parent_class)->constructed(object);
 }
 
@@ -2509,8 +2769,12 @@ finalize(GObject *gobject)
 
     g_free(priv->iwd_config_path);
 
+    nm_g_array_unref(priv->ignore_route_tables);
+    nm_g_array_unref(priv->ignore_route_protocols);
+
     _match_section_infos_free(priv->connection_infos);
     _match_section_infos_free(priv->device_infos);
+    nm_g_hash_table_unref(priv->match_cache.entries);
 
     g_key_file_unref(priv->keyfile);
     if (priv->keyfile_user)
@@ -180,6 +180,7 @@ char      **nm_config_data_get_plugins(const NMConfigData *config_data, gboolean
 gboolean    nm_config_data_get_connectivity_enabled(const NMConfigData *config_data);
 const char *nm_config_data_get_connectivity_uri(const NMConfigData *config_data);
 guint       nm_config_data_get_connectivity_interval(const NMConfigData *config_data);
+guint       nm_config_data_get_connectivity_max_interval(const NMConfigData *config_data);
 guint       nm_config_data_get_connectivity_timeout(const NMConfigData *config_data);
 const char *nm_config_data_get_connectivity_response(const NMConfigData *config_data);
 
@@ -206,6 +207,11 @@ NMGlobalDnsConfig *nm_config_data_get_global_dns_config(const NMConfigData *self
 
 const char *nm_config_data_get_iwd_config_path(const NMConfigData *self);
 
+const guint32 *nm_config_data_get_main_ignore_route_tables(const NMConfigData *self,
+                                                           guint              *out_len);
+const guint8  *nm_config_data_get_main_ignore_route_protocols(const NMConfigData *self,
+                                                              guint              *out_len);
+
 extern const char *__start_connection_defaults[];
 extern const char *__stop_connection_defaults[];
 
@@ -239,6 +245,8 @@ const char *nm_config_data_get_device_config(const NMConfigData
                                              const struct _NMMatchSpecDeviceData *match_data,
                                              gboolean                            *has_match);
 
+guint nmtst_config_data_get_match_cache_len(const NMConfigData *self);
+
 const char *nm_config_data_get_device_config_by_device(const NMConfigData *self,
                                                        const char         *property,
                                                        NMDevice           *device,
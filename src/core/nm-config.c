@@ -853,11 +853,15 @@ static const ConfigGroup config_groups[] = {
                              NM_CONFIG_KEYFILE_KEY_MAIN_FIREWALL_BACKEND,
                              NM_CONFIG_KEYFILE_KEY_MAIN_HOSTNAME_MODE,
                              NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_ROUTE_PROTOCOLS,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_ROUTE_TABLES,
                              NM_CONFIG_KEYFILE_KEY_MAIN_IWD_CONFIG_PATH,
                              NM_CONFIG_KEYFILE_KEY_MAIN_MIGRATE_IFCFG_RH,
                              NM_CONFIG_KEYFILE_KEY_MAIN_MONITOR_CONNECTION_FILES,
                              NM_CONFIG_KEYFILE_KEY_MAIN_NO_AUTO_DEFAULT,
                              NM_CONFIG_KEYFILE_KEY_MAIN_PLUGINS,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_PROPERTIES_CHANGED_DELAY,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_PROPERTIES_CHANGED_RATELIMIT,
                              NM_CONFIG_KEYFILE_KEY_MAIN_RC_MANAGER,
                              NM_CONFIG_KEYFILE_KEY_MAIN_SYSTEMD_RESOLVED, ),
     },
@@ -872,16 +876,19 @@ static const ConfigGroup config_groups[] = {
         .group = NM_CONFIG_KEYFILE_GROUP_CONNECTIVITY,
         .keys  = NM_MAKE_STRV(NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_ENABLED,
                              NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_INTERVAL,
+                             NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_MAX_INTERVAL,
                              NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_TIMEOUT,
                              NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_RESPONSE,
                              NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_URI, ),
     },
     {
         .group = NM_CONFIG_KEYFILE_GROUP_KEYFILE,
-        .keys  = NM_MAKE_STRV(NM_CONFIG_KEYFILE_KEY_KEYFILE_HOSTNAME,
+        .keys  = NM_MAKE_STRV(NM_CONFIG_KEYFILE_KEY_KEYFILE_CACHE,
+                             NM_CONFIG_KEYFILE_KEY_KEYFILE_HOSTNAME,
                              NM_CONFIG_KEYFILE_KEY_KEYFILE_PATH,
                              NM_CONFIG_KEYFILE_KEY_KEYFILE_RENAME,
-                             NM_CONFIG_KEYFILE_KEY_KEYFILE_UNMANAGED_DEVICES, ),
+                             NM_CONFIG_KEYFILE_KEY_KEYFILE_UNMANAGED_DEVICES,
+                             NM_CONFIG_KEYFILE_KEY_KEYFILE_WATCH, ),
     },
     {
         .group = NM_CONFIG_KEYFILE_GROUP_IFUPDOWN,
@@ -901,6 +908,7 @@ static const ConfigGroup config_groups[] = {
                              NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_SCAN_RAND_MAC_ADDRESS,
                              NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_SCAN_GENERATE_MAC_ADDRESS_MASK,
                              NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_IWD_AUTOCONNECT,
+                             NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_NL80211_SCAN_RESULTS,
                              NM_CONFIG_KEYFILE_KEY_MATCH_DEVICE,
                              NM_CONFIG_KEYFILE_KEY_STOP_MATCH, ),
     },
@@ -22,11 +22,26 @@
 #include "NetworkManagerUtils.h"
 #include "nm-dbus-manager.h"
 #include "dns/nm-dns-manager.h"
+#include "devices/nm-device-utils.h"
 
 #define HEADER_STATUS_ONLINE "X-NetworkManager-Status: online\r\n"
 
 #define SD_RESOLVED_DNS ((guint64) (1LL << 0))
 
+/* Connections to the connectivity check server are only kept open, if the
+ * next check on the interface is expected within this time. Otherwise, the
+ * server most likely closed the connection in the meantime. This is also the
+ * default of CURLOPT_MAXAGE_CONN.
+ *
+ * With the default interval of 300 seconds, connections are therefore not
+ * kept open. Keep-alive is only used with a configured interval of 98 seconds
+ * or less (with the default timeout of 20 seconds). */
+#define CON_CURL_KEEP_ALIVE_MAX_SEC 118u
+
+/* After a check completed, at most this much of the rest of the response is
+ * received to keep the connection open. */
+#define CON_CURL_DRAIN_MAX_BYTES ((gsize) (100 * 1024))
+
 /*****************************************************************************/
 
 static NM_UTILS_LOOKUP_STR_DEFINE(_state_to_string,
@@ -61,6 +76,37 @@ typedef struct {
     guint timeout;
 } ConConfig;
 
+#if WITH_CONCHECK
+typedef struct {
+    /* must be the first field, the shares are hashed by nm_pstr_hash(). */
+    const char *key;
+
+    /* The curl share handle of one interface and address family. It holds
+     * the DNS cache, the TLS sessions and (with keep-alive) the connections,
+     * so that they are only reused by checks on the same interface and for
+     * the same address family. */
+    CURLSH *curl_shandle;
+
+    gint64 last_used_msec;
+    guint  n_users;
+
+    guint n_transfers;
+    guint n_reused;
+} ConCurlShare;
+
+/* A transfer whose check already completed, but whose response was not yet
+ * fully received. It is kept running, so that the connection stays usable
+ * for the next check. */
+typedef struct {
+    CList              drain_lst;
+    CURL              *curl_ehandle;
+    struct curl_slist *request_headers;
+    struct curl_slist *hosts;
+    ConCurlShare      *curl_share;
+    gsize              n_bytes;
+} ConCurlDrain;
+#endif
+
 struct _NMConnectivityCheckHandle {
     CList                       handles_lst;
     NMConnectivity             *self;
@@ -79,14 +125,15 @@ struct _NMConnectivityCheckHandle {
         GCancellable      *resolve_cancellable;
         int                resolve_ifindex;
         GDBusConnection   *dbus_connection;
-        CURLM             *curl_mhandle;
+        ConCurlShare      *curl_share;
         CURL              *curl_ehandle;
         struct curl_slist *request_headers;
         struct curl_slist *hosts;
 
-        GSource *curl_timer;
-
         gsize response_good_cnt;
+
+        bool keep_alive : 1;
+        bool curl_done : 1;
     } concheck;
 #endif
 
@@ -114,6 +161,20 @@ typedef struct {
     NMConfig  *config;
     ConConfig *con_config;
     guint      interval;
+    guint      max_interval;
+
+#if WITH_CONCHECK
+    /* all checks share one multi handle, so that connections, DNS results and
+     * TLS sessions can be reused (see ConCurlShare). */
+    CURLM      *curl_mhandle;
+    GSource    *curl_timer;
+    GHashTable *curl_shares;
+    CList       curl_drain_lst_head;
+
+    /* over the lifetime of all shares. */
+    guint64 curl_n_transfers;
+    guint64 curl_n_reused;
+#endif
 
     bool enabled : 1;
     bool uri_valid : 1;
@@ -202,6 +263,72 @@ _con_config_get_response(const ConConfig *con_config)
 
 /*****************************************************************************/
 
+#if WITH_CONCHECK
+static void
+_con_curl_share_release(ConCurlShare *share)
+{
+    nm_assert(share->n_users > 0);
+
+    share->n_users--;
+    share->last_used_msec = nm_utils_get_monotonic_timestamp_msec();
+}
+
+static size_t
+_con_curl_drain_cb(char *buffer, size_t size, size_t nitems, void *userdata)
+{
+    ConCurlDrain *drain = userdata;
+    size_t        len   = size * nitems;
+
+    /* the check already completed. Discard the rest of the response, unless
+     * it gets too long. Then rather close the connection. */
+    drain->n_bytes += len;
+    if (drain->n_bytes > CON_CURL_DRAIN_MAX_BYTES)
+        return 0;
+    return len;
+}
+
+static void
+_con_curl_drain_start(NMConnectivity *self, NMConnectivityCheckHandle *cb_data)
+{
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+    ConCurlDrain          *drain;
+
+    drain  = g_slice_new(ConCurlDrain);
+    *drain = (ConCurlDrain) {
+        .curl_ehandle    = g_steal_pointer(&cb_data->concheck.curl_ehandle),
+        .request_headers = g_steal_pointer(&cb_data->concheck.request_headers),
+        .hosts           = g_steal_pointer(&cb_data->concheck.hosts),
+        .curl_share      = g_steal_pointer(&cb_data->concheck.curl_share),
+    };
+    c_list_link_tail(&priv->curl_drain_lst_head, &drain->drain_lst);
+
+    /* the transfer keeps running until curl reports it as done. It is bounded
+     * by CURLOPT_TIMEOUT and CON_CURL_DRAIN_MAX_BYTES. */
+    curl_easy_setopt(drain->curl_ehandle, CURLOPT_WRITEFUNCTION, _con_curl_drain_cb);
+    curl_easy_setopt(drain->curl_ehandle, CURLOPT_WRITEDATA, drain);
+    curl_easy_setopt(drain->curl_ehandle, CURLOPT_HEADERFUNCTION, _con_curl_drain_cb);
+    curl_easy_setopt(drain->curl_ehandle, CURLOPT_HEADERDATA, drain);
+    curl_easy_setopt(drain->curl_ehandle, CURLOPT_PRIVATE, NULL);
+    curl_easy_setopt(drain->curl_ehandle, CURLOPT_DEBUGFUNCTION, NULL);
+    curl_easy_setopt(drain->curl_ehandle, CURLOPT_DEBUGDATA, NULL);
+    curl_easy_setopt(drain->curl_ehandle, CURLOPT_VERBOSE, 0L);
+}
+
+static void
+_con_curl_drain_free(NMConnectivity *self, ConCurlDrain *drain)
+{
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+
+    c_list_unlink_stale(&drain->drain_lst);
+    curl_multi_remove_handle(priv->curl_mhandle, drain->curl_ehandle);
+    curl_easy_cleanup(drain->curl_ehandle);
+    curl_slist_free_all(drain->request_headers);
+    curl_slist_free_all(drain->hosts);
+    _con_curl_share_release(drain->curl_share);
+    nm_g_slice_free(drain);
+}
+#endif
+
 static void
 cb_data_complete(NMConnectivityCheckHandle *cb_data,
                  NMConnectivityState        state,
@@ -224,7 +351,12 @@ cb_data_complete(NMConnectivityCheckHandle *cb_data,
     c_list_unlink_stale(&cb_data->handles_lst);
 
 #if WITH_CONCHECK
-    if (cb_data->concheck.curl_ehandle) {
+    if (cb_data->concheck.curl_ehandle && cb_data->concheck.keep_alive
+        && !cb_data->concheck.curl_done && state == NM_CONNECTIVITY_FULL) {
+        /* the check succeeded, but the rest of the response is still on its
+         * way. Aborting the transfer would close the connection. */
+        _con_curl_drain_start(self, cb_data);
+    } else if (cb_data->concheck.curl_ehandle) {
         /* Contrary to what cURL manual claim it is *not* safe to remove
          * the easy handle "at any moment"; specifically it's not safe to
          * remove *any* handle from within a libcurl callback. That is
@@ -239,14 +371,15 @@ cb_data_complete(NMConnectivityCheckHandle *cb_data,
         curl_easy_setopt(cb_data->concheck.curl_ehandle, CURLOPT_PRIVATE, NULL);
         curl_easy_setopt(cb_data->concheck.curl_ehandle, CURLOPT_HTTPHEADER, NULL);
 
-        curl_multi_remove_handle(cb_data->concheck.curl_mhandle, cb_data->concheck.curl_ehandle);
+        curl_multi_remove_handle(NM_CONNECTIVITY_GET_PRIVATE(self)->curl_mhandle,
+                                 cb_data->concheck.curl_ehandle);
         curl_easy_cleanup(cb_data->concheck.curl_ehandle);
-        curl_multi_cleanup(cb_data->concheck.curl_mhandle);
 
         curl_slist_free_all(cb_data->concheck.request_headers);
         curl_slist_free_all(cb_data->concheck.hosts);
     }
-    nm_clear_g_source_inst(&cb_data->concheck.curl_timer);
+    if (cb_data->concheck.curl_share)
+        _con_curl_share_release(cb_data->concheck.curl_share);
     nm_clear_g_cancellable(&cb_data->concheck.resolve_cancellable);
 #endif
 
@@ -314,9 +447,136 @@ _complete_queued(NMConnectivity *self)
     nm_g_object_unref(self_keep_alive);
 }
 
+static void
+_con_curl_share_free(gpointer data)
+{
+    ConCurlShare *share = data;
+
+    nm_assert(share->n_users == 0);
+
+    if (share->n_transfers > 0) {
+        _LOGD("(%s) drop share: %u of %u requests reused a connection",
+              share->key,
+              share->n_reused,
+              share->n_transfers);
+    }
+
+    curl_share_cleanup(share->curl_shandle);
+    g_free((char *) share->key);
+    nm_g_slice_free(share);
+}
+
+static ConCurlShare *
+_con_curl_share_acquire(NMConnectivity *self, const NMConnectivityCheckHandle *cb_data)
+{
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+    gs_free char          *key  = NULL;
+    ConCurlShare          *share;
+    CURLSH                *shandle;
+
+    key = g_strdup_printf("%s,IPv%c",
+                          cb_data->ifspec,
+                          nm_utils_addr_family_to_char(cb_data->addr_family));
+
+    if (!priv->curl_shares) {
+        priv->curl_shares =
+            g_hash_table_new_full(nm_pstr_hash, nm_pstr_equal, _con_curl_share_free, NULL);
+    }
+
+    share = g_hash_table_lookup(priv->curl_shares, &key);
+    if (!share) {
+        shandle = curl_share_init();
+        if (!shandle)
+            return NULL;
+
+        curl_share_setopt(shandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(shandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900 /* libcurl 7.57.0 */
+        curl_share_setopt(shandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+
+        share  = g_slice_new(ConCurlShare);
+        *share = (ConCurlShare) {
+            .key          = g_steal_pointer(&key),
+            .curl_shandle = shandle,
+        };
+        g_hash_table_add(priv->curl_shares, share);
+    }
+
+    share->n_users++;
+    return share;
+}
+
+static void
+_con_curl_shares_prune(NMConnectivity *self)
+{
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+    GHashTableIter         iter;
+    ConCurlShare          *share;
+    gint64                 now_msec;
+    gint64                 max_idle_msec;
+
+    if (!priv->curl_shares)
+        return;
+
+    /* Drop the shares (and their idle connections) of interfaces that
+     * had no check for a while, for example because they are gone. */
+    now_msec      = nm_utils_get_monotonic_timestamp_msec();
+    max_idle_msec = 2 * ((gint64) priv->interval + priv->con_config->timeout) * 1000;
+
+    g_hash_table_iter_init(&iter, priv->curl_shares);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &share, NULL)) {
+        if (share->n_users == 0 && now_msec - share->last_used_msec > max_idle_msec)
+            g_hash_table_iter_remove(&iter);
+    }
+}
+
+static gboolean
+_con_curl_keep_alive(const NMConnectivityPrivate *priv, const ConConfig *con_config)
+{
+#if LIBCURL_VERSION_NUM >= 0x074100 /* libcurl 7.65.0 */
+    /* Only keep the connection open, if the next check is due before the
+     * connection would expire anyway. Otherwise we would just hold on to
+     * an idle socket. */
+    return ((guint64) priv->interval + con_config->timeout) <= CON_CURL_KEEP_ALIVE_MAX_SEC;
+#else
+    /* Without CURLOPT_MAXAGE_CONN and a connection cache in the share handle,
+     * we cannot ensure that connections are only reused on the same interface
+     * and for the same address family. */
+    return FALSE;
+#endif
+}
+
+static void
+_con_curl_count_transfer(NMConnectivity *self, ConCurlShare *share, CURL *ehandle)
+{
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+    long                   num_connects;
+
+    if (curl_easy_getinfo(ehandle, CURLINFO_NUM_CONNECTS, &num_connects) != CURLE_OK)
+        return;
+
+    share->n_transfers++;
+    priv->curl_n_transfers++;
+    if (num_connects == 0) {
+        share->n_reused++;
+        priv->curl_n_reused++;
+    }
+
+    _LOGD("(%s) request used a %s connection (%u of %u requests reused a connection, "
+          "%" G_GUINT64_FORMAT " of %" G_GUINT64_FORMAT " on all interfaces)",
+          share->key,
+          num_connects == 0 ? "reused" : "new",
+          share->n_reused,
+          share->n_transfers,
+          priv->curl_n_reused,
+          priv->curl_n_transfers);
+}
+
 static gboolean
-_con_curl_check_connectivity(CURLM *mhandle, int sockfd, int ev_bitmask)
+_con_curl_check_connectivity(NMConnectivity *self, int sockfd, int ev_bitmask)
 {
+    NMConnectivityPrivate     *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
     NMConnectivityCheckHandle *cb_data;
     CURLMsg                   *msg;
     int                        m_left;
@@ -325,13 +585,13 @@ _con_curl_check_connectivity(CURLM *mhandle, int sockfd, int ev_bitmask)
     int                        running_handles;
     gboolean                   success = TRUE;
 
-    ret = curl_multi_socket_action(mhandle, sockfd, ev_bitmask, &running_handles);
+    ret = curl_multi_socket_action(priv->curl_mhandle, sockfd, ev_bitmask, &running_handles);
     if (ret != CURLM_OK) {
         _LOGD("connectivity check failed: (%d) %s", ret, curl_multi_strerror(ret));
         success = FALSE;
     }
 
-    while ((msg = curl_multi_info_read(mhandle, &m_left))) {
+    while ((msg = curl_multi_info_read(priv->curl_mhandle, &m_left))) {
         const char *response;
         CURLcode    eret;
 
@@ -348,8 +608,26 @@ _con_curl_check_connectivity(CURLM *mhandle, int sockfd, int ev_bitmask)
             continue;
         }
 
-        nm_assert(cb_data);
+        if (!cb_data) {
+            ConCurlDrain *drain;
+
+            /* the check already completed before, and now the rest of the
+             * response was received. */
+            c_list_for_each_entry (drain, &priv->curl_drain_lst_head, drain_lst) {
+                if (drain->curl_ehandle == msg->easy_handle) {
+                    _con_curl_count_transfer(self, drain->curl_share, drain->curl_ehandle);
+                    _con_curl_drain_free(self, drain);
+                    break;
+                }
+            }
+            continue;
+        }
+
         nm_assert(NM_IS_CONNECTIVITY(cb_data->self));
+        nm_assert(cb_data->concheck.curl_share);
+
+        cb_data->concheck.curl_done = TRUE;
+        _con_curl_count_transfer(self, cb_data->concheck.curl_share, msg->easy_handle);
 
         if (cb_data->completed_state != NM_CONNECTIVITY_UNKNOWN) {
             /* callback was already invoked earlier. Nothing to do. */
@@ -409,29 +687,28 @@ _con_curl_check_connectivity(CURLM *mhandle, int sockfd, int ev_bitmask)
 static gboolean
 _con_curl_timeout_cb(gpointer user_data)
 {
-    NMConnectivityCheckHandle *cb_data = user_data;
+    NMConnectivity *self = user_data;
 
-    nm_clear_g_source_inst(&cb_data->concheck.curl_timer);
-    _con_curl_check_connectivity(cb_data->concheck.curl_mhandle, CURL_SOCKET_TIMEOUT, 0);
-    _complete_queued(cb_data->self);
+    nm_clear_g_source_inst(&NM_CONNECTIVITY_GET_PRIVATE(self)->curl_timer);
+    _con_curl_check_connectivity(self, CURL_SOCKET_TIMEOUT, 0);
+    _complete_queued(self);
     return G_SOURCE_CONTINUE;
 }
 
 static int
 multi_timer_cb(CURLM *multi, long timeout_msec, void *userdata)
 {
-    NMConnectivityCheckHandle *cb_data = userdata;
+    NMConnectivity        *self = userdata;
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
 
-    nm_clear_g_source_inst(&cb_data->concheck.curl_timer);
-    if (timeout_msec != -1) {
-        cb_data->concheck.curl_timer =
-            nm_g_timeout_add_source(timeout_msec, _con_curl_timeout_cb, cb_data);
-    }
+    nm_clear_g_source_inst(&priv->curl_timer);
+    if (timeout_msec != -1)
+        priv->curl_timer = nm_g_timeout_add_source(timeout_msec, _con_curl_timeout_cb, self);
     return 0;
 }
 
 typedef struct {
-    NMConnectivityCheckHandle *cb_data;
+    NMConnectivity *self;
 
     GSource *source;
 
@@ -447,11 +724,11 @@ typedef struct {
 static gboolean
 _con_curl_socketevent_cb(int fd, GIOCondition condition, gpointer user_data)
 {
-    ConCurlSockData           *fdp           = user_data;
-    NMConnectivityCheckHandle *cb_data       = fdp->cb_data;
-    int                        action        = 0;
-    gboolean                   fdp_destroyed = FALSE;
-    gboolean                   success;
+    ConCurlSockData *fdp           = user_data;
+    NMConnectivity  *self          = fdp->self;
+    int              action        = 0;
+    gboolean         fdp_destroyed = FALSE;
+    gboolean         success;
 
     if (condition & G_IO_IN)
         action |= CURL_CSELECT_IN;
@@ -463,7 +740,7 @@ _con_curl_socketevent_cb(int fd, GIOCondition condition, gpointer user_data)
     nm_assert(!fdp->destroy_notify);
     fdp->destroy_notify = &fdp_destroyed;
 
-    success = _con_curl_check_connectivity(cb_data->concheck.curl_mhandle, fd, action);
+    success = _con_curl_check_connectivity(self, fd, action);
 
     if (fdp_destroyed) {
         /* hups. fdp got invalidated during _con_curl_check_connectivity(). That's fine,
@@ -475,7 +752,7 @@ _con_curl_socketevent_cb(int fd, GIOCondition condition, gpointer user_data)
             nm_clear_g_source_inst(&fdp->source);
     }
 
-    _complete_queued(cb_data->self);
+    _complete_queued(self);
 
     return G_SOURCE_CONTINUE;
 }
@@ -483,8 +760,8 @@ _con_curl_socketevent_cb(int fd, GIOCondition condition, gpointer user_data)
 static int
 multi_socket_cb(CURL *e_handle, curl_socket_t fd, int what, void *userdata, void *socketp)
 {
-    NMConnectivityCheckHandle *cb_data = userdata;
-    ConCurlSockData           *fdp     = socketp;
+    NMConnectivity  *self = userdata;
+    ConCurlSockData *fdp  = socketp;
 
     (void) _NM_ENSURE_TYPE(int, fd);
 
@@ -493,7 +770,7 @@ multi_socket_cb(CURL *e_handle, curl_socket_t fd, int what, void *userdata, void
             if (fdp->destroy_notify)
                 *fdp->destroy_notify = TRUE;
             nm_clear_g_source_inst(&fdp->source);
-            curl_multi_assign(cb_data->concheck.curl_mhandle, fd, NULL);
+            curl_multi_assign(NM_CONNECTIVITY_GET_PRIVATE(self)->curl_mhandle, fd, NULL);
             g_slice_free(ConCurlSockData, fdp);
         }
     } else {
@@ -502,9 +779,9 @@ multi_socket_cb(CURL *e_handle, curl_socket_t fd, int what, void *userdata, void
         if (!fdp) {
             fdp  = g_slice_new(ConCurlSockData);
             *fdp = (ConCurlSockData) {
-                .cb_data = cb_data,
+                .self = self,
             };
-            curl_multi_assign(cb_data->concheck.curl_mhandle, fd, fdp);
+            curl_multi_assign(NM_CONNECTIVITY_GET_PRIVATE(self)->curl_mhandle, fd, fdp);
         } else
             nm_clear_g_source_inst(&fdp->source);
 
@@ -524,6 +801,20 @@ multi_socket_cb(CURL *e_handle, curl_socket_t fd, int what, void *userdata, void
     return CURLM_OK;
 }
 
+static size_t
+_easy_completed_continue(const NMConnectivityCheckHandle *cb_data, size_t len)
+{
+    /* After a successful check, keep receiving the rest of the (short) response.
+     * Aborting the transfer would close the connection, while a transfer that
+     * finishes cleanly leaves the connection for reuse by the next check.
+     *
+     * If the response does not arrive in one go, the transfer continues after
+     * the check completed (see _con_curl_drain_start()). */
+    if (cb_data->completed_state == NM_CONNECTIVITY_FULL)
+        return len;
+    return 0;
+}
+
 static size_t
 easy_header_cb(char *buffer, size_t size, size_t nitems, void *userdata)
 {
@@ -532,13 +823,13 @@ easy_header_cb(char *buffer, size_t size, size_t nitems, void *userdata)
 
     if (cb_data->completed_state != NM_CONNECTIVITY_UNKNOWN) {
         /* already completed. */
-        return 0;
+        return _easy_completed_continue(cb_data, len);
     }
 
     if (len >= sizeof(HEADER_STATUS_ONLINE) - 1
         && !g_ascii_strncasecmp(buffer, HEADER_STATUS_ONLINE, sizeof(HEADER_STATUS_ONLINE) - 1)) {
         cb_data_queue_completed(cb_data, NM_CONNECTIVITY_FULL, "status header found", NULL);
-        return 0;
+        return len;
     }
 
     return len;
@@ -555,7 +846,7 @@ easy_write_cb(void *buffer, size_t size, size_t nmemb, void *userdata)
 
     if (cb_data->completed_state != NM_CONNECTIVITY_UNKNOWN) {
         /* already completed. */
-        return 0;
+        return _easy_completed_continue(cb_data, len);
     }
 
     if (len == 0) {
@@ -611,7 +902,7 @@ easy_write_cb(void *buffer, size_t size, size_t nmemb, void *userdata)
     if (cb_data->concheck.response_good_cnt >= response_len) {
         /* We already have enough data, and it matched. */
         cb_data_queue_completed(cb_data, NM_CONNECTIVITY_FULL, "expected response", NULL);
-        return 0;
+        return len;
     }
 
     return len;
@@ -716,42 +1007,72 @@ _idle_cb(gpointer user_data)
 }
 
 #if WITH_CONCHECK
+static CURLM *
+_con_curl_get_mhandle(NMConnectivity *self)
+{
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+    CURLM                 *mhandle;
+
+    if (priv->curl_mhandle)
+        return priv->curl_mhandle;
+
+    mhandle = curl_multi_init();
+    if (!mhandle)
+        return NULL;
+
+    curl_multi_setopt(mhandle, CURLMOPT_SOCKETFUNCTION, multi_socket_cb);
+    curl_multi_setopt(mhandle, CURLMOPT_SOCKETDATA, self);
+    curl_multi_setopt(mhandle, CURLMOPT_TIMERFUNCTION, multi_timer_cb);
+    curl_multi_setopt(mhandle, CURLMOPT_TIMERDATA, self);
+
+    priv->curl_mhandle = mhandle;
+    return mhandle;
+}
+
 static void
 do_curl_request(NMConnectivityCheckHandle *cb_data, const char *hosts)
 {
-    CURLM *mhandle;
-    CURL  *ehandle;
-    long   resolve;
+    NMConnectivity        *self = cb_data->self;
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+    CURLM                 *mhandle;
+    CURL                  *ehandle;
+    gboolean               keep_alive;
+    long                   resolve;
 
     _LOG2T("set curl resolve list to '%s'", hosts);
 
-    mhandle = curl_multi_init();
+    mhandle = _con_curl_get_mhandle(self);
     if (!mhandle) {
         cb_data_complete(cb_data, NM_CONNECTIVITY_ERROR, "curl error");
         return;
     }
 
+    _con_curl_shares_prune(self);
+
+    cb_data->concheck.curl_share = _con_curl_share_acquire(self, cb_data);
+    if (!cb_data->concheck.curl_share) {
+        cb_data_complete(cb_data, NM_CONNECTIVITY_ERROR, "curl error");
+        return;
+    }
+
     ehandle = curl_easy_init();
     if (!ehandle) {
-        curl_multi_cleanup(mhandle);
         cb_data_complete(cb_data, NM_CONNECTIVITY_ERROR, "curl error");
         return;
     }
 
+    keep_alive = _con_curl_keep_alive(priv, cb_data->concheck.con_config);
+
     cb_data->concheck.hosts = curl_slist_append(NULL, hosts);
 
-    cb_data->concheck.curl_mhandle    = mhandle;
-    cb_data->concheck.curl_ehandle    = ehandle;
-    cb_data->concheck.request_headers = curl_slist_append(NULL, "Connection: close");
+    cb_data->concheck.curl_ehandle = ehandle;
+    cb_data->concheck.keep_alive   = keep_alive;
+    if (!keep_alive)
+        cb_data->concheck.request_headers = curl_slist_append(NULL, "Connection: close");
     cb_data->timeout_source = nm_g_timeout_add_seconds_source(cb_data->concheck.con_config->timeout,
                                                               _timeout_cb,
                                                               cb_data);
 
-    curl_multi_setopt(mhandle, CURLMOPT_SOCKETFUNCTION, multi_socket_cb);
-    curl_multi_setopt(mhandle, CURLMOPT_SOCKETDATA, cb_data);
-    curl_multi_setopt(mhandle, CURLMOPT_TIMERFUNCTION, multi_timer_cb);
-    curl_multi_setopt(mhandle, CURLMOPT_TIMERDATA, cb_data);
-
     switch (cb_data->addr_family) {
     case AF_INET:
         resolve = CURL_IPRESOLVE_V4;
@@ -777,6 +1098,15 @@ do_curl_request(NMConnectivityCheckHandle *cb_data, const char *hosts)
     curl_easy_setopt(ehandle, CURLOPT_INTERFACE, cb_data->ifspec);
     curl_easy_setopt(ehandle, CURLOPT_RESOLVE, cb_data->concheck.hosts);
     curl_easy_setopt(ehandle, CURLOPT_IPRESOLVE, resolve);
+    curl_easy_setopt(ehandle, CURLOPT_SHARE, cb_data->concheck.curl_share->curl_shandle);
+    curl_easy_setopt(ehandle, CURLOPT_TIMEOUT, (long) cb_data->concheck.con_config->timeout);
+
+    if (keep_alive) {
+#if LIBCURL_VERSION_NUM >= 0x074100 /* libcurl 7.65.0 */
+        curl_easy_setopt(ehandle, CURLOPT_MAXAGE_CONN, (long) CON_CURL_KEEP_ALIVE_MAX_SEC);
+#endif
+    } else
+        curl_easy_setopt(ehandle, CURLOPT_FORBID_REUSE, 1L);
 
 #if LIBCURL_VERSION_NUM >= 0x075500 /* libcurl 7.85.0 */
     curl_easy_setopt(ehandle, CURLOPT_PROTOCOLS_STR, "HTTP,HTTPS");
@@ -1278,6 +1608,13 @@ nm_connectivity_get_interval(NMConnectivity *self)
     return nm_connectivity_check_enabled(self) ? NM_CONNECTIVITY_GET_PRIVATE(self)->interval : 0;
 }
 
+guint
+nm_connectivity_get_max_interval(NMConnectivity *self)
+{
+    return nm_connectivity_check_enabled(self) ? NM_CONNECTIVITY_GET_PRIVATE(self)->max_interval
+                                               : 0;
+}
+
 static gboolean
 host_and_port_from_uri(const char *uri, char **host, char **port)
 {
@@ -1331,6 +1668,7 @@ update_config(NMConnectivity *self, NMConfigData *config_data)
 {
     NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
     guint                  interval;
+    guint                  max_interval;
     guint                  new_timeout;
     gboolean               enabled;
     gboolean               changed      = FALSE;
@@ -1405,12 +1743,19 @@ update_config(NMConnectivity *self, NMConfigData *config_data)
     priv->uri_valid = new_uri_valid;
 
     interval = nm_config_data_get_connectivity_interval(config_data);
-    interval = NM_MIN(interval, (7u * 24 * 3600));
+    interval = NM_MIN(interval, NM_DEVICE_CONCHECK_INTERVAL_MAX);
     if (priv->interval != interval) {
         priv->interval = interval;
         changed        = TRUE;
     }
 
+    max_interval = nm_config_data_get_connectivity_max_interval(config_data);
+    max_interval = NM_CLAMP(max_interval, interval, NM_DEVICE_CONCHECK_INTERVAL_MAX);
+    if (priv->max_interval != max_interval) {
+        priv->max_interval = max_interval;
+        changed            = TRUE;
+    }
+
     enabled = FALSE;
 #if WITH_CONCHECK
     if (priv->uri_valid && priv->interval)
@@ -1448,6 +1793,9 @@ nm_connectivity_init(NMConnectivity *self)
 
     c_list_init(&priv->handles_lst_head);
     c_list_init(&priv->completed_handles_lst_head);
+#if WITH_CONCHECK
+    c_list_init(&priv->curl_drain_lst_head);
+#endif
 
     priv->config = g_object_ref(nm_config_get());
     g_signal_connect(G_OBJECT(priv->config),
@@ -1473,6 +1821,9 @@ dispose(GObject *object)
     NMConnectivity            *self = NM_CONNECTIVITY(object);
     NMConnectivityPrivate     *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
     NMConnectivityCheckHandle *cb_data;
+#if WITH_CONCHECK
+    ConCurlDrain *drain;
+#endif
 
     nm_assert(c_list_is_empty(&priv->completed_handles_lst_head));
 
@@ -1484,6 +1835,17 @@ dispose(GObject *object)
     nm_clear_pointer(&priv->con_config, _con_config_unref);
 
 #if WITH_CONCHECK
+    while ((drain = c_list_first_entry(&priv->curl_drain_lst_head, ConCurlDrain, drain_lst)))
+        _con_curl_drain_free(self, drain);
+
+    /* the easy handles of all checks are gone, now the shares and the multi
+     * handle can be released. */
+    nm_clear_pointer(&priv->curl_shares, g_hash_table_unref);
+    if (priv->curl_mhandle) {
+        curl_multi_cleanup(priv->curl_mhandle);
+        priv->curl_mhandle = NULL;
+    }
+    nm_clear_g_source_inst(&priv->curl_timer);
     curl_global_cleanup();
 #endif
 
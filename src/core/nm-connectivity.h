@@ -54,6 +54,8 @@ gboolean nm_connectivity_check_enabled(NMConnectivity *self);
 
 guint nm_connectivity_get_interval(NMConnectivity *self);
 
+guint nm_connectivity_get_max_interval(NMConnectivity *self);
+
 typedef struct _NMConnectivityCheckHandle NMConnectivityCheckHandle;
 
 typedef void (*NMConnectivityCheckCallback)(NMConnectivity            *self,
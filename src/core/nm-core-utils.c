@@ -1165,6 +1165,11 @@ typedef struct {
         gboolean is_parsed;
         guint    len;
         guint8   bin[_NM_UTILS_HWADDR_LEN_MAX];
+
+        /* the canonical string representation of @bin. Only set by
+         * _match_data_hwaddr_str(). */
+        const char *str;
+        char        str_buf[_NM_UTILS_HWADDR_LEN_MAX * 3];
     } hwaddr;
     struct {
         gboolean is_parsed;
@@ -1241,12 +1246,8 @@ match_device_s390_subchannels_parse(const char *s390_subchannels,
 }
 
 static gboolean
-match_data_s390_subchannels_eval(const char *spec_str, MatchSpecDeviceData *match_data)
+_match_data_s390_subchannels_parse(MatchSpecDeviceData *match_data)
 {
-    guint32 a;
-    guint32 b;
-    guint32 c;
-
     if (G_UNLIKELY(!match_data->s390_subchannels.is_parsed)) {
         nm_assert(!match_data->s390_subchannels.is_good);
         match_data->s390_subchannels.is_parsed = TRUE;
@@ -1262,14 +1263,49 @@ match_data_s390_subchannels_eval(const char *spec_str, MatchSpecDeviceData *matc
     } else if (!match_data->s390_subchannels.is_good)
         return FALSE;
 
+    return TRUE;
+}
+
+static gboolean
+match_data_s390_subchannels_eval(const char *spec_str, MatchSpecDeviceData *match_data)
+{
+    guint32 a;
+    guint32 b;
+    guint32 c;
+
+    if (!_match_data_s390_subchannels_parse(match_data))
+        return FALSE;
+
     if (!match_device_s390_subchannels_parse(spec_str, &a, &b, &c))
         return FALSE;
     return match_data->s390_subchannels.a == a && match_data->s390_subchannels.b == b
            && match_data->s390_subchannels.c == c;
 }
 
+static void
+_match_data_init(MatchSpecDeviceData *match_data, const NMMatchSpecDeviceData *data)
+{
+    *match_data = (MatchSpecDeviceData) {
+        .data           = data,
+        .device_type    = nm_str_not_empty(data->device_type),
+        .driver         = nm_str_not_empty(data->driver),
+        .driver_version = nm_str_not_empty(data->driver_version),
+        .dhcp_plugin    = nm_str_not_empty(data->dhcp_plugin),
+        .hwaddr =
+            {
+                .is_parsed = FALSE,
+                .len       = 0,
+            },
+        .s390_subchannels =
+            {
+                .is_parsed = FALSE,
+                .is_good   = FALSE,
+            },
+    };
+}
+
 static gboolean
-match_device_hwaddr_eval(const char *spec_str, MatchSpecDeviceData *match_data)
+_match_data_hwaddr_parse(MatchSpecDeviceData *match_data)
 {
     if (G_UNLIKELY(!match_data->hwaddr.is_parsed)) {
         match_data->hwaddr.is_parsed = TRUE;
@@ -1289,9 +1325,50 @@ match_device_hwaddr_eval(const char *spec_str, MatchSpecDeviceData *match_data)
     } else if (match_data->hwaddr.len == 0)
         return FALSE;
 
+    return TRUE;
+}
+
+static gboolean
+match_device_hwaddr_eval(const char *spec_str, MatchSpecDeviceData *match_data)
+{
+    if (!_match_data_hwaddr_parse(match_data))
+        return FALSE;
+
     return nm_utils_hwaddr_matches(spec_str, -1, match_data->hwaddr.bin, match_data->hwaddr.len);
 }
 
+/* Returns the key under which a compiled "mac:" spec indexes the address.
+ * Like nm_utils_hwaddr_matches(), addresses only match if they have the same
+ * length, and only the last 8 bytes of InfiniBand addresses are compared.
+ * The first bytes of those are therefore cleared. */
+static const char *
+_match_spec_hwaddr_key(const guint8 *bin, gsize len, char *buf, gsize buf_len)
+{
+    guint8 ib[INFINIBAND_ALEN];
+
+    if (len == INFINIBAND_ALEN) {
+        memset(ib, 0, INFINIBAND_ALEN - 8);
+        memcpy(&ib[INFINIBAND_ALEN - 8], &bin[INFINIBAND_ALEN - 8], 8);
+        bin = ib;
+    }
+    return _nm_utils_hwaddr_ntoa(bin, len, TRUE, buf, buf_len);
+}
+
+static const char *
+_match_data_hwaddr_str(MatchSpecDeviceData *match_data)
+{
+    if (!_match_data_hwaddr_parse(match_data))
+        return NULL;
+
+    if (!match_data->hwaddr.str) {
+        match_data->hwaddr.str = _match_spec_hwaddr_key(match_data->hwaddr.bin,
+                                                        match_data->hwaddr.len,
+                                                        match_data->hwaddr.str_buf,
+                                                        sizeof(match_data->hwaddr.str_buf));
+    }
+    return match_data->hwaddr.str;
+}
+
 #define _MATCH_CHECK(spec_str, tag)                                        \
     ({                                                                     \
         gboolean _has = FALSE;                                             \
@@ -1438,23 +1515,7 @@ nm_match_spec_device(const GSList *specs, const NMMatchSpecDeviceData *data)
     if (!specs)
         return NM_MATCH_SPEC_NO_MATCH;
 
-    match_data = (MatchSpecDeviceData) {
-        .data           = data,
-        .device_type    = nm_str_not_empty(data->device_type),
-        .driver         = nm_str_not_empty(data->driver),
-        .driver_version = nm_str_not_empty(data->driver_version),
-        .dhcp_plugin    = nm_str_not_empty(data->dhcp_plugin),
-        .hwaddr =
-            {
-                .is_parsed = FALSE,
-                .len       = 0,
-            },
-        .s390_subchannels =
-            {
-                .is_parsed = FALSE,
-                .is_good   = FALSE,
-            },
-    };
+    _match_data_init(&match_data, data);
 
     for (iter = specs; iter; iter = iter->next) {
         gboolean except;
@@ -1488,6 +1549,328 @@ nm_match_spec_device(const GSList *specs, const NMMatchSpecDeviceData *data)
     return _match_result(has_except, has_not_except, has_match, has_match_except);
 }
 
+/*****************************************************************************/
+
+typedef struct {
+    char         *driver;
+    gsize         driver_len;
+    GPatternSpec *driver_version;
+} MatchSpecDriverVersion;
+
+typedef struct {
+    guint32 a;
+    guint32 b;
+    guint32 c;
+} MatchSpecS390Subchannels;
+
+typedef struct {
+    GHashTable *interface_names;
+    GPtrArray  *interface_name_patterns;
+    GHashTable *hwaddrs;
+    GHashTable *device_types;
+    GHashTable *drivers;
+    GArray     *driver_versions;
+    GArray     *s390_subchannels;
+    GHashTable *dhcp_plugins;
+    bool        match_all : 1;
+} MatchSpecDeviceCompiled;
+
+struct _NMMatchSpecDevice {
+    /* The compiled specs, the first for the regular ones and the
+     * second for the "except:" ones. */
+    MatchSpecDeviceCompiled compiled[2];
+    bool                    has_except : 1;
+    bool                    has_not_except : 1;
+};
+
+static void
+_match_spec_driver_version_clear(gpointer data)
+{
+    MatchSpecDriverVersion *dv = data;
+
+    g_free(dv->driver);
+    g_pattern_spec_free(dv->driver_version);
+}
+
+static void
+_match_spec_str_add(GHashTable **p_hash, const char *str)
+{
+    if (!*p_hash)
+        *p_hash = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+    g_hash_table_add(*p_hash, g_strdup(str));
+}
+
+static gboolean
+_match_spec_str_contains(GHashTable *hash, const char *str)
+{
+    return hash && str && g_hash_table_contains(hash, str);
+}
+
+static gboolean
+_match_spec_hwaddr_add(MatchSpecDeviceCompiled *compiled, const char *spec_str)
+{
+    guint8 bin[_NM_UTILS_HWADDR_LEN_MAX];
+    char   buf[_NM_UTILS_HWADDR_LEN_MAX * 3];
+    gsize  len;
+
+    if (!_nm_utils_hwaddr_aton(spec_str, bin, sizeof(bin), &len) || len == 0)
+        return FALSE;
+
+    _match_spec_str_add(&compiled->hwaddrs, _match_spec_hwaddr_key(bin, len, buf, sizeof(buf)));
+    return TRUE;
+}
+
+static void
+_match_spec_interface_name_add(MatchSpecDeviceCompiled *compiled,
+                               const char              *spec_str,
+                               gboolean                 use_pattern)
+{
+    /* Without wildcards, g_pattern_match_simple() is a plain string compare. */
+    if (!use_pattern || !strpbrk(spec_str, "*?")) {
+        _match_spec_str_add(&compiled->interface_names, spec_str);
+        return;
+    }
+
+    if (!compiled->interface_name_patterns) {
+        compiled->interface_name_patterns =
+            g_ptr_array_new_with_free_func((GDestroyNotify) g_pattern_spec_free);
+    }
+    g_ptr_array_add(compiled->interface_name_patterns, g_pattern_spec_new(spec_str));
+}
+
+static void
+_match_spec_device_compile_one(MatchSpecDeviceCompiled *compiled,
+                               const char              *spec_str,
+                               gboolean                 allow_fuzzy)
+{
+    /* This must be kept in sync with match_device_eval(). */
+
+    if (spec_str[0] == '*' && spec_str[1] == '\0') {
+        compiled->match_all = TRUE;
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, DEVICE_TYPE_TAG)) {
+        _match_spec_str_add(&compiled->device_types, spec_str);
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, NM_MATCH_SPEC_MAC_TAG)) {
+        _match_spec_hwaddr_add(compiled, spec_str);
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, NM_MATCH_SPEC_INTERFACE_NAME_TAG)) {
+        gboolean use_pattern = FALSE;
+
+        if (spec_str[0] == '=')
+            spec_str += 1;
+        else {
+            if (spec_str[0] == '~')
+                spec_str += 1;
+            use_pattern = TRUE;
+        }
+        _match_spec_interface_name_add(compiled, spec_str, use_pattern);
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, DRIVER_TAG)) {
+        MatchSpecDriverVersion *dv;
+        const char             *t;
+
+        t = strrchr(spec_str, '/');
+        if (!t) {
+            _match_spec_str_add(&compiled->drivers, spec_str);
+            return;
+        }
+
+        if (!compiled->driver_versions) {
+            compiled->driver_versions = g_array_new(FALSE, FALSE, sizeof(MatchSpecDriverVersion));
+            g_array_set_clear_func(compiled->driver_versions, _match_spec_driver_version_clear);
+        }
+        dv  = nm_g_array_append_new(compiled->driver_versions, MatchSpecDriverVersion);
+        *dv = (MatchSpecDriverVersion) {
+            .driver         = g_strndup(spec_str, t - spec_str),
+            .driver_len     = t - spec_str,
+            .driver_version = g_pattern_spec_new(&t[1]),
+        };
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, NM_MATCH_SPEC_S390_SUBCHANNELS_TAG)) {
+        MatchSpecS390Subchannels s;
+
+        if (!match_device_s390_subchannels_parse(spec_str, &s.a, &s.b, &s.c))
+            return;
+        if (!compiled->s390_subchannels) {
+            compiled->s390_subchannels =
+                g_array_new(FALSE, FALSE, sizeof(MatchSpecS390Subchannels));
+        }
+        g_array_append_val(compiled->s390_subchannels, s);
+        return;
+    }
+
+    if (_MATCH_CHECK(spec_str, DHCP_PLUGIN_TAG)) {
+        _match_spec_str_add(&compiled->dhcp_plugins, spec_str);
+        return;
+    }
+
+    if (allow_fuzzy) {
+        _match_spec_hwaddr_add(compiled, spec_str);
+        _match_spec_str_add(&compiled->interface_names, spec_str);
+    }
+}
+
+static gboolean
+_match_spec_device_compiled_eval(const MatchSpecDeviceCompiled *compiled,
+                                 MatchSpecDeviceData           *match_data)
+{
+    const char *interface_name = match_data->data->interface_name;
+    guint       i;
+
+    if (compiled->match_all)
+        return TRUE;
+
+    if (interface_name) {
+        if (_match_spec_str_contains(compiled->interface_names, interface_name))
+            return TRUE;
+        if (compiled->interface_name_patterns) {
+            for (i = 0; i < compiled->interface_name_patterns->len; i++) {
+                if (g_pattern_match_string(compiled->interface_name_patterns->pdata[i],
+                                           interface_name))
+                    return TRUE;
+            }
+        }
+    }
+
+    if (compiled->hwaddrs
+        && _match_spec_str_contains(compiled->hwaddrs, _match_data_hwaddr_str(match_data)))
+        return TRUE;
+
+    if (_match_spec_str_contains(compiled->device_types, match_data->device_type))
+        return TRUE;
+
+    if (match_data->driver) {
+        if (_match_spec_str_contains(compiled->drivers, match_data->driver))
+            return TRUE;
+        if (compiled->driver_versions) {
+            for (i = 0; i < compiled->driver_versions->len; i++) {
+                const MatchSpecDriverVersion *dv =
+                    &nm_g_array_index(compiled->driver_versions, MatchSpecDriverVersion, i);
+
+                if (strncmp(dv->driver, match_data->driver, dv->driver_len) == 0
+                    && g_pattern_match_string(dv->driver_version,
+                                              match_data->driver_version ?: ""))
+                    return TRUE;
+            }
+        }
+    }
+
+    if (compiled->s390_subchannels && _match_data_s390_subchannels_parse(match_data)) {
+        for (i = 0; i < compiled->s390_subchannels->len; i++) {
+            const MatchSpecS390Subchannels *s =
+                &nm_g_array_index(compiled->s390_subchannels, MatchSpecS390Subchannels, i);
+
+            if (match_data->s390_subchannels.a == s->a && match_data->s390_subchannels.b == s->b
+                && match_data->s390_subchannels.c == s->c)
+                return TRUE;
+        }
+    }
+
+    if (_match_spec_str_contains(compiled->dhcp_plugins, match_data->dhcp_plugin))
+        return TRUE;
+
+    return FALSE;
+}
+
+static void
+_match_spec_device_compiled_clear(MatchSpecDeviceCompiled *compiled)
+{
+    nm_clear_pointer(&compiled->interface_names, g_hash_table_unref);
+    nm_clear_pointer(&compiled->interface_name_patterns, g_ptr_array_unref);
+    nm_clear_pointer(&compiled->hwaddrs, g_hash_table_unref);
+    nm_clear_pointer(&compiled->device_types, g_hash_table_unref);
+    nm_clear_pointer(&compiled->drivers, g_hash_table_unref);
+    nm_clear_pointer(&compiled->driver_versions, g_array_unref);
+    nm_clear_pointer(&compiled->s390_subchannels, g_array_unref);
+    nm_clear_pointer(&compiled->dhcp_plugins, g_hash_table_unref);
+}
+
+/**
+ * nm_match_spec_device_compile:
+ * @specs: (element-type utf8): the device match specs
+ *
+ * Parses @specs once, so that they can be evaluated repeatedly with
+ * nm_match_spec_device_match(). That gives the same result as
+ * nm_match_spec_device(), but looks up exact interface names, MAC addresses,
+ * device types and drivers in hash tables and doesn't parse the patterns
+ * again.
+ *
+ * Returns: (transfer full): the compiled specs. Free with
+ *   nm_match_spec_device_free().
+ */
+NMMatchSpecDevice *
+nm_match_spec_device_compile(const GSList *specs)
+{
+    NMMatchSpecDevice *self;
+    const GSList      *iter;
+
+    self = g_slice_new0(NMMatchSpecDevice);
+
+    for (iter = specs; iter; iter = iter->next) {
+        const char *spec_str = iter->data;
+        gboolean    except;
+
+        if (!spec_str || !*spec_str)
+            continue;
+
+        spec_str = match_except(spec_str, &except);
+
+        if (except)
+            self->has_except = TRUE;
+        else
+            self->has_not_except = TRUE;
+
+        _match_spec_device_compile_one(&self->compiled[except], spec_str, !except);
+    }
+
+    return self;
+}
+
+void
+nm_match_spec_device_free(NMMatchSpecDevice *self)
+{
+    if (!self)
+        return;
+
+    _match_spec_device_compiled_clear(&self->compiled[0]);
+    _match_spec_device_compiled_clear(&self->compiled[1]);
+    nm_g_slice_free(self);
+}
+
+NMMatchSpecMatchType
+nm_match_spec_device_match(const NMMatchSpecDevice *self, const NMMatchSpecDeviceData *data)
+{
+    MatchSpecDeviceData match_data;
+    gboolean            has_match        = FALSE;
+    gboolean            has_match_except = FALSE;
+
+    nm_assert(data);
+    nm_assert(!data->hwaddr || nm_utils_hwaddr_valid(data->hwaddr, -1));
+
+    if (!self)
+        return NM_MATCH_SPEC_NO_MATCH;
+
+    _match_data_init(&match_data, data);
+
+    if (self->has_except)
+        has_match_except = _match_spec_device_compiled_eval(&self->compiled[1], &match_data);
+    if (self->has_not_except && !has_match_except)
+        has_match = _match_spec_device_compiled_eval(&self->compiled[0], &match_data);
+
+    return _match_result(self->has_except, self->has_not_except, has_match, has_match_except);
+}
+
 int
 nm_match_spec_match_type_to_bool(NMMatchSpecMatchType m, int no_match_value)
 {
@@ -4900,7 +5283,10 @@ get_bandwidth_vht(const guint8 *bytes, guint len, guint32 *out_bandwidth)
 }
 
 /* Management Frame Information Element IDs, ieee80211_eid */
+#define WLAN_EID_SUPP_RATES      1
 #define WLAN_EID_HT_CAPABILITY   45
+#define WLAN_EID_RSN             48
+#define WLAN_EID_EXT_SUPP_RATES  50
 #define WLAN_EID_HT_OPERATION    61
 #define WLAN_EID_VHT_CAPABILITY  191
 #define WLAN_EID_VHT_OPERATION   192
@@ -4974,6 +5360,329 @@ nm_wifi_utils_parse_ies(const guint8 *bytes,
     }
 }
 
+/**
+ * nm_wifi_utils_ies_find:
+ * @bytes: the information elements
+ * @len: the length of @bytes
+ * @eid: the element ID to find
+ * @out_len: (out): the length of the element's data
+ *
+ * Returns: the data of the first element @eid, or %NULL.
+ */
+const guint8 *
+nm_wifi_utils_ies_find(const guint8 *bytes, gsize len, guint8 eid, gsize *out_len)
+{
+    guint8 id, elem_len;
+
+    while (len >= 2) {
+        id       = *bytes++;
+        elem_len = *bytes++;
+        len -= 2;
+
+        if (elem_len > len)
+            break;
+
+        if (id == eid) {
+            *out_len = elem_len;
+            return bytes;
+        }
+
+        len -= elem_len;
+        bytes += elem_len;
+    }
+
+    *out_len = 0;
+    return NULL;
+}
+
+#define RSN_OUI 0x000FACu
+#define WPA_OUI 0x0050F2u
+
+static gboolean
+_ie_suite_get(const guint8 **p_bytes, gsize *p_len, guint32 *out_oui, guint8 *out_type)
+{
+    if (*p_len < 4)
+        return FALSE;
+
+    *out_oui  = ((*p_bytes)[0] << 16) | ((*p_bytes)[1] << 8) | (*p_bytes)[2];
+    *out_type = (*p_bytes)[3];
+    *p_bytes += 4;
+    *p_len -= 4;
+    return TRUE;
+}
+
+static gboolean
+_ie_suite_count_get(const guint8 **p_bytes, gsize *p_len, guint *out_count)
+{
+    if (*p_len < 2)
+        return FALSE;
+
+    *out_count = unaligned_read_le16(*p_bytes);
+    *p_bytes += 2;
+    *p_len -= 2;
+    return TRUE;
+}
+
+static NM80211ApSecurityFlags
+_ie_cipher_to_flags(guint32 oui, guint8 type, guint32 expected_oui, gboolean group)
+{
+    if (oui != expected_oui)
+        return NM_802_11_AP_SEC_NONE;
+
+    switch (type) {
+    case 1:
+        return group ? NM_802_11_AP_SEC_GROUP_WEP40 : NM_802_11_AP_SEC_NONE;
+    case 2:
+        return group ? NM_802_11_AP_SEC_GROUP_TKIP : NM_802_11_AP_SEC_PAIR_TKIP;
+    case 4:
+        return group ? NM_802_11_AP_SEC_GROUP_CCMP : NM_802_11_AP_SEC_PAIR_CCMP;
+    case 5:
+        return group ? NM_802_11_AP_SEC_GROUP_WEP104 : NM_802_11_AP_SEC_NONE;
+    }
+    return NM_802_11_AP_SEC_NONE;
+}
+
+static NM80211ApSecurityFlags
+_ie_akm_to_flags(guint32 oui, guint8 type, guint32 expected_oui)
+{
+    if (oui != expected_oui)
+        return NM_802_11_AP_SEC_NONE;
+
+    if (oui == WPA_OUI) {
+        switch (type) {
+        case 1:
+            return NM_802_11_AP_SEC_KEY_MGMT_802_1X;
+        case 2:
+            return NM_802_11_AP_SEC_KEY_MGMT_PSK;
+        }
+        return NM_802_11_AP_SEC_NONE;
+    }
+
+    /* This follows how wpa_supplicant's KeyMgmt values get mapped for
+     * the BSS from D-Bus. */
+    switch (type) {
+    case 1:  /* 802.1X */
+    case 3:  /* FT-802.1X */
+    case 5:  /* 802.1X-SHA256 */
+    case 14: /* FILS-SHA256 */
+    case 15: /* FILS-SHA384 */
+    case 16: /* FT-FILS-SHA256 */
+    case 17: /* FT-FILS-SHA384 */
+        return NM_802_11_AP_SEC_KEY_MGMT_802_1X;
+    case 2: /* PSK */
+    case 4: /* FT-PSK */
+    case 6: /* PSK-SHA256 */
+        return NM_802_11_AP_SEC_KEY_MGMT_PSK;
+    case 8: /* SAE */
+    case 9: /* FT-SAE */
+        return NM_802_11_AP_SEC_KEY_MGMT_SAE;
+    case 12: /* 802.1X-SUITE-B-192 */
+    case 13: /* FT-802.1X-SHA384 */
+        return NM_802_11_AP_SEC_KEY_MGMT_EAP_SUITE_B_192;
+    case 18: /* OWE */
+        return NM_802_11_AP_SEC_KEY_MGMT_OWE;
+    }
+    return NM_802_11_AP_SEC_NONE;
+}
+
+static NM80211ApSecurityFlags
+_ie_parse_wpa_rsn(const guint8 *bytes, gsize len, guint32 oui)
+{
+    NM80211ApSecurityFlags flags;
+    guint32                s_oui;
+    guint8                 s_type;
+    guint                  n;
+
+    /* The RSN and WPA elements have the same layout: version, group cipher,
+     * pairwise ciphers and AKMs. The fields at the end are optional and
+     * have a default value. */
+    if (len < 2)
+        return NM_802_11_AP_SEC_NONE;
+    bytes += 2;
+    len -= 2;
+
+    if (!_ie_suite_get(&bytes, &len, &s_oui, &s_type)) {
+        s_oui  = oui;
+        s_type = (oui == RSN_OUI) ? 4 : 2;
+    }
+    flags = _ie_cipher_to_flags(s_oui, s_type, oui, TRUE);
+
+    if (!_ie_suite_count_get(&bytes, &len, &n))
+        flags |= _ie_cipher_to_flags(oui, (oui == RSN_OUI) ? 4 : 2, oui, FALSE);
+    else {
+        for (; n > 0; n--) {
+            if (!_ie_suite_get(&bytes, &len, &s_oui, &s_type))
+                return flags;
+            flags |= _ie_cipher_to_flags(s_oui, s_type, oui, FALSE);
+        }
+    }
+
+    if (!_ie_suite_count_get(&bytes, &len, &n))
+        flags |= _ie_akm_to_flags(oui, 1, oui);
+    else {
+        for (; n > 0; n--) {
+            if (!_ie_suite_get(&bytes, &len, &s_oui, &s_type))
+                return flags;
+            flags |= _ie_akm_to_flags(s_oui, s_type, oui);
+        }
+    }
+
+    return flags;
+}
+
+/**
+ * nm_wifi_utils_parse_ies_security:
+ * @bytes: the information elements
+ * @len: the length of @bytes
+ * @out_wpa_flags: (out): the flags from the WPA element
+ * @out_rsn_flags: (out): the flags from the RSN element
+ *
+ * Parses the security flags from the WPA and RSN elements, like
+ * wpa_supplicant reports them on D-Bus.
+ */
+void
+nm_wifi_utils_parse_ies_security(const guint8           *bytes,
+                                 gsize                   len,
+                                 NM80211ApSecurityFlags *out_wpa_flags,
+                                 NM80211ApSecurityFlags *out_rsn_flags)
+{
+    guint8 id, elem_len;
+
+    NM_SET_OUT(out_wpa_flags, NM_802_11_AP_SEC_NONE);
+    NM_SET_OUT(out_rsn_flags, NM_802_11_AP_SEC_NONE);
+
+    while (len >= 2) {
+        id       = *bytes++;
+        elem_len = *bytes++;
+        len -= 2;
+
+        if (elem_len > len)
+            break;
+
+        if (id == WLAN_EID_RSN)
+            NM_SET_OUT(out_rsn_flags, _ie_parse_wpa_rsn(bytes, elem_len, RSN_OUI));
+        else if (id == WLAN_EID_VENDOR_SPECIFIC && elem_len >= 4 && bytes[0] == 0x00
+                 && bytes[1] == 0x50 && bytes[2] == 0xf2
+                 && bytes[3] == 0x01) /* OUI: Microsoft, type: WPA */
+            NM_SET_OUT(out_wpa_flags, _ie_parse_wpa_rsn(bytes + 4, elem_len - 4, WPA_OUI));
+
+        len -= elem_len;
+        bytes += elem_len;
+    }
+}
+
+/**
+ * nm_wifi_utils_parse_ies_legacy_rate:
+ * @bytes: the information elements
+ * @len: the length of @bytes
+ *
+ * Returns: the highest rate in bit/s from the (extended) supported rates elements.
+ */
+guint32
+nm_wifi_utils_parse_ies_legacy_rate(const guint8 *bytes, gsize len)
+{
+    guint32 max_rate = 0;
+    guint8  id, elem_len;
+    guint   i;
+
+    while (len >= 2) {
+        id       = *bytes++;
+        elem_len = *bytes++;
+        len -= 2;
+
+        if (elem_len > len)
+            break;
+
+        if (NM_IN_SET(id, WLAN_EID_SUPP_RATES, WLAN_EID_EXT_SUPP_RATES)) {
+            /* in units of 500 kbit/s. The highest bit marks basic rates. */
+            for (i = 0; i < elem_len; i++)
+                max_rate = NM_MAX(max_rate, (bytes[i] & 0x7Fu) * 500000u);
+        }
+
+        len -= elem_len;
+        bytes += elem_len;
+    }
+
+    return max_rate;
+}
+
+#define WPS_ATTR_DEV_PASSWORD_ID   0x1012u
+#define WPS_ATTR_SELECTED_REGISTRAR 0x1041u
+#define WPS_DEV_PW_PUSHBUTTON       0x0004u
+
+/**
+ * nm_wifi_utils_parse_ies_wps:
+ * @bytes: the information elements
+ * @len: the length of @bytes
+ *
+ * Parses the WPS element, like wpa_supplicant does for the "WPS" property
+ * of the BSS on D-Bus. While a registrar is selected, the mode is reported
+ * as push button or PIN.
+ *
+ * Returns: the WPS flags of #NM80211ApFlags.
+ */
+NM80211ApFlags
+nm_wifi_utils_parse_ies_wps(const guint8 *bytes, gsize len)
+{
+    nm_auto_unref_bytearray GByteArray *wps                = NULL;
+    gboolean                            selected_registrar = FALSE;
+    int                                 dev_password_id    = -1;
+    const guint8                       *attr;
+    gsize                               attr_len;
+    guint8                              id, elem_len;
+
+    /* the WPS element might be split across several vendor specific elements.
+     * The attributes continue in the next one. */
+    while (len >= 2) {
+        id       = *bytes++;
+        elem_len = *bytes++;
+        len -= 2;
+
+        if (elem_len > len)
+            break;
+
+        if (id == WLAN_EID_VENDOR_SPECIFIC && elem_len >= 4 && bytes[0] == 0x00
+            && bytes[1] == 0x50 && bytes[2] == 0xf2
+            && bytes[3] == 0x04) { /* OUI: Microsoft, type: WPS */
+            if (!wps)
+                wps = g_byte_array_new();
+            g_byte_array_append(wps, bytes + 4, elem_len - 4);
+        }
+
+        len -= elem_len;
+        bytes += elem_len;
+    }
+
+    if (!wps)
+        return NM_802_11_AP_FLAGS_NONE;
+
+    attr     = wps->data;
+    attr_len = wps->len;
+    while (attr_len >= 4) {
+        guint16 attr_type = unaligned_read_be16(&attr[0]);
+        guint16 attr_size = unaligned_read_be16(&attr[2]);
+
+        attr += 4;
+        attr_len -= 4;
+        if (attr_size > attr_len)
+            break;
+
+        if (attr_type == WPS_ATTR_SELECTED_REGISTRAR && attr_size >= 1)
+            selected_registrar = (attr[0] != 0);
+        else if (attr_type == WPS_ATTR_DEV_PASSWORD_ID && attr_size >= 2)
+            dev_password_id = unaligned_read_be16(attr);
+
+        attr += attr_size;
+        attr_len -= attr_size;
+    }
+
+    if (!selected_registrar)
+        return NM_802_11_AP_FLAGS_WPS;
+    if (dev_password_id == WPS_DEV_PW_PUSHBUTTON)
+        return NM_802_11_AP_FLAGS_WPS | NM_802_11_AP_FLAGS_WPS_PBC;
+    return NM_802_11_AP_FLAGS_WPS | NM_802_11_AP_FLAGS_WPS_PIN;
+}
+
 /*****************************************************************************/
 
 guint8
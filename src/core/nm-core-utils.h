@@ -207,6 +207,18 @@ typedef struct _NMMatchSpecDeviceData {
 
 NMMatchSpecMatchType nm_match_spec_device(const GSList *specs, const NMMatchSpecDeviceData *data);
 
+typedef struct _NMMatchSpecDevice NMMatchSpecDevice;
+
+NMMatchSpecDevice   *nm_match_spec_device_compile(const GSList *specs);
+void                 nm_match_spec_device_free(NMMatchSpecDevice *self);
+NMMatchSpecMatchType nm_match_spec_device_match(const NMMatchSpecDevice     *self,
+                                                const NMMatchSpecDeviceData *data);
+
+NM_AUTO_DEFINE_FCN0(NMMatchSpecDevice *,
+                    _nm_auto_free_match_spec_device,
+                    nm_match_spec_device_free);
+#define nm_auto_free_match_spec_device nm_auto(_nm_auto_free_match_spec_device)
+
 NMMatchSpecMatchType nm_match_spec_config(const GSList *specs, guint nm_version, const char *env);
 GSList              *nm_match_spec_split(const char *value);
 char                *nm_match_spec_join(GSList *specs);
@@ -466,6 +478,17 @@ void nm_wifi_utils_parse_ies(const guint8 *bytes,
                              gboolean     *out_metered,
                              gboolean     *out_owe_transition_mode);
 
+const guint8 *nm_wifi_utils_ies_find(const guint8 *bytes, gsize len, guint8 eid, gsize *out_len);
+
+void nm_wifi_utils_parse_ies_security(const guint8           *bytes,
+                                      gsize                   len,
+                                      NM80211ApSecurityFlags *out_wpa_flags,
+                                      NM80211ApSecurityFlags *out_rsn_flags);
+
+guint32 nm_wifi_utils_parse_ies_legacy_rate(const guint8 *bytes, gsize len);
+
+NM80211ApFlags nm_wifi_utils_parse_ies_wps(const guint8 *bytes, gsize len);
+
 guint8 nm_wifi_utils_level_to_quality(int val);
 
 /*****************************************************************************/
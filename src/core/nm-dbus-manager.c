@@ -20,6 +20,7 @@
 #include "nm-dbus-object.h"
 #include "NetworkManagerUtils.h"
 #include "libnm-core-aux-intern/nm-auth-subject.h"
+#include "nm-config.h"
 
 /* The base path for our GDBusObjectManagerServers.  They do not contain
  * "NetworkManager" because GDBusObjectManagerServer requires that all
@@ -43,6 +44,9 @@ typedef struct {
 
 typedef struct {
     GVariant *value;
+
+    /* whether the property changed since the last PropertiesChanged signal. */
+    bool changed : 1;
 } PropertyCacheData;
 
 typedef struct {
@@ -51,7 +55,19 @@ typedef struct {
     NMDBusObjectClass *klass;
     guint              info_idx;
     guint              registration_id;
-    PropertyCacheData  property_cache[];
+
+    /* The a{sv} dictionary with all properties of the interface, as used by
+     * GetManagedObjects() and InterfacesAdded. Like @property_cache, it is
+     * only invalidated by _nm_dbus_manager_obj_notify(). */
+    GVariant *properties;
+
+    /* the time of the last PropertiesChanged signal for the interface,
+     * for rate limiting. */
+    gint64 properties_changed_last_msec;
+
+    bool properties_changed_pending : 1;
+
+    PropertyCacheData property_cache[];
 } RegistrationData;
 
 /* we require that @path is the first member of NMDBusManagerData
@@ -80,6 +96,26 @@ typedef struct {
 
     CList caller_info_lst_head;
 
+    NMConfig *config;
+
+    /* interface name -> minimum interval in msec between two PropertiesChanged
+     * signals for that interface of an object. */
+    GHashTable *properties_changed_ratelimit;
+
+    /* the objects with pending PropertiesChanged signals. */
+    CList properties_changed_lst_head;
+
+    struct {
+        guint64 n_emitted;
+        guint64 n_suppressed;
+    } properties_changed_stats;
+
+    guint properties_changed_delay_msec;
+
+    /* the number of method calls that did not return yet. While there are
+     * any, PropertiesChanged signals are not delayed. */
+    guint n_method_calls_pending;
+
     guint objmgr_registration_id;
     bool  started : 1;
     bool  shutting_down : 1;
@@ -112,6 +148,9 @@ static const GDBusSignalInfo    signal_info_objmgr_interfaces_added;
 static const GDBusSignalInfo    signal_info_objmgr_interfaces_removed;
 static GVariantBuilder *_obj_collect_properties_all(NMDBusObject *obj, GVariantBuilder *builder);
 
+static void _obj_properties_changed_flush(NMDBusManager *self, NMDBusObject *obj, gboolean force);
+static void _properties_changed_flush_all(NMDBusManager *self);
+
 /*****************************************************************************/
 
 static guint
@@ -762,6 +801,32 @@ _reg_data_get_interface_info(RegistrationData *reg_data)
 
 /*****************************************************************************/
 
+static void
+_method_call_done_cb(gpointer user_data, GObject *invocation)
+{
+    NMDBusManager        *self = user_data;
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+
+    nm_assert(priv->n_method_calls_pending > 0);
+    priv->n_method_calls_pending--;
+    g_object_unref(self);
+}
+
+static void
+_method_call_start(NMDBusManager *self, GDBusMethodInvocation *invocation)
+{
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+
+    /* A client expects the PropertiesChanged signals for the changes that
+     * happened before the reply to arrive before the reply. Emit the pending
+     * signals now, and don't delay signals until the invocation is gone. That
+     * happens after the reply was sent. */
+    _properties_changed_flush_all(self);
+
+    priv->n_method_calls_pending++;
+    g_object_weak_ref(G_OBJECT(invocation), _method_call_done_cb, g_object_ref(self));
+}
+
 static void
 dbus_vtable_method_call(GDBusConnection       *connection,
                         const char            *sender,
@@ -780,6 +845,8 @@ dbus_vtable_method_call(GDBusConnection       *connection,
     const NMDBusMethodInfoExtended    *method_info    = NULL;
     gboolean                           on_same_interface;
 
+    _method_call_start(nm_dbus_object_get_manager(obj), invocation);
+
     on_same_interface = nm_streq(interface_info->parent.name, interface_name);
 
     /* handle property setter first... */
@@ -860,23 +927,19 @@ dbus_vtable_method_call(GDBusConnection       *connection,
 }
 
 static GVariant *
-_obj_get_property(RegistrationData *reg_data, guint property_idx, gboolean refetch)
+_obj_get_property(RegistrationData *reg_data, guint property_idx)
 {
     const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info(reg_data);
     const NMDBusPropertyInfoExtended  *property_info;
     GVariant                          *value;
 
+    value = reg_data->property_cache[property_idx].value;
+    if (value)
+        goto out;
+
     property_info =
         (const NMDBusPropertyInfoExtended *) (interface_info->parent.properties[property_idx]);
 
-    if (refetch)
-        nm_clear_g_variant(&reg_data->property_cache[property_idx].value);
-    else {
-        value = reg_data->property_cache[property_idx].value;
-        if (value)
-            goto out;
-    }
-
     value = nm_dbus_utils_get_property(G_OBJECT(reg_data->obj),
                                        property_info->parent.signature,
                                        property_info->property_name);
@@ -903,7 +966,7 @@ dbus_vtable_get_property(GDBusConnection *connection,
                                                       &property_idx))
         g_return_val_if_reached(NULL);
 
-    return _obj_get_property(reg_data, property_idx, FALSE);
+    return _obj_get_property(reg_data, property_idx);
 }
 
 static const GDBusInterfaceVTable dbus_vtable = {
@@ -1029,6 +1092,9 @@ _obj_unregister(NMDBusManager *self, NMDBusObject *obj)
     nm_assert(priv->started);
     nm_assert(!c_list_is_empty(&obj->internal.registration_lst_head));
 
+    /* Don't lose property changes that are still waiting for their signal. */
+    _obj_properties_changed_flush(self, obj, TRUE);
+
     g_variant_builder_init(&builder, G_VARIANT_TYPE("as"));
 
     while ((reg_data = c_list_last_entry(&obj->internal.registration_lst_head,
@@ -1043,6 +1109,7 @@ _obj_unregister(NMDBusManager *self, NMDBusObject *obj)
                                                  reg_data->registration_id))
             nm_assert_not_reached();
 
+        nm_clear_g_variant(&reg_data->properties);
         if (interface_info->parent.properties) {
             for (i = 0; interface_info->parent.properties[i]; i++)
                 nm_clear_g_variant(&reg_data->property_cache[i].value);
@@ -1061,6 +1128,77 @@ _obj_unregister(NMDBusManager *self, NMDBusObject *obj)
                                   NULL);
 }
 
+static void
+_properties_changed_config_update(NMDBusManager *self, const NMConfigData *config_data)
+{
+    NMDBusManagerPrivate *priv  = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    gs_free char         *value = NULL;
+    gs_free const char  **strv  = NULL;
+    gsize                 i;
+
+    priv->properties_changed_delay_msec =
+        nm_config_data_get_value_int64(config_data,
+                                       NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                       NM_CONFIG_KEYFILE_KEY_MAIN_PROPERTIES_CHANGED_DELAY,
+                                       10,
+                                       0,
+                                       10000,
+                                       0);
+
+    nm_clear_pointer(&priv->properties_changed_ratelimit, g_hash_table_unref);
+
+    value = nm_config_data_get_value(config_data,
+                                     NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                     NM_CONFIG_KEYFILE_KEY_MAIN_PROPERTIES_CHANGED_RATELIMIT,
+                                     NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
+
+    strv = nm_strsplit_set(value, ", \t");
+    for (i = 0; strv && strv[i]; i++) {
+        const char *sep = strrchr(strv[i], ':');
+        gint64      msec;
+
+        msec = sep ? _nm_utils_ascii_str_to_int64(&sep[1], 10, 1, 3600000, -1) : -1;
+        if (msec < 0 || sep == strv[i]) {
+            _LOGW("config: invalid value '%s' for main.%s",
+                  strv[i],
+                  NM_CONFIG_KEYFILE_KEY_MAIN_PROPERTIES_CHANGED_RATELIMIT);
+            continue;
+        }
+
+        if (!priv->properties_changed_ratelimit) {
+            priv->properties_changed_ratelimit =
+                g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+        }
+        g_hash_table_insert(priv->properties_changed_ratelimit,
+                            g_strndup(strv[i], sep - strv[i]),
+                            GUINT_TO_POINTER((guint) msec));
+    }
+}
+
+static void
+_properties_changed_log_stats(NMDBusManager *self)
+{
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+
+    _LOGD("PropertiesChanged signals: %" G_GUINT64_FORMAT " emitted, %" G_GUINT64_FORMAT
+          " merged into pending signals",
+          priv->properties_changed_stats.n_emitted,
+          priv->properties_changed_stats.n_suppressed);
+}
+
+static void
+_config_changed_cb(NMConfig           *config,
+                   NMConfigData       *config_data,
+                   NMConfigChangeFlags changes,
+                   NMConfigData       *old_data,
+                   NMDBusManager      *self)
+{
+    _properties_changed_log_stats(self);
+    _properties_changed_config_update(self, config_data);
+}
+
+/*****************************************************************************/
+
 gpointer
 nm_dbus_manager_lookup_object(NMDBusManager *self, const char *path)
 {
@@ -1147,12 +1285,141 @@ _nm_dbus_manager_obj_unexport(NMDBusObject *obj)
     c_list_unlink(&obj->internal.objects_lst);
 }
 
+static void
+_obj_emit_properties_changed(NMDBusManager    *self,
+                             NMDBusObject     *obj,
+                             RegistrationData *reg_data,
+                             gint64            now_msec)
+{
+    NMDBusManagerPrivate              *priv           = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info(reg_data);
+    GVariantBuilder                    builder;
+    GVariantBuilder                    invalidated_builder;
+    guint                              i;
+
+    nm_assert(reg_data->properties_changed_pending);
+    nm_assert(interface_info->parent.properties);
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+    for (i = 0; interface_info->parent.properties[i]; i++) {
+        gs_unref_variant GVariant *value = NULL;
+
+        if (!reg_data->property_cache[i].changed)
+            continue;
+
+        reg_data->property_cache[i].changed = FALSE;
+
+        value = _obj_get_property(reg_data, i);
+        g_variant_builder_add(&builder,
+                              "{sv}",
+                              interface_info->parent.properties[i]->name,
+                              value);
+    }
+
+    reg_data->properties_changed_pending   = FALSE;
+    reg_data->properties_changed_last_msec = now_msec;
+    priv->properties_changed_stats.n_emitted++;
+
+    g_variant_builder_init(&invalidated_builder, G_VARIANT_TYPE("as"));
+    g_dbus_connection_emit_signal(
+        priv->main_dbus_connection,
+        NULL,
+        obj->internal.path,
+        DBUS_INTERFACE_PROPERTIES,
+        "PropertiesChanged",
+        g_variant_new("(sa{sv}as)", interface_info->parent.name, &builder, &invalidated_builder),
+        NULL);
+}
+
+static gboolean
+_obj_properties_changed_timeout_cb(gpointer user_data)
+{
+    NMDBusObject *obj = user_data;
+
+    _obj_properties_changed_flush(obj->internal.bus_manager, obj, FALSE);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_obj_properties_changed_schedule(NMDBusObject *obj, gint64 timeout_msec)
+{
+    GSource *source = obj->internal.properties_changed_source;
+
+    if (source
+        && g_source_get_ready_time(source)
+               <= g_get_monotonic_time()
+                      + (timeout_msec * (NM_UTILS_USEC_PER_SEC / NM_UTILS_MSEC_PER_SEC))) {
+        /* the pending timeout expires early enough. */
+        return;
+    }
+
+    nm_clear_g_source_inst(&obj->internal.properties_changed_source);
+    obj->internal.properties_changed_source =
+        nm_g_timeout_add_source(timeout_msec, _obj_properties_changed_timeout_cb, obj);
+}
+
+static void
+_obj_properties_changed_flush(NMDBusManager *self, NMDBusObject *obj, gboolean force)
+{
+    NMDBusManagerPrivate *priv        = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    gint64                now_msec    = nm_utils_get_monotonic_timestamp_msec();
+    gint64                expiry_msec = 0;
+    RegistrationData     *reg_data;
+
+    nm_clear_g_source_inst(&obj->internal.properties_changed_source);
+
+    c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
+        guint ratelimit_msec = 0;
+
+        if (!reg_data->properties_changed_pending)
+            continue;
+
+        if (!force && priv->properties_changed_ratelimit) {
+            ratelimit_msec = GPOINTER_TO_UINT(
+                g_hash_table_lookup(priv->properties_changed_ratelimit,
+                                    _reg_data_get_interface_info(reg_data)->parent.name));
+        }
+
+        if (ratelimit_msec > 0 && reg_data->properties_changed_last_msec != 0
+            && now_msec < reg_data->properties_changed_last_msec + ratelimit_msec) {
+            gint64 e = reg_data->properties_changed_last_msec + ratelimit_msec;
+
+            expiry_msec = expiry_msec == 0 ? e : NM_MIN(expiry_msec, e);
+            continue;
+        }
+
+        _obj_emit_properties_changed(self, obj, reg_data, now_msec);
+    }
+
+    if (expiry_msec != 0)
+        _obj_properties_changed_schedule(obj, expiry_msec - now_msec);
+    else
+        c_list_unlink(&obj->internal.properties_changed_lst);
+}
+
+static void
+_properties_changed_flush_all(NMDBusManager *self)
+{
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    NMDBusObject         *obj;
+    NMDBusObject         *obj_safe;
+
+    c_list_for_each_entry_safe (obj,
+                                obj_safe,
+                                &priv->properties_changed_lst_head,
+                                internal.properties_changed_lst)
+        _obj_properties_changed_flush(self, obj, TRUE);
+
+    nm_assert(c_list_is_empty(&priv->properties_changed_lst_head));
+}
+
 void
 _nm_dbus_manager_obj_notify(NMDBusObject *obj, guint n_pspecs, const GParamSpec *const *pspecs)
 {
     NMDBusManager        *self;
     NMDBusManagerPrivate *priv;
     RegistrationData     *reg_data;
+    gboolean              has_pending = FALSE;
     guint                 i, p;
 
     nm_assert(NM_IS_DBUS_OBJECT(obj));
@@ -1180,9 +1447,6 @@ _nm_dbus_manager_obj_notify(NMDBusObject *obj, guint n_pspecs, const GParamSpec
     c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
         const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info(reg_data);
         gboolean                           has_properties = FALSE;
-        GVariantBuilder                    builder;
-        GVariantBuilder                    invalidated_builder;
-        GVariant                          *args;
 
         if (!interface_info->parent.properties)
             continue;
@@ -1192,37 +1456,42 @@ _nm_dbus_manager_obj_notify(NMDBusObject *obj, guint n_pspecs, const GParamSpec
                 (const NMDBusPropertyInfoExtended *) interface_info->parent.properties[i];
 
             for (p = 0; p < n_pspecs; p++) {
-                const GParamSpec          *pspec = pspecs[p];
-                gs_unref_variant GVariant *value = NULL;
-
-                if (!nm_streq(property_info->property_name, pspec->name))
+                if (!nm_streq(property_info->property_name, pspecs[p]->name))
                     continue;
 
-                value = _obj_get_property(reg_data, i, TRUE);
-
-                if (!has_properties) {
-                    has_properties = TRUE;
-                    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
-                }
-                g_variant_builder_add(&builder, "{sv}", property_info->parent.name, value);
+                /* The value is fetched anew when it's needed. That is, at the
+                 * latest when emitting the PropertiesChanged signal. */
+                nm_clear_g_variant(&reg_data->property_cache[i].value);
+                reg_data->property_cache[i].changed = TRUE;
+                has_properties                      = TRUE;
             }
         }
 
         if (!has_properties)
             continue;
 
-        args = g_variant_builder_end(&builder);
-
-        g_variant_builder_init(&invalidated_builder, G_VARIANT_TYPE("as"));
-        g_dbus_connection_emit_signal(
-            priv->main_dbus_connection,
-            NULL,
-            obj->internal.path,
-            DBUS_INTERFACE_PROPERTIES,
-            "PropertiesChanged",
-            g_variant_new("(s@a{sv}as)", interface_info->parent.name, args, &invalidated_builder),
-            NULL);
+        nm_clear_g_variant(&reg_data->properties);
+
+        if (reg_data->properties_changed_pending) {
+            /* merged into the signal that is already pending. */
+            priv->properties_changed_stats.n_suppressed++;
+        }
+        reg_data->properties_changed_pending = TRUE;
+        has_pending                          = TRUE;
     }
+
+    if (!has_pending)
+        return;
+
+    if (c_list_is_empty(&obj->internal.properties_changed_lst))
+        c_list_link_tail(&priv->properties_changed_lst_head, &obj->internal.properties_changed_lst);
+
+    if (priv->n_method_calls_pending > 0)
+        _obj_properties_changed_flush(self, obj, TRUE);
+    else if (priv->properties_changed_delay_msec == 0)
+        _obj_properties_changed_flush(self, obj, FALSE);
+    else
+        _obj_properties_changed_schedule(obj, priv->properties_changed_delay_msec);
 }
 
 void
@@ -1247,6 +1516,11 @@ _nm_dbus_manager_obj_emit_signal(NMDBusObject                      *obj,
         return;
     }
 
+    /* Signals must not overtake the PropertiesChanged signals for changes that
+     * happened before. That also applies to the changes of other objects, for
+     * example, the properties of a device before the DeviceAdded signal. */
+    _properties_changed_flush_all(self);
+
     g_dbus_connection_emit_signal(priv->main_dbus_connection,
                                   NULL,
                                   obj->internal.path,
@@ -1258,26 +1532,31 @@ _nm_dbus_manager_obj_emit_signal(NMDBusObject                      *obj,
 
 /*****************************************************************************/
 
-static GVariantBuilder *
-_obj_collect_properties_per_interface(NMDBusObject     *obj,
-                                      RegistrationData *reg_data,
-                                      GVariantBuilder  *builder)
+static GVariant *
+_obj_collect_properties_per_interface(NMDBusObject *obj, RegistrationData *reg_data)
 {
-    const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info(reg_data);
+    const NMDBusInterfaceInfoExtended *interface_info;
+    GVariantBuilder                    builder;
     guint                              i;
 
-    g_variant_builder_init(builder, G_VARIANT_TYPE("a{sv}"));
+    if (reg_data->properties)
+        return reg_data->properties;
+
+    interface_info = _reg_data_get_interface_info(reg_data);
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
     if (interface_info->parent.properties) {
         for (i = 0; interface_info->parent.properties[i]; i++) {
             const NMDBusPropertyInfoExtended *property_info =
                 (const NMDBusPropertyInfoExtended *) interface_info->parent.properties[i];
             gs_unref_variant GVariant *variant = NULL;
 
-            variant = _obj_get_property(reg_data, i, FALSE);
-            g_variant_builder_add(builder, "{sv}", property_info->parent.name, variant);
+            variant = _obj_get_property(reg_data, i);
+            g_variant_builder_add(&builder, "{sv}", property_info->parent.name, variant);
         }
     }
-    return builder;
+    reg_data->properties = g_variant_ref_sink(g_variant_builder_end(&builder));
+    return reg_data->properties;
 }
 
 static GVariantBuilder *
@@ -1288,13 +1567,10 @@ _obj_collect_properties_all(NMDBusObject *obj, GVariantBuilder *builder)
     g_variant_builder_init(builder, G_VARIANT_TYPE("a{sa{sv}}"));
 
     c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
-        GVariantBuilder properties_builder;
-
-        g_variant_builder_add(
-            builder,
-            "{sa{sv}}",
-            _reg_data_get_interface_info(reg_data)->parent.name,
-            _obj_collect_properties_per_interface(obj, reg_data, &properties_builder));
+        g_variant_builder_add(builder,
+                              "{s@a{sv}}",
+                              _reg_data_get_interface_info(reg_data)->parent.name,
+                              _obj_collect_properties_per_interface(obj, reg_data));
     }
 
     return builder;
@@ -1405,6 +1681,13 @@ nm_dbus_manager_start(NMDBusManager                  *self,
     priv->set_property_handler_data = set_property_handler_data;
     priv->started                   = TRUE;
 
+    priv->config = g_object_ref(nm_config_get());
+    g_signal_connect(priv->config,
+                     NM_CONFIG_SIGNAL_CONFIG_CHANGED,
+                     G_CALLBACK(_config_changed_cb),
+                     self);
+    _properties_changed_config_update(self, nm_config_get_data(priv->config));
+
     c_list_for_each_entry (obj, &priv->objects_lst_head, internal.objects_lst)
         _obj_register(self, obj);
 }
@@ -1461,12 +1744,40 @@ nm_dbus_manager_request_name_sync(NMDBusManager *self)
     return TRUE;
 }
 
+static gboolean
+_setup_objmgr(NMDBusManager *self)
+{
+    NMDBusManagerPrivate *priv  = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    gs_free_error GError *error = NULL;
+    guint                 registration_id;
+
+    g_dbus_connection_set_exit_on_close(priv->main_dbus_connection, FALSE);
+
+    registration_id = g_dbus_connection_register_object(
+        priv->main_dbus_connection,
+        OBJECT_MANAGER_SERVER_BASE_PATH,
+        NM_UNCONST_PTR(GDBusInterfaceInfo, &interface_info_objmgr),
+        &dbus_vtable_objmgr,
+        self,
+        NULL,
+        &error);
+    if (!registration_id) {
+        _LOGE("failure to register object manager: %s", error->message);
+        return FALSE;
+    }
+
+    priv->objmgr_registration_id = registration_id;
+
+    _LOGD("D-Bus connection created and ObjectManager object registered");
+
+    return TRUE;
+}
+
 gboolean
 nm_dbus_manager_setup(NMDBusManager *self)
 {
     NMDBusManagerPrivate *priv;
     gs_free_error GError *error = NULL;
-    guint                 registration_id;
 
     g_return_val_if_fail(NM_IS_DBUS_MANAGER(self), FALSE);
 
@@ -1485,26 +1796,25 @@ nm_dbus_manager_setup(NMDBusManager *self)
         return FALSE;
     }
 
-    g_dbus_connection_set_exit_on_close(priv->main_dbus_connection, FALSE);
+    return _setup_objmgr(self);
+}
 
-    registration_id = g_dbus_connection_register_object(
-        priv->main_dbus_connection,
-        OBJECT_MANAGER_SERVER_BASE_PATH,
-        NM_UNCONST_PTR(GDBusInterfaceInfo, &interface_info_objmgr),
-        &dbus_vtable_objmgr,
-        self,
-        NULL,
-        &error);
-    if (!registration_id) {
-        _LOGE("failure to register object manager: %s", error->message);
-        return FALSE;
-    }
+/* Like nm_dbus_manager_setup(), but uses @connection, for example one end
+ * of a peer-to-peer connection in a unit test. */
+gboolean
+nmtst_dbus_manager_setup(NMDBusManager *self, GDBusConnection *connection)
+{
+    NMDBusManagerPrivate *priv;
 
-    priv->objmgr_registration_id = registration_id;
+    g_return_val_if_fail(NM_IS_DBUS_MANAGER(self), FALSE);
+    g_return_val_if_fail(G_IS_DBUS_CONNECTION(connection), FALSE);
 
-    _LOGD("D-Bus connection created and ObjectManager object registered");
+    priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
 
-    return TRUE;
+    g_return_val_if_fail(!priv->main_dbus_connection, FALSE);
+
+    priv->main_dbus_connection = g_object_ref(connection);
+    return _setup_objmgr(self);
 }
 
 void
@@ -1514,6 +1824,8 @@ nm_dbus_manager_stop(NMDBusManager *self)
 
     priv->shutting_down = TRUE;
 
+    _properties_changed_log_stats(self);
+
     /* during shutdown we also clear the set-property-handler. It's no longer
      * possible to set a property, because doing so would require authorization,
      * which is async, which is just complicated to get right. No more property
@@ -1537,6 +1849,7 @@ nm_dbus_manager_init(NMDBusManager *self)
 
     c_list_init(&priv->private_servers_lst_head);
     c_list_init(&priv->objects_lst_head);
+    c_list_init(&priv->properties_changed_lst_head);
 
     priv->objects_by_path =
         g_hash_table_new((GHashFunc) _objects_by_path_hash, (GEqualFunc) _objects_by_path_equal);
@@ -1569,6 +1882,12 @@ dispose(GObject *object)
 
     g_clear_object(&priv->main_dbus_connection);
 
+    if (priv->config) {
+        g_signal_handlers_disconnect_by_func(priv->config, _config_changed_cb, self);
+        g_clear_object(&priv->config);
+    }
+    nm_clear_pointer(&priv->properties_changed_ratelimit, g_hash_table_unref);
+
     G_OBJECT_CLASS(nm_dbus_manager_parent_class)->dispose(object);
 
     while ((caller_info =
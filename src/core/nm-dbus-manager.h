@@ -39,6 +39,8 @@ typedef void (*NMDBusManagerSetPropertyHandler)(NMDBusObject
 
 gboolean nm_dbus_manager_setup(NMDBusManager *self);
 
+gboolean nmtst_dbus_manager_setup(NMDBusManager *self, GDBusConnection *connection);
+
 gboolean nm_dbus_manager_request_name_sync(NMDBusManager *self);
 
 GDBusConnection *nm_dbus_manager_get_dbus_connection(NMDBusManager *self);
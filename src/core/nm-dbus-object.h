@@ -72,7 +72,14 @@ struct _NMDBusObjectInternal {
      * unexported, or even re-exported afterwards. If that happens, we want
      * to fail the request. For that, we keep track of a version id.  */
     guint64 export_version_id;
-    bool    is_unexporting : 1;
+
+    /* pending timeout for emitting coalesced PropertiesChanged signals. */
+    GSource *properties_changed_source;
+
+    /* linked while the object has PropertiesChanged signals pending. */
+    CList properties_changed_lst;
+
+    bool is_unexporting : 1;
 };
 
 struct _NMDBusObject {
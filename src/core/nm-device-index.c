@@ -0,0 +1,340 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "nm-device-index.h"
+
+/*****************************************************************************/
+
+typedef enum {
+    IDX_TYPE_IFINDEX,
+    IDX_TYPE_IFACE,
+    IDX_TYPE_IP_IFACE,
+    IDX_TYPE_PERM_HW_ADDR,
+    _IDX_TYPE_NUM,
+} IdxType;
+
+#define PERM_HW_ADDR_BUF_LEN (_NM_UTILS_HWADDR_LEN_MAX * 3u)
+
+typedef struct {
+    /* must be the first field, the entries are hashed by nm_pdirect_hash(). */
+    gpointer device;
+
+    /* The keys under which the device is currently indexed, or NULL.
+     * For IDX_TYPE_IFINDEX this is GINT_TO_POINTER(ifindex), otherwise
+     * a string owned by the entry. */
+    gpointer keys[_IDX_TYPE_NUM];
+
+    bool perm_hw_addr_unset : 1;
+} Entry;
+
+struct _NMDeviceIndex {
+    GHashTable *entries;
+
+    /* for each IdxType, a dictionary from the key to a GPtrArray with the
+     * devices that have the key. */
+    GHashTable *idx[_IDX_TYPE_NUM];
+
+    guint n_without_perm_hw_addr;
+};
+
+/*****************************************************************************/
+
+static const char *
+_perm_hw_addr_normalize(const char *hwaddr, char buf[static PERM_HW_ADDR_BUF_LEN])
+{
+    guint8 bin[_NM_UTILS_HWADDR_LEN_MAX];
+    gsize  len;
+
+    /* nm_utils_hwaddr_matches() considers two addresses equal if they have the
+     * same length and the same bytes, except that only the last 8 bytes of
+     * InfiniBand addresses are compared. Use the canonical string representation
+     * with the other bytes of InfiniBand addresses cleared as key. */
+    if (!hwaddr || !_nm_utils_hwaddr_aton(hwaddr, bin, sizeof(bin), &len) || len == 0)
+        return NULL;
+    if (len == INFINIBAND_ALEN)
+        memset(bin, 0, INFINIBAND_ALEN - 8);
+    return _nm_utils_hwaddr_ntoa(bin, len, TRUE, buf, PERM_HW_ADDR_BUF_LEN);
+}
+
+static gboolean
+_key_equal(IdxType idx_type, gconstpointer key_a, gconstpointer key_b)
+{
+    if (idx_type == IDX_TYPE_IFINDEX)
+        return key_a == key_b;
+    return nm_streq0(key_a, key_b);
+}
+
+static gpointer const *
+_idx_lookup(const NMDeviceIndex *self, IdxType idx_type, gconstpointer key, guint *out_len)
+{
+    GPtrArray *devices;
+
+    if (!key) {
+        NM_SET_OUT(out_len, 0);
+        return NULL;
+    }
+
+    devices = g_hash_table_lookup(self->idx[idx_type], key);
+    if (!devices) {
+        NM_SET_OUT(out_len, 0);
+        return NULL;
+    }
+
+    nm_assert(devices->len > 0);
+    NM_SET_OUT(out_len, devices->len);
+    return devices->pdata;
+}
+
+static void
+_idx_add(NMDeviceIndex *self, IdxType idx_type, gconstpointer key, gpointer device)
+{
+    GPtrArray *devices;
+
+    if (!key)
+        return;
+
+    devices = g_hash_table_lookup(self->idx[idx_type], key);
+    if (!devices) {
+        devices = g_ptr_array_new();
+        g_hash_table_insert(self->idx[idx_type],
+                            idx_type == IDX_TYPE_IFINDEX ? (gpointer) key : g_strdup(key),
+                            devices);
+    }
+
+    nm_assert(!g_ptr_array_find(devices, device, NULL));
+    g_ptr_array_add(devices, device);
+}
+
+static void
+_idx_remove(NMDeviceIndex *self, IdxType idx_type, gconstpointer key, gpointer device)
+{
+    GPtrArray *devices;
+
+    if (!key)
+        return;
+
+    devices = g_hash_table_lookup(self->idx[idx_type], key);
+    if (!devices || !g_ptr_array_remove(devices, device))
+        nm_assert_not_reached();
+    else if (devices->len == 0)
+        g_hash_table_remove(self->idx[idx_type], key);
+}
+
+static void
+_entry_set_key(NMDeviceIndex *self, Entry *entry, IdxType idx_type, gconstpointer key)
+{
+    if (_key_equal(idx_type, entry->keys[idx_type], key))
+        return;
+
+    _idx_remove(self, idx_type, entry->keys[idx_type], entry->device);
+    if (idx_type != IDX_TYPE_IFINDEX) {
+        g_free(entry->keys[idx_type]);
+        entry->keys[idx_type] = g_strdup(key);
+    } else
+        entry->keys[idx_type] = (gpointer) key;
+    _idx_add(self, idx_type, entry->keys[idx_type], entry->device);
+}
+
+static void
+_entry_free(gpointer data)
+{
+    Entry *entry = data;
+    int    i;
+
+    for (i = IDX_TYPE_IFINDEX + 1; i < _IDX_TYPE_NUM; i++)
+        g_free(entry->keys[i]);
+    nm_g_slice_free(entry);
+}
+
+/*****************************************************************************/
+
+/**
+ * nm_device_index_update:
+ * @self: the #NMDeviceIndex
+ * @device: the device to add or update
+ * @ifindex: the ifindex of the device. Values <= 0 are not indexed.
+ * @iface: (nullable): the interface name of the device
+ * @ip_iface: (nullable): the IP interface name of the device
+ * @perm_hw_addr: (nullable): the permanent MAC address of the device,
+ *   or %NULL if it's not yet known. An address that cannot be parsed
+ *   is not indexed.
+ *
+ * Adds @device to the index, or updates the keys of @device if it
+ * is already indexed.
+ *
+ * Returns: %TRUE if @device was newly added.
+ */
+gboolean
+nm_device_index_update(NMDeviceIndex *self,
+                       gpointer       device,
+                       int            ifindex,
+                       const char    *iface,
+                       const char    *ip_iface,
+                       const char    *perm_hw_addr)
+{
+    char     perm_hw_addr_buf[PERM_HW_ADDR_BUF_LEN];
+    Entry   *entry;
+    gboolean added = FALSE;
+
+    g_return_val_if_fail(self, FALSE);
+    g_return_val_if_fail(device, FALSE);
+
+    entry = g_hash_table_lookup(self->entries, &device);
+    if (!entry) {
+        entry  = g_slice_new(Entry);
+        *entry = (Entry){
+            .device             = device,
+            .perm_hw_addr_unset = TRUE,
+        };
+        g_hash_table_add(self->entries, entry);
+        self->n_without_perm_hw_addr++;
+        added = TRUE;
+    }
+
+    _entry_set_key(self, entry, IDX_TYPE_IFINDEX, GINT_TO_POINTER(NM_MAX(ifindex, 0)));
+    _entry_set_key(self, entry, IDX_TYPE_IFACE, iface);
+    _entry_set_key(self, entry, IDX_TYPE_IP_IFACE, ip_iface);
+    _entry_set_key(self,
+                   entry,
+                   IDX_TYPE_PERM_HW_ADDR,
+                   _perm_hw_addr_normalize(perm_hw_addr, perm_hw_addr_buf));
+
+    if (entry->perm_hw_addr_unset != !perm_hw_addr) {
+        entry->perm_hw_addr_unset = !perm_hw_addr;
+        if (entry->perm_hw_addr_unset)
+            self->n_without_perm_hw_addr++;
+        else
+            self->n_without_perm_hw_addr--;
+    }
+
+    return added;
+}
+
+gboolean
+nm_device_index_remove(NMDeviceIndex *self, gpointer device)
+{
+    Entry *entry;
+    int    i;
+
+    g_return_val_if_fail(self, FALSE);
+
+    entry = g_hash_table_lookup(self->entries, &device);
+    if (!entry)
+        return FALSE;
+
+    for (i = 0; i < _IDX_TYPE_NUM; i++)
+        _idx_remove(self, i, entry->keys[i], device);
+    if (entry->perm_hw_addr_unset)
+        self->n_without_perm_hw_addr--;
+
+    g_hash_table_remove(self->entries, entry);
+    return TRUE;
+}
+
+gboolean
+nm_device_index_contains(const NMDeviceIndex *self, gconstpointer device)
+{
+    g_return_val_if_fail(self, FALSE);
+
+    return g_hash_table_contains(self->entries, &device);
+}
+
+guint
+nm_device_index_get_len(const NMDeviceIndex *self)
+{
+    g_return_val_if_fail(self, 0);
+
+    return g_hash_table_size(self->entries);
+}
+
+/**
+ * nm_device_index_get_n_without_perm_hw_addr:
+ * @self: the #NMDeviceIndex
+ *
+ * Returns: the number of devices that were indexed without a
+ *   permanent MAC address. A lookup by permanent MAC address may
+ *   miss these devices.
+ */
+guint
+nm_device_index_get_n_without_perm_hw_addr(const NMDeviceIndex *self)
+{
+    g_return_val_if_fail(self, 0);
+
+    return self->n_without_perm_hw_addr;
+}
+
+/*****************************************************************************/
+
+gpointer const *
+nm_device_index_lookup_ifindex(const NMDeviceIndex *self, int ifindex, guint *out_len)
+{
+    g_return_val_if_fail(self, NULL);
+
+    return _idx_lookup(self,
+                       IDX_TYPE_IFINDEX,
+                       ifindex > 0 ? GINT_TO_POINTER(ifindex) : NULL,
+                       out_len);
+}
+
+gpointer const *
+nm_device_index_lookup_iface(const NMDeviceIndex *self, const char *iface, guint *out_len)
+{
+    g_return_val_if_fail(self, NULL);
+
+    return _idx_lookup(self, IDX_TYPE_IFACE, iface, out_len);
+}
+
+gpointer const *
+nm_device_index_lookup_ip_iface(const NMDeviceIndex *self, const char *ip_iface, guint *out_len)
+{
+    g_return_val_if_fail(self, NULL);
+
+    return _idx_lookup(self, IDX_TYPE_IP_IFACE, ip_iface, out_len);
+}
+
+gpointer const *
+nm_device_index_lookup_perm_hw_addr(const NMDeviceIndex *self, const char *hwaddr, guint *out_len)
+{
+    char buf[PERM_HW_ADDR_BUF_LEN];
+
+    g_return_val_if_fail(self, NULL);
+
+    return _idx_lookup(self, IDX_TYPE_PERM_HW_ADDR, _perm_hw_addr_normalize(hwaddr, buf), out_len);
+}
+
+/*****************************************************************************/
+
+NMDeviceIndex *
+nm_device_index_new(void)
+{
+    NMDeviceIndex *self;
+    int            i;
+
+    self          = g_slice_new0(NMDeviceIndex);
+    self->entries = g_hash_table_new_full(nm_pdirect_hash, nm_pdirect_equal, _entry_free, NULL);
+
+    self->idx[IDX_TYPE_IFINDEX] =
+        g_hash_table_new_full(nm_direct_hash, NULL, NULL, (GDestroyNotify) g_ptr_array_unref);
+    for (i = IDX_TYPE_IFINDEX + 1; i < _IDX_TYPE_NUM; i++) {
+        self->idx[i] = g_hash_table_new_full(nm_str_hash,
+                                             g_str_equal,
+                                             g_free,
+                                             (GDestroyNotify) g_ptr_array_unref);
+    }
+    return self;
+}
+
+void
+nm_device_index_free(NMDeviceIndex *self)
+{
+    int i;
+
+    if (!self)
+        return;
+
+    g_hash_table_unref(self->entries);
+    for (i = 0; i < _IDX_TYPE_NUM; i++)
+        g_hash_table_unref(self->idx[i]);
+    nm_g_slice_free(self);
+}
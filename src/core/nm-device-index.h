@@ -0,0 +1,55 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __NM_DEVICE_INDEX_H__
+#define __NM_DEVICE_INDEX_H__
+
+/*****************************************************************************/
+
+/* NMDeviceIndex maps the lookup keys of devices (ifindex, interface name,
+ * IP interface name and permanent MAC address) to the devices that currently
+ * have them. The devices are opaque pointers that are never dereferenced,
+ * it's up to the user to call nm_device_index_update() whenever one of the
+ * keys of a device changes.
+ *
+ * The lookup functions return the devices with a key in the order in which
+ * they got that key. The returned array is only valid until the next
+ * modification of the index. */
+
+typedef struct _NMDeviceIndex NMDeviceIndex;
+
+NMDeviceIndex *nm_device_index_new(void);
+
+void nm_device_index_free(NMDeviceIndex *self);
+
+NM_AUTO_DEFINE_FCN0(NMDeviceIndex *, _nm_auto_free_device_index, nm_device_index_free);
+#define nm_auto_free_device_index nm_auto(_nm_auto_free_device_index)
+
+gboolean nm_device_index_update(NMDeviceIndex *self,
+                                gpointer       device,
+                                int            ifindex,
+                                const char    *iface,
+                                const char    *ip_iface,
+                                const char    *perm_hw_addr);
+
+gboolean nm_device_index_remove(NMDeviceIndex *self, gpointer device);
+
+gboolean nm_device_index_contains(const NMDeviceIndex *self, gconstpointer device);
+
+guint nm_device_index_get_len(const NMDeviceIndex *self);
+
+guint nm_device_index_get_n_without_perm_hw_addr(const NMDeviceIndex *self);
+
+gpointer const *
+nm_device_index_lookup_ifindex(const NMDeviceIndex *self, int ifindex, guint *out_len);
+
+gpointer const *
+nm_device_index_lookup_iface(const NMDeviceIndex *self, const char *iface, guint *out_len);
+
+gpointer const *
+nm_device_index_lookup_ip_iface(const NMDeviceIndex *self, const char *ip_iface, guint *out_len);
+
+gpointer const *nm_device_index_lookup_perm_hw_addr(const NMDeviceIndex *self,
+                                                    const char          *hwaddr,
+                                                    guint               *out_len);
+
+#endif /* __NM_DEVICE_INDEX_H__ */
@@ -472,7 +472,6 @@ static NM_UTILS_ENUM2STR_DEFINE(
     NML3ConfigNotifyType,
     NM_UTILS_ENUM2STR(NM_L3_CONFIG_NOTIFY_TYPE_ACD_EVENT, "acd-event"),
     NM_UTILS_ENUM2STR(NM_L3_CONFIG_NOTIFY_TYPE_IPV4LL_EVENT, "ipv4ll-event"),
-    NM_UTILS_ENUM2STR(NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE, "platform-change"),
     NM_UTILS_ENUM2STR(NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE, "platform-change-on-idle"),
     NM_UTILS_ENUM2STR(NM_L3_CONFIG_NOTIFY_TYPE_PRE_COMMIT, "pre-commit"),
     NM_UTILS_ENUM2STR(NM_L3_CONFIG_NOTIFY_TYPE_POST_COMMIT, "post-commit"),
@@ -645,20 +644,12 @@ _l3_config_notify_data_to_string(const NML3ConfigNotifyData *notify_data,
                          nm_inet4_ntop(notify_data->acd_event.info.addr, sbuf_addr),
                          _l3_acd_addr_state_to_string(notify_data->acd_event.info.state));
         break;
-    case NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE:
-        nm_strbuf_append(
-            &s,
-            &l,
-            ", obj-type=%s, change=%s, obj=",
-            NMP_OBJECT_GET_CLASS(notify_data->platform_change.obj)->obj_type_name,
-            nm_platform_signal_change_type_to_string(notify_data->platform_change.change_type));
-        nmp_object_to_string(notify_data->platform_change.obj, NMP_OBJECT_TO_STRING_PUBLIC, s, l);
-        break;
     case NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE:
         nm_strbuf_append(&s,
                          &l,
-                         ", obj-type-flags=0x%" G_GINT64_MODIFIER "x",
-                         notify_data->platform_change_on_idle.obj_type_flags);
+                         ", obj-type-flags=0x%" G_GINT64_MODIFIER "x, n-events=%u",
+                         notify_data->platform_change_on_idle.obj_type_flags,
+                         notify_data->platform_change_on_idle.n_events);
         break;
     case NM_L3_CONFIG_NOTIFY_TYPE_IPV4LL_EVENT:
         nm_assert(NM_IS_L3_IPV4LL(notify_data->ipv4ll_event.ipv4ll));
@@ -1604,7 +1595,7 @@ _load_link(NML3Cfg *self, gboolean initial)
 /*****************************************************************************/
 
 void
-_nm_l3cfg_notify_platform_change_on_idle(NML3Cfg *self, guint64 obj_type_flags)
+_nm_l3cfg_notify_platform_change_on_idle(NML3Cfg *self, guint64 obj_type_flags, guint n_events)
 {
     NML3ConfigNotifyData notify_data;
 
@@ -1614,19 +1605,24 @@ _nm_l3cfg_notify_platform_change_on_idle(NML3Cfg *self, guint64 obj_type_flags)
     notify_data.notify_type             = NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE;
     notify_data.platform_change_on_idle = (typeof(notify_data.platform_change_on_idle)) {
         .obj_type_flags = obj_type_flags,
+        .n_events       = n_events,
     };
     _nm_l3cfg_emit_signal_notify(self, &notify_data);
 
     _nm_l3cfg_emit_signal_notify_acd_event_all(self);
 }
 
+/* Called by NMNetns synchronously for each platform change. This only updates
+ * the state that must be in sync with the platform cache (the link object,
+ * ACD and the tracked object states). Subscribers get notified about the
+ * changes later, once per main loop iteration, via
+ * _nm_l3cfg_notify_platform_change_on_idle(). */
 void
 _nm_l3cfg_notify_platform_change(NML3Cfg                   *self,
                                  NMPlatformSignalChangeType change_type,
                                  const NMPObject           *obj)
 {
-    NML3ConfigNotifyData notify_data;
-    NMPObjectType        obj_type;
+    NMPObjectType obj_type;
 
     nm_assert(NMP_OBJECT_IS_VALID(obj));
 
@@ -1654,15 +1650,6 @@ _nm_l3cfg_notify_platform_change(NML3Cfg                   *self,
     default:
         break;
     }
-
-    notify_data.notify_type     = NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE;
-    notify_data.platform_change = (typeof(notify_data.platform_change)) {
-        .obj         = obj,
-        .change_type = change_type,
-    };
-    _nm_l3cfg_emit_signal_notify(self, &notify_data);
-
-    nm_assert(NMP_OBJECT_IS_VALID(obj));
 }
 
 /*****************************************************************************/
@@ -6013,6 +6000,8 @@ _l3_commit(NML3Cfg *self, NML3CfgCommitType commit_type, gboolean is_idle)
     if (commit_type <= NM_L3_CFG_COMMIT_TYPE_NONE)
         return;
 
+    _nm_netns_notify_l3cfg_commit(self->priv.netns);
+
     self->priv.p->commit_reentrant_count++;
 
     _l3cfg_update_combined_config(self,
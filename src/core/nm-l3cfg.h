@@ -139,17 +139,11 @@ typedef enum {
     NM_L3_CONFIG_NOTIFY_TYPE_POST_COMMIT,
 
     /* NML3Cfg hooks to the NMPlatform signals for link, addresses and routes.
-     * It re-emits the platform signal.
-     * Contrary to NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE, this even
-     * is re-emitted synchronously. You probably want to hook to the on-idle signal,
-     * unless you need to catch all intermediate changes too. Note that this
-     * event is not re-entrant safe (so beware what you are doing). */
-    NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE,
-
-    /* NML3Cfg hooks to the NMPlatform signals for link, addresses and routes.
-     * It re-emits the signal on an idle handler. The purpose is for something
-     * like NMDevice which is already subscribed to these signals, it can get the
-     * notifications without also subscribing directly to the platform. */
+     * NMNetns collects the changes for the interface during one main loop
+     * iteration, and they are then re-emitted on an idle handler as one change
+     * set. The purpose is for something like NMDevice which is already subscribed
+     * to these signals, it can get the notifications without also subscribing
+     * directly to the platform. */
     NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE,
 
     NM_L3_CONFIG_NOTIFY_TYPE_IPV4LL_EVENT,
@@ -173,12 +167,12 @@ typedef struct {
         } acd_event;
 
         struct {
-            const NMPObject           *obj;
-            NMPlatformSignalChangeType change_type;
-        } platform_change;
-
-        struct {
+            /* the NMPObjectType flags of the objects that changed. */
             guint64 obj_type_flags;
+
+            /* the number of platform events that were merged into this
+             * notification. */
+            guint n_events;
         } platform_change_on_idle;
 
         struct {
@@ -208,6 +202,7 @@ struct _NML3Cfg {
      * relevant to NMNetns here. */
     struct {
         guint64 signal_pending_obj_type_flags;
+        guint   signal_pending_n_events;
         CList   signal_pending_lst;
         CList   ecmp_track_ifindex_lst_head;
     } internal_netns;
@@ -223,7 +218,9 @@ NML3Cfg *nm_l3cfg_new(NMNetns *netns, int ifindex);
 
 gboolean nm_l3cfg_is_ready(NML3Cfg *self);
 
-void _nm_l3cfg_notify_platform_change_on_idle(NML3Cfg *self, guint64 obj_type_flags);
+void _nm_l3cfg_notify_platform_change_on_idle(NML3Cfg *self,
+                                              guint64  obj_type_flags,
+                                              guint    n_events);
 
 void _nm_l3cfg_notify_platform_change(NML3Cfg                   *self,
                                       NMPlatformSignalChangeType change_type,
@@ -38,6 +38,7 @@
 #include "nm-connectivity.h"
 #include "nm-dbus-manager.h"
 #include "nm-dbus-object.h"
+#include "nm-device-index.h"
 #include "nm-dispatcher.h"
 #include "nm-hostname-manager.h"
 #include "nm-keep-alive.h"
@@ -178,6 +179,8 @@ typedef struct {
 
     NMDnsManager *dns_mgr;
     gulong        dns_mgr_update_pending_signal_id;
+    gulong        dns_mgr_config_changed_signal_id;
+    char        **dns_nameservers;
 
     GArray *capabilities;
 
@@ -190,6 +193,10 @@ typedef struct {
 
     CList devices_lst_head;
 
+    /* indexes the devices on devices_lst_head by ifindex, iface, ip_iface and
+     * permanent MAC address. */
+    NMDeviceIndex *device_index;
+
     NMState            state;
     NMConfig          *config;
     NMConnectivity    *concheck_mgr;
@@ -204,7 +211,11 @@ typedef struct {
 
     GHashTable *devcon_data_dict;
 
-    CList link_cb_lst;
+    /* queue of ifindexes with pending platform link events. link_cb_idx
+     * contains the same entries, to merge events for the same ifindex. */
+    CList       link_cb_lst;
+    GHashTable *link_cb_idx;
+    GSource    *link_cb_idle_source;
 
     NMCheckpointManager *checkpoint_mgr;
 
@@ -1238,6 +1249,45 @@ nm_manager_get_activatable_connections(NMManager *manager,
         NULL);
 }
 
+/**
+ * nm_manager_get_activatable_connections_for_device:
+ * @manager: the #NMManager
+ * @device: the #NMDevice
+ * @for_auto_activation: whether the connections are for autoconnect
+ * @sort: whether to sort the connections by autoconnect priority
+ * @out_len: (optional): the number of returned connections
+ *
+ * Like nm_manager_get_activatable_connections(), but only returns the
+ * connections that are candidates for @device, based on their type and
+ * interface name. The caller still needs to check whether the connections
+ * are compatible with @device.
+ *
+ * Returns: (transfer container): a %NULL terminated array of connections.
+ */
+NMSettingsConnection **
+nm_manager_get_activatable_connections_for_device(NMManager *manager,
+                                                  NMDevice  *device,
+                                                  gboolean   for_auto_activation,
+                                                  gboolean   sort,
+                                                  guint     *out_len)
+{
+    NMManagerPrivate                         *priv = NM_MANAGER_GET_PRIVATE(manager);
+    const GetActivatableConnectionsFilterData d    = {
+           .self                = manager,
+           .for_auto_activation = for_auto_activation,
+    };
+
+    return nm_settings_get_candidate_connections_clone(
+        priv->settings,
+        nm_device_get_connection_type_compatible(device),
+        nm_device_get_iface(device),
+        out_len,
+        _get_activatable_connections_filter,
+        (gpointer) &d,
+        sort ? nm_settings_connection_cmp_autoconnect_priority_p_with_data : NULL,
+        NULL);
+}
+
 static NMActiveConnection *
 active_connection_get_by_path(NMManager *self, const char *path)
 {
@@ -1857,26 +1907,55 @@ nm_manager_get_device_by_path(NMManager *self, const char *path)
     return device;
 }
 
+static void
+_device_index_update(NMManager *self, NMDevice *device)
+{
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+
+    nm_device_index_update(priv->device_index,
+                           device,
+                           nm_device_get_ifindex(device),
+                           nm_device_get_iface(device),
+                           nm_device_get_ip_iface(device),
+                           nm_device_get_permanent_hw_address_full(device, FALSE, NULL));
+}
+
+/**
+ * nm_manager_device_index_update:
+ * @self: the #NMManager
+ * @device: the #NMDevice whose ifindex, interface name, IP interface name
+ *   or permanent MAC address changed
+ *
+ * The devices call this directly instead of the manager subscribing to
+ * property notifications, because the device may freeze notifications
+ * while it realizes and the index must not be outdated in the meantime.
+ */
+void
+nm_manager_device_index_update(NMManager *self, NMDevice *device)
+{
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+
+    if (!nm_device_index_contains(priv->device_index, device))
+        return;
+
+    _device_index_update(self, device);
+}
+
 NMDevice *
 nm_manager_get_device_by_ifindex(NMManager *self, int ifindex)
 {
     NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    NMDevice         *device;
-
-    if (ifindex > 0) {
-        c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
-            if (nm_device_get_ifindex(device) == ifindex)
-                return device;
-        }
-    }
+    gpointer const   *devices;
 
-    return NULL;
+    devices = nm_device_index_lookup_ifindex(priv->device_index, ifindex, NULL);
+    return devices ? devices[0] : NULL;
 }
 
 static NMDevice *
 find_device_by_permanent_hw_addr(NMManager *self, const char *hwaddr)
 {
     NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+    gpointer const   *devices;
     NMDevice         *device;
     const char       *device_addr;
     guint8            hwaddr_bin[_NM_UTILS_HWADDR_LEN_MAX];
@@ -1887,7 +1966,18 @@ find_device_by_permanent_hw_addr(NMManager *self, const char *hwaddr)
     if (!_nm_utils_hwaddr_aton(hwaddr, hwaddr_bin, sizeof(hwaddr_bin), &hwaddr_len))
         return NULL;
 
+    devices = nm_device_index_lookup_perm_hw_addr(priv->device_index, hwaddr, NULL);
+    if (devices)
+        return devices[0];
+
+    if (nm_device_index_get_n_without_perm_hw_addr(priv->device_index) == 0)
+        return NULL;
+
+    /* Some devices don't have a permanent MAC address yet, because they still
+     * wait for udev. nm_device_get_permanent_hw_address() determines it now. */
     c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
+        if (nm_device_get_permanent_hw_address_full(device, FALSE, NULL))
+            continue;
         device_addr = nm_device_get_permanent_hw_address(device);
         if (device_addr && nm_utils_hwaddr_matches(hwaddr_bin, hwaddr_len, device_addr, -1))
             return device;
@@ -1899,13 +1989,16 @@ static NMDevice *
 find_device_by_ip_iface(NMManager *self, const char *iface)
 {
     NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    NMDevice         *device;
+    gpointer const   *devices;
+    guint             len;
+    guint             i;
 
     g_return_val_if_fail(iface, NULL);
 
-    c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
-        if (nm_device_is_real(device) && nm_streq0(nm_device_get_ip_iface(device), iface))
-            return device;
+    devices = nm_device_index_lookup_ip_iface(priv->device_index, iface, &len);
+    for (i = 0; i < len; i++) {
+        if (nm_device_is_real(devices[i]))
+            return devices[i];
     }
     return NULL;
 }
@@ -1936,12 +2029,15 @@ find_device_by_iface(NMManager    *self,
     NMManagerPrivate *priv     = NM_MANAGER_GET_PRIVATE(self);
     NMDevice         *fallback = NULL;
     NMDevice         *candidate;
+    gpointer const   *devices;
+    guint             len;
+    guint             i;
 
     g_return_val_if_fail(iface != NULL, NULL);
 
-    c_list_for_each_entry (candidate, &priv->devices_lst_head, devices_lst) {
-        if (!nm_streq(nm_device_get_iface(candidate), iface))
-            continue;
+    devices = nm_device_index_lookup_iface(priv->device_index, iface, &len);
+    for (i = 0; i < len; i++) {
+        candidate = devices[i];
         if (connection && !nm_device_check_connection_compatible(candidate, connection, TRUE, NULL))
             continue;
         if (port) {
@@ -2335,6 +2431,7 @@ remove_device(NMManager *self, NMDevice *device, gboolean quitting)
     _devcon_remove_device_all(self, device);
 
     c_list_unlink(&device->devices_lst);
+    nm_device_index_remove(priv->device_index, device);
 
     _parent_notify_changed(self, device, TRUE);
 
@@ -2563,15 +2660,17 @@ NMDevice *
 nm_manager_get_device(NMManager *self, const char *ifname, NMDeviceType device_type)
 {
     NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    NMDevice         *device;
+    gpointer const   *devices;
+    guint             len;
+    guint             i;
 
     g_return_val_if_fail(ifname, NULL);
     g_return_val_if_fail(device_type != NM_DEVICE_TYPE_UNKNOWN, NULL);
 
-    c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
-        if (nm_device_get_device_type(device) == device_type
-            && nm_streq0(nm_device_get_iface(device), ifname))
-            return device;
+    devices = nm_device_index_lookup_iface(priv->device_index, ifname, &len);
+    for (i = 0; i < len; i++) {
+        if (nm_device_get_device_type(devices[i]) == device_type)
+            return devices[i];
     }
 
     return NULL;
@@ -3477,7 +3576,8 @@ get_existing_connection(NMManager *self, NMDevice *device, gboolean *out_generat
         /* @assume_state_guess_assume=TRUE means this is the first start of NM
          * and the state file contains no UUID. Search persistent connections
          * for a matching candidate. */
-        sett_conns = nm_manager_get_activatable_connections(self, FALSE, FALSE, &len);
+        sett_conns =
+            nm_manager_get_activatable_connections_for_device(self, device, FALSE, FALSE, &len);
         if (len > 0) {
             for (i = 0, j = 0; i < len; i++) {
                 NMSettingsConnection *sett_conn = sett_conns[i];
@@ -3772,15 +3872,19 @@ device_ip_iface_changed(NMDevice *device, GParamSpec *pspec, NMManager *self)
     const char       *ip_iface    = nm_device_get_ip_iface(device);
     NMDeviceType      device_type = nm_device_get_device_type(device);
     NMDevice         *candidate;
+    gpointer const   *devices;
+    guint             len;
+    guint             i;
 
     /* Remove NMDevice objects that are actually child devices of others,
      * when the other device finally knows its IP interface name.  For example,
      * remove the PPP interface that's a child of a WWAN device, since it's
      * not really a standalone NMDevice.
      */
-    c_list_for_each_entry (candidate, &priv->devices_lst_head, devices_lst) {
-        if (candidate != device && nm_streq0(nm_device_get_iface(candidate), ip_iface)
-            && nm_device_get_device_type(candidate) == device_type
+    devices = nm_device_index_lookup_iface(priv->device_index, ip_iface, &len);
+    for (i = 0; i < len; i++) {
+        candidate = devices[i];
+        if (candidate != device && nm_device_get_device_type(candidate) == device_type
             && nm_device_is_real(candidate)) {
             remove_device(self, candidate, FALSE);
             break;
@@ -3993,6 +4097,7 @@ add_device(NMManager *self, NMDevice *device, GError **error)
 
     nm_assert(c_list_is_empty(&device->devices_lst));
     c_list_link_tail(&priv->devices_lst_head, &device->devices_lst);
+    _device_index_update(self, device);
 
     g_signal_connect(device,
                      NM_DEVICE_STATE_CHANGED,
@@ -4276,11 +4381,15 @@ add:
     }
 }
 
+/* The maximum number of queued link events handled by one invocation of
+ * _platform_link_cb_idle(). The rest is handled on the next main loop
+ * iteration, so that a burst of events does not block the main loop. */
+#define PLATFORM_LINK_CB_BUDGET 100u
+
 typedef struct {
-    CList      lst;
-    NMManager *self;
-    int        ifindex;
-    guint      idle_id;
+    /* must be the first field, for nm_pint_hash(). */
+    int   ifindex;
+    CList lst;
 } PlatformLinkCbData;
 
 static gboolean
@@ -4322,17 +4431,12 @@ _check_remove_dev_on_link_deleted(NMManager *self, NMDevice *device)
     return TRUE;
 }
 
-static gboolean
-_platform_link_cb_idle(PlatformLinkCbData *data)
+static void
+_platform_link_cb_handle(NMManager *self, int ifindex)
 {
-    int                   ifindex = data->ifindex;
-    NMManager            *self    = data->self;
-    NMManagerPrivate     *priv    = NM_MANAGER_GET_PRIVATE(self);
+    NMManagerPrivate     *priv = NM_MANAGER_GET_PRIVATE(self);
     const NMPlatformLink *plink;
 
-    c_list_unlink_stale(&data->lst);
-    g_slice_free(PlatformLinkCbData, data);
-
     plink = nm_platform_link_get(priv->platform, ifindex);
     if (plink) {
         const NMPObject *plink_keep_alive = nmp_object_ref(NMP_OBJECT_UP_CAST(plink));
@@ -4363,8 +4467,41 @@ _platform_link_cb_idle(PlatformLinkCbData *data)
             }
         }
     }
+}
 
-    return G_SOURCE_REMOVE;
+static gboolean
+_platform_link_cb_idle(gpointer user_data)
+{
+    NMManager          *self = user_data;
+    NMManagerPrivate   *priv = NM_MANAGER_GET_PRIVATE(self);
+    PlatformLinkCbData *data;
+    int                 ifindex;
+    guint               n;
+
+    for (n = 0; n < PLATFORM_LINK_CB_BUDGET; n++) {
+        data = c_list_first_entry(&priv->link_cb_lst, PlatformLinkCbData, lst);
+        if (!data)
+            break;
+
+        /* Dequeue the ifindex first. Handling it may emit new platform
+         * signals, which queue the ifindex again. */
+        ifindex = data->ifindex;
+        c_list_unlink_stale(&data->lst);
+        if (!g_hash_table_remove(priv->link_cb_idx, data))
+            nm_assert_not_reached();
+
+        _platform_link_cb_handle(self, ifindex);
+    }
+
+    if (c_list_is_empty(&priv->link_cb_lst))
+        nm_clear_g_source_inst(&priv->link_cb_idle_source);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_platform_link_cb_data_free(gpointer data)
+{
+    nm_g_slice_free((PlatformLinkCbData *) data);
 }
 
 static void
@@ -4386,11 +4523,20 @@ platform_link_cb(NMPlatform     *platform,
         self = NM_MANAGER(user_data);
         priv = NM_MANAGER_GET_PRIVATE(self);
 
-        data          = g_slice_new(PlatformLinkCbData);
-        data->self    = self;
-        data->ifindex = ifindex;
+        /* The idle handler looks at the link as it is then, so if the
+         * ifindex is already queued, there is nothing to do. */
+        if (g_hash_table_contains(priv->link_cb_idx, &ifindex))
+            break;
+
+        data  = g_slice_new(PlatformLinkCbData);
+        *data = (PlatformLinkCbData){
+            .ifindex = ifindex,
+        };
         c_list_link_tail(&priv->link_cb_lst, &data->lst);
-        data->idle_id = g_idle_add((GSourceFunc) _platform_link_cb_idle, data);
+        g_hash_table_add(priv->link_cb_idx, data);
+
+        if (!priv->link_cb_idle_source)
+            priv->link_cb_idle_source = nm_g_idle_add_source(_platform_link_cb_idle, self);
         break;
     default:
         break;
@@ -4524,6 +4670,7 @@ nm_manager_get_best_device_for_connection(NMManager            *self,
     gs_unref_ptrarray GPtrArray   *all_ac_arr = NULL;
     gs_free_error GError          *local_best = NULL;
     NMConnectionMultiConnect       multi_connect;
+    const char                    *conn_iface;
 
     nm_assert(!sett_conn || NM_IS_SETTINGS_CONNECTION(sett_conn));
     nm_assert(!connection || NM_IS_CONNECTION(connection));
@@ -4660,6 +4807,11 @@ found_better:
             return ac_device;
     }
 
+    /* A device with a different interface name than the profile is never
+     * compatible. Skip those early, unless we need to report the reason
+     * why no device is available. */
+    conn_iface = error ? NULL : nm_connection_get_interface_name(connection);
+
     /* Pick the first device that's compatible with the connection. */
     c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
         GError              *local = NULL;
@@ -4668,6 +4820,9 @@ found_better:
         if (nm_g_hash_table_contains(exclude_devices, device))
             continue;
 
+        if (conn_iface && !nm_streq0(conn_iface, nm_device_get_iface(device)))
+            continue;
+
         if (!nm_device_is_available(device,
                                     for_user_request
                                         ? NM_DEVICE_CHECK_DEV_AVAILABLE_FOR_USER_REQUEST
@@ -8749,6 +8904,37 @@ impl_manager_checkpoint_adjust_rollback_timeout(NMDBusObject
 
 /*****************************************************************************/
 
+static void
+_dns_mgr_config_changed_cb(NMDnsManager *dns_mgr, GParamSpec *pspec, NMManager *self)
+{
+    NMManagerPrivate  *priv = NM_MANAGER_GET_PRIVATE(self);
+    const char *const *nameservers;
+    NMDevice          *device;
+    int                IS_IPv4;
+
+    /* the configuration also changes for search domains, options and
+     * for every update of the caching plugin. Only a different set of
+     * upstream nameservers might affect the connectivity. */
+    nameservers = nm_dns_manager_get_nameservers(dns_mgr);
+    if (nm_strv_equal(nameservers, NM_CAST_STRV_CC(priv->dns_nameservers)))
+        return;
+
+    g_strfreev(priv->dns_nameservers);
+    priv->dns_nameservers = nm_strv_dup(nameservers, -1, TRUE);
+
+    /* a changed DNS configuration might fix (or break) the connectivity of
+     * devices. Recheck those that don't have full connectivity right away,
+     * instead of waiting for their next periodic check. */
+    c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
+        for (IS_IPv4 = 1; IS_IPv4 >= 0; IS_IPv4--) {
+            const int addr_family = IS_IPv4 ? AF_INET : AF_INET6;
+
+            if (nm_device_get_connectivity_state(device, addr_family) != NM_CONNECTIVITY_FULL)
+                nm_device_check_connectivity_probe(device, addr_family, "DNS change");
+        }
+    }
+}
+
 NMDnsManager *
 nm_manager_get_dns_manager(NMManager *self)
 {
@@ -8764,6 +8950,11 @@ nm_manager_get_dns_manager(NMManager *self)
          * But keep a reference. This is to ensure proper lifetimes between
          * singleton instances (i.e. nm_dns_manager_get() outlives NMManager). */
         priv->dns_mgr = g_object_ref(nm_dns_manager_get());
+        priv->dns_mgr_config_changed_signal_id =
+            g_signal_connect(priv->dns_mgr,
+                             "notify::" NM_DNS_MANAGER_CONFIGURATION,
+                             G_CALLBACK(_dns_mgr_config_changed_cb),
+                             self);
     }
 
     return priv->dns_mgr;
@@ -9008,6 +9199,8 @@ nm_manager_init(NMManager *self)
 
     c_list_init(&priv->auth_lst_head);
     c_list_init(&priv->link_cb_lst);
+    priv->link_cb_idx =
+        g_hash_table_new_full(nm_pint_hash, nm_pint_equal, _platform_link_cb_data_free, NULL);
     c_list_init(&priv->devices_lst_head);
     c_list_init(&priv->active_connections_lst_head);
     c_list_init(&priv->async_op_lst_head);
@@ -9015,6 +9208,8 @@ nm_manager_init(NMManager *self)
 
     priv->platform = g_object_ref(NM_PLATFORM_GET);
 
+    priv->device_index = nm_device_index_new();
+
     priv->capabilities = g_array_new(FALSE, FALSE, sizeof(guint32));
 
     priv->radio_states[NM_RFKILL_TYPE_WLAN] = (RfkillRadioState) {
@@ -9257,13 +9452,9 @@ dispose(GObject *object)
     nm_assert(c_list_is_empty(&priv->async_op_lst_head));
 
     g_signal_handlers_disconnect_by_func(priv->platform, G_CALLBACK(platform_link_cb), self);
-    while ((iter = c_list_first(&priv->link_cb_lst))) {
-        PlatformLinkCbData *data = c_list_entry(iter, PlatformLinkCbData, lst);
-
-        g_source_remove(data->idle_id);
-        c_list_unlink_stale(&data->lst);
-        g_slice_free(PlatformLinkCbData, data);
-    }
+    nm_clear_g_source_inst(&priv->link_cb_idle_source);
+    c_list_init(&priv->link_cb_lst);
+    nm_clear_pointer(&priv->link_cb_idx, g_hash_table_unref);
 
     while ((iter = c_list_first(&priv->auth_lst_head)))
         nm_auth_chain_destroy(nm_auth_chain_parent_lst_entry(iter));
@@ -9280,7 +9471,9 @@ dispose(GObject *object)
     }
 
     nm_clear_g_signal_handler(priv->dns_mgr, &priv->dns_mgr_update_pending_signal_id);
+    nm_clear_g_signal_handler(priv->dns_mgr, &priv->dns_mgr_config_changed_signal_id);
     g_clear_object(&priv->dns_mgr);
+    nm_clear_pointer(&priv->dns_nameservers, g_strfreev);
 
     if (priv->auth_mgr) {
         g_signal_handlers_disconnect_by_func(priv->auth_mgr, G_CALLBACK(auth_mgr_changed), self);
@@ -9288,6 +9481,7 @@ dispose(GObject *object)
     }
 
     nm_assert(c_list_is_empty(&priv->devices_lst_head));
+    nm_assert(nm_device_index_get_len(priv->device_index) == 0);
 
     nm_clear_g_source(&priv->ac_cleanup_id);
 
@@ -9381,6 +9575,8 @@ finalize(GObject *object)
 
     g_array_free(priv->capabilities, TRUE);
 
+    nm_device_index_free(priv->device_index);
+
     G_OBJECT_CLASS(nm_manager_parent_class)->finalize(object);
 
     g_object_unref(priv->platform);
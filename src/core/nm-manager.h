@@ -125,6 +125,13 @@ NMSettingsConnection **nm_manager_get_activatable_connections(NMManager *manager
                                                               gboolean   sort,
                                                               guint     *out_len);
 
+NMSettingsConnection **
+nm_manager_get_activatable_connections_for_device(NMManager *manager,
+                                                  NMDevice  *device,
+                                                  gboolean   for_auto_activation,
+                                                  gboolean   sort,
+                                                  guint     *out_len);
+
 void nm_manager_deactivate_ac(NMManager *self, NMSettingsConnection *connection);
 
 void nm_manager_device_recheck_auto_activate_schedule(NMManager *self, NMDevice *device);
@@ -192,6 +199,7 @@ gboolean nm_manager_deactivate_connection(NMManager          *manager,
 
 void nm_manager_set_capability(NMManager *self, NMCapability cap);
 void nm_manager_emit_device_ifindex_changed(NMManager *self, NMDevice *device);
+void nm_manager_device_index_update(NMManager *self, NMDevice *device);
 
 NMDevice *nm_manager_get_device(NMManager *self, const char *ifname, NMDeviceType device_type);
 gboolean  nm_manager_remove_device(NMManager *self, const char *ifname, NMDeviceType device_type);
@@ -85,6 +85,8 @@ typedef struct {
 
     CList    l3cfg_signal_pending_lst_head;
     GSource *signal_pending_idle_source;
+
+    NMNetnsPlatformChangeStats platform_change_stats;
 } NMNetnsPrivate;
 
 struct _NMNetns {
@@ -325,6 +327,22 @@ nm_netns_get_multi_idx(NMNetns *self)
     return nm_platform_get_multi_idx(NM_NETNS_GET_PRIVATE(self)->platform);
 }
 
+const NMNetnsPlatformChangeStats *
+nm_netns_get_platform_change_stats(NMNetns *self)
+{
+    g_return_val_if_fail(NM_IS_NETNS(self), NULL);
+
+    return &NM_NETNS_GET_PRIVATE(self)->platform_change_stats;
+}
+
+void
+_nm_netns_notify_l3cfg_commit(NMNetns *self)
+{
+    nm_assert(NM_IS_NETNS(self));
+
+    NM_NETNS_GET_PRIVATE(self)->platform_change_stats.n_commits++;
+}
+
 /*****************************************************************************/
 
 static guint
@@ -461,6 +479,7 @@ _platform_signal_on_idle_cb(gpointer user_data)
     NMNetnsPrivate          *priv = NM_NETNS_GET_PRIVATE(self);
     NML3Cfg                 *l3cfg;
     CList                    work_list;
+    guint                    n_l3cfgs = 0;
 
     nm_clear_g_source_inst(&priv->signal_pending_idle_source);
 
@@ -478,11 +497,21 @@ _platform_signal_on_idle_cb(gpointer user_data)
     while ((l3cfg = c_list_first_entry(&work_list, NML3Cfg, internal_netns.signal_pending_lst))) {
         nm_assert(NM_IS_L3CFG(l3cfg));
         c_list_unlink(&l3cfg->internal_netns.signal_pending_lst);
+        priv->platform_change_stats.n_change_sets++;
+        n_l3cfgs++;
         _nm_l3cfg_notify_platform_change_on_idle(
             l3cfg,
-            nm_steal_int(&l3cfg->internal_netns.signal_pending_obj_type_flags));
+            nm_steal_int(&l3cfg->internal_netns.signal_pending_obj_type_flags),
+            nm_steal_int(&l3cfg->internal_netns.signal_pending_n_events));
     }
 
+    _LOGT("platform-change: notified %u l3cfg(s) (total: %" G_GUINT64_FORMAT
+          " events, %" G_GUINT64_FORMAT " change sets, %" G_GUINT64_FORMAT " commits)",
+          n_l3cfgs,
+          priv->platform_change_stats.n_events,
+          priv->platform_change_stats.n_change_sets,
+          priv->platform_change_stats.n_commits);
+
     return G_SOURCE_CONTINUE;
 }
 
@@ -509,7 +538,9 @@ _platform_signal_cb(NMPlatform   *platform,
     if (!l3cfg)
         goto notify_watcher;
 
+    priv->platform_change_stats.n_events++;
     l3cfg->internal_netns.signal_pending_obj_type_flags |= nmp_object_type_to_flags(obj_type);
+    l3cfg->internal_netns.signal_pending_n_events++;
 
     if (c_list_is_empty(&l3cfg->internal_netns.signal_pending_lst)) {
         c_list_link_tail(&priv->l3cfg_signal_pending_lst_head,
@@ -41,6 +41,23 @@ NML3Cfg *nm_netns_l3cfg_acquire(NMNetns *netns, int ifindex);
 
 /*****************************************************************************/
 
+typedef struct {
+    /* platform change events received for interfaces that have a NML3Cfg. */
+    guint64 n_events;
+
+    /* coalesced change sets handed to NML3Cfg instances. */
+    guint64 n_change_sets;
+
+    /* commits performed by the NML3Cfg instances of this namespace. */
+    guint64 n_commits;
+} NMNetnsPlatformChangeStats;
+
+const NMNetnsPlatformChangeStats *nm_netns_get_platform_change_stats(NMNetns *self);
+
+void _nm_netns_notify_l3cfg_commit(NMNetns *self);
+
+/*****************************************************************************/
+
 typedef enum {
     NM_NETNS_IP_RESERVATION_TYPE_SHARED4,
     NM_NETNS_IP_RESERVATION_TYPE_CLAT,
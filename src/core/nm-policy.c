@@ -1532,7 +1532,8 @@ _auto_activate_device(NMPolicy *self, NMDevice *device)
     if (!nm_device_autoconnect_allowed(device))
         return;
 
-    connections = nm_manager_get_activatable_connections(priv->manager, TRUE, TRUE, &len);
+    connections =
+        nm_manager_get_activatable_connections_for_device(priv->manager, device, TRUE, TRUE, &len);
     if (!connections[0])
         return;
 
@@ -1773,10 +1774,11 @@ reset_autoconnect_all(
     NMDevice *device, /* if present, only reset connections compatible with @device */
     gboolean  only_no_secrets)
 {
-    NMPolicyPrivate             *priv        = NM_POLICY_GET_PRIVATE(self);
-    NMSettingsConnection *const *connections = NULL;
-    guint                        i;
-    gboolean                     changed = FALSE;
+    NMPolicyPrivate               *priv             = NM_POLICY_GET_PRIVATE(self);
+    NMSettingsConnection *const   *connections      = NULL;
+    gs_free NMSettingsConnection **connections_free = NULL;
+    guint                          i;
+    gboolean                       changed = FALSE;
 
     _LOGD(LOGD_DEVICE,
           "re-enabling autoconnect for all connections%s%s%s",
@@ -1784,7 +1786,19 @@ reset_autoconnect_all(
           device ? nm_device_get_iface(device) : "",
           only_no_secrets ? " (only clear no-secrets flag)" : "");
 
-    connections = nm_settings_get_connections(priv->settings, NULL);
+    if (device) {
+        connections_free = nm_settings_get_candidate_connections_clone(
+            priv->settings,
+            nm_device_get_connection_type_compatible(device),
+            nm_device_get_iface(device),
+            NULL,
+            NULL,
+            NULL,
+            NULL,
+            NULL);
+        connections = connections_free;
+    } else
+        connections = nm_settings_get_connections(priv->settings, NULL);
     for (i = 0; connections[i]; i++) {
         NMSettingsConnection *sett_conn = connections[i];
 
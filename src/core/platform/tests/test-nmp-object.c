@@ -561,6 +561,189 @@ test_cache_qdisc(void)
 
 /*****************************************************************************/
 
+static gsize
+_get_rss_kib(void)
+{
+    gs_free char        *contents = NULL;
+    gs_free const char **tokens   = NULL;
+
+    if (!g_file_get_contents("/proc/self/statm", &contents, NULL, NULL))
+        return 0;
+    tokens = nm_strsplit_set(contents, " ");
+    if (NM_PTRARRAY_LEN(tokens) < 2)
+        return 0;
+    return _nm_utils_ascii_str_to_int64(tokens[1], 10, 0, G_MAXINT64, 0)
+           * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static void
+test_obj_pool_churn(void)
+{
+    const guint         N_ROUTES = 100000;
+    const guint         N_ROUNDS = 5;
+    gs_free NMPObject **objs     = g_new0(NMPObject *, N_ROUTES);
+    NMPObjectPoolStats  s0;
+    NMPObjectPoolStats  s1;
+    NMPObjectPoolStats  s2;
+    NMPObjectPoolStats  s3;
+    gsize               rss0;
+    gsize               rss1;
+    gsize               rss2;
+    gsize               rss3;
+    guint               round;
+    guint               i;
+
+    if (!nmp_object_pool_get_stats(NMP_OBJECT_TYPE_IP4_ROUTE, &s0)) {
+        g_test_skip("NMPObject pools are disabled");
+        return;
+    }
+
+    rss0 = _get_rss_kib();
+
+    for (i = 0; i < N_ROUTES; i++) {
+        const NMPlatformIP4Route r = {
+            .ifindex    = 1 + (i % 10),
+            .network    = htonl(0x0A000000u + (i << 8)),
+            .plen       = 24,
+            .metric     = 100,
+            .n_nexthops = 1,
+        };
+
+        objs[i] = nmp_object_new(NMP_OBJECT_TYPE_IP4_ROUTE, &r);
+    }
+
+    nmp_object_pool_get_stats(NMP_OBJECT_TYPE_IP4_ROUTE, &s1);
+    rss1 = _get_rss_kib();
+
+    g_assert_cmpint(s1.n_in_use, ==, s0.n_in_use + N_ROUTES);
+    g_assert_cmpint(s1.n_allocs, ==, s0.n_allocs + N_ROUTES);
+
+    /* The objects are allocated in chunks. Compared to allocating each object
+     * separately, there are at least 32 times fewer allocations. */
+    g_assert_cmpint((s1.n_chunk_allocs - s0.n_chunk_allocs) * 32u, <=, N_ROUTES);
+
+    /* There is no per-object overhead, apart from the chunk headers and
+     * filling the last chunk. */
+    g_assert_cmpint(s1.chunk_bytes - s0.chunk_bytes,
+                    <=,
+                    ((N_ROUTES * s1.obj_size) * 102u / 100u) + 65536u);
+
+    /* The chunks are all the memory that the objects need. */
+    if (rss0 > 0)
+        g_assert_cmpint(rss1, <=, rss0 + ((s1.chunk_bytes - s0.chunk_bytes) / 1024u) + 1024u);
+
+    /* Churn: replace the routes one by one. The released objects are reused
+     * and no new chunks are needed, apart from one if the last chunk was
+     * full. */
+    for (round = 0; round < N_ROUNDS; round++) {
+        for (i = 0; i < N_ROUTES; i++) {
+            NMPObject *obj;
+
+            obj = nmp_object_clone(objs[i], FALSE);
+            obj->ip4_route.metric += round + 1;
+            nmp_object_unref(objs[i]);
+            objs[i] = obj;
+        }
+    }
+
+    nmp_object_pool_get_stats(NMP_OBJECT_TYPE_IP4_ROUTE, &s2);
+    rss2 = _get_rss_kib();
+
+    g_assert_cmpint(s2.n_in_use, ==, s1.n_in_use);
+    g_assert_cmpint(s2.n_allocs, ==, s1.n_allocs + (N_ROUNDS * N_ROUTES));
+    g_assert_cmpint(s2.n_chunk_allocs, <=, s1.n_chunk_allocs + 1u);
+    g_assert_cmpint(s2.chunk_bytes, <=, s1.chunk_bytes + (s1.chunk_bytes - s0.chunk_bytes) / 100u);
+    if (rss0 > 0)
+        g_assert_cmpint(rss2, <=, rss1 + 1024u);
+
+    /* Release the first half of the routes. Their chunks become empty and are
+     * released right away, although other objects of the type are still in use. */
+    for (i = 0; i < N_ROUTES / 2u; i++)
+        nm_clear_pointer(&objs[i], nmp_object_unref);
+
+    nmp_object_pool_get_stats(NMP_OBJECT_TYPE_IP4_ROUTE, &s3);
+    rss3 = _get_rss_kib();
+
+    g_assert_cmpint(s3.n_in_use, ==, s0.n_in_use + (N_ROUTES - N_ROUTES / 2u));
+    g_assert_cmpint(s3.chunk_bytes - s0.chunk_bytes,
+                    <=,
+                    (s2.chunk_bytes - s0.chunk_bytes) * 6u / 10u);
+    if (rss0 > 0)
+        g_assert_cmpint(rss3 + ((s2.chunk_bytes - s3.chunk_bytes) / 1024u / 2u), <=, rss2);
+
+    g_test_message("%u routes: %" G_GUINT64_FORMAT " allocations served by %" G_GUINT64_FORMAT
+                   " chunks (%zu KiB, %zu bytes per object). RSS grew by %zd KiB and dropped by"
+                   " %zd KiB after releasing half of the routes",
+                   N_ROUTES,
+                   s2.n_allocs - s0.n_allocs,
+                   s2.n_chunk_allocs - s0.n_chunk_allocs,
+                   (s2.chunk_bytes - s0.chunk_bytes) / 1024u,
+                   s2.obj_size,
+                   (gssize) rss1 - (gssize) rss0,
+                   (gssize) rss2 - (gssize) rss3);
+
+    for (i = N_ROUTES / 2u; i < N_ROUTES; i++)
+        nmp_object_unref(objs[i]);
+
+    nmp_object_pool_get_stats(NMP_OBJECT_TYPE_IP4_ROUTE, &s3);
+    g_assert_cmpint(s3.n_in_use, ==, s0.n_in_use);
+    if (s3.n_in_use == 0) {
+        /* with the last object gone, the chunks are released, apart from
+         * the one empty chunk that the pool keeps. */
+        g_assert_cmpint(s3.chunk_bytes,
+                        <=,
+                        NM_MAX((gsize) 16384u, (gsize) sysconf(_SC_PAGESIZE)));
+    }
+}
+
+static void
+test_obj_pool_alternate(void)
+{
+    const NMPlatformIP6Route r = {
+        .ifindex = 1,
+        .network = IN6ADDR_LOOPBACK_INIT,
+        .plen    = 128,
+        .metric  = 100,
+    };
+    NMPObjectPoolStats s0;
+    NMPObjectPoolStats s1;
+    NMPObject         *obj;
+    NMPObject         *obj2;
+    guint              i;
+
+    if (!nmp_object_pool_get_stats(NMP_OBJECT_TYPE_IP6_ROUTE, &s0)) {
+        g_test_skip("NMPObject pools are disabled");
+        return;
+    }
+
+    /* Make sure that the pool has a chunk. */
+    obj = nmp_object_new(NMP_OBJECT_TYPE_IP6_ROUTE, &r);
+    nmp_object_unref(obj);
+    nmp_object_pool_get_stats(NMP_OBJECT_TYPE_IP6_ROUTE, &s0);
+
+    /* Allocating and freeing the only object of a type, or cloning and
+     * releasing an object, must not map and unmap a chunk each time. */
+    for (i = 0; i < 1000; i++) {
+        obj = nmp_object_new(NMP_OBJECT_TYPE_IP6_ROUTE, &r);
+        nmp_object_unref(obj);
+    }
+    obj = nmp_object_new(NMP_OBJECT_TYPE_IP6_ROUTE, &r);
+    for (i = 0; i < 1000; i++) {
+        obj2 = nmp_object_clone(obj, FALSE);
+        nmp_object_unref(obj);
+        obj = obj2;
+    }
+    nmp_object_unref(obj);
+
+    nmp_object_pool_get_stats(NMP_OBJECT_TYPE_IP6_ROUTE, &s1);
+    g_assert_cmpint(s1.n_in_use, ==, s0.n_in_use);
+    g_assert_cmpint(s1.n_allocs, ==, s0.n_allocs + 2001u);
+    g_assert_cmpint(s1.n_chunk_allocs, ==, s0.n_chunk_allocs);
+    g_assert_cmpint(s1.chunk_bytes, ==, s0.chunk_bytes);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -605,6 +788,8 @@ main(int argc, char **argv)
     g_test_add_func("/nmp-object/obj-base", test_obj_base);
     g_test_add_func("/nmp-object/cache_link", test_cache_link);
     g_test_add_func("/nmp-object/cache_qdisc", test_cache_qdisc);
+    g_test_add_func("/nmp-object/obj-pool-churn", test_obj_pool_churn);
+    g_test_add_func("/nmp-object/obj-pool-alternate", test_obj_pool_alternate);
 
     result = g_test_run();
 
@@ -2460,6 +2460,133 @@ done:
     }
 }
 
+/*****************************************************************************/
+
+static void
+test_ip4_route_sync_batch(void)
+{
+    const int   IFINDEX  = nm_platform_link_get_ifindex(NM_PLATFORM_GET, DEVICE_NAME);
+    const guint N_ROUTES = nmtst_test_quick() ? 300 : 3000;
+    gs_unref_ptrarray GPtrArray *routes =
+        g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+    gs_unref_ptrarray GPtrArray *routes_failed = NULL;
+    gs_unref_ptrarray GPtrArray *routes_plat   = NULL;
+    const NMPObject             *obj_unreachable;
+    guint                        i;
+
+    /* nm_platform_ip_route_sync() sends many requests at once, and collects
+     * the responses afterwards. Check that a failure is still reported for
+     * exactly the route that failed. */
+
+    for (i = 0; i < N_ROUTES; i++) {
+        const NMPlatformIP4Route r = {
+            .ifindex    = IFINDEX,
+            .rt_source  = NM_IP_CONFIG_SOURCE_USER,
+            .network    = htonl(0xAC100000u + (i << 8)),
+            .plen       = 24,
+            .metric     = 22986,
+            .n_nexthops = 1,
+        };
+
+        g_ptr_array_add(routes, nmp_object_new(NMP_OBJECT_TYPE_IP4_ROUTE, &r));
+    }
+
+    {
+        /* The gateway is not reachable via the device. Kernel rejects this route. */
+        const NMPlatformIP4Route r = {
+            .ifindex    = IFINDEX,
+            .rt_source  = NM_IP_CONFIG_SOURCE_USER,
+            .network    = nmtst_inet4_from_string("198.51.100.0"),
+            .plen       = 24,
+            .gateway    = nmtst_inet4_from_string("203.0.113.1"),
+            .metric     = 22986,
+            .n_nexthops = 1,
+        };
+
+        obj_unreachable = nmp_object_new(NMP_OBJECT_TYPE_IP4_ROUTE, &r);
+        g_ptr_array_insert(routes, N_ROUTES / 2, (gpointer) obj_unreachable);
+    }
+
+    g_assert(!nm_platform_ip_route_sync(NM_PLATFORM_GET,
+                                        AF_INET,
+                                        IFINDEX,
+                                        routes,
+                                        NULL,
+                                        &routes_failed));
+    g_assert(routes_failed);
+    g_assert_cmpint(routes_failed->len, ==, 1);
+    g_assert(routes_failed->pdata[0] == obj_unreachable);
+
+    routes_plat = nmtstp_ip4_route_get_all(NM_PLATFORM_GET, IFINDEX);
+    g_assert_cmpint(routes_plat->len, ==, N_ROUTES);
+
+    g_assert(nm_platform_ip_route_flush(NM_PLATFORM_GET, AF_INET, IFINDEX));
+
+    nm_clear_pointer(&routes_plat, g_ptr_array_unref);
+    routes_plat = nmtstp_ip4_route_get_all(NM_PLATFORM_GET, IFINDEX);
+    g_assert_cmpint(nm_g_ptr_array_len(routes_plat), ==, 0);
+}
+
+/*****************************************************************************/
+
+static guint
+_ip4_route_count_in_table(int ifindex, guint32 table)
+{
+    gs_unref_ptrarray GPtrArray *routes = NULL;
+    guint                        n      = 0;
+    guint                        i;
+
+    routes = nm_platform_lookup_object_clone(NM_PLATFORM_GET,
+                                             NMP_OBJECT_TYPE_IP4_ROUTE,
+                                             ifindex,
+                                             NULL,
+                                             NULL);
+    for (i = 0; i < nm_g_ptr_array_len(routes); i++) {
+        const NMPlatformIP4Route *r = NMP_OBJECT_CAST_IP4_ROUTE(routes->pdata[i]);
+
+        if (r->rt_source == NM_IP_CONFIG_SOURCE_RTPROT_KERNEL)
+            continue;
+        if (nm_platform_route_table_uncoerce(r->table_coerced, TRUE) == table)
+            n++;
+    }
+    return n;
+}
+
+static void
+test_ip4_route_ignore(void)
+{
+    const int     IFINDEX = nm_platform_link_get_ifindex(NM_PLATFORM_GET, DEVICE_NAME);
+    const guint32 TABLE   = 10101;
+
+    nmtstp_run_command_check("ip route add 192.0.2.0/25 dev %s table %u", DEVICE_NAME, TABLE);
+    nmtstp_run_command_check("ip route add 198.51.100.0/24 dev %s", DEVICE_NAME);
+    nm_platform_process_events(NM_PLATFORM_GET);
+    g_assert_cmpint(_ip4_route_count_in_table(IFINDEX, TABLE), ==, 1);
+    g_assert_cmpint(_ip4_route_count_in_table(IFINDEX, RT_TABLE_MAIN), ==, 1);
+
+    /* Routes in the table get dropped from the cache, and new ones are not added. */
+    nm_platform_ip_route_set_ignore(NM_PLATFORM_GET, &TABLE, 1, NULL, 0, NULL, 0);
+    g_assert_cmpint(_ip4_route_count_in_table(IFINDEX, TABLE), ==, 0);
+    g_assert_cmpint(_ip4_route_count_in_table(IFINDEX, RT_TABLE_MAIN), ==, 1);
+
+    nmtstp_run_command_check("ip route add 192.0.2.128/25 dev %s table %u", DEVICE_NAME, TABLE);
+    nm_platform_process_events(NM_PLATFORM_GET);
+    g_assert_cmpint(_ip4_route_count_in_table(IFINDEX, TABLE), ==, 0);
+
+    /* Ignoring the interface hides the remaining route too. */
+    nm_platform_ip_route_set_ignore(NM_PLATFORM_GET, &TABLE, 1, NULL, 0, &IFINDEX, 1);
+    g_assert_cmpint(_ip4_route_count_in_table(IFINDEX, RT_TABLE_MAIN), ==, 0);
+
+    nm_platform_ip_route_set_ignore(NM_PLATFORM_GET, NULL, 0, NULL, 0, NULL, 0);
+    g_assert_cmpint(_ip4_route_count_in_table(IFINDEX, TABLE), ==, 2);
+    g_assert_cmpint(_ip4_route_count_in_table(IFINDEX, RT_TABLE_MAIN), ==, 1);
+
+    nmtstp_run_command_check("ip route flush table %u", TABLE);
+    nmtstp_run_command_check("ip route flush dev %s", DEVICE_NAME);
+    nm_platform_process_events(NM_PLATFORM_GET);
+    g_assert_cmpint(_ip4_route_count_in_table(IFINDEX, TABLE), ==, 0);
+}
+
 /*****************************************************************************/
 static void
 test_ip4_rtnh_onlink(void)
@@ -2569,6 +2696,8 @@ _nmtstp_setup_tests(void)
         add_test_func("/route/ip6_route_get", test_ip6_route_get);
         add_test_func("/route/ip4_zero_gateway", test_ip4_zero_gateway);
         add_test_func("/route/via", test_via);
+        add_test_func("/route/ip4_sync_batch", test_ip4_route_sync_batch);
+        add_test_func("/route/ip4_ignore", test_ip4_route_ignore);
     }
 
     if (nmtstp_is_root_test()) {
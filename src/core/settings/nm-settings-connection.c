@@ -1398,21 +1398,12 @@ auth_start(NMSettingsConnection  *self,
 
 /**** DBus method handlers ************************************/
 
-static void
-get_settings_auth_cb(NMSettingsConnection  *self,
-                     GDBusMethodInvocation *context,
-                     NMAuthSubject         *subject,
-                     GError                *error,
-                     gpointer               data)
+static GVariant *
+_get_settings_dbus(NMSettingsConnection *self)
 {
     const char                      *seen_bssids_strv[SEEN_BSSIDS_MAX + 1];
     NMConnectionSerializationOptions options = {};
 
-    if (error) {
-        g_dbus_method_invocation_return_gerror(context, error);
-        return;
-    }
-
     /* Timestamp is not updated in connection's 'timestamp' property,
      * because it would force updating the connection and in turn
      * writing to /etc periodically, which we want to avoid. Rather real
@@ -1434,7 +1425,38 @@ get_settings_auth_cb(NMSettingsConnection  *self,
      * protected against leakage of secrets to unprivileged callers.
      */
 
-    g_dbus_method_invocation_return_value(context, _getsettings_cached_get(self, &options));
+    return _getsettings_cached_get(self, &options);
+}
+
+/**
+ * nm_settings_connection_get_settings_dbus:
+ * @self: the #NMSettingsConnection
+ *
+ * Returns: (transfer full): the settings of @self as returned by the
+ *   GetSettings D-Bus method, of type "a{sa{sv}}". The caller must
+ *   check that the requester is permitted to see the profile.
+ */
+GVariant *
+nm_settings_connection_get_settings_dbus(NMSettingsConnection *self)
+{
+    g_return_val_if_fail(NM_IS_SETTINGS_CONNECTION(self), NULL);
+
+    return g_variant_get_child_value(_get_settings_dbus(self), 0);
+}
+
+static void
+get_settings_auth_cb(NMSettingsConnection  *self,
+                     GDBusMethodInvocation *context,
+                     NMAuthSubject         *subject,
+                     GError                *error,
+                     gpointer               data)
+{
+    if (error) {
+        g_dbus_method_invocation_return_gerror(context, error);
+        return;
+    }
+
+    g_dbus_method_invocation_return_value(context, _get_settings_dbus(self));
 }
 
 static void
@@ -214,6 +214,7 @@ NMSettings *nm_settings_connection_get_settings(NMSettingsConnection *self);
 NMManager *nm_settings_connection_get_manager(NMSettingsConnection *self);
 
 NMConnection *nm_settings_connection_get_connection(NMSettingsConnection *self);
+GVariant     *nm_settings_connection_get_settings_dbus(NMSettingsConnection *self);
 gpointer      nm_settings_connection_get_setting(NMSettingsConnection *self,
                                                  NMMetaSettingType     meta_type);
 
@@ -18,6 +18,7 @@
 enum {
     UNMANAGED_SPECS_CHANGED,
     UNRECOGNIZED_SPECS_CHANGED,
+    CONNECTIONS_CHANGED,
 
     LAST_SIGNAL
 };
@@ -256,6 +257,14 @@ _nm_settings_plugin_emit_signal_unrecognized_specs_changed(NMSettingsPlugin *sel
     g_signal_emit(self, signals[UNRECOGNIZED_SPECS_CHANGED], 0);
 }
 
+void
+_nm_settings_plugin_emit_signal_connections_changed(NMSettingsPlugin *self)
+{
+    nm_assert(NM_IS_SETTINGS_PLUGIN(self));
+
+    g_signal_emit(self, signals[CONNECTIONS_CHANGED], 0);
+}
+
 /*****************************************************************************/
 
 static void
@@ -287,4 +296,16 @@ nm_settings_plugin_class_init(NMSettingsPluginClass *klass)
                      g_cclosure_marshal_VOID__VOID,
                      G_TYPE_NONE,
                      0);
+
+    /* Emitted when the plugin noticed that profiles changed on disk, and
+     * asks for nm_settings_plugin_reload_connections() to be called. */
+    signals[CONNECTIONS_CHANGED] = g_signal_new(NM_SETTINGS_PLUGIN_CONNECTIONS_CHANGED,
+                                                G_OBJECT_CLASS_TYPE(object_class),
+                                                G_SIGNAL_RUN_FIRST,
+                                                0,
+                                                NULL,
+                                                NULL,
+                                                g_cclosure_marshal_VOID__VOID,
+                                                G_TYPE_NONE,
+                                                0);
 }
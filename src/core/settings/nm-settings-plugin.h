@@ -37,6 +37,7 @@ typedef struct {
 
 #define NM_SETTINGS_PLUGIN_UNMANAGED_SPECS_CHANGED    "unmanaged-specs-changed"
 #define NM_SETTINGS_PLUGIN_UNRECOGNIZED_SPECS_CHANGED "unrecognized-specs-changed"
+#define NM_SETTINGS_PLUGIN_CONNECTIONS_CHANGED        "connections-changed"
 
 struct _NMSettingsPlugin {
     GObject parent;
@@ -183,6 +184,8 @@ void _nm_settings_plugin_emit_signal_unmanaged_specs_changed(NMSettingsPlugin *s
 
 void _nm_settings_plugin_emit_signal_unrecognized_specs_changed(NMSettingsPlugin *self);
 
+void _nm_settings_plugin_emit_signal_connections_changed(NMSettingsPlugin *self);
+
 /*****************************************************************************/
 
 int nm_settings_plugin_cmp_by_priority(const NMSettingsPlugin *a,
@@ -159,3 +159,227 @@ nm_sett_util_storages_steal(NMSettUtilStorages *storages,
 
     return storage;
 }
+
+/*****************************************************************************/
+
+typedef struct {
+    /* must be the first field, the entries are hashed by nm_pdirect_hash(). */
+    gpointer obj;
+
+    /* the interface name, or NULL if the object is indexed by @connection_type. */
+    char *iface;
+    char *connection_type;
+
+    /* the position in the order in which the objects were added. */
+    guint64 add_idx;
+} CandidateIdxEntry;
+
+static void
+_candidate_idx_entry_free(gpointer data)
+{
+    CandidateIdxEntry *entry = data;
+
+    g_free(entry->iface);
+    g_free(entry->connection_type);
+    nm_g_slice_free(entry);
+}
+
+static const char *
+_candidate_idx_entry_get_key(const CandidateIdxEntry *entry)
+{
+    return entry->iface ?: entry->connection_type;
+}
+
+static GHashTable *
+_candidate_idx_get(const NMSettUtilCandidateIdx *idx, const CandidateIdxEntry *entry)
+{
+    return entry->iface ? idx->by_iface : idx->by_type;
+}
+
+static void
+_candidate_idx_bucket_add(NMSettUtilCandidateIdx *idx, CandidateIdxEntry *entry)
+{
+    GHashTable *by_key = _candidate_idx_get(idx, entry);
+    const char *key    = _candidate_idx_entry_get_key(entry);
+    GHashTable *bucket;
+
+    bucket = g_hash_table_lookup(by_key, key);
+    if (!bucket) {
+        bucket = g_hash_table_new(nm_direct_hash, NULL);
+        g_hash_table_insert(by_key, g_strdup(key), bucket);
+    }
+    g_hash_table_add(bucket, entry);
+}
+
+static void
+_candidate_idx_bucket_remove(NMSettUtilCandidateIdx *idx, CandidateIdxEntry *entry)
+{
+    GHashTable *by_key = _candidate_idx_get(idx, entry);
+    const char *key    = _candidate_idx_entry_get_key(entry);
+    GHashTable *bucket;
+
+    bucket = g_hash_table_lookup(by_key, key);
+    if (!bucket || !g_hash_table_remove(bucket, entry))
+        nm_assert_not_reached();
+    else if (g_hash_table_size(bucket) == 0)
+        g_hash_table_remove(by_key, key);
+}
+
+void
+nm_sett_util_candidate_idx_init(NMSettUtilCandidateIdx *idx)
+{
+    idx->entries =
+        g_hash_table_new_full(nm_pdirect_hash, nm_pdirect_equal, _candidate_idx_entry_free, NULL);
+    idx->by_iface     = g_hash_table_new_full(nm_str_hash,
+                                              g_str_equal,
+                                              g_free,
+                                              (GDestroyNotify) g_hash_table_unref);
+    idx->by_type      = g_hash_table_new_full(nm_str_hash,
+                                              g_str_equal,
+                                              g_free,
+                                              (GDestroyNotify) g_hash_table_unref);
+    idx->add_idx_next = 0;
+}
+
+void
+nm_sett_util_candidate_idx_clear(NMSettUtilCandidateIdx *idx)
+{
+    nm_clear_pointer(&idx->by_iface, g_hash_table_destroy);
+    nm_clear_pointer(&idx->by_type, g_hash_table_destroy);
+    nm_clear_pointer(&idx->entries, g_hash_table_destroy);
+}
+
+/**
+ * nm_sett_util_candidate_idx_update:
+ * @idx: the index
+ * @obj: the object to add or update
+ * @iface: (nullable): the connection.interface-name of @obj
+ * @connection_type: (nullable): the connection.type of @obj
+ *
+ * Adds @obj to the index, or updates its keys. An object that is already
+ * in the index keeps its position in the lookup results.
+ */
+void
+nm_sett_util_candidate_idx_update(NMSettUtilCandidateIdx *idx,
+                                  gpointer                obj,
+                                  const char             *iface,
+                                  const char             *connection_type)
+{
+    CandidateIdxEntry *entry;
+
+    nm_assert(obj);
+
+    connection_type = connection_type ?: "";
+
+    entry = g_hash_table_lookup(idx->entries, &obj);
+    if (entry) {
+        if (nm_streq0(entry->iface, iface) && nm_streq(entry->connection_type, connection_type))
+            return;
+        _candidate_idx_bucket_remove(idx, entry);
+        g_free(entry->iface);
+        g_free(entry->connection_type);
+    } else {
+        entry  = g_slice_new(CandidateIdxEntry);
+        *entry = (CandidateIdxEntry) {
+            .obj     = obj,
+            .add_idx = idx->add_idx_next++,
+        };
+        g_hash_table_add(idx->entries, entry);
+    }
+    entry->iface           = g_strdup(iface);
+    entry->connection_type = g_strdup(connection_type);
+
+    _candidate_idx_bucket_add(idx, entry);
+}
+
+void
+nm_sett_util_candidate_idx_remove(NMSettUtilCandidateIdx *idx, gpointer obj)
+{
+    CandidateIdxEntry *entry;
+
+    entry = g_hash_table_lookup(idx->entries, &obj);
+    if (!entry) {
+        nm_assert_not_reached();
+        return;
+    }
+
+    _candidate_idx_bucket_remove(idx, entry);
+    g_hash_table_remove(idx->entries, entry);
+}
+
+static void
+_candidate_idx_collect(GPtrArray *arr, GHashTable *bucket, const char *connection_type)
+{
+    GHashTableIter     iter;
+    CandidateIdxEntry *entry;
+
+    if (!bucket)
+        return;
+
+    g_hash_table_iter_init(&iter, bucket);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &entry, NULL)) {
+        if (connection_type && !nm_streq(connection_type, entry->connection_type))
+            continue;
+        g_ptr_array_add(arr, entry);
+    }
+}
+
+static int
+_candidate_idx_entry_cmp(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const CandidateIdxEntry *entry_a = *((const CandidateIdxEntry *const *) a);
+    const CandidateIdxEntry *entry_b = *((const CandidateIdxEntry *const *) b);
+
+    NM_CMP_FIELD(entry_a, entry_b, add_idx);
+    return 0;
+}
+
+/**
+ * nm_sett_util_candidate_idx_lookup:
+ * @idx: the index
+ * @connection_type: (nullable): if set, only return objects of this type.
+ * @iface: (nullable): the interface name of the device.
+ *
+ * Returns: (transfer full): the objects with interface name @iface and
+ *   the ones without interface name, in the order in which they were added
+ *   to the index.
+ */
+GPtrArray *
+nm_sett_util_candidate_idx_lookup(const NMSettUtilCandidateIdx *idx,
+                                  const char                   *connection_type,
+                                  const char                   *iface)
+{
+    GPtrArray *arr;
+    guint      i;
+
+    arr = g_ptr_array_new();
+
+    if (iface)
+        _candidate_idx_collect(arr, g_hash_table_lookup(idx->by_iface, iface), connection_type);
+
+    if (connection_type)
+        _candidate_idx_collect(arr, g_hash_table_lookup(idx->by_type, connection_type), NULL);
+    else {
+        GHashTableIter iter;
+        GHashTable    *bucket;
+
+        g_hash_table_iter_init(&iter, idx->by_type);
+        while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &bucket))
+            _candidate_idx_collect(arr, bucket, NULL);
+    }
+
+    /* the buckets are unordered. Return the objects in the order in which they
+     * were added, like a walk over the list of all objects would. */
+    if (arr->len > 1) {
+        g_qsort_with_data(arr->pdata,
+                          arr->len,
+                          sizeof(CandidateIdxEntry *),
+                          _candidate_idx_entry_cmp,
+                          NULL);
+    }
+
+    for (i = 0; i < arr->len; i++)
+        arr->pdata[i] = ((CandidateIdxEntry *) arr->pdata[i])->obj;
+
+    return arr;
+}
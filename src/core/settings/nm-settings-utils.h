@@ -88,4 +88,38 @@ typedef struct {
 
 gboolean nm_sett_util_allow_filename_cb(const char *filename, gpointer user_data);
 
+/*****************************************************************************/
+
+/* Index of the profiles by connection.interface-name, and for profiles without
+ * interface name, by connection.type. The indexed objects are opaque pointers
+ * (NMSettingsConnection in NMSettings). Lookups return the objects in the order
+ * in which they were first added to the index. */
+typedef struct {
+    GHashTable *entries;
+    GHashTable *by_iface;
+    GHashTable *by_type;
+    guint64     add_idx_next;
+} NMSettUtilCandidateIdx;
+
+void nm_sett_util_candidate_idx_init(NMSettUtilCandidateIdx *idx);
+
+void nm_sett_util_candidate_idx_clear(NMSettUtilCandidateIdx *idx);
+
+void nm_sett_util_candidate_idx_update(NMSettUtilCandidateIdx *idx,
+                                       gpointer                obj,
+                                       const char             *iface,
+                                       const char             *connection_type);
+
+void nm_sett_util_candidate_idx_remove(NMSettUtilCandidateIdx *idx, gpointer obj);
+
+GPtrArray *nm_sett_util_candidate_idx_lookup(const NMSettUtilCandidateIdx *idx,
+                                             const char                   *connection_type,
+                                             const char                   *iface);
+
+static inline guint
+nm_sett_util_candidate_idx_get_len(const NMSettUtilCandidateIdx *idx)
+{
+    return g_hash_table_size(idx->entries);
+}
+
 #endif /* __NM_SETTINGS_UTILS_H__ */
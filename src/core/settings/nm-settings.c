@@ -53,6 +53,7 @@
 #include "devices/nm-device-ethernet.h"
 #include "nm-settings-connection.h"
 #include "nm-settings-plugin.h"
+#include "nm-settings-utils.h"
 #include "nm-dbus-manager.h"
 #include "nm-auth-utils.h"
 #include "libnm-core-aux-intern/nm-auth-subject.h"
@@ -410,6 +411,12 @@ typedef struct {
     NMSettingsConnection **connections_cached_list;
     NMSettingsConnection **connections_cached_list_sorted_by_autoconnect_priority;
 
+    /* Index of the connections by connection.interface-name, and for profiles
+     * without interface name, by connection.type. A device only needs to consider
+     * the profiles for its interface name and the ones without interface name.
+     * See nm_settings_get_candidate_connections_clone(). */
+    NMSettUtilCandidateIdx candidate_idx;
+
     GSList *unmanaged_specs;
     GSList *unrecognized_specs;
 
@@ -1095,6 +1102,20 @@ _connection_changed_normalize_connection(NMSettingsStorage *storage,
 
 /*****************************************************************************/
 
+static void
+_candidate_idx_update(NMSettings *self, NMSettingsConnection *sett_conn)
+{
+    NMSettingsPrivate *priv       = NM_SETTINGS_GET_PRIVATE(self);
+    NMConnection      *connection = nm_settings_connection_get_connection(sett_conn);
+
+    nm_sett_util_candidate_idx_update(&priv->candidate_idx,
+                                      sett_conn,
+                                      nm_connection_get_interface_name(connection),
+                                      nm_connection_get_connection_type(connection));
+}
+
+/*****************************************************************************/
+
 static void
 _connection_changed_update(NMSettings                      *self,
                            SettConnEntry                   *sett_conn_entry,
@@ -1127,6 +1148,8 @@ _connection_changed_update(NMSettings                      *self,
 
     _nm_settings_connection_set_connection(sett_conn, connection, &connection_old, update_reason);
 
+    _candidate_idx_update(self, sett_conn);
+
     if (is_new) {
         _nm_settings_connection_register_kf_dbs(sett_conn,
                                                 priv->kf_db_timestamps,
@@ -1250,6 +1273,7 @@ _connection_changed_delete(NMSettings           *self,
     _clear_connections_cached_list(priv);
     c_list_unlink(&sett_conn->_connections_lst);
     priv->connections_len--;
+    nm_sett_util_candidate_idx_remove(&priv->candidate_idx, sett_conn);
     priv->connections_generation++;
 
     /* Tell agents to remove secrets for this connection */
@@ -1577,6 +1601,28 @@ _plugin_connections_reload(NMSettings *self)
     }
 }
 
+static void
+_plugin_connections_changed(NMSettingsPlugin *plugin, gpointer user_data)
+{
+    NMSettings *self = NM_SETTINGS(user_data);
+
+    /* Only reload the plugin that asked for it. This is the same as
+     * _plugin_connections_reload(), but without the ifcfg-rh migration. */
+    nm_settings_plugin_reload_connections(plugin, _plugin_connections_reload_cb, self);
+
+    _connection_changed_process_all_dirty(
+        self,
+        FALSE,
+        NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
+        NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
+        TRUE,
+        NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_SYSTEM_SECRETS
+            | NM_SETTINGS_CONNECTION_UPDATE_REASON_RESET_AGENT_SECRETS
+            | NM_SETTINGS_CONNECTION_UPDATE_REASON_UPDATE_NON_SECRET);
+
+    nm_settings_plugin_load_connections_done(plugin);
+}
+
 /*****************************************************************************/
 
 static gboolean
@@ -3149,6 +3195,76 @@ impl_settings_list_connections(NMDBusObject                      *obj,
     g_dbus_method_invocation_return_value(invocation, g_variant_new("(^ao)", strv));
 }
 
+static void
+_get_connection_settings_add(GVariantBuilder      *builder,
+                             NMSettingsConnection *sett_conn,
+                             NMAuthSubject        *subject)
+{
+    gs_unref_variant GVariant *settings = NULL;
+
+    /* Like GetSettings, the caller only gets the profiles which it is
+     * permitted to see. */
+    if (!nm_auth_is_subject_in_acl(nm_settings_connection_get_connection(sett_conn),
+                                   subject,
+                                   NULL))
+        return;
+
+    settings = nm_settings_connection_get_settings_dbus(sett_conn);
+    g_variant_builder_add(builder,
+                          "{o@a{sa{sv}}}",
+                          nm_dbus_object_get_path(NM_DBUS_OBJECT(sett_conn)),
+                          settings);
+}
+
+static void
+impl_settings_get_connection_settings(NMDBusObject                      *obj,
+                                      const NMDBusInterfaceInfoExtended *interface_info,
+                                      const NMDBusMethodInfoExtended    *method_info,
+                                      GDBusConnection                   *dbus_connection,
+                                      const char                        *sender,
+                                      GDBusMethodInvocation             *invocation,
+                                      GVariant                          *parameters)
+{
+    NMSettings                    *self    = NM_SETTINGS(obj);
+    NMSettingsPrivate             *priv    = NM_SETTINGS_GET_PRIVATE(self);
+    gs_unref_object NMAuthSubject *subject = NULL;
+    gs_free const char           **paths   = NULL;
+    GVariantBuilder                builder;
+    NMSettingsConnection          *sett_conn;
+
+    g_variant_get(parameters, "(^a&o)", &paths);
+
+    subject = nm_dbus_manager_new_auth_subject_from_context(invocation);
+    if (!subject) {
+        g_dbus_method_invocation_return_error_literal(invocation,
+                                                      NM_SETTINGS_ERROR,
+                                                      NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                                      NM_UTILS_ERROR_MSG_REQ_UID_UKNOWN);
+        return;
+    }
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{oa{sa{sv}}}"));
+
+    if (!paths || !paths[0]) {
+        c_list_for_each_entry (sett_conn, &priv->connections_lst_head, _connections_lst)
+            _get_connection_settings_add(&builder, sett_conn, subject);
+    } else {
+        gs_unref_hashtable GHashTable *seen = g_hash_table_new(nm_direct_hash, NULL);
+        gsize                          i;
+
+        /* Paths of unknown profiles are silently skipped. The caller can tell
+         * from the result which profiles are missing. */
+        for (i = 0; paths[i]; i++) {
+            sett_conn = nm_settings_get_connection_by_path(self, paths[i]);
+            if (!sett_conn || !g_hash_table_add(seen, sett_conn))
+                continue;
+            _get_connection_settings_add(&builder, sett_conn, subject);
+        }
+    }
+
+    g_dbus_method_invocation_return_value(invocation, g_variant_new("(a{oa{sa{sv}}})", &builder));
+}
+
 NMSettingsConnection *
 nm_settings_get_connection_by_uuid(NMSettings *self, const char *uuid)
 {
@@ -3385,6 +3501,74 @@ nm_settings_get_connections_clone(NMSettings                    *self,
     return list;
 }
 
+/**
+ * nm_settings_get_candidate_connections_clone:
+ * @self: the #NMSetting
+ * @connection_type: (nullable): if set, only return connections of this
+ *   type.
+ * @iface: (nullable): the interface name of the device.
+ * @out_len: (optional): optional output argument
+ * @func: caller-supplied function for filtering connections
+ * @func_data: caller-supplied data passed to @func
+ * @sort_compare_func: (nullable): optional function pointer for
+ *   sorting the returned list.
+ * @sort_data: user data for @sort_compare_func.
+ *
+ * Like nm_settings_get_connections_clone(), but only returns the connections
+ * that can possibly be compatible with a device of interface name @iface.
+ * Those are the ones which have connection.interface-name set to @iface
+ * and those that don't have an interface name. This uses an index and does
+ * not iterate over all connections.
+ *
+ * Returns: (transfer container) (element-type NMSettingsConnection):
+ *   an NULL terminated array of #NMSettingsConnection objects.
+ *   Caller is responsible for freeing the returned array with free(),
+ *   the contained values do not need to be unrefed.
+ */
+NMSettingsConnection **
+nm_settings_get_candidate_connections_clone(NMSettings                    *self,
+                                            const char                    *connection_type,
+                                            const char                    *iface,
+                                            guint                         *out_len,
+                                            NMSettingsConnectionFilterFunc func,
+                                            gpointer                       func_data,
+                                            GCompareDataFunc               sort_compare_func,
+                                            gpointer                       sort_data)
+{
+    NMSettingsPrivate *priv;
+    GPtrArray         *arr;
+
+    g_return_val_if_fail(NM_IS_SETTINGS(self), NULL);
+
+    priv = NM_SETTINGS_GET_PRIVATE(self);
+
+    arr = nm_sett_util_candidate_idx_lookup(&priv->candidate_idx, connection_type, iface);
+
+    if (func) {
+        guint i, j;
+
+        for (i = 0, j = 0; i < arr->len; i++) {
+            NMSettingsConnection *sett_conn = arr->pdata[i];
+
+            if (func(self, sett_conn, func_data))
+                arr->pdata[j++] = sett_conn;
+        }
+        g_ptr_array_set_size(arr, j);
+    }
+
+    if (arr->len > 1 && sort_compare_func) {
+        g_qsort_with_data(arr->pdata,
+                          arr->len,
+                          sizeof(NMSettingsConnection *),
+                          sort_compare_func,
+                          sort_data);
+    }
+
+    NM_SET_OUT(out_len, arr->len);
+    g_ptr_array_add(arr, NULL);
+    return (NMSettingsConnection **) g_ptr_array_free(arr, FALSE);
+}
+
 NMSettingsConnection *
 nm_settings_get_connection_by_path(NMSettings *self, const char *path)
 {
@@ -4147,6 +4331,10 @@ nm_settings_start(NMSettings *self, GError **error)
                          NM_SETTINGS_PLUGIN_UNRECOGNIZED_SPECS_CHANGED,
                          G_CALLBACK(_plugin_unrecognized_specs_changed),
                          self);
+        g_signal_connect(plugin,
+                         NM_SETTINGS_PLUGIN_CONNECTIONS_CHANGED,
+                         G_CALLBACK(_plugin_connections_changed),
+                         self);
     }
 
     _plugin_unmanaged_specs_changed(NULL, self);
@@ -4248,6 +4436,8 @@ nm_settings_init(NMSettings *self)
                                           NULL,
                                           (GDestroyNotify) _sett_conn_entry_free);
 
+    nm_sett_util_candidate_idx_init(&priv->candidate_idx);
+
     priv->config = g_object_ref(nm_config_get());
 
     priv->agent_mgr = g_object_ref(nm_agent_manager_get());
@@ -4325,6 +4515,9 @@ finalize(GObject *object)
 
     nm_clear_pointer(&priv->sce_idx, g_hash_table_destroy);
 
+    nm_assert(nm_sett_util_candidate_idx_get_len(&priv->candidate_idx) == 0);
+    nm_sett_util_candidate_idx_clear(&priv->candidate_idx);
+
     g_slist_free_full(priv->unmanaged_specs, g_free);
     g_slist_free_full(priv->unrecognized_specs, g_free);
 
@@ -4383,6 +4576,14 @@ static const NMDBusInterfaceInfoExtended interface_info_settings = {
                     .out_args =
                         NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("connection", "o"), ), ),
                 .handle = impl_settings_get_connection_by_uuid, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetConnectionSettings",
+                    .in_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("connections", "ao"), ),
+                    .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("settings", "a{oa{sa{sv}}}"), ), ),
+                .handle = impl_settings_get_connection_settings, ),
             NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
                 NM_DEFINE_GDBUS_METHOD_INFO_INIT(
                     "AddConnection",
@@ -92,6 +92,16 @@ NMSettingsConnection **nm_settings_get_connections_clone(NMSettings
                                                          GCompareDataFunc sort_compare_func,
                                                          gpointer         sort_data);
 
+NMSettingsConnection **
+nm_settings_get_candidate_connections_clone(NMSettings                    *self,
+                                            const char                    *connection_type,
+                                            const char                    *iface,
+                                            guint                         *out_len,
+                                            NMSettingsConnectionFilterFunc func,
+                                            gpointer                       func_data,
+                                            GCompareDataFunc               sort_compare_func,
+                                            gpointer                       sort_data);
+
 gboolean nm_settings_add_connection(NMSettings                     *settings,
                                     const char                     *plugin,
                                     NMConnection                   *connection,
@@ -0,0 +1,522 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "nms-keyfile-cache.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "libnm-glib-aux/nm-io-utils.h"
+#include "libnm-glib-aux/nm-uuid.h"
+#include "libnm-core-intern/nm-core-internal.h"
+#include "nm-connection.h"
+
+#include "nms-keyfile-utils.h"
+
+/*****************************************************************************/
+
+/* Bump this whenever the format of the entries changes. The cache is also
+ * discarded when NetworkManager's version changes, because the normalization
+ * of the profiles might differ.
+ *
+ * Format 2 no longer contains secrets. */
+#define CACHE_FORMAT 2
+
+/* (format, version, profile-dir, entries)
+ *
+ * Each entry is keyed by the full filename of the keyfile and contains
+ * (dev, ino, size, mtime-sec, mtime-nsec, ctime-sec, ctime-nsec,
+ * is-nm-generated, is-volatile, is-external, shadowed-owned,
+ * shadowed-storage, connection). */
+#define CACHE_ENTRY_TYPE_STR "(ttxxxxxiiiimsa{sa{sv}})"
+#define CACHE_TYPE_STR       "(ussa{s" CACHE_ENTRY_TYPE_STR "})"
+
+typedef struct {
+    /* must be the first field, the entries are hashed by nm_pstr_hash(). */
+    char     *filename;
+    GVariant *data;
+
+    /* whether the entry was looked up or added since the last pruning. */
+    bool used;
+} CacheEntry;
+
+struct _NMSKeyfileCache {
+    char       *filename;
+    char       *profile_dir;
+    GHashTable *entries;
+    guint       n_hits;
+    bool        dirty : 1;
+};
+
+/*****************************************************************************/
+
+#define _NMLOG_PREFIX_NAME "keyfile"
+#define _NMLOG_DOMAIN      LOGD_SETTINGS
+#define _NMLOG(level, ...)                          \
+    nm_log((level),                                 \
+           _NMLOG_DOMAIN,                           \
+           NULL,                                    \
+           NULL,                                    \
+           "%s" _NM_UTILS_MACRO_FIRST(__VA_ARGS__), \
+           _NMLOG_PREFIX_NAME ": cache: " _NM_UTILS_MACRO_REST(__VA_ARGS__))
+
+/*****************************************************************************/
+
+static NMTernary
+_ternary_from_int(gint32 v)
+{
+    if (v < 0)
+        return NM_TERNARY_DEFAULT;
+    return v ? NM_TERNARY_TRUE : NM_TERNARY_FALSE;
+}
+
+static void
+_cache_entry_free(gpointer data)
+{
+    CacheEntry *entry = data;
+
+    g_free(entry->filename);
+    g_variant_unref(entry->data);
+    nm_g_slice_free(entry);
+}
+
+static CacheEntry *
+_cache_entry_set(NMSKeyfileCache *cache, const char *filename, GVariant *data)
+{
+    CacheEntry *entry;
+
+    entry = g_hash_table_lookup(cache->entries, &filename);
+    if (!entry) {
+        entry  = g_slice_new(CacheEntry);
+        *entry = (CacheEntry) {
+            .filename = g_strdup(filename),
+        };
+        g_hash_table_add(cache->entries, entry);
+    } else
+        g_variant_unref(entry->data);
+
+    entry->data = g_variant_ref_sink(data);
+    return entry;
+}
+
+static void
+_cache_load(NMSKeyfileCache *cache)
+{
+    gs_free_error GError      *error     = NULL;
+    gs_unref_bytes GBytes     *bytes     = NULL;
+    gs_unref_variant GVariant *v         = NULL;
+    gs_unref_variant GVariant *v_entries = NULL;
+    nm_auto_close int          fd        = -1;
+    GMappedFile               *mapped;
+    struct stat                st;
+    guint32                    format;
+    const char                *version;
+    const char                *profile_dir;
+    GVariantIter               iter;
+    const char                *filename;
+    GVariant                  *data;
+    int                        errsv;
+
+    fd = open(cache->filename, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        errsv = errno;
+        if (errsv != ENOENT)
+            _LOGD("failed to open \"%s\": %s", cache->filename, nm_strerror_native(errsv));
+        return;
+    }
+
+    if (fstat(fd, &st) != 0) {
+        errsv = errno;
+        _LOGD("failed to stat \"%s\": %s", cache->filename, nm_strerror_native(errsv));
+        return;
+    }
+
+    /* the cache contains the profiles (without secrets). Only trust it under
+     * the same conditions as a keyfile. */
+    if (!nms_keyfile_utils_check_file_permissions_stat(NMS_KEYFILE_FILETYPE_KEYFILE,
+                                                       &st,
+                                                       &error)) {
+        _LOGD("ignore \"%s\": %s", cache->filename, error->message);
+        return;
+    }
+
+    mapped = g_mapped_file_new_from_fd(fd, FALSE, &error);
+    if (!mapped) {
+        _LOGD("failed to map \"%s\": %s", cache->filename, error->message);
+        return;
+    }
+    bytes = g_mapped_file_get_bytes(mapped);
+    g_mapped_file_unref(mapped);
+
+    /* The data is not trusted to be in normal form. GVariant handles that
+     * gracefully, and only validates the parts that we actually access. */
+    v = g_variant_ref_sink(g_variant_new_from_bytes(G_VARIANT_TYPE(CACHE_TYPE_STR), bytes, FALSE));
+
+    g_variant_get(v,
+                  "(u&s&s@a{s" CACHE_ENTRY_TYPE_STR "})",
+                  &format,
+                  &version,
+                  &profile_dir,
+                  &v_entries);
+    if (format != CACHE_FORMAT || !nm_streq(version, VERSION)
+        || !nm_streq(profile_dir, cache->profile_dir)) {
+        _LOGD("discard \"%s\" from a different version or configuration", cache->filename);
+        /* overwrite the file on the next commit. An older format might contain
+         * secrets, that should not stay on disk. */
+        cache->dirty = TRUE;
+        return;
+    }
+
+    g_variant_iter_init(&iter, v_entries);
+    while (g_variant_iter_next(&iter, "{&s@" CACHE_ENTRY_TYPE_STR "}", &filename, &data)) {
+        if (filename[0] == '/')
+            _cache_entry_set(cache, filename, data);
+        g_variant_unref(data);
+    }
+
+    _LOGD("loaded %u entries from \"%s\"", g_hash_table_size(cache->entries), cache->filename);
+}
+
+/*****************************************************************************/
+
+static gboolean
+_cache_entry_matches_stat(const CacheEntry *entry, const struct stat *st)
+{
+    guint64 dev;
+    guint64 ino;
+    gint64  size;
+    gint64  mtime_sec;
+    gint64  mtime_nsec;
+    gint64  ctime_sec;
+    gint64  ctime_nsec;
+
+    g_variant_get(entry->data,
+                  CACHE_ENTRY_TYPE_STR,
+                  &dev,
+                  &ino,
+                  &size,
+                  &mtime_sec,
+                  &mtime_nsec,
+                  &ctime_sec,
+                  &ctime_nsec,
+                  NULL,
+                  NULL,
+                  NULL,
+                  NULL,
+                  NULL,
+                  NULL);
+
+    /* The ctime cannot be set from user space. Together with the mtime,
+     * that catches all modifications of the file, even if the size
+     * did not change or the mtime was restored afterwards. */
+    return dev == (guint64) st->st_dev && ino == (guint64) st->st_ino && size == st->st_size
+           && mtime_sec == st->st_mtim.tv_sec && mtime_nsec == st->st_mtim.tv_nsec
+           && ctime_sec == st->st_ctim.tv_sec && ctime_nsec == st->st_ctim.tv_nsec;
+}
+
+/**
+ * nms_keyfile_cache_contains:
+ * @cache: the #NMSKeyfileCache
+ * @full_filename: the keyfile
+ * @st: the current stat() data of @full_filename
+ *
+ * Checks whether there is an entry for @full_filename that matches @st.
+ * This does not modify the cache, and may be called from a worker thread.
+ *
+ * Returns: whether nms_keyfile_cache_lookup() will likely find the profile.
+ */
+gboolean
+nms_keyfile_cache_contains(const NMSKeyfileCache *cache,
+                           const char            *full_filename,
+                           const struct stat     *st)
+{
+    const CacheEntry *entry;
+
+    nm_assert(cache);
+    nm_assert(full_filename && full_filename[0] == '/');
+    nm_assert(st);
+
+    entry = g_hash_table_lookup(cache->entries, &full_filename);
+    return entry && _cache_entry_matches_stat(entry, st);
+}
+
+/**
+ * nms_keyfile_cache_lookup:
+ * @cache: the #NMSKeyfileCache
+ * @full_filename: the keyfile
+ * @st: the current stat() data of @full_filename
+ * @out_is_nm_generated: (out): the cached nm-generated flag
+ * @out_is_volatile: (out): the cached volatile flag
+ * @out_is_external: (out): the cached external flag
+ * @out_shadowed_storage: (out) (transfer full): the cached shadowed storage
+ * @out_shadowed_owned: (out): the cached shadowed-owned flag
+ *
+ * Looks up the profile of @full_filename. The entry is only used if
+ * the inode, size and timestamps in @st match the ones at the time
+ * the entry was added.
+ *
+ * Returns: (transfer full): the normalized connection, or %NULL if
+ *   there is no valid cache entry for the file.
+ */
+NMConnection *
+nms_keyfile_cache_lookup(NMSKeyfileCache   *cache,
+                         const char        *full_filename,
+                         const struct stat *st,
+                         NMTernary         *out_is_nm_generated,
+                         NMTernary         *out_is_volatile,
+                         NMTernary         *out_is_external,
+                         char             **out_shadowed_storage,
+                         NMTernary         *out_shadowed_owned)
+{
+    gs_unref_variant GVariant    *v_connection = NULL;
+    gs_unref_object NMConnection *connection   = NULL;
+    CacheEntry                   *entry;
+    gint32                        is_nm_generated;
+    gint32                        is_volatile;
+    gint32                        is_external;
+    gint32                        shadowed_owned;
+    const char                   *shadowed_storage;
+
+    nm_assert(cache);
+    nm_assert(full_filename && full_filename[0] == '/');
+    nm_assert(st);
+
+    entry = g_hash_table_lookup(cache->entries, &full_filename);
+    if (!entry || !_cache_entry_matches_stat(entry, st))
+        return NULL;
+
+    g_variant_get(entry->data,
+                  "(ttxxxxxiiiim&s@a{sa{sv}})",
+                  NULL,
+                  NULL,
+                  NULL,
+                  NULL,
+                  NULL,
+                  NULL,
+                  NULL,
+                  &is_nm_generated,
+                  &is_volatile,
+                  &is_external,
+                  &shadowed_owned,
+                  &shadowed_storage,
+                  &v_connection);
+
+    connection =
+        _nm_simple_connection_new_from_dbus(v_connection, NM_SETTING_PARSE_FLAGS_STRICT, NULL);
+    if (!connection)
+        return NULL;
+    if (_nm_connection_verify(connection, NULL) != NM_SETTING_VERIFY_SUCCESS
+        || !nm_uuid_is_normalized(nm_connection_get_uuid(connection)))
+        return NULL;
+
+    entry->used = TRUE;
+    cache->n_hits++;
+
+    NM_SET_OUT(out_is_nm_generated, _ternary_from_int(is_nm_generated));
+    NM_SET_OUT(out_is_volatile, _ternary_from_int(is_volatile));
+    NM_SET_OUT(out_is_external, _ternary_from_int(is_external));
+    NM_SET_OUT(out_shadowed_storage, g_strdup(shadowed_storage));
+    NM_SET_OUT(out_shadowed_owned, _ternary_from_int(shadowed_owned));
+    return g_steal_pointer(&connection);
+}
+
+/**
+ * nms_keyfile_cache_add:
+ * @cache: the #NMSKeyfileCache
+ * @full_filename: the keyfile
+ * @st: the stat() data of @full_filename at the time it was read
+ * @connection: the normalized connection read from @full_filename
+ * @is_nm_generated: the nm-generated flag
+ * @is_volatile: the volatile flag
+ * @is_external: the external flag
+ * @shadowed_storage: the shadowed storage
+ * @shadowed_owned: the shadowed-owned flag
+ *
+ * Adds or replaces the entry for @full_filename. The cache never contains
+ * secrets, so a profile with secrets is not cached (and a previous entry
+ * for the file is removed).
+ */
+void
+nms_keyfile_cache_add(NMSKeyfileCache   *cache,
+                      const char        *full_filename,
+                      const struct stat *st,
+                      NMConnection      *connection,
+                      NMTernary          is_nm_generated,
+                      NMTernary          is_volatile,
+                      NMTernary          is_external,
+                      const char        *shadowed_storage,
+                      NMTernary          shadowed_owned)
+{
+    CacheEntry *entry;
+
+    nm_assert(cache);
+    nm_assert(full_filename && full_filename[0] == '/');
+    nm_assert(st);
+    nm_assert(NM_IS_CONNECTION(connection));
+
+    if (_nm_connection_aggregate(connection, NM_CONNECTION_AGGREGATE_ANY_SECRETS, NULL)) {
+        nms_keyfile_cache_remove(cache, full_filename);
+        return;
+    }
+
+    entry = _cache_entry_set(
+        cache,
+        full_filename,
+        g_variant_new("(ttxxxxxiiiims@a{sa{sv}})",
+                      (guint64) st->st_dev,
+                      (guint64) st->st_ino,
+                      (gint64) st->st_size,
+                      (gint64) st->st_mtim.tv_sec,
+                      (gint64) st->st_mtim.tv_nsec,
+                      (gint64) st->st_ctim.tv_sec,
+                      (gint64) st->st_ctim.tv_nsec,
+                      (gint32) is_nm_generated,
+                      (gint32) is_volatile,
+                      (gint32) is_external,
+                      (gint32) shadowed_owned,
+                      shadowed_storage,
+                      nm_connection_to_dbus(connection, NM_CONNECTION_SERIALIZE_WITH_NON_SECRET)));
+    entry->used  = TRUE;
+    cache->dirty = TRUE;
+}
+
+/**
+ * nms_keyfile_cache_remove:
+ * @cache: the #NMSKeyfileCache
+ * @full_filename: the keyfile
+ *
+ * Removes the entry for @full_filename, for example because the file
+ * was deleted or can no longer be loaded.
+ */
+void
+nms_keyfile_cache_remove(NMSKeyfileCache *cache, const char *full_filename)
+{
+    nm_assert(cache);
+    nm_assert(full_filename && full_filename[0] == '/');
+
+    if (g_hash_table_remove(cache->entries, &full_filename))
+        cache->dirty = TRUE;
+}
+
+/**
+ * nms_keyfile_cache_commit:
+ * @cache: the #NMSKeyfileCache
+ * @prune: whether to drop the entries that were neither looked up
+ *   nor added since the last pruning.
+ *
+ * Writes the cache to disk, if it changed. Call this with @prune after
+ * all keyfiles were loaded, so that deleted and renamed keyfiles don't
+ * stay in the cache forever.
+ */
+void
+nms_keyfile_cache_commit(NMSKeyfileCache *cache, gboolean prune)
+{
+    gs_free_error GError      *error = NULL;
+    gs_unref_variant GVariant *v     = NULL;
+    GVariantBuilder            builder;
+    GHashTableIter             h_iter;
+    CacheEntry                *entry;
+
+    nm_assert(cache);
+
+    if (prune) {
+        g_hash_table_iter_init(&h_iter, cache->entries);
+        while (g_hash_table_iter_next(&h_iter, (gpointer *) &entry, NULL)) {
+            if (!entry->used) {
+                g_hash_table_iter_remove(&h_iter);
+                cache->dirty = TRUE;
+            } else
+                entry->used = FALSE;
+        }
+    }
+
+    if (!cache->dirty)
+        return;
+    cache->dirty = FALSE;
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{s" CACHE_ENTRY_TYPE_STR "}"));
+    g_hash_table_iter_init(&h_iter, cache->entries);
+    while (g_hash_table_iter_next(&h_iter, (gpointer *) &entry, NULL))
+        g_variant_builder_add(&builder,
+                              "{s@" CACHE_ENTRY_TYPE_STR "}",
+                              entry->filename,
+                              entry->data);
+
+    v = g_variant_ref_sink(g_variant_new("(uss@a{s" CACHE_ENTRY_TYPE_STR "})",
+                                         (guint32) CACHE_FORMAT,
+                                         VERSION,
+                                         cache->profile_dir,
+                                         g_variant_builder_end(&builder)));
+
+    if (!nm_utils_file_set_contents(cache->filename,
+                                    g_variant_get_data(v),
+                                    g_variant_get_size(v),
+                                    0600,
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    &error)) {
+        _LOGW("failed to write \"%s\": %s", cache->filename, error->message);
+        return;
+    }
+
+    _LOGT("wrote %u entries to \"%s\"", g_hash_table_size(cache->entries), cache->filename);
+}
+
+guint
+nms_keyfile_cache_get_len(const NMSKeyfileCache *cache)
+{
+    nm_assert(cache);
+
+    return g_hash_table_size(cache->entries);
+}
+
+guint
+nms_keyfile_cache_get_n_hits(const NMSKeyfileCache *cache)
+{
+    nm_assert(cache);
+
+    return cache->n_hits;
+}
+
+gboolean
+nms_keyfile_cache_is_dirty(const NMSKeyfileCache *cache)
+{
+    nm_assert(cache);
+
+    return cache->dirty;
+}
+
+/*****************************************************************************/
+
+NMSKeyfileCache *
+nms_keyfile_cache_new(const char *filename, const char *profile_dir)
+{
+    NMSKeyfileCache *cache;
+
+    nm_assert(filename && filename[0] == '/');
+    nm_assert(profile_dir && profile_dir[0] == '/');
+
+    cache  = g_slice_new(NMSKeyfileCache);
+    *cache = (NMSKeyfileCache) {
+        .filename    = g_strdup(filename),
+        .profile_dir = g_strdup(profile_dir),
+        .entries     = g_hash_table_new_full(nm_pstr_hash, nm_pstr_equal, _cache_entry_free, NULL),
+    };
+
+    _cache_load(cache);
+    return cache;
+}
+
+void
+nms_keyfile_cache_free(NMSKeyfileCache *cache)
+{
+    if (!cache)
+        return;
+
+    g_hash_table_unref(cache->entries);
+    g_free(cache->filename);
+    g_free(cache->profile_dir);
+    nm_g_slice_free(cache);
+}
@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __NMS_KEYFILE_CACHE_H__
+#define __NMS_KEYFILE_CACHE_H__
+
+#include <sys/stat.h>
+
+/*****************************************************************************/
+
+/* NMSKeyfileCache is an on-disk cache of the profiles that the keyfile plugin
+ * read. For each keyfile it remembers the normalized connection (without
+ * secrets) and the [.nmmeta] flags, keyed by the filename and the stat() data
+ * of the file.
+ * The cache file is mapped into memory, so that unchanged profiles can be
+ * loaded without parsing the keyfile again.
+ *
+ * nms_keyfile_cache_contains() may be called from worker threads, as long as
+ * no other function modifies the cache at the same time. */
+
+typedef struct _NMSKeyfileCache NMSKeyfileCache;
+
+#define NMS_KEYFILE_CACHE_FILENAME NMSTATEDIR "/keyfile-cache"
+
+NMSKeyfileCache *nms_keyfile_cache_new(const char *filename, const char *profile_dir);
+
+void nms_keyfile_cache_free(NMSKeyfileCache *cache);
+
+gboolean nms_keyfile_cache_contains(const NMSKeyfileCache *cache,
+                                    const char            *full_filename,
+                                    const struct stat     *st);
+
+NMConnection *nms_keyfile_cache_lookup(NMSKeyfileCache   *cache,
+                                       const char        *full_filename,
+                                       const struct stat *st,
+                                       NMTernary         *out_is_nm_generated,
+                                       NMTernary         *out_is_volatile,
+                                       NMTernary         *out_is_external,
+                                       char             **out_shadowed_storage,
+                                       NMTernary         *out_shadowed_owned);
+
+void nms_keyfile_cache_add(NMSKeyfileCache   *cache,
+                           const char        *full_filename,
+                           const struct stat *st,
+                           NMConnection      *connection,
+                           NMTernary          is_nm_generated,
+                           NMTernary          is_volatile,
+                           NMTernary          is_external,
+                           const char        *shadowed_storage,
+                           NMTernary          shadowed_owned);
+
+void nms_keyfile_cache_remove(NMSKeyfileCache *cache, const char *full_filename);
+
+void nms_keyfile_cache_commit(NMSKeyfileCache *cache, gboolean prune);
+
+guint nms_keyfile_cache_get_len(const NMSKeyfileCache *cache);
+
+guint nms_keyfile_cache_get_n_hits(const NMSKeyfileCache *cache);
+
+gboolean nms_keyfile_cache_is_dirty(const NMSKeyfileCache *cache);
+
+#endif /* __NMS_KEYFILE_CACHE_H__ */
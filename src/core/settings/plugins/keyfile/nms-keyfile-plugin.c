@@ -9,6 +9,7 @@
 #include "nms-keyfile-plugin.h"
 
 #include <sys/stat.h>
+#include <sys/inotify.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/time.h>
@@ -34,9 +35,16 @@
 #include "nms-keyfile-writer.h"
 #include "nms-keyfile-reader.h"
 #include "nms-keyfile-utils.h"
+#include "nms-keyfile-cache.h"
 
 /*****************************************************************************/
 
+typedef enum {
+    WATCH_MODE_NO,
+    WATCH_MODE_YES,
+    WATCH_MODE_AUTO,
+} WatchMode;
+
 typedef struct {
     NMConfig *config;
 
@@ -59,6 +67,25 @@ typedef struct {
 
     NMSettUtilStorages storages;
 
+    /* optional, see NM_CONFIG_KEYFILE_KEY_KEYFILE_CACHE. */
+    NMSKeyfileCache *cache;
+    GSource         *cache_commit_source;
+
+    /* Tracks the files in the keyfile directories that changed since the last
+     * reload, see NM_CONFIG_KEYFILE_KEY_KEYFILE_WATCH. */
+    struct {
+        GHashTable *dirnames_by_wd;
+        GHashTable *dirty_filenames;
+        GSource    *source;
+        GSource    *auto_reload_source;
+        int         fd;
+        WatchMode   mode;
+
+        /* whether all directories are watched and no events were lost.
+         * Only then, reload can limit itself to the dirty files. */
+        bool valid : 1;
+    } watch;
+
 } NMSKeyfilePluginPrivate;
 
 struct _NMSKeyfilePlugin {
@@ -206,29 +233,31 @@ _path_detect_storage_type(const char            *full_filename,
 /*****************************************************************************/
 
 static NMConnection *
-_read_from_file(const char  *full_filename,
-                const char  *plugin_dir,
-                struct stat *out_stat,
-                NMTernary   *out_is_nm_generated,
-                NMTernary   *out_is_volatile,
-                NMTernary   *out_is_external,
-                char       **out_shadowed_storage,
-                NMTernary   *out_shadowed_owned,
-                GError     **error)
+_read_from_keyfile(GKeyFile   *key_file,
+                   const char *full_filename,
+                   const char *plugin_dir,
+                   NMTernary  *out_is_nm_generated,
+                   NMTernary  *out_is_volatile,
+                   NMTernary  *out_is_external,
+                   char      **out_shadowed_storage,
+                   NMTernary  *out_shadowed_owned,
+                   gboolean   *out_has_warnings,
+                   GError    **error)
 {
     NMConnection *connection;
 
     nm_assert(full_filename && full_filename[0] == '/');
 
-    connection = nms_keyfile_reader_from_file(full_filename,
-                                              plugin_dir,
-                                              out_stat,
-                                              out_is_nm_generated,
-                                              out_is_volatile,
-                                              out_is_external,
-                                              out_shadowed_storage,
-                                              out_shadowed_owned,
-                                              error);
+    connection = nms_keyfile_reader_from_loaded_keyfile(key_file,
+                                                        full_filename,
+                                                        plugin_dir,
+                                                        out_is_nm_generated,
+                                                        out_is_volatile,
+                                                        out_is_external,
+                                                        out_shadowed_storage,
+                                                        out_shadowed_owned,
+                                                        out_has_warnings,
+                                                        error);
 
     nm_assert(!connection
               || (_nm_connection_verify(connection, NULL) == NM_SETTING_VERIFY_SUCCESS));
@@ -291,6 +320,168 @@ _nm_assert_storage(gpointer plugin /* NMSKeyfilePlugin  */,
 
 /*****************************************************************************/
 
+/* Loading a few profiles only changes a few entries, but the cache is a single
+ * file that is always written as a whole. Coalesce such writes. */
+#define CACHE_COMMIT_DELAY_SEC 10u
+
+static gboolean
+_cache_commit_cb(gpointer user_data)
+{
+    NMSKeyfilePlugin        *self = user_data;
+    NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+
+    nm_clear_g_source_inst(&priv->cache_commit_source);
+    nms_keyfile_cache_commit(priv->cache, FALSE);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_cache_commit(NMSKeyfilePlugin *self, gboolean full_reload)
+{
+    NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+
+    if (!priv->cache)
+        return;
+
+    if (full_reload) {
+        /* after a full reload we know all files, and can drop the entries for
+         * files that no longer exist. */
+        nm_clear_g_source_inst(&priv->cache_commit_source);
+        nms_keyfile_cache_commit(priv->cache, TRUE);
+        return;
+    }
+
+    if (!priv->cache_commit_source && nms_keyfile_cache_is_dirty(priv->cache)) {
+        priv->cache_commit_source =
+            nm_g_timeout_add_seconds_source(CACHE_COMMIT_DELAY_SEC, _cache_commit_cb, self);
+    }
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    const char *filename;
+    char       *full_filename;
+    GKeyFile   *key_file;
+    GError     *error;
+    struct stat st;
+    bool        in_cache : 1;
+} LoadFileData;
+
+static void
+_load_file_data_clear(LoadFileData *lfd)
+{
+    nm_clear_g_free(&lfd->full_filename);
+    nm_clear_pointer(&lfd->key_file, g_key_file_unref);
+    g_clear_error(&lfd->error);
+}
+
+static void
+_load_file_data_read(LoadFileData *lfd, NMSKeyfileCache *cache)
+{
+    /* This may run on a worker thread (see _load_dir()). It must only touch
+     * @lfd and do the file I/O. Creating the connection from the keyfile
+     * and logging is left to _load_file_data_complete() on the main thread. */
+    if (!nms_keyfile_utils_check_file_permissions(NMS_KEYFILE_FILETYPE_KEYFILE,
+                                                  lfd->full_filename,
+                                                  &lfd->st,
+                                                  &lfd->error))
+        return;
+
+    if (cache && nms_keyfile_cache_contains(cache, lfd->full_filename, &lfd->st)) {
+        lfd->in_cache = TRUE;
+        return;
+    }
+
+    lfd->key_file = nms_keyfile_reader_load_keyfile(lfd->full_filename, &lfd->error);
+}
+
+static NMSKeyfileStorage *
+_load_file_data_complete(NMSKeyfilePlugin     *self,
+                         LoadFileData         *lfd,
+                         NMSKeyfileStorageType storage_type,
+                         GError              **error)
+{
+    NMSKeyfilePluginPrivate      *priv             = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+    gs_unref_object NMConnection *connection       = NULL;
+    gs_free char                 *shadowed_storage = NULL;
+    NMTernary                     is_nm_generated_opt;
+    NMTernary                     is_volatile_opt;
+    NMTernary                     is_external_opt;
+    NMTernary                     shadowed_owned_opt;
+    gboolean                      has_warnings;
+
+    if (lfd->in_cache) {
+        connection = nms_keyfile_cache_lookup(priv->cache,
+                                              lfd->full_filename,
+                                              &lfd->st,
+                                              &is_nm_generated_opt,
+                                              &is_volatile_opt,
+                                              &is_external_opt,
+                                              &shadowed_storage,
+                                              &shadowed_owned_opt);
+        if (!connection) {
+            /* the cache entry turned out to be unusable. */
+            lfd->key_file = nms_keyfile_reader_load_keyfile(lfd->full_filename, &lfd->error);
+        }
+    }
+
+    if (!connection && lfd->key_file) {
+        connection = _read_from_keyfile(lfd->key_file,
+                                        lfd->full_filename,
+                                        _get_plugin_dir(priv),
+                                        &is_nm_generated_opt,
+                                        &is_volatile_opt,
+                                        &is_external_opt,
+                                        &shadowed_storage,
+                                        &shadowed_owned_opt,
+                                        &has_warnings,
+                                        &lfd->error);
+
+        /* only profiles that load without warnings are cached, so that the
+         * warnings are logged again on every load. Profiles in /run don't
+         * survive a reboot and are not cached either. */
+        if (connection && priv->cache && !has_warnings
+            && storage_type != NMS_KEYFILE_STORAGE_TYPE_RUN) {
+            nms_keyfile_cache_add(priv->cache,
+                                  lfd->full_filename,
+                                  &lfd->st,
+                                  connection,
+                                  is_nm_generated_opt,
+                                  is_volatile_opt,
+                                  is_external_opt,
+                                  shadowed_storage,
+                                  shadowed_owned_opt);
+        } else if (priv->cache) {
+            nms_keyfile_cache_remove(priv->cache, lfd->full_filename);
+        }
+    }
+
+    if (!connection) {
+        if (priv->cache)
+            nms_keyfile_cache_remove(priv->cache, lfd->full_filename);
+        if (error)
+            g_propagate_error(error, g_steal_pointer(&lfd->error));
+        else {
+            _LOGW("load: \"%s\": failed to load connection: %s",
+                  lfd->full_filename,
+                  lfd->error->message);
+        }
+        return NULL;
+    }
+
+    return nms_keyfile_storage_new_connection(self,
+                                              g_steal_pointer(&connection),
+                                              lfd->full_filename,
+                                              storage_type,
+                                              is_nm_generated_opt,
+                                              is_volatile_opt,
+                                              is_external_opt,
+                                              shadowed_storage,
+                                              shadowed_owned_opt,
+                                              &lfd->st.st_mtim);
+}
+
 static NMSKeyfileStorage *
 _load_file(NMSKeyfilePlugin     *self,
            const char           *dirname,
@@ -298,16 +489,8 @@ _load_file(NMSKeyfilePlugin     *self,
            NMSKeyfileStorageType storage_type,
            GError              **error)
 {
-    NMSKeyfilePluginPrivate      *priv;
-    gs_unref_object NMConnection *connection = NULL;
-    NMTernary                     is_nm_generated_opt;
-    NMTernary                     is_volatile_opt;
-    NMTernary                     is_external_opt;
-    NMTernary                     shadowed_owned_opt;
-    gs_free char                 *shadowed_storage = NULL;
-    gs_free_error GError         *local            = NULL;
-    gs_free char                 *full_filename    = NULL;
-    struct stat                   st;
+    nm_auto(_load_file_data_clear) LoadFileData lfd           = {};
+    gs_free char                               *full_filename = NULL;
 
     if (_ignore_filename(storage_type, filename)) {
         gs_free char *nmmeta                    = NULL;
@@ -367,37 +550,10 @@ _load_file(NMSKeyfilePlugin     *self,
                                                  shadowed_storage_filename);
     }
 
-    full_filename = g_build_filename(dirname, filename, NULL);
-
-    priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
-
-    connection = _read_from_file(full_filename,
-                                 _get_plugin_dir(priv),
-                                 &st,
-                                 &is_nm_generated_opt,
-                                 &is_volatile_opt,
-                                 &is_external_opt,
-                                 &shadowed_storage,
-                                 &shadowed_owned_opt,
-                                 &local);
-    if (!connection) {
-        if (error)
-            g_propagate_error(error, g_steal_pointer(&local));
-        else
-            _LOGW("load: \"%s\": failed to load connection: %s", full_filename, local->message);
-        return NULL;
-    }
-
-    return nms_keyfile_storage_new_connection(self,
-                                              g_steal_pointer(&connection),
-                                              full_filename,
-                                              storage_type,
-                                              is_nm_generated_opt,
-                                              is_volatile_opt,
-                                              is_external_opt,
-                                              shadowed_storage,
-                                              shadowed_owned_opt,
-                                              &st.st_mtim);
+    lfd.filename      = filename;
+    lfd.full_filename = g_build_filename(dirname, filename, NULL);
+    _load_file_data_read(&lfd, NMS_KEYFILE_PLUGIN_GET_PRIVATE(self)->cache);
+    return _load_file_data_complete(self, &lfd, storage_type, error);
 }
 
 static NMSKeyfileStorage *
@@ -418,15 +574,30 @@ _load_file_from_path(NMSKeyfilePlugin     *self,
     return _load_file(self, f_dirname, f_filename, storage_type, error);
 }
 
+/* Below this number of profiles, _load_dir() reads them on the main thread. */
+#define LOAD_DIR_PARALLEL_MIN_FILES 64u
+#define LOAD_DIR_MAX_THREADS        8u
+
+static void
+_load_dir_thread_cb(gpointer data, gpointer user_data)
+{
+    _load_file_data_read(data, user_data);
+}
+
 static void
 _load_dir(NMSKeyfilePlugin     *self,
           NMSKeyfileStorageType storage_type,
           const char           *dirname,
           NMSettUtilStorages   *storages)
 {
+    NMSKeyfilePluginPrivate       *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
     const char                    *filename;
     GDir                          *dir;
     gs_unref_hashtable GHashTable *dupl_filenames = NULL;
+    gs_unref_array GArray         *lfds           = NULL;
+    gboolean                       parallel;
+    guint                          n_files = 0;
+    guint                          i;
 
     dir = g_dir_open(dirname, 0, NULL);
     if (!dir)
@@ -434,22 +605,71 @@ _load_dir(NMSKeyfilePlugin     *self,
 
     dupl_filenames = g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, g_free);
 
+    lfds = g_array_new(FALSE, FALSE, sizeof(LoadFileData));
+    g_array_set_clear_func(lfds, (GDestroyNotify) _load_file_data_clear);
+
     while ((filename = g_dir_read_name(dir))) {
-        gs_unref_object NMSKeyfileStorage *storage = NULL;
+        LoadFileData *lfd;
 
         filename = g_strdup(filename);
         if (!g_hash_table_add(dupl_filenames, (char *) filename))
             continue;
 
-        storage = _load_file(self, dirname, filename, storage_type, NULL);
+        lfd  = nm_g_array_append_new(lfds, LoadFileData);
+        *lfd = (LoadFileData) {
+            .filename = filename,
+        };
+
+        /* nmmeta files (and invalid filenames) are left to _load_file(). */
+        if (!_ignore_filename(storage_type, filename)) {
+            lfd->full_filename = g_build_filename(dirname, filename, NULL);
+            n_files++;
+        }
+    }
+
+    g_dir_close(dir);
+
+    /* With many profiles, read and parse the files on a pool of worker threads.
+     * Creating and normalizing the connections is not thread-safe, that is
+     * done below on the main thread, in directory order. The storages and the
+     * logging messages are thus the same as when reading the files one by one. */
+    parallel = (n_files >= LOAD_DIR_PARALLEL_MIN_FILES);
+    if (parallel) {
+        GThreadPool *pool;
+
+        _LOGT("load: \"%s\": read %u files in parallel", dirname, n_files);
+
+        pool = g_thread_pool_new(_load_dir_thread_cb,
+                                 priv->cache,
+                                 NM_CLAMP(g_get_num_processors(), 1u, LOAD_DIR_MAX_THREADS),
+                                 FALSE,
+                                 NULL);
+        for (i = 0; i < lfds->len; i++) {
+            LoadFileData *lfd = &nm_g_array_index(lfds, LoadFileData, i);
+
+            if (lfd->full_filename)
+                g_thread_pool_push(pool, lfd, NULL);
+        }
+        g_thread_pool_free(pool, FALSE, TRUE);
+    }
+
+    for (i = 0; i < lfds->len; i++) {
+        LoadFileData                      *lfd     = &nm_g_array_index(lfds, LoadFileData, i);
+        gs_unref_object NMSKeyfileStorage *storage = NULL;
+
+        if (!lfd->full_filename)
+            storage = _load_file(self, dirname, lfd->filename, storage_type, NULL);
+        else {
+            if (!parallel)
+                _load_file_data_read(lfd, priv->cache);
+            storage = _load_file_data_complete(self, lfd, storage_type, NULL);
+        }
         if (!storage)
             continue;
 
         nm_sett_util_storages_add_take(storages, g_steal_pointer(&storage));
     }
 
-    g_dir_close(dir);
-
 #if NM_MORE_ASSERTS
     {
         NMSKeyfileStorage *storage;
@@ -573,6 +793,267 @@ _storages_consolidate(NMSKeyfilePlugin                      *self,
     }
 }
 
+/*****************************************************************************/
+
+#define WATCH_MASK                                                                    \
+    (IN_CREATE | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO \
+     | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR)
+
+/* With [keyfile].watch=auto, reload this long after the first change. Tools
+ * usually modify several files in a row, this avoids reloading for each. */
+#define WATCH_AUTO_RELOAD_DELAY_MSEC 1000u
+
+static void
+_watch_stop(NMSKeyfilePlugin *self)
+{
+    NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+
+    nm_clear_g_source_inst(&priv->watch.source);
+    nm_clear_g_source_inst(&priv->watch.auto_reload_source);
+    nm_clear_fd(&priv->watch.fd);
+    nm_clear_pointer(&priv->watch.dirnames_by_wd, g_hash_table_unref);
+    nm_clear_pointer(&priv->watch.dirty_filenames, g_hash_table_unref);
+    priv->watch.valid = FALSE;
+}
+
+static void
+_watch_read_events(NMSKeyfilePlugin *self)
+{
+    NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+    char                     buf[4096] _nm_alignas(struct inotify_event);
+
+    if (priv->watch.fd < 0)
+        return;
+
+    for (;;) {
+        const struct inotify_event *event;
+        const char                 *dirname;
+        gssize                      n;
+        gssize                      offset;
+
+        n = read(priv->watch.fd, buf, sizeof(buf));
+        if (n < 0) {
+            int errsv = errno;
+
+            if (errsv == EINTR)
+                continue;
+            if (errsv != EAGAIN) {
+                _LOGD("watch: failure reading events: %s", nm_strerror_native(errsv));
+                priv->watch.valid = FALSE;
+            }
+            return;
+        }
+        if (n == 0)
+            return;
+
+        for (offset = 0; offset < n; offset += sizeof(struct inotify_event) + event->len) {
+            event = (const struct inotify_event *) &buf[offset];
+
+            if (NM_FLAGS_ANY(event->mask,
+                             IN_Q_OVERFLOW | IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) {
+                if (priv->watch.valid)
+                    _LOGD("watch: lost track of changes, the next reload reads all files");
+                priv->watch.valid = FALSE;
+                continue;
+            }
+
+            if (event->len == 0)
+                continue;
+
+            dirname = g_hash_table_lookup(priv->watch.dirnames_by_wd, GINT_TO_POINTER(event->wd));
+            if (!dirname)
+                continue;
+
+            g_hash_table_add(priv->watch.dirty_filenames,
+                             g_build_filename(dirname, event->name, NULL));
+        }
+    }
+}
+
+static gboolean
+_watch_auto_reload_cb(gpointer user_data)
+{
+    NMSKeyfilePlugin        *self = user_data;
+    NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+
+    nm_clear_g_source_inst(&priv->watch.auto_reload_source);
+
+    _LOGD("watch: files changed, request reload");
+    _nm_settings_plugin_emit_signal_connections_changed(NM_SETTINGS_PLUGIN(self));
+    return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+_watch_event_cb(int fd, GIOCondition condition, gpointer user_data)
+{
+    NMSKeyfilePlugin        *self = user_data;
+    NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+
+    _watch_read_events(self);
+
+    if (priv->watch.mode == WATCH_MODE_AUTO && !priv->watch.auto_reload_source
+        && (!priv->watch.valid || g_hash_table_size(priv->watch.dirty_filenames) > 0)) {
+        priv->watch.auto_reload_source =
+            nm_g_timeout_add_source(WATCH_AUTO_RELOAD_DELAY_MSEC, _watch_auto_reload_cb, self);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_watch_start(NMSKeyfilePlugin *self)
+{
+    NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+    const char              *dirnames[G_N_ELEMENTS(priv->dirname_libs) + 2];
+    guint                    n_dirnames = 0;
+    guint                    i;
+    int                      errsv;
+
+    _watch_stop(self);
+
+    if (priv->watch.mode == WATCH_MODE_NO)
+        return;
+
+    priv->watch.fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (priv->watch.fd < 0) {
+        errsv = errno;
+        _LOGW("watch: cannot initialize inotify: %s", nm_strerror_native(errsv));
+        return;
+    }
+
+    priv->watch.dirnames_by_wd  = g_hash_table_new(nm_direct_hash, NULL);
+    priv->watch.dirty_filenames = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+    priv->watch.valid           = TRUE;
+
+    /* The directory in /run only gets created when the first profile is
+     * stored there. Create it now, so that it can be watched. */
+    (void) g_mkdir_with_parents(priv->dirname_run, 0755);
+
+    dirnames[n_dirnames++] = priv->dirname_run;
+    if (priv->dirname_etc)
+        dirnames[n_dirnames++] = priv->dirname_etc;
+    for (i = 0; priv->dirname_libs[i]; i++)
+        dirnames[n_dirnames++] = priv->dirname_libs[i];
+
+    for (i = 0; i < n_dirnames; i++) {
+        int wd;
+
+        wd = inotify_add_watch(priv->watch.fd, dirnames[i], WATCH_MASK);
+        if (wd < 0) {
+            errsv = errno;
+            _LOGD("watch: cannot watch \"%s\" (%s), reload will read all files",
+                  dirnames[i],
+                  nm_strerror_native(errsv));
+            priv->watch.valid = FALSE;
+            continue;
+        }
+        g_hash_table_insert(priv->watch.dirnames_by_wd, GINT_TO_POINTER(wd), (char *) dirnames[i]);
+    }
+
+    priv->watch.source = nm_g_unix_fd_source_new(priv->watch.fd,
+                                                 G_IO_IN,
+                                                 G_PRIORITY_DEFAULT,
+                                                 _watch_event_cb,
+                                                 self,
+                                                 NULL);
+    g_source_attach(priv->watch.source, NULL);
+}
+
+static gboolean
+_reload_connections_dirty(NMSKeyfilePlugin                      *self,
+                          NMSettingsPluginConnectionLoadCallback callback,
+                          gpointer                               user_data)
+{
+    NMSKeyfilePluginPrivate                            *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+    nm_auto_clear_sett_util_storages NMSettUtilStorages storages_new =
+        NM_SETT_UTIL_STORAGES_INIT(storages_new, nms_keyfile_storage_destroy);
+    gs_unref_hashtable GHashTable *dirty_filenames   = NULL;
+    gs_unref_hashtable GHashTable *storages_replaced = NULL;
+    GHashTableIter                 h_iter;
+    const char                    *full_filename;
+    guint                          n_loaded = 0;
+
+    /* Changes done right before the reload request might not have been
+     * processed by the mainloop yet. */
+    _watch_read_events(self);
+
+    if (!priv->watch.valid)
+        return FALSE;
+
+    dirty_filenames = g_steal_pointer(&priv->watch.dirty_filenames);
+    priv->watch.dirty_filenames = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+    nm_clear_g_source_inst(&priv->watch.auto_reload_source);
+
+    storages_replaced = g_hash_table_new_full(nm_direct_hash, NULL, g_object_unref, NULL);
+
+    g_hash_table_iter_init(&h_iter, dirty_filenames);
+    while (g_hash_table_iter_next(&h_iter, (gpointer *) &full_filename, NULL)) {
+        gs_unref_object NMSKeyfileStorage *storage = NULL;
+        NMSKeyfileStorage                 *storage_old;
+        NMSKeyfileStorageType              storage_type;
+        const char                        *f_dirname;
+        const char                        *f_filename;
+        struct stat                        st;
+        gboolean                           is_nmmeta_file;
+        gboolean                           exists;
+
+        if (!_path_detect_storage_type(full_filename,
+                                       (const char *const *) priv->dirname_libs,
+                                       priv->dirname_etc,
+                                       priv->dirname_run,
+                                       &storage_type,
+                                       &f_dirname,
+                                       &f_filename,
+                                       &is_nmmeta_file,
+                                       NULL))
+            continue;
+
+        storage_old = nm_sett_util_storages_lookup_by_filename(&priv->storages, full_filename);
+
+        /* like nms_keyfile_utils_check_file_permissions(), follow symlinks for
+         * keyfiles (so that the mtime compares to the one of the storage) but
+         * not for .nmmeta files. */
+        if (is_nmmeta_file)
+            exists = (lstat(full_filename, &st) == 0);
+        else
+            exists = (stat(full_filename, &st) == 0);
+
+        if (!exists && !storage_old)
+            continue;
+
+        /* Our own writes also cause events. Skip files that still have the
+         * timestamp from when we loaded or wrote them. */
+        if (exists && storage_old && !storage_old->is_meta_data
+            && storage_old->u.conn_data.stat_mtime.tv_sec == st.st_mtim.tv_sec
+            && storage_old->u.conn_data.stat_mtime.tv_nsec == st.st_mtim.tv_nsec)
+            continue;
+
+        if (storage_old)
+            g_hash_table_add(storages_replaced, g_object_ref(storage_old));
+
+        if (!exists) {
+            if (priv->cache)
+                nms_keyfile_cache_remove(priv->cache, full_filename);
+            continue;
+        }
+
+        storage = _load_file(self, f_dirname, f_filename, storage_type, NULL);
+        n_loaded++;
+        if (storage)
+            nm_sett_util_storages_add_take(&storages_new, g_steal_pointer(&storage));
+    }
+
+    _LOGD("reload: %u files changed, %u loaded, %u replaced",
+          g_hash_table_size(dirty_filenames),
+          n_loaded,
+          g_hash_table_size(storages_replaced));
+
+    _cache_commit(self, FALSE);
+
+    _storages_consolidate(self, &storages_new, FALSE, storages_replaced, callback, user_data);
+    return TRUE;
+}
+
 static void
 reload_connections(NMSettingsPlugin                      *plugin,
                    NMSettingsPluginConnectionLoadCallback callback,
@@ -584,12 +1065,23 @@ reload_connections(NMSettingsPlugin                      *plugin,
         NM_SETT_UTIL_STORAGES_INIT(storages_new, nms_keyfile_storage_destroy);
     int i;
 
+    if (priv->watch.mode != WATCH_MODE_NO) {
+        if (_reload_connections_dirty(self, callback, user_data))
+            return;
+
+        /* Start watching before reading the directories. Files that change
+         * while we read them, will be read again on the next reload. */
+        _watch_start(self);
+    }
+
     _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_RUN, priv->dirname_run, &storages_new);
     if (priv->dirname_etc)
         _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_ETC, priv->dirname_etc, &storages_new);
     for (i = 0; priv->dirname_libs[i]; i++)
         _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_LIB(i), priv->dirname_libs[i], &storages_new);
 
+    _cache_commit(self, TRUE);
+
     _storages_consolidate(self, &storages_new, TRUE, NULL, callback, user_data);
 }
 
@@ -738,6 +1230,8 @@ load_connections(NMSettingsPlugin                      *plugin,
     nm_clear_pointer(&loaded_uuids, g_hash_table_destroy);
     nm_clear_pointer(&dupl_filenames, g_hash_table_destroy);
 
+    _cache_commit(self, FALSE);
+
     _storages_consolidate(self, &storages_new, FALSE, storages_replaced, callback, user_data);
 }
 
@@ -1231,6 +1725,22 @@ out:
 
 /*****************************************************************************/
 
+static WatchMode
+_watch_mode_from_config(const NMConfigData *config_data)
+{
+    gs_free char *value = NULL;
+
+    value = nm_config_data_get_value(config_data,
+                                     NM_CONFIG_KEYFILE_GROUP_KEYFILE,
+                                     NM_CONFIG_KEYFILE_KEY_KEYFILE_WATCH,
+                                     NM_CONFIG_GET_VALUE_STRIP);
+    if (nm_streq0(value, "auto"))
+        return WATCH_MODE_AUTO;
+    if (_nm_utils_ascii_str_to_bool(value, FALSE))
+        return WATCH_MODE_YES;
+    return WATCH_MODE_NO;
+}
+
 static void
 config_changed_cb(NMConfig           *config,
                   NMConfigData       *config_data,
@@ -1238,8 +1748,10 @@ config_changed_cb(NMConfig           *config,
                   NMConfigData       *old_data,
                   NMSKeyfilePlugin   *self)
 {
-    gs_free char *old_value = NULL;
-    gs_free char *new_value = NULL;
+    NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+    gs_free char            *old_value = NULL;
+    gs_free char            *new_value = NULL;
+    WatchMode                watch_mode;
 
     old_value = nm_config_data_get_value(old_data,
                                          NM_CONFIG_KEYFILE_GROUP_KEYFILE,
@@ -1252,6 +1764,18 @@ config_changed_cb(NMConfig           *config,
 
     if (!nm_streq0(old_value, new_value))
         _nm_settings_plugin_emit_signal_unmanaged_specs_changed(NM_SETTINGS_PLUGIN(self));
+
+    watch_mode = _watch_mode_from_config(config_data);
+    if (watch_mode != priv->watch.mode) {
+        /* When the watch gets enabled, the next reload reads all files
+         * and starts watching. */
+        _LOGD("watch: configuration changed");
+        priv->watch.mode = watch_mode;
+        if (watch_mode == WATCH_MODE_NO)
+            _watch_stop(self);
+        else if (watch_mode != WATCH_MODE_AUTO)
+            nm_clear_g_source_inst(&priv->watch.auto_reload_source);
+    }
 }
 
 static GSList *
@@ -1279,6 +1803,8 @@ nms_keyfile_plugin_init(NMSKeyfilePlugin *plugin)
     priv->storages = (NMSettUtilStorages) NM_SETT_UTIL_STORAGES_INIT(priv->storages,
                                                                      nms_keyfile_storage_destroy);
 
+    priv->watch.fd = -1;
+
     /* dirname_libs are a set of read-only directories with lower priority than /etc or /run.
      * There is nothing complicated about having multiple of such directories, so dirname_libs
      * is a list (which currently only has at most one directory). */
@@ -1310,6 +1836,14 @@ nms_keyfile_plugin_init(NMSKeyfilePlugin *plugin)
     nm_assert(!priv->dirname_libs[0] || priv->dirname_libs[0][0] == '/');
     nm_assert(!priv->dirname_etc || priv->dirname_etc[0] == '/');
     nm_assert(priv->dirname_run && priv->dirname_run[0] == '/');
+
+    if (nm_config_data_get_value_boolean(NM_CONFIG_GET_DATA_ORIG,
+                                         NM_CONFIG_KEYFILE_GROUP_KEYFILE,
+                                         NM_CONFIG_KEYFILE_KEY_KEYFILE_CACHE,
+                                         FALSE))
+        priv->cache = nms_keyfile_cache_new(NMS_KEYFILE_CACHE_FILENAME, _get_plugin_dir(priv));
+
+    priv->watch.mode = _watch_mode_from_config(NM_CONFIG_GET_DATA_ORIG);
 }
 
 static void
@@ -1344,6 +1878,42 @@ nms_keyfile_plugin_new(void)
     return g_object_new(NMS_TYPE_KEYFILE_PLUGIN, NULL);
 }
 
+NMSKeyfileCache *
+nmtst_keyfile_plugin_get_cache(NMSKeyfilePlugin *self)
+{
+    return NMS_KEYFILE_PLUGIN_GET_PRIVATE(self)->cache;
+}
+
+/* Creates a plugin that uses the given directories instead of the configured
+ * ones, with no read-only directory. @cache_filename enables the cache. */
+NMSKeyfilePlugin *
+nmtst_keyfile_plugin_new(const char *dirname_etc,
+                         const char *dirname_run,
+                         const char *cache_filename,
+                         gboolean    watch)
+{
+    NMSKeyfilePlugin        *self = nms_keyfile_plugin_new();
+    NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+
+    g_assert(dirname_etc && dirname_etc[0] == '/');
+    g_assert(dirname_run && dirname_run[0] == '/');
+    g_assert(!nm_streq(dirname_etc, dirname_run));
+
+    nm_clear_g_free(&priv->dirname_libs[0]);
+    g_free(priv->dirname_etc);
+    priv->dirname_etc = nm_path_simplify(g_strdup(dirname_etc));
+    g_free(priv->dirname_run);
+    priv->dirname_run = nm_path_simplify(g_strdup(dirname_run));
+
+    nm_clear_g_source_inst(&priv->cache_commit_source);
+    nm_clear_pointer(&priv->cache, nms_keyfile_cache_free);
+    if (cache_filename)
+        priv->cache = nms_keyfile_cache_new(cache_filename, _get_plugin_dir(priv));
+
+    priv->watch.mode = watch ? WATCH_MODE_YES : WATCH_MODE_NO;
+    return self;
+}
+
 static void
 dispose(GObject *object)
 {
@@ -1353,8 +1923,14 @@ dispose(GObject *object)
     if (priv->config)
         g_signal_handlers_disconnect_by_func(priv->config, config_changed_cb, object);
 
+    _watch_stop(self);
+
     nm_sett_util_storages_clear(&priv->storages);
 
+    if (nm_clear_g_source_inst(&priv->cache_commit_source))
+        nms_keyfile_cache_commit(priv->cache, FALSE);
+    nm_clear_pointer(&priv->cache, nms_keyfile_cache_free);
+
     nm_clear_g_free(&priv->dirname_libs[0]);
     nm_clear_g_free(&priv->dirname_etc);
     nm_clear_g_free(&priv->dirname_run);
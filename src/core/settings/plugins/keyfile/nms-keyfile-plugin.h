@@ -11,6 +11,7 @@
 #include "settings/nm-settings-storage.h"
 
 #include "nms-keyfile-utils.h"
+#include "nms-keyfile-cache.h"
 
 #define NMS_TYPE_KEYFILE_PLUGIN (nms_keyfile_plugin_get_type())
 #define NMS_KEYFILE_PLUGIN(obj) \
@@ -30,6 +31,13 @@ GType nms_keyfile_plugin_get_type(void);
 
 NMSKeyfilePlugin *nms_keyfile_plugin_new(void);
 
+NMSKeyfilePlugin *nmtst_keyfile_plugin_new(const char *dirname_etc,
+                                          const char *dirname_run,
+                                          const char *cache_filename,
+                                          gboolean    watch);
+
+NMSKeyfileCache *nmtst_keyfile_plugin_get_cache(NMSKeyfilePlugin *self);
+
 gboolean nms_keyfile_plugin_add_connection(NMSKeyfilePlugin   *self,
                                            NMConnection       *connection,
                                            gboolean            in_memory,
@@ -48,6 +48,7 @@ _fmt_warn(const NMKeyfileHandlerData *handler_data, char **out_message)
 
 typedef struct {
     bool verbose;
+    bool has_warnings;
 } ReadInfo;
 
 static gboolean
@@ -57,13 +58,15 @@ _handler_read(GKeyFile             *keyfile,
               NMKeyfileHandlerData *handler_data,
               void                 *user_data)
 {
-    const ReadInfo *read_info = user_data;
+    ReadInfo *read_info = user_data;
 
     if (handler_type == NM_KEYFILE_HANDLER_TYPE_WARN) {
         const NMKeyfileHandlerDataWarn *warn_data = &handler_data->warn;
         NMLogLevel                      level;
         char                           *message_free = NULL;
 
+        read_info->has_warnings = TRUE;
+
         if (!read_info->verbose)
             return TRUE;
 
@@ -89,13 +92,14 @@ _handler_read(GKeyFile             *keyfile,
     return FALSE;
 }
 
-NMConnection *
-nms_keyfile_reader_from_keyfile(GKeyFile   *key_file,
-                                const char *filename,
-                                const char *base_dir,
-                                const char *profile_dir,
-                                gboolean    verbose,
-                                GError    **error)
+static NMConnection *
+_reader_from_keyfile(GKeyFile   *key_file,
+                     const char *filename,
+                     const char *base_dir,
+                     const char *profile_dir,
+                     gboolean    verbose,
+                     gboolean   *out_has_warnings,
+                     GError    **error)
 {
     NMConnection *connection;
     ReadInfo      read_info = {
@@ -132,6 +136,7 @@ nms_keyfile_reader_from_keyfile(GKeyFile   *key_file,
                                  _handler_read,
                                  &read_info,
                                  error);
+    NM_SET_OUT(out_has_warnings, read_info.has_warnings);
     if (!connection)
         return NULL;
 
@@ -154,20 +159,75 @@ nms_keyfile_reader_from_keyfile(GKeyFile   *key_file,
 }
 
 NMConnection *
-nms_keyfile_reader_from_file(const char  *full_filename,
-                             const char  *profile_dir,
-                             struct stat *out_stat,
-                             NMTernary   *out_is_nm_generated,
-                             NMTernary   *out_is_volatile,
-                             NMTernary   *out_is_external,
-                             char       **out_shadowed_storage,
-                             NMTernary   *out_shadowed_owned,
-                             GError     **error)
+nms_keyfile_reader_from_keyfile(GKeyFile   *key_file,
+                                const char *filename,
+                                const char *base_dir,
+                                const char *profile_dir,
+                                gboolean    verbose,
+                                GError    **error)
+{
+    return _reader_from_keyfile(key_file, filename, base_dir, profile_dir, verbose, NULL, error);
+}
+
+/**
+ * nms_keyfile_reader_load_keyfile:
+ * @full_filename: the keyfile to load
+ * @error: the error on failure
+ *
+ * Loads @full_filename into a #GKeyFile, without checking the file
+ * permissions. This only does file I/O and does not log, so unlike the
+ * other functions here, it may be called from a worker thread.
+ *
+ * Returns: (transfer full): the #GKeyFile or %NULL on error.
+ */
+GKeyFile *
+nms_keyfile_reader_load_keyfile(const char *full_filename, GError **error)
+{
+    nm_auto_unref_keyfile GKeyFile *key_file = NULL;
+
+    nm_assert(full_filename && full_filename[0] == '/');
+
+    key_file = g_key_file_new();
+    if (!g_key_file_load_from_file(key_file, full_filename, G_KEY_FILE_NONE, error))
+        return NULL;
+    return g_steal_pointer(&key_file);
+}
+
+/**
+ * nms_keyfile_reader_from_loaded_keyfile:
+ * @key_file: the keyfile, as loaded by nms_keyfile_reader_load_keyfile()
+ * @full_filename: the name of the file that @key_file was loaded from
+ * @profile_dir: (optional): the directory for generating the UUID
+ * @out_is_nm_generated: (out) (optional): the nm-generated flag
+ * @out_is_volatile: (out) (optional): the volatile flag
+ * @out_is_external: (out) (optional): the external flag
+ * @out_shadowed_storage: (out) (optional) (transfer full): the shadowed storage
+ * @out_shadowed_owned: (out) (optional): the shadowed-owned flag
+ * @out_has_warnings: (out) (optional): whether reading the profile
+ *   logged warnings
+ * @error: the error on failure
+ *
+ * Creates, normalizes and verifies the connection from @key_file. This must
+ * be called on the main thread.
+ *
+ * Returns: (transfer full): the connection or %NULL on error.
+ */
+NMConnection *
+nms_keyfile_reader_from_loaded_keyfile(GKeyFile   *key_file,
+                                       const char *full_filename,
+                                       const char *profile_dir,
+                                       NMTernary  *out_is_nm_generated,
+                                       NMTernary  *out_is_volatile,
+                                       NMTernary  *out_is_external,
+                                       char      **out_shadowed_storage,
+                                       NMTernary  *out_shadowed_owned,
+                                       gboolean   *out_has_warnings,
+                                       GError    **error)
 {
-    nm_auto_unref_keyfile GKeyFile *key_file     = NULL;
-    NMConnection                   *connection   = NULL;
-    GError                         *verify_error = NULL;
+    NMConnection *connection   = NULL;
+    GError       *verify_error = NULL;
 
+    nm_assert(key_file);
     nm_assert(full_filename && full_filename[0] == '/');
     nm_assert(!profile_dir || profile_dir[0] == '/');
 
@@ -175,19 +235,15 @@ nms_keyfile_reader_from_file(const char  *full_filename,
     NM_SET_OUT(out_is_volatile, NM_TERNARY_DEFAULT);
     NM_SET_OUT(out_is_external, NM_TERNARY_DEFAULT);
     NM_SET_OUT(out_shadowed_owned, NM_TERNARY_DEFAULT);
-
-    if (!nms_keyfile_utils_check_file_permissions(NMS_KEYFILE_FILETYPE_KEYFILE,
-                                                  full_filename,
-                                                  out_stat,
-                                                  error))
-        return NULL;
-
-    key_file = g_key_file_new();
-    if (!g_key_file_load_from_file(key_file, full_filename, G_KEY_FILE_NONE, error))
-        return NULL;
-
-    connection =
-        nms_keyfile_reader_from_keyfile(key_file, full_filename, NULL, profile_dir, TRUE, error);
+    NM_SET_OUT(out_has_warnings, FALSE);
+
+    connection = _reader_from_keyfile(key_file,
+                                      full_filename,
+                                      NULL,
+                                      profile_dir,
+                                      TRUE,
+                                      out_has_warnings,
+                                      error);
     if (!connection)
         return NULL;
 
@@ -235,3 +291,46 @@ nms_keyfile_reader_from_file(const char  *full_filename,
 
     return connection;
 }
+
+NMConnection *
+nms_keyfile_reader_from_file(const char  *full_filename,
+                             const char  *profile_dir,
+                             struct stat *out_stat,
+                             NMTernary   *out_is_nm_generated,
+                             NMTernary   *out_is_volatile,
+                             NMTernary   *out_is_external,
+                             char       **out_shadowed_storage,
+                             NMTernary   *out_shadowed_owned,
+                             GError     **error)
+{
+    nm_auto_unref_keyfile GKeyFile *key_file = NULL;
+
+    nm_assert(full_filename && full_filename[0] == '/');
+    nm_assert(!profile_dir || profile_dir[0] == '/');
+
+    NM_SET_OUT(out_is_nm_generated, NM_TERNARY_DEFAULT);
+    NM_SET_OUT(out_is_volatile, NM_TERNARY_DEFAULT);
+    NM_SET_OUT(out_is_external, NM_TERNARY_DEFAULT);
+    NM_SET_OUT(out_shadowed_owned, NM_TERNARY_DEFAULT);
+
+    if (!nms_keyfile_utils_check_file_permissions(NMS_KEYFILE_FILETYPE_KEYFILE,
+                                                  full_filename,
+                                                  out_stat,
+                                                  error))
+        return NULL;
+
+    key_file = nms_keyfile_reader_load_keyfile(full_filename, error);
+    if (!key_file)
+        return NULL;
+
+    return nms_keyfile_reader_from_loaded_keyfile(key_file,
+                                                  full_filename,
+                                                  profile_dir,
+                                                  out_is_nm_generated,
+                                                  out_is_volatile,
+                                                  out_is_external,
+                                                  out_shadowed_storage,
+                                                  out_shadowed_owned,
+                                                  NULL,
+                                                  error);
+}
@@ -28,4 +28,17 @@ NMConnection *nms_keyfile_reader_from_file(const char  *full_filename,
                                            NMTernary   *out_shadowed_owned,
                                            GError     **error);
 
+GKeyFile *nms_keyfile_reader_load_keyfile(const char *full_filename, GError **error);
+
+NMConnection *nms_keyfile_reader_from_loaded_keyfile(GKeyFile   *key_file,
+                                                     const char *full_filename,
+                                                     const char *profile_dir,
+                                                     NMTernary  *out_is_nm_generated,
+                                                     NMTernary  *out_is_volatile,
+                                                     NMTernary  *out_is_external,
+                                                     char      **out_shadowed_storage,
+                                                     NMTernary  *out_shadowed_owned,
+                                                     gboolean   *out_has_warnings,
+                                                     GError    **error);
+
 #endif /* __NMS_KEYFILE_READER_H__ */
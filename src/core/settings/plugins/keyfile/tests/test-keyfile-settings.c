@@ -8,6 +8,8 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
@@ -21,6 +23,10 @@
 #include "settings/plugins/keyfile/nms-keyfile-reader.h"
 #include "settings/plugins/keyfile/nms-keyfile-writer.h"
 #include "settings/plugins/keyfile/nms-keyfile-utils.h"
+#include "settings/plugins/keyfile/nms-keyfile-cache.h"
+#include "settings/plugins/keyfile/nms-keyfile-plugin.h"
+#include "settings/plugins/keyfile/nms-keyfile-storage.h"
+#include "nm-config.h"
 
 #include "nm-test-utils-core.h"
 
@@ -2907,6 +2913,455 @@ test_nmmeta(void)
 
 /*****************************************************************************/
 
+static void
+test_cache(void)
+{
+    const char                   *testfile         = TEST_KEYFILES_DIR "/Test_Wired_Connection";
+    const char                   *cachefile        = TEST_SCRATCH_DIR "/keyfile-cache";
+    gs_unref_object NMConnection *connection       = NULL;
+    gs_unref_object NMConnection *cached           = NULL;
+    gs_free char                 *shadowed_storage = NULL;
+    NMSKeyfileCache              *cache;
+    NMTernary                     is_volatile;
+    struct stat                   st;
+    struct stat                   st_changed;
+
+    (void) unlink(cachefile);
+
+    if (stat(testfile, &st) != 0)
+        g_assert_not_reached();
+
+    cache = nms_keyfile_cache_new(cachefile, TEST_SCRATCH_DIR);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 0);
+    g_assert(!nms_keyfile_cache_lookup(cache, testfile, &st, NULL, NULL, NULL, NULL, NULL));
+
+    connection = keyfile_read_connection_from_file(testfile);
+    nms_keyfile_cache_add(cache,
+                          testfile,
+                          &st,
+                          connection,
+                          NM_TERNARY_DEFAULT,
+                          NM_TERNARY_TRUE,
+                          NM_TERNARY_DEFAULT,
+                          "/some/shadowed/storage",
+                          NM_TERNARY_FALSE);
+    nms_keyfile_cache_commit(cache, FALSE);
+    nms_keyfile_cache_free(cache);
+
+    /* the entry is read back from disk. */
+    cache = nms_keyfile_cache_new(cachefile, TEST_SCRATCH_DIR);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 1);
+    cached = nms_keyfile_cache_lookup(cache,
+                                      testfile,
+                                      &st,
+                                      NULL,
+                                      &is_volatile,
+                                      NULL,
+                                      &shadowed_storage,
+                                      NULL);
+    g_assert(cached);
+    nmtst_assert_connection_equals(connection, FALSE, cached, FALSE);
+    g_assert_cmpint(is_volatile, ==, NM_TERNARY_TRUE);
+    g_assert_cmpstr(shadowed_storage, ==, "/some/shadowed/storage");
+
+    /* stale entries are not used. */
+    st_changed                 = st;
+    st_changed.st_mtim.tv_nsec = (st.st_mtim.tv_nsec + 1) % NM_UTILS_NSEC_PER_SEC;
+    g_assert(!nms_keyfile_cache_lookup(cache, testfile, &st_changed, NULL, NULL, NULL, NULL, NULL));
+    st_changed = st;
+    st_changed.st_ino++;
+    g_assert(!nms_keyfile_cache_lookup(cache, testfile, &st_changed, NULL, NULL, NULL, NULL, NULL));
+    st_changed = st;
+    st_changed.st_size++;
+    g_assert(!nms_keyfile_cache_lookup(cache, testfile, &st_changed, NULL, NULL, NULL, NULL, NULL));
+
+    /* the entry was looked up, pruning keeps it. */
+    nms_keyfile_cache_commit(cache, TRUE);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 1);
+    nms_keyfile_cache_free(cache);
+
+    /* a cache for a different profile directory is discarded. */
+    cache = nms_keyfile_cache_new(cachefile, TEST_SCRATCH_DIR "/other");
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 0);
+    nms_keyfile_cache_free(cache);
+
+    /* entries that are not looked up get pruned. */
+    cache = nms_keyfile_cache_new(cachefile, TEST_SCRATCH_DIR);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 1);
+    nms_keyfile_cache_commit(cache, TRUE);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 0);
+    nms_keyfile_cache_free(cache);
+
+    cache = nms_keyfile_cache_new(cachefile, TEST_SCRATCH_DIR);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 0);
+    nms_keyfile_cache_free(cache);
+
+    (void) unlink(cachefile);
+}
+
+/*****************************************************************************/
+
+#define TEST_PLUGIN_DIR_ETC TEST_SCRATCH_DIR "/plugin-etc"
+#define TEST_PLUGIN_DIR_RUN TEST_SCRATCH_DIR "/plugin-run"
+
+typedef struct {
+    /* the filenames of the added or updated storages, in the order of the events. */
+    GPtrArray *loaded;
+    /* the filenames of the removed storages. */
+    GPtrArray *deleted;
+} PluginEvents;
+
+static void
+_plugin_events_cb(NMSettingsPlugin  *plugin,
+                  NMSettingsStorage *storage,
+                  NMConnection      *connection,
+                  gpointer           user_data)
+{
+    PluginEvents *events = user_data;
+
+    g_ptr_array_add(connection ? events->loaded : events->deleted,
+                    g_strdup(nms_keyfile_storage_get_filename(NMS_KEYFILE_STORAGE(storage))));
+}
+
+static void
+_plugin_events_init(PluginEvents *events)
+{
+    *events = (PluginEvents) {
+        .loaded  = g_ptr_array_new_with_free_func(g_free),
+        .deleted = g_ptr_array_new_with_free_func(g_free),
+    };
+}
+
+static void
+_plugin_events_clear(PluginEvents *events)
+{
+    nm_clear_pointer(&events->loaded, g_ptr_array_unref);
+    nm_clear_pointer(&events->deleted, g_ptr_array_unref);
+}
+
+static void
+_plugin_reload(NMSKeyfilePlugin *plugin, PluginEvents *events)
+{
+    g_ptr_array_set_size(events->loaded, 0);
+    g_ptr_array_set_size(events->deleted, 0);
+    nm_settings_plugin_reload_connections(NM_SETTINGS_PLUGIN(plugin), _plugin_events_cb, events);
+}
+
+static void
+_plugin_dir_reset(const char *dirname)
+{
+    GDir       *dir;
+    const char *name;
+
+    dir = g_dir_open(dirname, 0, NULL);
+    if (dir) {
+        while ((name = g_dir_read_name(dir))) {
+            gs_free char *full_filename = g_build_filename(dirname, name, NULL);
+
+            (void) unlink(full_filename);
+        }
+        g_dir_close(dir);
+    }
+    if (g_mkdir_with_parents(dirname, 0755) != 0)
+        g_assert_not_reached();
+}
+
+static char *
+_plugin_write_profile(const char *dirname, guint idx, const char *extra)
+{
+    char         *full_filename;
+    gs_free char *contents = NULL;
+
+    full_filename = g_strdup_printf("%s/profile-%03u.nmconnection", dirname, idx);
+    contents      = g_strdup_printf("[connection]\n"
+                                    "id=profile-%u\n"
+                                    "uuid=a1b2c3d4-0000-4000-8000-%012u\n"
+                                    "type=ethernet\n"
+                                    "\n"
+                                    "[ipv4]\n"
+                                    "method=auto\n"
+                                    "%s",
+                                    idx,
+                                    idx,
+                                    extra ?: "");
+    if (!g_file_set_contents(full_filename, contents, -1, NULL))
+        g_assert_not_reached();
+    return full_filename;
+}
+
+static void
+test_plugin_load_parallel(void)
+{
+    gs_unref_object NMSKeyfilePlugin *plugin   = NULL;
+    gs_unref_ptrarray GPtrArray      *expected = g_ptr_array_new_with_free_func(g_free);
+    PluginEvents                      events;
+    GDir                             *dir;
+    const char                       *name;
+    guint                             i;
+
+    _plugin_dir_reset(TEST_PLUGIN_DIR_ETC);
+    _plugin_dir_reset(TEST_PLUGIN_DIR_RUN);
+
+    /* enough profiles to read them on the thread pool. Some log warnings,
+     * one cannot be parsed. */
+    for (i = 0; i < 100; i++) {
+        gs_free char *full_filename = NULL;
+        gs_free char *extra         = NULL;
+
+        if (i % 10 == 3)
+            extra = g_strdup_printf("dns=bogus-%03u;\n", i);
+        full_filename = _plugin_write_profile(TEST_PLUGIN_DIR_ETC, i, extra);
+        if (i == 50) {
+            if (!g_file_set_contents(full_filename, "not a keyfile", -1, NULL))
+                g_assert_not_reached();
+        }
+    }
+
+    /* The profiles are reported, and the warnings are logged, in directory
+     * order, like when reading the files one by one. */
+    dir = g_dir_open(TEST_PLUGIN_DIR_ETC, 0, NULL);
+    g_assert(dir);
+    while ((name = g_dir_read_name(dir))) {
+        gs_free char *full_filename = g_build_filename(TEST_PLUGIN_DIR_ETC, name, NULL);
+        gs_free char *msg           = NULL;
+
+        i = strtoul(&name[NM_STRLEN("profile-")], NULL, 10);
+        if (i == 50) {
+            msg = g_strdup_printf("*<warn>  [*] keyfile: load: \"%s\": failed to load connection*",
+                                  full_filename);
+        } else {
+            if (i % 10 == 3)
+                msg = g_strdup_printf("*<warn>  [*] keyfile: ipv4.dns: *'bogus-%03u'*", i);
+            g_ptr_array_add(expected, g_steal_pointer(&full_filename));
+        }
+        if (msg)
+            NMTST_EXPECT_NM(G_LOG_LEVEL_MESSAGE, msg);
+    }
+    g_dir_close(dir);
+
+    _plugin_events_init(&events);
+    plugin = nmtst_keyfile_plugin_new(TEST_PLUGIN_DIR_ETC, TEST_PLUGIN_DIR_RUN, NULL, FALSE);
+    _plugin_reload(plugin, &events);
+    g_test_assert_expected_messages();
+
+    g_assert_cmpint(events.loaded->len, ==, expected->len);
+    for (i = 0; i < expected->len; i++)
+        g_assert_cmpstr(events.loaded->pdata[i], ==, expected->pdata[i]);
+    g_assert_cmpint(events.deleted->len, ==, 0);
+
+    _plugin_events_clear(&events);
+}
+
+static void
+test_plugin_cache(void)
+{
+    const char                         *cachefile = TEST_SCRATCH_DIR "/plugin-cache";
+    NMSettingsPluginConnectionLoadEntry entry     = {
+        .filename = TEST_PLUGIN_DIR_ETC "/profile-003.nmconnection",
+    };
+    NMSKeyfilePlugin                   *plugin;
+    NMSKeyfileCache                    *cache;
+    PluginEvents                        events;
+    guint                               n_hits;
+    guint                               i;
+
+    _plugin_dir_reset(TEST_PLUGIN_DIR_ETC);
+    _plugin_dir_reset(TEST_PLUGIN_DIR_RUN);
+    (void) unlink(cachefile);
+
+    for (i = 0; i < 4; i++)
+        g_free(_plugin_write_profile(TEST_PLUGIN_DIR_ETC, i, NULL));
+
+    /* neither profiles with secrets nor profiles in /run are cached. */
+    g_free(_plugin_write_profile(TEST_PLUGIN_DIR_ETC,
+                                 4,
+                                 "\n"
+                                 "[802-1x]\n"
+                                 "eap=md5;\n"
+                                 "identity=user\n"
+                                 "password=secret\n"));
+    g_free(_plugin_write_profile(TEST_PLUGIN_DIR_RUN, 5, NULL));
+
+    _plugin_events_init(&events);
+
+    /* the first load misses and fills the cache. */
+    plugin = nmtst_keyfile_plugin_new(TEST_PLUGIN_DIR_ETC, TEST_PLUGIN_DIR_RUN, cachefile, FALSE);
+    cache  = nmtst_keyfile_plugin_get_cache(plugin);
+    _plugin_reload(plugin, &events);
+    g_assert_cmpint(events.loaded->len, ==, 6);
+    g_assert_cmpint(nms_keyfile_cache_get_n_hits(cache), ==, 0);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 4);
+    g_assert(!nms_keyfile_cache_is_dirty(cache));
+    g_object_unref(plugin);
+
+    /* a new instance gets the unchanged profiles from the cache. */
+    plugin = nmtst_keyfile_plugin_new(TEST_PLUGIN_DIR_ETC, TEST_PLUGIN_DIR_RUN, cachefile, FALSE);
+    cache  = nmtst_keyfile_plugin_get_cache(plugin);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 4);
+    _plugin_reload(plugin, &events);
+    g_assert_cmpint(events.loaded->len, ==, 6);
+    g_assert_cmpint(nms_keyfile_cache_get_n_hits(cache), ==, 4);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 4);
+
+    /* a modified profile misses, a deleted one gets dropped. */
+    g_free(_plugin_write_profile(TEST_PLUGIN_DIR_ETC, 1, "dhcp-timeout=42\n"));
+    g_assert_cmpint(unlink(TEST_PLUGIN_DIR_ETC "/profile-002.nmconnection"), ==, 0);
+    n_hits = nms_keyfile_cache_get_n_hits(cache);
+    _plugin_reload(plugin, &events);
+    g_assert_cmpint(events.deleted->len, ==, 1);
+    g_assert_cmpint(nms_keyfile_cache_get_n_hits(cache) - n_hits, ==, 2);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 3);
+    g_assert(!nms_keyfile_cache_is_dirty(cache));
+
+    /* loading a single deleted file drops its entry too. The write of the
+     * cache is delayed, and happens at the latest on dispose. */
+    g_assert_cmpint(unlink(entry.filename), ==, 0);
+    nm_settings_plugin_load_connections(NM_SETTINGS_PLUGIN(plugin),
+                                        &entry,
+                                        1,
+                                        _plugin_events_cb,
+                                        &events);
+    g_assert_no_error(entry.error);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 2);
+    g_assert(nms_keyfile_cache_is_dirty(cache));
+    g_object_unref(plugin);
+
+    cache = nms_keyfile_cache_new(cachefile, TEST_PLUGIN_DIR_ETC);
+    g_assert_cmpint(nms_keyfile_cache_get_len(cache), ==, 2);
+    nms_keyfile_cache_free(cache);
+
+    _plugin_events_clear(&events);
+    (void) unlink(cachefile);
+}
+
+static void
+_plugin_set_mtime(const char *full_filename, time_t sec)
+{
+    const struct timespec times[2] = {
+        {.tv_sec = sec},
+        {.tv_sec = sec},
+    };
+
+    if (utimensat(AT_FDCWD, full_filename, times, 0) != 0)
+        g_assert_not_reached();
+}
+
+static void
+test_plugin_watch(void)
+{
+    const char *const                 p0       = TEST_PLUGIN_DIR_ETC "/profile-000.nmconnection";
+    const char *const                 p1       = TEST_PLUGIN_DIR_ETC "/profile-001.nmconnection";
+    const char *const                 p2       = TEST_PLUGIN_DIR_ETC "/profile-002.nmconnection";
+    gs_unref_object NMSKeyfilePlugin *plugin   = NULL;
+    gs_free char                     *contents = NULL;
+    PluginEvents                      events;
+    gint64                            n_events;
+    gint64                            i;
+
+    _plugin_dir_reset(TEST_PLUGIN_DIR_ETC);
+    _plugin_dir_reset(TEST_PLUGIN_DIR_RUN);
+
+    /* the timestamps might be coarse. Set them explicitly, so that every
+     * modification gets a different one. */
+    for (i = 0; i < 3; i++) {
+        gs_free char *full_filename = _plugin_write_profile(TEST_PLUGIN_DIR_ETC, i, NULL);
+
+        _plugin_set_mtime(full_filename, 1000 + i);
+    }
+
+    _plugin_events_init(&events);
+    plugin = nmtst_keyfile_plugin_new(TEST_PLUGIN_DIR_ETC, TEST_PLUGIN_DIR_RUN, NULL, TRUE);
+    _plugin_reload(plugin, &events);
+    g_assert_cmpint(events.loaded->len, ==, 3);
+
+    /* only the modified file is read again. */
+    g_free(_plugin_write_profile(TEST_PLUGIN_DIR_ETC, 1, "dhcp-timeout=42\n"));
+    _plugin_set_mtime(p1, 2000);
+    _plugin_reload(plugin, &events);
+    g_assert_cmpint(events.loaded->len, ==, 1);
+    g_assert_cmpstr(events.loaded->pdata[0], ==, p1);
+    g_assert_cmpint(events.deleted->len, ==, 0);
+
+    /* a deleted file gets removed. */
+    g_assert_cmpint(unlink(p2), ==, 0);
+    _plugin_reload(plugin, &events);
+    g_assert_cmpint(events.loaded->len, ==, 0);
+    g_assert_cmpint(events.deleted->len, ==, 1);
+    g_assert_cmpstr(events.deleted->pdata[0], ==, p2);
+
+    /* events for a file that still has the timestamp from when it was
+     * loaded (like after our own writes) don't cause reading it again. */
+    _plugin_set_mtime(p0, 1000);
+    _plugin_reload(plugin, &events);
+    g_assert_cmpint(events.loaded->len, ==, 0);
+    g_assert_cmpint(events.deleted->len, ==, 0);
+
+    /* when the event queue overflows, the next reload reads all files. */
+    if (!g_file_get_contents("/proc/sys/fs/inotify/max_queued_events", &contents, NULL, NULL))
+        n_events = -1;
+    else
+        n_events = _nm_utils_ascii_str_to_int64(contents, 10, 1, 1000000, -1);
+    if (n_events < 0) {
+        g_test_message("cannot determine the size of the inotify queue. Skip overflow test");
+    } else {
+        /* alternate between two files. Identical events would be merged. */
+        for (i = 0; i < n_events + 2; i++)
+            _plugin_set_mtime(i % 2 ? p0 : p1, i % 2 ? 1000 : 2000);
+        _plugin_reload(plugin, &events);
+        g_assert_cmpint(events.loaded->len, ==, 2);
+        g_assert_cmpint(events.deleted->len, ==, 0);
+
+        /* afterwards, the files are tracked again. */
+        g_free(_plugin_write_profile(TEST_PLUGIN_DIR_ETC, 0, "dhcp-timeout=43\n"));
+        _plugin_set_mtime(p0, 3000);
+        _plugin_reload(plugin, &events);
+        g_assert_cmpint(events.loaded->len, ==, 1);
+        g_assert_cmpstr(events.loaded->pdata[0], ==, p0);
+    }
+
+    _plugin_events_clear(&events);
+}
+
+/*****************************************************************************/
+
+static void
+_setup_config(void)
+{
+    const char             *config_file = TEST_SCRATCH_DIR "/NetworkManager.conf";
+    gs_free_error GError   *error       = NULL;
+    char                   *args[]      = {(char *) "test-keyfile-settings",
+                                           (char *) "--config",
+                                           (char *) config_file,
+                                           (char *) "--intern-config",
+                                           (char *) "",
+                                           (char *) "--config-dir",
+                                           (char *) "/no/such/dir",
+                                           (char *) "--system-config-dir",
+                                           (char *) "",
+                                           NULL};
+    char                  **argv        = args;
+    int                     argc        = G_N_ELEMENTS(args) - 1;
+    NMConfigCmdLineOptions *cli;
+    GOptionContext         *context;
+
+    /* the plugin needs a NMConfig instance. */
+    if (!g_file_set_contents(config_file, "[main]\n", -1, NULL))
+        g_assert_not_reached();
+
+    cli     = nm_config_cmd_line_options_new(FALSE);
+    context = g_option_context_new(NULL);
+    nm_config_cmd_line_options_add_to_entries(cli, context);
+    if (!g_option_context_parse(context, &argc, &argv, NULL))
+        g_assert_not_reached();
+    g_option_context_free(context);
+
+    if (!nm_config_setup(cli, NULL, &error))
+        g_error("failure to setup config: %s", error->message);
+    nm_config_cmd_line_options_free(cli);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -2925,6 +3380,8 @@ main(int argc, char **argv)
                 nm_strerror_native(errsv));
     }
 
+    _setup_config();
+
     /* The tests */
     g_test_add_func("/keyfile/test_read_valid_wired_connection", test_read_valid_wired_connection);
     g_test_add_func("/keyfile/test_write_wired_connection", test_write_wired_connection);
@@ -3010,6 +3467,11 @@ main(int argc, char **argv)
                     test_nm_keyfile_plugin_utils_escape_filename);
 
     g_test_add_func("/keyfile/test_nmmeta", test_nmmeta);
+    g_test_add_func("/keyfile/test_cache", test_cache);
+
+    g_test_add_func("/keyfile/plugin/load-parallel", test_plugin_load_parallel);
+    g_test_add_func("/keyfile/plugin/cache", test_plugin_cache);
+    g_test_add_func("/keyfile/plugin/watch", test_plugin_watch);
 
     return g_test_run();
 }
@@ -113,6 +113,11 @@ typedef struct _NMSupplicantInterfacePrivate {
     CList       bss_lst_head;
     CList       bss_initializing_lst_head;
 
+    /* BSS that received their properties and wait for bss_queued_source
+     * to apply them in one batch. */
+    CList    bss_queued_lst_head;
+    GSource *bss_queued_source;
+
     NMRefString *current_bss;
 
     GHashTable *peer_idx;
@@ -331,7 +336,8 @@ security_from_vardict(GVariant *security)
 /*****************************************************************************/
 
 /* Various conditions prevent _starting_check_ready() from completing. For example,
- * bss_initializing_lst_head, peer_initializing_lst_head and p2p_group_properties_cancellable.
+ * bss_initializing_lst_head, bss_queued_lst_head, peer_initializing_lst_head and
+ * p2p_group_properties_cancellable.
  * At some places, these conditions might toggle, and it would seems we would have
  * to call _starting_check_ready() at that point, to ensure we don't miss a state
  * change that we are ready. However, these places are deep in the call stack and
@@ -522,7 +528,9 @@ _notify_maybe_scanning(NMSupplicantInterface *self)
     if (priv->scanning_cached == scanning)
         return;
 
-    if (!scanning && !c_list_is_empty(&priv->bss_initializing_lst_head)) {
+    if (!scanning
+        && (!c_list_is_empty(&priv->bss_initializing_lst_head)
+            || !c_list_is_empty(&priv->bss_queued_lst_head))) {
         /* we would change state to indicate we no longer scan. However,
          * we still have BSS instances to be initialized. Delay the
          * state change further. */
@@ -587,6 +595,7 @@ _bss_info_destroy(NMSupplicantBssInfo *bss_info)
 {
     c_list_unlink_stale(&bss_info->_bss_lst);
     nm_clear_g_cancellable(&bss_info->_init_cancellable);
+    nm_g_variant_unref(bss_info->_init_properties);
     g_bytes_unref(bss_info->ssid);
     nm_ref_string_unref(bss_info->bss_path);
     nm_g_slice_free(bss_info);
@@ -796,36 +805,98 @@ _bss_info_properties_changed(NMSupplicantInterface *self,
     _bss_info_changed_emit(self, bss_info, TRUE);
 }
 
+static gboolean
+_bss_info_is_initializing(const NMSupplicantBssInfo *bss_info)
+{
+    return bss_info->_init_cancellable || bss_info->_init_queued;
+}
+
 static void
-_bss_info_get_all_cb(GVariant *result, GError *error, gpointer user_data)
+_bss_info_init_complete(NMSupplicantInterface *self, NMSupplicantBssInfo *bss_info)
 {
+    NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE(self);
+    gs_unref_variant GVariant    *properties = g_steal_pointer(&bss_info->_init_properties);
+
+    nm_assert(bss_info->_init_queued);
+    nm_assert(!bss_info->_init_cancellable);
+
+    bss_info->_init_queued = FALSE;
+    nm_c_list_move_tail(&priv->bss_lst_head, &bss_info->_bss_lst);
+
+    _bss_info_properties_changed(self, bss_info, properties, TRUE);
+}
+
+static gboolean
+_bss_info_queued_cb(gpointer user_data)
+{
+    NMSupplicantInterface        *self = user_data;
+    NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE(self);
     NMSupplicantBssInfo          *bss_info;
-    NMSupplicantInterface        *self;
-    NMSupplicantInterfacePrivate *priv;
-    gs_unref_variant GVariant    *properties = NULL;
+    guint                         n = 0;
+
+    nm_clear_g_source_inst(&priv->bss_queued_source);
+
+    while ((bss_info =
+                c_list_first_entry(&priv->bss_queued_lst_head, NMSupplicantBssInfo, _bss_lst))) {
+        _bss_info_init_complete(self, bss_info);
+        n++;
+    }
+
+    _LOGT("BSS: initialized %u BSS in one batch", n);
+
+    _starting_check_ready(self);
+
+    _notify_maybe_scanning(self);
+
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_bss_info_queue(NMSupplicantInterface *self,
+                NMSupplicantBssInfo   *bss_info,
+                GVariant              *properties)
+{
+    NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE(self);
+
+    /* Each BSS gets initialized asynchronously, either from the properties of
+     * the BSSAdded signal or from a GetAll call. When a scan finds many BSS, the
+     * replies arrive in a burst. Queue them, and apply them together on idle.
+     * This way, the listeners see all new BSS at once, and we only check once
+     * whether we are done starting and scanning. */
+    nm_clear_g_cancellable(&bss_info->_init_cancellable);
+    nm_clear_pointer(&bss_info->_init_properties, g_variant_unref);
+    bss_info->_init_properties = nm_g_variant_ref(properties);
+
+    if (!bss_info->_init_queued) {
+        bss_info->_init_queued = TRUE;
+        nm_c_list_move_tail(&priv->bss_queued_lst_head, &bss_info->_bss_lst);
+    }
+
+    if (!priv->bss_queued_source)
+        priv->bss_queued_source = nm_g_idle_add_source(_bss_info_queued_cb, self);
+}
+
+static void
+_bss_info_get_all_cb(GVariant *result, GError *error, gpointer user_data)
+{
+    NMSupplicantBssInfo       *bss_info;
+    gs_unref_variant GVariant *properties = NULL;
 
     if (nm_utils_error_is_cancelled(error))
         return;
 
     bss_info = user_data;
-    self     = bss_info->_self;
-    priv     = NM_SUPPLICANT_INTERFACE_GET_PRIVATE(self);
 
     g_clear_object(&bss_info->_init_cancellable);
-    nm_c_list_move_tail(&priv->bss_lst_head, &bss_info->_bss_lst);
 
     if (result)
         g_variant_get(result, "(@a{sv})", &properties);
 
-    _bss_info_properties_changed(self, bss_info, properties, TRUE);
-
-    _starting_check_ready(self);
-
-    _notify_maybe_scanning(self);
+    _bss_info_queue(bss_info->_self, bss_info, properties);
 }
 
 static void
-_bss_info_add(NMSupplicantInterface *self, const char *object_path)
+_bss_info_add(NMSupplicantInterface *self, const char *object_path, GVariant *properties)
 {
     NMSupplicantInterfacePrivate   *priv     = NM_SUPPLICANT_INTERFACE_GET_PRIVATE(self);
     nm_auto_ref_string NMRefString *bss_path = NULL;
@@ -835,21 +906,35 @@ _bss_info_add(NMSupplicantInterface *self, const char *object_path)
     if (!bss_path)
         return;
 
+    /* The BSSAdded signal carries all properties of the BSS. If we have them,
+     * we don't need to fetch them with a separate GetAll call. */
+    if (properties && g_variant_n_children(properties) == 0)
+        properties = NULL;
+
     bss_info = g_hash_table_lookup(priv->bss_idx, &bss_path);
     if (bss_info) {
         bss_info->_bss_dirty = FALSE;
+        if (properties && bss_info->_init_cancellable) {
+            /* the GetAll call is still pending. Use the properties we have now. */
+            _bss_info_queue(self, bss_info, properties);
+        }
         return;
     }
 
     bss_info  = g_slice_new(NMSupplicantBssInfo);
     *bss_info = (NMSupplicantBssInfo) {
-        ._self             = self,
-        .bss_path          = g_steal_pointer(&bss_path),
-        ._init_cancellable = g_cancellable_new(),
+        ._self    = self,
+        .bss_path = g_steal_pointer(&bss_path),
     };
     c_list_link_tail(&priv->bss_initializing_lst_head, &bss_info->_bss_lst);
     g_hash_table_add(priv->bss_idx, bss_info);
 
+    if (properties) {
+        _bss_info_queue(self, bss_info, properties);
+        return;
+    }
+
+    bss_info->_init_cancellable = g_cancellable_new();
     nm_dbus_connection_call_get_all(priv->dbus_connection,
                                     priv->name_owner->str,
                                     bss_info->bss_path->str,
@@ -874,7 +959,7 @@ _bss_info_remove(NMSupplicantInterface *self, NMRefString **p_bss_path)
         return FALSE;
 
     c_list_unlink(&bss_info->_bss_lst);
-    if (!bss_info->_init_cancellable)
+    if (!_bss_info_is_initializing(bss_info))
         _bss_info_changed_emit(self, bss_info, FALSE);
     _bss_info_destroy(bss_info);
 
@@ -1135,12 +1220,18 @@ set_state_down(NMSupplicantInterface *self,
         assoc_return(self, error, "cancelled because supplicant interface is going down");
     }
 
+    nm_clear_g_source_inst(&priv->bss_queued_source);
     while (
         (bss_info =
              c_list_first_entry(&priv->bss_initializing_lst_head, NMSupplicantBssInfo, _bss_lst))) {
         g_hash_table_remove(priv->bss_idx, bss_info);
         _bss_info_destroy(bss_info);
     }
+    while ((bss_info =
+                c_list_first_entry(&priv->bss_queued_lst_head, NMSupplicantBssInfo, _bss_lst))) {
+        g_hash_table_remove(priv->bss_idx, bss_info);
+        _bss_info_destroy(bss_info);
+    }
     while ((bss_info = c_list_first_entry(&priv->bss_lst_head, NMSupplicantBssInfo, _bss_lst))) {
         g_hash_table_remove(priv->bss_idx, bss_info);
         _bss_info_destroy(bss_info);
@@ -1329,6 +1420,9 @@ _starting_check_ready(NMSupplicantInterface *self)
     if (!c_list_is_empty(&priv->bss_initializing_lst_head))
         return;
 
+    if (!c_list_is_empty(&priv->bss_queued_lst_head))
+        return;
+
     if (!c_list_is_empty(&priv->peer_initializing_lst_head))
         return;
 
@@ -2029,9 +2123,11 @@ _properties_changed_main(NMSupplicantInterface *self, GVariant *properties)
             bss_info->_bss_dirty = TRUE;
         c_list_for_each_entry (bss_info, &priv->bss_initializing_lst_head, _bss_lst)
             bss_info->_bss_dirty = TRUE;
+        c_list_for_each_entry (bss_info, &priv->bss_queued_lst_head, _bss_lst)
+            bss_info->_bss_dirty = TRUE;
 
         for (iter = v_strv; *iter; iter++)
-            _bss_info_add(self, *iter);
+            _bss_info_add(self, *iter, NULL);
 
         g_free(v_strv);
 
@@ -2042,6 +2138,13 @@ _properties_changed_main(NMSupplicantInterface *self, GVariant *properties)
             if (bss_info->_bss_dirty)
                 _bss_info_remove(self, &bss_info->bss_path);
         }
+        c_list_for_each_entry_safe (bss_info,
+                                    bss_info_safe,
+                                    &priv->bss_queued_lst_head,
+                                    _bss_lst) {
+            if (bss_info->_bss_dirty)
+                _bss_info_remove(self, &bss_info->bss_path);
+        }
         c_list_for_each_entry_safe (bss_info, bss_info_safe, &priv->bss_lst_head, _bss_lst) {
             if (bss_info->_bss_dirty)
                 _bss_info_remove(self, &bss_info->bss_path);
@@ -3103,6 +3206,11 @@ _bss_properties_changed_cb(GDBusConnection *connection,
     if (bss_info->_init_cancellable)
         return;
 
+    if (bss_info->_init_queued) {
+        /* the change is newer than the queued properties. Apply those first. */
+        _bss_info_init_complete(self, bss_info);
+    }
+
     g_variant_get(parameters, "(&s@a{sv}^a&s)", NULL, &changed_properties, NULL);
     _bss_info_properties_changed(self, bss_info, changed_properties, FALSE);
 }
@@ -3186,11 +3294,13 @@ _signal_handle(NMSupplicantInterface *self,
             return;
 
         if (nm_streq(signal_name, "BSSAdded")) {
+            gs_unref_variant GVariant *properties = NULL;
+
             if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(oa{sv})")))
                 return;
 
-            g_variant_get(parameters, "(&oa{sv})", &path, NULL);
-            _bss_info_add(self, path);
+            g_variant_get(parameters, "(&o@a{sv})", &path, &properties);
+            _bss_info_add(self, path, properties);
             return;
         }
 
@@ -3528,6 +3638,7 @@ nm_supplicant_interface_init(NMSupplicantInterface *self)
 
     c_list_init(&priv->bss_lst_head);
     c_list_init(&priv->bss_initializing_lst_head);
+    c_list_init(&priv->bss_queued_lst_head);
 
     G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(NMSupplicantPeerInfo, peer_path) == 0);
     priv->peer_idx = g_hash_table_new(nm_pdirect_hash, nm_pdirect_equal);
@@ -3694,6 +3805,7 @@ dispose(GObject *object)
         set_state_down(self, TRUE, "NMSupplicantInterface is disposing");
 
     nm_assert(c_list_is_empty(&self->supp_lst));
+    nm_assert(!priv->bss_queued_source);
 
     if (priv->wps_data) {
         /* we shut down, but an asynchronous Cancel request is pending.
@@ -168,6 +168,10 @@ typedef struct _NMSupplicantBssInfo {
     CList                  _bss_lst;
     GCancellable          *_init_cancellable;
 
+    /* the properties that were received for the initialization, until they get
+     * applied together with the other queued BSS (see _init_queued). */
+    GVariant *_init_properties;
+
     GBytes *ssid;
 
     gint64 last_seen_msec;
@@ -195,6 +199,8 @@ typedef struct _NMSupplicantBssInfo {
 
     bool _bss_dirty : 1;
 
+    bool _init_queued : 1;
+
 } NMSupplicantBssInfo;
 
 typedef struct _NMSupplicantPeerInfo {
@@ -855,6 +855,129 @@ test_config_warnings(void)
 
 /*****************************************************************************/
 
+static void
+test_config_ignore_route(void)
+{
+    nm_auto_unref_keyfile GKeyFile *keyfile     = nm_config_create_keyfile();
+    gs_unref_object NMConfigData   *config_data = NULL;
+    gs_unref_ptrarray GPtrArray    *warnings    = g_ptr_array_new_with_free_func(g_free);
+    const guint32                  *tables;
+    const guint8                   *protocols;
+    guint                           len;
+
+    config_data = nm_config_data_new(NULL, NULL, NULL, keyfile, NULL);
+    g_assert(!nm_config_data_get_main_ignore_route_tables(config_data, &len));
+    g_assert_cmpint(len, ==, 0);
+    g_assert(!nm_config_data_get_main_ignore_route_protocols(config_data, &len));
+    g_assert_cmpint(len, ==, 0);
+    g_clear_object(&config_data);
+
+    g_key_file_set_string(keyfile, "main", "ignore-route-tables", "100, 254 main,255,4294967295");
+    g_key_file_set_string(keyfile, "main", "ignore-route-protocols", "1,3,4,16,256");
+    config_data = nm_config_data_new(NULL, NULL, NULL, keyfile, NULL);
+
+    /* The main and local table and NetworkManager's own protocols are rejected. */
+    tables = nm_config_data_get_main_ignore_route_tables(config_data, &len);
+    g_assert_cmpint(len, ==, 2);
+    g_assert_cmpint(tables[0], ==, 100);
+    g_assert_cmpint(tables[1], ==, G_MAXUINT32);
+
+    protocols = nm_config_data_get_main_ignore_route_protocols(config_data, &len);
+    g_assert_cmpint(len, ==, 2);
+    g_assert_cmpint(protocols[0], ==, 1);
+    g_assert_cmpint(protocols[1], ==, 3);
+
+    nm_config_data_get_warnings(config_data, warnings);
+    g_assert_cmpint(warnings->len, ==, 6);
+    g_assert_cmpstr(warnings->pdata[0],
+                    ==,
+                    "invalid value \"254\" for main.ignore-route-tables is ignored");
+    g_assert_cmpstr(warnings->pdata[5],
+                    ==,
+                    "invalid value \"256\" for main.ignore-route-protocols is ignored");
+}
+
+/*****************************************************************************/
+
+static void
+test_config_match_cache(void)
+{
+    nm_auto_unref_keyfile GKeyFile *keyfile      = nm_config_create_keyfile();
+    gs_unref_object NMConfigData   *config_data  = NULL;
+    gs_unref_object NMConfigData   *config_data2 = NULL;
+    char                            ifname[]     = "eth0";
+    NMMatchSpecDeviceData           match_data   = {
+                    .interface_name = "eth0",
+                    .device_type    = "ethernet",
+    };
+    gboolean                        has_match;
+    guint                           len;
+    guint                           i;
+
+    g_key_file_set_string(keyfile, "device-eth0", "match-device", "interface-name:eth0");
+    g_key_file_set_string(keyfile, "device-eth0", "managed", "0");
+    config_data = nm_config_data_new(NULL, NULL, NULL, keyfile, NULL);
+    g_assert_cmpint(nmtst_config_data_get_match_cache_len(config_data), ==, 0);
+
+    g_assert_cmpstr(
+        nm_config_data_get_device_config(config_data, "managed", &match_data, &has_match),
+        ==,
+        "0");
+    g_assert(has_match);
+    g_assert_cmpint(nmtst_config_data_get_match_cache_len(config_data), ==, 1);
+
+    /* the same data, in other strings, hits the cache entry. */
+    match_data.interface_name = ifname;
+    g_assert_cmpstr(
+        nm_config_data_get_device_config(config_data, "managed", &match_data, &has_match),
+        ==,
+        "0");
+    g_assert(has_match);
+    g_assert_cmpint(nmtst_config_data_get_match_cache_len(config_data), ==, 1);
+
+    /* when a property of the device changes, it gets a new entry. */
+    match_data.interface_name = "eth1";
+    g_assert(!nm_config_data_get_device_config(config_data, "managed", &match_data, &has_match));
+    g_assert(!has_match);
+    g_assert_cmpint(nmtst_config_data_get_match_cache_len(config_data), ==, 2);
+
+    /* a new configuration has its own, empty cache. The old results are not
+     * reused, while the old configuration keeps them. */
+    g_key_file_set_string(keyfile, "device-eth0", "match-device", "interface-name:eth1");
+    config_data2 = nm_config_data_new(NULL, NULL, NULL, keyfile, NULL);
+    g_assert_cmpint(nmtst_config_data_get_match_cache_len(config_data2), ==, 0);
+    g_assert_cmpstr(
+        nm_config_data_get_device_config(config_data2, "managed", &match_data, &has_match),
+        ==,
+        "0");
+    g_assert(has_match);
+    match_data.interface_name = "eth0";
+    g_assert(!nm_config_data_get_device_config(config_data2, "managed", &match_data, &has_match));
+    g_assert(!has_match);
+    g_assert_cmpint(nmtst_config_data_get_match_cache_len(config_data2), ==, 2);
+    g_assert_cmpstr(
+        nm_config_data_get_device_config(config_data, "managed", &match_data, &has_match),
+        ==,
+        "0");
+    g_assert_cmpint(nmtst_config_data_get_match_cache_len(config_data), ==, 2);
+
+    /* the cache holds at most 1024 entries, then it starts over. */
+    for (i = 0; (len = nmtst_config_data_get_match_cache_len(config_data)) < 1024; i++) {
+        gs_free char *name = g_strdup_printf("dummy%u", i);
+
+        match_data.interface_name = name;
+        g_assert(!nm_config_data_get_device_config(config_data, "managed", &match_data, NULL));
+        g_assert_cmpint(nmtst_config_data_get_match_cache_len(config_data), ==, len + 1);
+    }
+    match_data.interface_name = "eth0";
+    g_assert_cmpstr(nm_config_data_get_device_config(config_data, "managed", &match_data, NULL),
+                    ==,
+                    "0");
+    g_assert_cmpint(nmtst_config_data_get_match_cache_len(config_data), ==, 1);
+}
+
+/*****************************************************************************/
+
 typedef void (*TestSetValuesUserSetFcn)(NMConfig            *config,
                                         gboolean             is_user,
                                         GKeyFile            *keyfile_user,
@@ -1511,6 +1634,8 @@ main(int argc, char **argv)
     g_test_add_func("/config/confdir", test_config_confdir);
     g_test_add_func("/config/confdir-parse-error", test_config_confdir_parse_error);
     g_test_add_func("/config/warnings", test_config_warnings);
+    g_test_add_func("/config/ignore-route", test_config_ignore_route);
+    g_test_add_func("/config/match-cache", test_config_match_cache);
 
     g_test_add_func("/config/set-values", test_config_set_values);
     g_test_add_func("/config/global-dns", test_config_global_dns);
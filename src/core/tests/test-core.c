@@ -1242,14 +1242,30 @@ test_connection_sort_autoconnect_priority(void)
 #define MATCH_S390   "S390:"
 #define MATCH_DRIVER "DRIVER:"
 
+static NMMatchSpecMatchType
+_test_match_spec_device_data(const GSList *specs, const NMMatchSpecDeviceData *data)
+{
+    nm_auto_free_match_spec_device NMMatchSpecDevice *compiled = NULL;
+    NMMatchSpecMatchType                              m;
+
+    m = nm_match_spec_device(specs, data);
+
+    /* the compiled specs must give the same result. */
+    compiled = nm_match_spec_device_compile(specs);
+    g_assert_cmpint(nm_match_spec_device_match(compiled, data), ==, m);
+
+    return m;
+}
+
 static NMMatchSpecMatchType
 _test_match_spec_device(const GSList *specs, const char *match_str)
 {
     if (match_str && g_str_has_prefix(match_str, MATCH_S390))
-        return nm_match_spec_device(specs,
-                                    &((const NMMatchSpecDeviceData) {
-                                        .s390_subchannels = &match_str[NM_STRLEN(MATCH_S390)],
-                                    }));
+        return _test_match_spec_device_data(specs,
+                                            &((const NMMatchSpecDeviceData) {
+                                                .s390_subchannels =
+                                                    &match_str[NM_STRLEN(MATCH_S390)],
+                                            }));
     if (match_str && g_str_has_prefix(match_str, MATCH_DRIVER)) {
         gs_free char *s = g_strdup(&match_str[NM_STRLEN(MATCH_DRIVER)]);
         char         *t;
@@ -1259,16 +1275,16 @@ _test_match_spec_device(const GSList *specs, const char *match_str)
             t[0] = '\0';
             t++;
         }
-        return nm_match_spec_device(specs,
-                                    &((const NMMatchSpecDeviceData) {
-                                        .driver         = s,
-                                        .driver_version = t,
-                                    }));
+        return _test_match_spec_device_data(specs,
+                                            &((const NMMatchSpecDeviceData) {
+                                                .driver         = s,
+                                                .driver_version = t,
+                                            }));
     }
-    return nm_match_spec_device(specs,
-                                &((const NMMatchSpecDeviceData) {
-                                    .interface_name = match_str,
-                                }));
+    return _test_match_spec_device_data(specs,
+                                        &((const NMMatchSpecDeviceData) {
+                                            .interface_name = match_str,
+                                        }));
 }
 
 static void
@@ -1466,6 +1482,92 @@ test_match_spec_device(void)
                                NULL);
 }
 
+static void
+_do_test_match_spec_device_hwaddr(const char          *spec_str,
+                                  const char          *hwaddr,
+                                  const char          *device_type,
+                                  NMMatchSpecMatchType expected)
+{
+    GSList *specs = nm_match_spec_split(spec_str);
+
+    g_assert_cmpint(_test_match_spec_device_data(specs,
+                                                 &((const NMMatchSpecDeviceData) {
+                                                     .interface_name = "eth0",
+                                                     .hwaddr         = hwaddr,
+                                                     .device_type    = device_type,
+                                                 })),
+                    ==,
+                    expected);
+    g_slist_free_full(specs, g_free);
+}
+
+static void
+test_match_spec_device_hwaddr(void)
+{
+    _do_test_match_spec_device_hwaddr("mac:00:11:22:33:44:55",
+                                      "00:11:22:33:44:55",
+                                      NULL,
+                                      NM_MATCH_SPEC_MATCH);
+    _do_test_match_spec_device_hwaddr("mac:00:11:22:33:44:55",
+                                      "00:11:22:33:44:56",
+                                      NULL,
+                                      NM_MATCH_SPEC_NO_MATCH);
+    _do_test_match_spec_device_hwaddr("mac:00:11:22:33:44:aa",
+                                      "00:11:22:33:44:AA",
+                                      NULL,
+                                      NM_MATCH_SPEC_MATCH);
+    _do_test_match_spec_device_hwaddr("00-11-22-33-44-aa",
+                                      "00:11:22:33:44:AA",
+                                      NULL,
+                                      NM_MATCH_SPEC_MATCH);
+    _do_test_match_spec_device_hwaddr("except:00:11:22:33:44:aa",
+                                      "00:11:22:33:44:AA",
+                                      NULL,
+                                      NM_MATCH_SPEC_MATCH);
+    _do_test_match_spec_device_hwaddr("except:mac:00:11:22:33:44:aa",
+                                      "00:11:22:33:44:AA",
+                                      NULL,
+                                      NM_MATCH_SPEC_NEG_MATCH);
+    _do_test_match_spec_device_hwaddr("mac:00:11:22:33:44",
+                                      "00:11:22:33:44:00",
+                                      NULL,
+                                      NM_MATCH_SPEC_NO_MATCH);
+    _do_test_match_spec_device_hwaddr("mac:invalid", NULL, NULL, NM_MATCH_SPEC_NO_MATCH);
+    _do_test_match_spec_device_hwaddr("type:ethernet,except:mac:00:11:22:33:44:55",
+                                      "00:11:22:33:44:55",
+                                      "ethernet",
+                                      NM_MATCH_SPEC_NEG_MATCH);
+    _do_test_match_spec_device_hwaddr("type:ethernet,except:mac:00:11:22:33:44:55",
+                                      "00:11:22:33:44:56",
+                                      "ethernet",
+                                      NM_MATCH_SPEC_MATCH);
+    _do_test_match_spec_device_hwaddr("type:wifi,mac:00:11:22:33:44:55",
+                                      NULL,
+                                      "ethernet",
+                                      NM_MATCH_SPEC_NO_MATCH);
+
+    /* Only the last 8 bytes of InfiniBand addresses are compared. */
+    _do_test_match_spec_device_hwaddr(
+        "mac:80:00:02:08:fe:80:00:00:00:00:00:00:00:02:c9:03:00:00:0f:65",
+        "80:00:00:48:fe:80:00:00:00:00:00:01:00:02:c9:03:00:00:0f:65",
+        "infiniband",
+        NM_MATCH_SPEC_MATCH);
+    _do_test_match_spec_device_hwaddr(
+        "mac:80:00:02:08:fe:80:00:00:00:00:00:00:00:02:c9:03:00:00:0f:65",
+        "80:00:02:08:fe:80:00:00:00:00:00:00:00:02:c9:03:00:00:0f:66",
+        "infiniband",
+        NM_MATCH_SPEC_NO_MATCH);
+    _do_test_match_spec_device_hwaddr(
+        "except:mac:80:00:02:08:fe:80:00:00:00:00:00:00:00:02:c9:03:00:00:0f:65",
+        "00:00:00:00:fe:80:00:00:00:00:00:00:00:02:c9:03:00:00:0f:65",
+        "infiniband",
+        NM_MATCH_SPEC_NEG_MATCH);
+    _do_test_match_spec_device_hwaddr("mac:00:02:c9:03:00:00:0f:65",
+                                      "80:00:02:08:fe:80:00:00:00:00:00:00:00:02:c9:03:00:00:0f:65",
+                                      "infiniband",
+                                      NM_MATCH_SPEC_NO_MATCH);
+}
+
 /*****************************************************************************/
 
 static void
@@ -2920,6 +3022,7 @@ main(int argc, char **argv)
                     test_connection_sort_autoconnect_priority);
 
     g_test_add_func("/general/match-spec/device", test_match_spec_device);
+    g_test_add_func("/general/match-spec/device-hwaddr", test_match_spec_device_hwaddr);
     g_test_add_func("/general/match-spec/config", test_match_spec_config);
     g_test_add_func("/general/duplicate_decl_specifier", test_duplicate_decl_specifier);
 
@@ -0,0 +1,398 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include <sys/socket.h>
+
+#include "nm-config.h"
+#include "nm-dbus-manager.h"
+#include "nm-dbus-object.h"
+#include "nm-test-utils-core.h"
+
+/*****************************************************************************/
+
+/* PropertiesChanged signals are delayed by this long, unless something
+ * requires to emit them earlier. */
+#define PROPERTIES_CHANGED_DELAY_MSEC 200
+
+#define TEST_DBUS_INTERFACE "org.freedesktop.NetworkManager.Test"
+
+/*****************************************************************************/
+
+#define NM_TYPE_TEST_DBUS_OBJECT (nm_test_dbus_object_get_type())
+#define NM_TEST_DBUS_OBJECT(obj) \
+    (_NM_G_TYPE_CHECK_INSTANCE_CAST((obj), NM_TYPE_TEST_DBUS_OBJECT, NMTestDBusObject))
+
+#define NM_TEST_DBUS_OBJECT_VALUE "value"
+
+typedef struct {
+    NMDBusObject parent;
+    guint        value;
+} NMTestDBusObject;
+
+typedef struct {
+    NMDBusObjectClass parent;
+} NMTestDBusObjectClass;
+
+static GType nm_test_dbus_object_get_type(void);
+
+G_DEFINE_TYPE(NMTestDBusObject, nm_test_dbus_object, NM_TYPE_DBUS_OBJECT)
+
+NM_GOBJECT_PROPERTIES_DEFINE(NMTestDBusObject, PROP_VALUE, );
+
+static const NMDBusInterfaceInfoExtended interface_info_test;
+static const GDBusSignalInfo             signal_info_ping;
+
+static void
+_test_dbus_object_set_value(NMTestDBusObject *self, guint value)
+{
+    self->value = value;
+    _notify(self, PROP_VALUE);
+}
+
+static void
+_test_dbus_object_emit_ping(NMTestDBusObject *self)
+{
+    nm_dbus_object_emit_signal(NM_DBUS_OBJECT(self),
+                               &interface_info_test,
+                               &signal_info_ping,
+                               "(u)",
+                               self->value);
+}
+
+static gboolean
+_poke_return_cb(gpointer user_data)
+{
+    g_dbus_method_invocation_return_value(user_data, NULL);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+impl_test_poke(NMDBusObject                      *obj,
+               const NMDBusInterfaceInfoExtended *interface_info,
+               const NMDBusMethodInfoExtended    *method_info,
+               GDBusConnection                   *connection,
+               const char                        *sender,
+               GDBusMethodInvocation             *invocation,
+               GVariant                          *parameters)
+{
+    guint32 value;
+
+    g_variant_get(parameters, "(u)", &value);
+
+    /* like most methods, change the state and reply asynchronously. */
+    _test_dbus_object_set_value(NM_TEST_DBUS_OBJECT(obj), value);
+    g_idle_add(_poke_return_cb, invocation);
+}
+
+static void
+get_property(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
+{
+    NMTestDBusObject *self = NM_TEST_DBUS_OBJECT(object);
+
+    switch (prop_id) {
+    case PROP_VALUE:
+        g_value_set_uint(value, self->value);
+        break;
+    default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void
+nm_test_dbus_object_init(NMTestDBusObject *self)
+{}
+
+static const GDBusSignalInfo signal_info_ping = NM_DEFINE_GDBUS_SIGNAL_INFO_INIT(
+    "Ping",
+    .args = NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("value", "u"), ), );
+
+static const NMDBusInterfaceInfoExtended interface_info_test = {
+    .parent = NM_DEFINE_GDBUS_INTERFACE_INFO_INIT(
+        TEST_DBUS_INTERFACE,
+        .methods = NM_DEFINE_GDBUS_METHOD_INFOS(NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+            NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                "Poke",
+                .in_args = NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("value", "u"), ), ),
+            .handle = impl_test_poke, ), ),
+        .signals    = NM_DEFINE_GDBUS_SIGNAL_INFOS(&signal_info_ping, ),
+        .properties = NM_DEFINE_GDBUS_PROPERTY_INFOS(
+            NM_DEFINE_DBUS_PROPERTY_INFO_EXTENDED_READABLE("Value",
+                                                           "u",
+                                                           NM_TEST_DBUS_OBJECT_VALUE), ), ),
+};
+
+static void
+nm_test_dbus_object_class_init(NMTestDBusObjectClass *klass)
+{
+    GObjectClass      *object_class      = G_OBJECT_CLASS(klass);
+    NMDBusObjectClass *dbus_object_class = NM_DBUS_OBJECT_CLASS(klass);
+
+    dbus_object_class->export_path     = NM_DBUS_EXPORT_PATH_NUMBERED(NM_DBUS_PATH "/Test");
+    dbus_object_class->interface_infos = NM_DBUS_INTERFACE_INFOS(&interface_info_test);
+
+    object_class->get_property = get_property;
+
+    obj_properties[PROP_VALUE] = g_param_spec_uint(NM_TEST_DBUS_OBJECT_VALUE,
+                                                   "",
+                                                   "",
+                                                   0,
+                                                   G_MAXUINT32,
+                                                   0,
+                                                   G_PARAM_READABLE | G_PARAM_STATIC_STRINGS);
+
+    g_object_class_install_properties(object_class, _PROPERTY_ENUMS_LAST, obj_properties);
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    GDBusConnection  *server;
+    GDBusConnection  *client;
+    NMTestDBusObject *obj;
+    const char       *path;
+    guint             subscription_id;
+
+    /* what the client received, in order. */
+    GPtrArray *events;
+} TestData;
+
+static void
+_new_connection_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    GDBusConnection     **p_connection = user_data;
+    gs_free_error GError *error        = NULL;
+
+    *p_connection = g_dbus_connection_new_finish(result, &error);
+    nmtst_assert_success(*p_connection, error);
+}
+
+static GIOStream *
+_io_stream_new(int fd)
+{
+    gs_unref_object GSocket *socket = NULL;
+    gs_free_error GError    *error  = NULL;
+
+    socket = g_socket_new_from_fd(fd, &error);
+    nmtst_assert_success(socket, error);
+    return G_IO_STREAM(g_socket_connection_factory_create_connection(socket));
+}
+
+static void
+_client_signal_cb(GDBusConnection *connection,
+                  const char      *sender_name,
+                  const char      *object_path,
+                  const char      *interface_name,
+                  const char      *signal_name,
+                  GVariant        *parameters,
+                  gpointer         user_data)
+{
+    TestData *tdata = user_data;
+    guint32   value;
+
+    if (nm_streq(signal_name, "PropertiesChanged")) {
+        gs_unref_variant GVariant *changed = NULL;
+
+        g_variant_get(parameters, "(&s@a{sv}@as)", NULL, &changed, NULL);
+        if (!g_variant_lookup(changed, "Value", "u", &value))
+            g_assert_not_reached();
+        g_ptr_array_add(tdata->events, g_strdup_printf("changed:%u", value));
+    } else if (nm_streq(signal_name, "Ping")) {
+        g_variant_get(parameters, "(u)", &value);
+        g_ptr_array_add(tdata->events, g_strdup_printf("ping:%u", value));
+    }
+}
+
+static void
+_client_poke_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    TestData                  *tdata = user_data;
+    gs_unref_variant GVariant *ret   = NULL;
+    gs_free_error GError      *error = NULL;
+
+    ret = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+    nmtst_assert_success(ret, error);
+    g_ptr_array_add(tdata->events, g_strdup("return"));
+}
+
+static void
+_setup(TestData *tdata)
+{
+    NMDBusManager             *manager       = nm_dbus_manager_get();
+    gs_free char              *guid          = g_dbus_generate_guid();
+    gs_unref_object GIOStream *stream_server = NULL;
+    gs_unref_object GIOStream *stream_client = NULL;
+    int                        fds[2];
+
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+        g_assert_not_reached();
+
+    stream_server = _io_stream_new(fds[0]);
+    stream_client = _io_stream_new(fds[1]);
+
+    *tdata = (TestData) {
+        .events = g_ptr_array_new_with_free_func(g_free),
+    };
+
+    g_dbus_connection_new(stream_server,
+                          guid,
+                          G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_SERVER,
+                          NULL,
+                          NULL,
+                          _new_connection_cb,
+                          &tdata->server);
+    g_dbus_connection_new(stream_client,
+                          NULL,
+                          G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT,
+                          NULL,
+                          NULL,
+                          _new_connection_cb,
+                          &tdata->client);
+    nmtst_main_context_iterate_until_assert(NULL, 5000, tdata->server && tdata->client);
+
+    if (!nmtst_dbus_manager_setup(manager, tdata->server))
+        g_assert_not_reached();
+    nm_dbus_manager_start(manager, NULL, NULL);
+
+    tdata->obj  = g_object_new(NM_TYPE_TEST_DBUS_OBJECT, NULL);
+    tdata->path = nm_dbus_object_export(tdata->obj);
+
+    tdata->subscription_id = g_dbus_connection_signal_subscribe(tdata->client,
+                                                                NULL,
+                                                                NULL,
+                                                                NULL,
+                                                                tdata->path,
+                                                                NULL,
+                                                                G_DBUS_SIGNAL_FLAGS_NONE,
+                                                                _client_signal_cb,
+                                                                tdata,
+                                                                NULL);
+}
+
+static void
+_assert_events(TestData *tdata, const char *const *expected)
+{
+    gsize n_expected = NM_PTRARRAY_LEN(expected);
+    gsize i;
+
+    nmtst_main_context_iterate_until_assert(NULL, 5000, tdata->events->len >= n_expected);
+
+    /* no more events are coming. */
+    nmtst_main_context_iterate_until(NULL, 2 * PROPERTIES_CHANGED_DELAY_MSEC, FALSE);
+
+    g_assert_cmpint(tdata->events->len, ==, n_expected);
+    for (i = 0; i < n_expected; i++)
+        g_assert_cmpstr(tdata->events->pdata[i], ==, expected[i]);
+
+    g_ptr_array_set_size(tdata->events, 0);
+}
+
+static void
+test_properties_changed(void)
+{
+    TestData tdata;
+
+    _setup(&tdata);
+
+    /* The changes within the delay are merged into one signal. */
+    _test_dbus_object_set_value(tdata.obj, 1);
+    _test_dbus_object_set_value(tdata.obj, 2);
+    _test_dbus_object_set_value(tdata.obj, 3);
+    _assert_events(&tdata, NM_MAKE_STRV("changed:3"));
+
+    /* Other signals don't overtake the pending PropertiesChanged signal. */
+    _test_dbus_object_set_value(tdata.obj, 4);
+    _test_dbus_object_emit_ping(tdata.obj);
+    _assert_events(&tdata, NM_MAKE_STRV("changed:4", "ping:4"));
+
+    /* Neither do method replies. */
+    g_dbus_connection_call(tdata.client,
+                           NULL,
+                           tdata.path,
+                           TEST_DBUS_INTERFACE,
+                           "Poke",
+                           g_variant_new("(u)", 5),
+                           NULL,
+                           G_DBUS_CALL_FLAGS_NONE,
+                           -1,
+                           NULL,
+                           _client_poke_cb,
+                           &tdata);
+    _assert_events(&tdata, NM_MAKE_STRV("changed:5", "return"));
+
+    /* After the reply, the signals are merged again. */
+    _test_dbus_object_set_value(tdata.obj, 6);
+    _test_dbus_object_set_value(tdata.obj, 7);
+    _assert_events(&tdata, NM_MAKE_STRV("changed:7"));
+
+    g_dbus_connection_signal_unsubscribe(tdata.client, tdata.subscription_id);
+    nm_dbus_object_unexport(tdata.obj);
+    g_clear_object(&tdata.obj);
+    g_clear_object(&tdata.client);
+    g_clear_object(&tdata.server);
+    nm_clear_pointer(&tdata.events, g_ptr_array_unref);
+}
+
+/*****************************************************************************/
+
+static void
+_setup_config(void)
+{
+    gs_free char           *config_file = NULL;
+    gs_free_error GError   *error       = NULL;
+    char                   *args[]      = {(char *) "test-dbus-manager",
+                                           (char *) "--config",
+                                           NULL,
+                                           (char *) "--intern-config",
+                                           (char *) "",
+                                           (char *) "--config-dir",
+                                           (char *) "/no/such/dir",
+                                           (char *) "--system-config-dir",
+                                           (char *) "",
+                                           NULL};
+    char                  **argv        = args;
+    int                     argc        = G_N_ELEMENTS(args) - 1;
+    NMConfigCmdLineOptions *cli;
+    GOptionContext         *context;
+    int                     fd;
+
+    fd = g_file_open_tmp("test-dbus-manager-XXXXXX.conf", &config_file, &error);
+    nmtst_assert_success(fd >= 0, error);
+    nm_close(fd);
+    if (!g_file_set_contents(config_file,
+                             "[main]\n"
+                             "properties-changed-delay=" G_STRINGIFY(
+                                 PROPERTIES_CHANGED_DELAY_MSEC) "\n",
+                             -1,
+                             NULL))
+        g_assert_not_reached();
+    args[2] = config_file;
+
+    cli     = nm_config_cmd_line_options_new(FALSE);
+    context = g_option_context_new(NULL);
+    nm_config_cmd_line_options_add_to_entries(cli, context);
+    if (!g_option_context_parse(context, &argc, &argv, NULL))
+        g_assert_not_reached();
+    g_option_context_free(context);
+
+    if (!nm_config_setup(cli, NULL, &error))
+        g_error("failure to setup config: %s", error->message);
+    nm_config_cmd_line_options_free(cli);
+
+    unlink(config_file);
+}
+
+NMTST_DEFINE();
+
+int
+main(int argc, char **argv)
+{
+    nmtst_init_with_logging(&argc, &argv, NULL, "ALL");
+
+    _setup_config();
+
+    g_test_add_func("/dbus-manager/properties-changed", test_properties_changed);
+
+    return g_test_run();
+}
@@ -0,0 +1,293 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "nm-device-index.h"
+#include "nm-test-utils-core.h"
+
+/*****************************************************************************/
+
+#define N_DEVICES 10000u
+
+typedef struct {
+    int  ifindex;
+    char iface[NM_IFNAMSIZ];
+    char ip_iface[NM_IFNAMSIZ];
+    char perm_hw_addr[sizeof("00:00:00:00:00:00")];
+    bool has_perm_hw_addr;
+} FakeDevice;
+
+static void
+_fake_device_set(FakeDevice *dev, guint i, const char *prefix, int ifindex_offset)
+{
+    dev->ifindex = ifindex_offset + ((int) i) + 1;
+    g_snprintf(dev->iface, sizeof(dev->iface), "%s%u", prefix, i);
+
+    /* Every third device has a separate IP interface (like a PPP interface
+     * of a modem), and every seventh has no permanent MAC address yet. */
+    if (i % 3u == 0)
+        g_snprintf(dev->ip_iface, sizeof(dev->ip_iface), "ppp-%s%u", prefix, i);
+    else
+        g_strlcpy(dev->ip_iface, dev->iface, sizeof(dev->ip_iface));
+
+    dev->has_perm_hw_addr = (i % 7u != 0);
+    g_snprintf(dev->perm_hw_addr,
+               sizeof(dev->perm_hw_addr),
+               "02:00:00:%02x:%02x:%02x",
+               (i >> 16) & 0xFFu,
+               (i >> 8) & 0xFFu,
+               i & 0xFFu);
+}
+
+static void
+_fake_device_index_update(NMDeviceIndex *idx, FakeDevice *dev)
+{
+    nm_device_index_update(idx,
+                           dev,
+                           dev->ifindex,
+                           dev->iface,
+                           dev->ip_iface,
+                           dev->has_perm_hw_addr ? dev->perm_hw_addr : NULL);
+}
+
+static void
+_assert_lookup_one(gpointer const *devices, guint len, FakeDevice *dev)
+{
+    g_assert_cmpint(len, ==, 1);
+    g_assert(devices);
+    g_assert(devices[0] == dev);
+}
+
+static void
+_assert_lookup_none(gpointer const *devices, guint len)
+{
+    g_assert_cmpint(len, ==, 0);
+    g_assert(!devices);
+}
+
+static void
+_assert_indexed(NMDeviceIndex *idx, FakeDevice *dev)
+{
+    gpointer const *devices;
+    guint           len;
+
+    g_assert(nm_device_index_contains(idx, dev));
+
+    devices = nm_device_index_lookup_ifindex(idx, dev->ifindex, &len);
+    _assert_lookup_one(devices, len, dev);
+
+    devices = nm_device_index_lookup_iface(idx, dev->iface, &len);
+    _assert_lookup_one(devices, len, dev);
+
+    devices = nm_device_index_lookup_ip_iface(idx, dev->ip_iface, &len);
+    _assert_lookup_one(devices, len, dev);
+
+    devices = nm_device_index_lookup_perm_hw_addr(idx, dev->perm_hw_addr, &len);
+    if (dev->has_perm_hw_addr) {
+        gs_free char *hwaddr_upper = g_ascii_strup(dev->perm_hw_addr, -1);
+
+        _assert_lookup_one(devices, len, dev);
+
+        /* the spelling of the MAC address does not matter. */
+        devices = nm_device_index_lookup_perm_hw_addr(idx, hwaddr_upper, &len);
+        _assert_lookup_one(devices, len, dev);
+    } else
+        _assert_lookup_none(devices, len);
+}
+
+static void
+_assert_not_indexed(NMDeviceIndex *idx, FakeDevice *dev)
+{
+    gpointer const *devices;
+    guint           len;
+
+    g_assert(!nm_device_index_contains(idx, dev));
+
+    devices = nm_device_index_lookup_ifindex(idx, dev->ifindex, &len);
+    _assert_lookup_none(devices, len);
+
+    devices = nm_device_index_lookup_iface(idx, dev->iface, &len);
+    _assert_lookup_none(devices, len);
+
+    devices = nm_device_index_lookup_ip_iface(idx, dev->ip_iface, &len);
+    _assert_lookup_none(devices, len);
+
+    devices = nm_device_index_lookup_perm_hw_addr(idx, dev->perm_hw_addr, &len);
+    _assert_lookup_none(devices, len);
+}
+
+static void
+test_device_index_scale(void)
+{
+    nm_auto_free_device_index NMDeviceIndex *idx  = nm_device_index_new();
+    gs_free FakeDevice                      *devs = g_new0(FakeDevice, N_DEVICES);
+    FakeDevice                               old;
+    gpointer const                          *devices;
+    guint                                    n_without_perm_hw_addr;
+    guint                                    len;
+    guint                                    i;
+
+    /* Add the devices. */
+    n_without_perm_hw_addr = 0;
+    for (i = 0; i < N_DEVICES; i++) {
+        _fake_device_set(&devs[i], i, "eth", 0);
+        g_assert(nm_device_index_update(idx,
+                                        &devs[i],
+                                        devs[i].ifindex,
+                                        devs[i].iface,
+                                        devs[i].ip_iface,
+                                        devs[i].has_perm_hw_addr ? devs[i].perm_hw_addr : NULL));
+        if (!devs[i].has_perm_hw_addr)
+            n_without_perm_hw_addr++;
+    }
+    g_assert_cmpint(nm_device_index_get_len(idx), ==, N_DEVICES);
+    g_assert_cmpint(nm_device_index_get_n_without_perm_hw_addr(idx), ==, n_without_perm_hw_addr);
+
+    for (i = 0; i < N_DEVICES; i++)
+        _assert_indexed(idx, &devs[i]);
+
+    devices = nm_device_index_lookup_ifindex(idx, 0, &len);
+    _assert_lookup_none(devices, len);
+    devices = nm_device_index_lookup_iface(idx, "eth", &len);
+    _assert_lookup_none(devices, len);
+    devices = nm_device_index_lookup_perm_hw_addr(idx, "invalid", &len);
+    _assert_lookup_none(devices, len);
+
+    /* Updating with the same keys is a no-op. */
+    for (i = 0; i < N_DEVICES; i++)
+        g_assert(!nm_device_index_update(idx,
+                                         &devs[i],
+                                         devs[i].ifindex,
+                                         devs[i].iface,
+                                         devs[i].ip_iface,
+                                         devs[i].has_perm_hw_addr ? devs[i].perm_hw_addr : NULL));
+    g_assert_cmpint(nm_device_index_get_len(idx), ==, N_DEVICES);
+
+    /* Rename all devices and give them a new ifindex. The permanent MAC
+     * address of the devices that did not have one yet becomes known. */
+    for (i = 0; i < N_DEVICES; i++) {
+        old = devs[i];
+        _fake_device_set(&devs[i], i, "wan", N_DEVICES);
+        devs[i].has_perm_hw_addr = TRUE;
+        _fake_device_index_update(idx, &devs[i]);
+
+        devices = nm_device_index_lookup_ifindex(idx, old.ifindex, &len);
+        _assert_lookup_none(devices, len);
+        devices = nm_device_index_lookup_iface(idx, old.iface, &len);
+        _assert_lookup_none(devices, len);
+        devices = nm_device_index_lookup_ip_iface(idx, old.ip_iface, &len);
+        _assert_lookup_none(devices, len);
+    }
+    g_assert_cmpint(nm_device_index_get_len(idx), ==, N_DEVICES);
+    g_assert_cmpint(nm_device_index_get_n_without_perm_hw_addr(idx), ==, 0);
+
+    for (i = 0; i < N_DEVICES; i++)
+        _assert_indexed(idx, &devs[i]);
+
+    /* Devices can share keys, the lookup returns them in the order in
+     * which they got the key. */
+    for (i = 1; i < 4; i++) {
+        g_strlcpy(devs[i].iface, devs[0].iface, sizeof(devs[i].iface));
+        _fake_device_index_update(idx, &devs[i]);
+    }
+    devices = nm_device_index_lookup_iface(idx, devs[0].iface, &len);
+    g_assert_cmpint(len, ==, 4);
+    for (i = 0; i < 4; i++)
+        g_assert(devices[i] == &devs[i]);
+
+    g_assert(nm_device_index_remove(idx, &devs[0]));
+    g_assert(!nm_device_index_remove(idx, &devs[0]));
+    devices = nm_device_index_lookup_iface(idx, devs[1].iface, &len);
+    g_assert_cmpint(len, ==, 3);
+    for (i = 0; i < 3; i++)
+        g_assert(devices[i] == &devs[i + 1]);
+
+    for (i = 1; i < 4; i++) {
+        g_snprintf(devs[i].iface, sizeof(devs[i].iface), "wan%u", i);
+        _fake_device_index_update(idx, &devs[i]);
+    }
+
+    /* Remove every other device, then the rest. */
+    for (i = 2; i < N_DEVICES; i += 2) {
+        g_assert(nm_device_index_remove(idx, &devs[i]));
+        _assert_not_indexed(idx, &devs[i]);
+    }
+    g_assert_cmpint(nm_device_index_get_len(idx), ==, N_DEVICES / 2u);
+
+    for (i = 1; i < N_DEVICES; i += 2)
+        _assert_indexed(idx, &devs[i]);
+
+    for (i = 1; i < N_DEVICES; i += 2) {
+        g_assert(nm_device_index_remove(idx, &devs[i]));
+        _assert_not_indexed(idx, &devs[i]);
+    }
+    g_assert_cmpint(nm_device_index_get_len(idx), ==, 0);
+    g_assert_cmpint(nm_device_index_get_n_without_perm_hw_addr(idx), ==, 0);
+}
+
+static void
+test_device_index_infiniband(void)
+{
+    nm_auto_free_device_index NMDeviceIndex *idx = nm_device_index_new();
+    int                                      dev1;
+    int                                      dev2;
+    gpointer const                          *devices;
+    guint                                    len;
+
+    /* Like nm_utils_hwaddr_matches(), only the last 8 bytes of InfiniBand
+     * addresses are relevant. */
+    g_assert(nm_device_index_update(
+        idx,
+        &dev1,
+        1,
+        "ib0",
+        NULL,
+        "80:00:02:08:fe:80:00:00:00:00:00:00:00:02:c9:03:00:00:0f:65"));
+    g_assert(nm_device_index_update(
+        idx,
+        &dev2,
+        2,
+        "ib1",
+        NULL,
+        "80:00:02:08:fe:80:00:00:00:00:00:00:00:02:c9:03:00:00:0f:66"));
+
+    devices = nm_device_index_lookup_perm_hw_addr(
+        idx,
+        "80:00:00:48:FE:80:00:00:00:00:00:01:00:02:C9:03:00:00:0F:65",
+        &len);
+    g_assert_cmpint(len, ==, 1);
+    g_assert(devices[0] == &dev1);
+    g_assert(nm_utils_hwaddr_matches("80:00:00:48:fe:80:00:00:00:00:00:01:00:02:c9:03:00:00:0f:65",
+                                     -1,
+                                     "80:00:02:08:fe:80:00:00:00:00:00:00:00:02:c9:03:00:00:0f:65",
+                                     -1));
+
+    devices = nm_device_index_lookup_perm_hw_addr(
+        idx,
+        "00:00:00:00:00:00:00:00:00:00:00:00:00:02:c9:03:00:00:0f:66",
+        &len);
+    g_assert_cmpint(len, ==, 1);
+    g_assert(devices[0] == &dev2);
+
+    /* An address of another length never matches. */
+    devices = nm_device_index_lookup_perm_hw_addr(idx, "00:02:c9:03:00:00:0f:65", &len);
+    _assert_lookup_none(devices, len);
+
+    g_assert(nm_device_index_remove(idx, &dev1));
+    g_assert(nm_device_index_remove(idx, &dev2));
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE();
+
+int
+main(int argc, char **argv)
+{
+    nmtst_init_with_logging(&argc, &argv, NULL, "ALL");
+
+    g_test_add_func("/device-index/scale", test_device_index_scale);
+    g_test_add_func("/device-index/infiniband", test_device_index_infiniband);
+
+    return g_test_run();
+}
@@ -175,11 +175,9 @@ _test_l3cfg_signal_notify(NML3Cfg                    *l3cfg,
     g_assert(_NM_INT_NOT_NEGATIVE(notify_data->notify_type));
     g_assert(notify_data->notify_type < _NM_L3_CONFIG_NOTIFY_TYPE_NUM);
 
-    if (notify_data->notify_type == NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE)
+    if (notify_data->notify_type == NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE) {
         g_assert(notify_data->platform_change_on_idle.obj_type_flags != 0u);
-    else if (notify_data->notify_type == NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE) {
-        g_assert(NMP_OBJECT_IS_VALID(notify_data->platform_change.obj));
-        g_assert(notify_data->platform_change.change_type != 0);
+        g_assert_cmpint(notify_data->platform_change_on_idle.n_events, >=, 1);
     } else if (notify_data->notify_type == NM_L3_CONFIG_NOTIFY_TYPE_ACD_EVENT) {
         g_assert_cmpint(notify_data->acd_event.info.n_track_infos, >=, 1);
         g_assert(notify_data->acd_event.info.track_infos);
@@ -207,9 +205,7 @@ _test_l3cfg_signal_notify(NML3Cfg                    *l3cfg,
         g_assert_not_reached();
         break;
     case TEST_L3CFG_NOTIFY_TYPE_IDLE_ASSERT_NO_SIGNAL:
-        if (NM_IN_SET(notify_data->notify_type,
-                      NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE,
-                      NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE))
+        if (notify_data->notify_type == NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE)
             return;
         g_assert_not_reached();
         return;
@@ -254,8 +250,6 @@ _test_l3cfg_signal_notify(NML3Cfg                    *l3cfg,
                 g_assert_not_reached();
                 return;
             }
-        case NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE:
-            return;
         default:
             g_assert_not_reached();
             return;
@@ -267,7 +261,6 @@ _test_l3cfg_signal_notify(NML3Cfg                    *l3cfg,
 
         if (NM_IN_SET(notify_data->notify_type,
                       NM_L3_CONFIG_NOTIFY_TYPE_PRE_COMMIT,
-                      NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE,
                       NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE))
             return;
         if (notify_data->notify_type == NM_L3_CONFIG_NOTIFY_TYPE_ACD_EVENT) {
@@ -334,6 +327,7 @@ test_l3cfg(gconstpointer test_data)
     NML3CfgCommitTypeHandle                       *commit_type_2;
     gs_unref_object NML3Cfg                       *l3cfg0      = NULL;
     nm_auto_unref_l3cd const NML3ConfigData       *l3cd_a      = NULL;
+    guint64                                        n_commits;
     TestL3cfgData                                  tdata_stack = {
                                          .f = NULL,
     };
@@ -462,10 +456,12 @@ test_l3cfg(gconstpointer test_data)
                           LOGL_DEBUG,
                           LOGD_PLATFORM);
 
+    n_commits = nm_netns_get_platform_change_stats(f->netns)->n_commits;
     _test_l3cfg_data_set_notify_type(tdata, TEST_L3CFG_NOTIFY_TYPE_COMMIT_1);
     nm_l3cfg_commit(l3cfg0, NM_L3_CFG_COMMIT_TYPE_REAPPLY);
     g_assert_cmpint(tdata->pre_commit_event_count, ==, 1);
     g_assert_cmpint(tdata->post_commit_event_count, ==, 1);
+    g_assert_cmpint(nm_netns_get_platform_change_stats(f->netns)->n_commits, ==, n_commits + 1);
     _test_l3cfg_data_set_notify_type(tdata, TEST_L3CFG_NOTIFY_TYPE_NONE);
 
     nmtstp_platform_ip_addresses_assert(tdata->f->platform,
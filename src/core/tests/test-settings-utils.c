@@ -0,0 +1,152 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "settings/nm-settings-utils.h"
+#include "nm-test-utils-core.h"
+
+/*****************************************************************************/
+
+#define N_PROFILES 200u
+
+static const char *const IFACES[] = {NULL, NULL, "eth0", "eth1", "wlan0"};
+static const char *const TYPES[]  = {"802-3-ethernet", "802-11-wireless", "vlan", NULL};
+
+typedef struct {
+    const char *iface;
+    const char *connection_type;
+} FakeProfile;
+
+static void
+_fake_profile_set_rand(FakeProfile *profile)
+{
+    profile->iface           = IFACES[nmtst_get_rand_uint32() % G_N_ELEMENTS(IFACES)];
+    profile->connection_type = TYPES[nmtst_get_rand_uint32() % G_N_ELEMENTS(TYPES)];
+}
+
+static void
+_fake_profile_update(NMSettUtilCandidateIdx *idx, GPtrArray *lst, FakeProfile *profile)
+{
+    nm_sett_util_candidate_idx_update(idx, profile, profile->iface, profile->connection_type);
+
+    /* like NMSettings, which appends new profiles to its list. */
+    if (!g_ptr_array_find(lst, profile, NULL))
+        g_ptr_array_add(lst, profile);
+}
+
+static void
+_fake_profile_remove(NMSettUtilCandidateIdx *idx, GPtrArray *lst, FakeProfile *profile)
+{
+    nm_sett_util_candidate_idx_remove(idx, profile);
+    g_assert(g_ptr_array_remove(lst, profile));
+}
+
+static void
+_assert_lookup(const NMSettUtilCandidateIdx *idx,
+               GPtrArray                    *lst,
+               const char                   *connection_type,
+               const char                   *iface)
+{
+    gs_unref_ptrarray GPtrArray *arr = NULL;
+    guint                        i;
+    guint                        j;
+
+    arr = nm_sett_util_candidate_idx_lookup(idx, connection_type, iface);
+
+    /* the result is the same as walking the whole list, in list order. */
+    for (i = 0, j = 0; i < lst->len; i++) {
+        const FakeProfile *profile = lst->pdata[i];
+
+        if (profile->iface && !nm_streq0(profile->iface, iface))
+            continue;
+        if (connection_type && !nm_streq0(profile->connection_type, connection_type))
+            continue;
+        g_assert_cmpint(j, <, arr->len);
+        g_assert(arr->pdata[j] == profile);
+        j++;
+    }
+    g_assert_cmpint(j, ==, arr->len);
+}
+
+static void
+_assert_lookup_all(const NMSettUtilCandidateIdx *idx, GPtrArray *lst)
+{
+    guint i;
+    guint j;
+
+    g_assert_cmpint(nm_sett_util_candidate_idx_get_len(idx), ==, lst->len);
+
+    for (i = 0; i < G_N_ELEMENTS(IFACES); i++) {
+        for (j = 0; j < G_N_ELEMENTS(TYPES); j++)
+            _assert_lookup(idx, lst, TYPES[j], IFACES[i]);
+        _assert_lookup(idx, lst, NULL, IFACES[i]);
+    }
+    _assert_lookup(idx, lst, NULL, "no-such-iface");
+    _assert_lookup(idx, lst, "no-such-type", NULL);
+}
+
+static void
+test_candidate_idx(void)
+{
+    NMSettUtilCandidateIdx       idx;
+    gs_free FakeProfile         *profiles = g_new0(FakeProfile, N_PROFILES);
+    gs_unref_ptrarray GPtrArray *lst      = g_ptr_array_new();
+    guint                        i;
+
+    nm_sett_util_candidate_idx_init(&idx);
+
+    /* Add the profiles. */
+    for (i = 0; i < N_PROFILES; i++) {
+        _fake_profile_set_rand(&profiles[i]);
+        _fake_profile_update(&idx, lst, &profiles[i]);
+    }
+    _assert_lookup_all(&idx, lst);
+
+    /* Updating with the same keys is a no-op. */
+    for (i = 0; i < N_PROFILES; i++)
+        _fake_profile_update(&idx, lst, &profiles[i]);
+    _assert_lookup_all(&idx, lst);
+
+    /* Profiles that change their interface name or type keep their position. */
+    for (i = 0; i < N_PROFILES; i++) {
+        if (nmtst_get_rand_uint32() % 2u)
+            continue;
+        _fake_profile_set_rand(&profiles[i]);
+        _fake_profile_update(&idx, lst, &profiles[i]);
+    }
+    _assert_lookup_all(&idx, lst);
+
+    /* Remove a third of the profiles, and add them again. Re-added profiles
+     * go to the end. */
+    for (i = 0; i < N_PROFILES; i += 3)
+        _fake_profile_remove(&idx, lst, &profiles[i]);
+    _assert_lookup_all(&idx, lst);
+
+    for (i = 0; i < N_PROFILES; i += 3) {
+        _fake_profile_set_rand(&profiles[i]);
+        _fake_profile_update(&idx, lst, &profiles[i]);
+    }
+    _assert_lookup_all(&idx, lst);
+
+    /* Remove all. */
+    for (i = 0; i < N_PROFILES; i++)
+        _fake_profile_remove(&idx, lst, &profiles[i]);
+    _assert_lookup_all(&idx, lst);
+    g_assert_cmpint(nm_sett_util_candidate_idx_get_len(&idx), ==, 0);
+
+    nm_sett_util_candidate_idx_clear(&idx);
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE();
+
+int
+main(int argc, char **argv)
+{
+    nmtst_init_with_logging(&argc, &argv, NULL, "ALL");
+
+    g_test_add_func("/settings-utils/candidate-idx", test_candidate_idx);
+
+    return g_test_run();
+}
@@ -19,39 +19,46 @@
 #define NM_CONFIG_KEYFILE_GROUP_GLOBAL_DNS   "global-dns"
 #define NM_CONFIG_KEYFILE_GROUP_CONFIG       ".config"
 
-#define NM_CONFIG_KEYFILE_KEY_MAIN_ASSUME_IPV6LL_ONLY          "assume-ipv6ll-only"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_AUTH_POLKIT                 "auth-polkit"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_AUTOCONNECT_RETRIES_DEFAULT "autoconnect-retries-default"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_CONFIGURE_AND_QUIT          "configure-and-quit"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_DEBUG                       "debug"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_DHCP                        "dhcp"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_DNS                         "dns"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_FIREWALL_BACKEND            "firewall-backend"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_HOSTNAME_MODE               "hostname-mode"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER              "ignore-carrier"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_IWD_CONFIG_PATH             "iwd-config-path"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_MIGRATE_IFCFG_RH            "migrate-ifcfg-rh"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_MONITOR_CONNECTION_FILES    "monitor-connection-files"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_NO_AUTO_DEFAULT             "no-auto-default"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_PLUGINS                     "plugins"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_RC_MANAGER                  "rc-manager"
-#define NM_CONFIG_KEYFILE_KEY_MAIN_SYSTEMD_RESOLVED            "systemd-resolved"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_ASSUME_IPV6LL_ONLY           "assume-ipv6ll-only"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_AUTH_POLKIT                  "auth-polkit"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_AUTOCONNECT_RETRIES_DEFAULT  "autoconnect-retries-default"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_CONFIGURE_AND_QUIT           "configure-and-quit"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_DEBUG                        "debug"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_DHCP                         "dhcp"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_DNS                          "dns"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_FIREWALL_BACKEND             "firewall-backend"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_HOSTNAME_MODE                "hostname-mode"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER               "ignore-carrier"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_ROUTE_PROTOCOLS       "ignore-route-protocols"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_ROUTE_TABLES          "ignore-route-tables"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_IWD_CONFIG_PATH              "iwd-config-path"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_MIGRATE_IFCFG_RH             "migrate-ifcfg-rh"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_MONITOR_CONNECTION_FILES     "monitor-connection-files"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_NO_AUTO_DEFAULT              "no-auto-default"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_PLUGINS                      "plugins"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_PROPERTIES_CHANGED_DELAY     "properties-changed-delay"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_PROPERTIES_CHANGED_RATELIMIT "properties-changed-ratelimit"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_RC_MANAGER                   "rc-manager"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_SYSTEMD_RESOLVED             "systemd-resolved"
 
 #define NM_CONFIG_KEYFILE_KEY_LOGGING_AUDIT   "audit"
 #define NM_CONFIG_KEYFILE_KEY_LOGGING_BACKEND "backend"
 #define NM_CONFIG_KEYFILE_KEY_LOGGING_DOMAINS "domains"
 #define NM_CONFIG_KEYFILE_KEY_LOGGING_LEVEL   "level"
 
-#define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_ENABLED  "enabled"
-#define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_INTERVAL "interval"
-#define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_TIMEOUT  "timeout"
-#define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_RESPONSE "response"
-#define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_URI      "uri"
+#define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_ENABLED      "enabled"
+#define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_INTERVAL     "interval"
+#define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_MAX_INTERVAL "max-interval"
+#define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_TIMEOUT      "timeout"
+#define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_RESPONSE     "response"
+#define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_URI          "uri"
 
+#define NM_CONFIG_KEYFILE_KEY_KEYFILE_CACHE             "cache"
 #define NM_CONFIG_KEYFILE_KEY_KEYFILE_PATH              "path"
 #define NM_CONFIG_KEYFILE_KEY_KEYFILE_UNMANAGED_DEVICES "unmanaged-devices"
 #define NM_CONFIG_KEYFILE_KEY_KEYFILE_HOSTNAME          "hostname"
 #define NM_CONFIG_KEYFILE_KEY_KEYFILE_RENAME            "rename"
+#define NM_CONFIG_KEYFILE_KEY_KEYFILE_WATCH             "watch"
 
 #define NM_CONFIG_KEYFILE_KEY_IFUPDOWN_MANAGED "managed"
 
@@ -73,8 +80,9 @@
 #define NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_SCAN_RAND_MAC_ADDRESS "wifi.scan-rand-mac-address"
 #define NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_SCAN_GENERATE_MAC_ADDRESS_MASK \
     "wifi.scan-generate-mac-address-mask"
-#define NM_CONFIG_KEYFILE_KEY_DEVICE_CARRIER_WAIT_TIMEOUT "carrier-wait-timeout"
-#define NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_IWD_AUTOCONNECT "wifi.iwd.autoconnect"
+#define NM_CONFIG_KEYFILE_KEY_DEVICE_CARRIER_WAIT_TIMEOUT      "carrier-wait-timeout"
+#define NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_IWD_AUTOCONNECT      "wifi.iwd.autoconnect"
+#define NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_NL80211_SCAN_RESULTS "wifi.nl80211-scan-results"
 
 #define NM_CONFIG_KEYFILE_KEY_MATCH_DEVICE "match-device"
 #define NM_CONFIG_KEYFILE_KEY_STOP_MATCH   "stop-match"
@@ -284,6 +284,16 @@ typedef struct {
     guint8       *permissions;
     GCancellable *permissions_cancellable;
 
+    /* The NMRemoteConnections for which we need to fetch the settings.
+     * They are fetched together with one GetConnectionSettings() call
+     * on an idle handler. */
+    struct {
+        GArray       *pending;
+        GSource      *idle_source;
+        GCancellable *cancellable;
+        bool          unsupported : 1;
+    } get_settings_batch;
+
     char *name_owner;
     guint name_owner_changed_id;
     guint dbsid_nm_object_manager;
@@ -3325,21 +3335,70 @@ _dbus_get_managed_objects_cb(GObject *source, GAsyncResult *result, gpointer use
 
 /*****************************************************************************/
 
+/* With nm_client_fetch_connection_settings_async(), the task waits for all
+ * requests that it started. The task data counts these requests and keeps
+ * the first error, which is the result of the task. */
+typedef struct {
+    guint   n_pending;
+    GError *error;
+} FetchSettingsData;
+
+static void
+_fetch_settings_data_free(gpointer data)
+{
+    FetchSettingsData *fsd = data;
+
+    nm_clear_error(&fsd->error);
+    nm_g_slice_free(fsd);
+}
+
+static GTask *
+_fetch_settings_task_acquire(GTask *task)
+{
+    FetchSettingsData *fsd = g_task_get_task_data(task);
+
+    fsd->n_pending++;
+    return g_object_ref(task);
+}
+
+static void
+_fetch_settings_task_release(GTask *task, const GError *error)
+{
+    FetchSettingsData *fsd = g_task_get_task_data(task);
+
+    nm_assert(fsd->n_pending > 0);
+
+    if (error && !fsd->error)
+        fsd->error = g_error_copy(error);
+
+    if (--fsd->n_pending == 0) {
+        if (fsd->error)
+            g_task_return_error(task, g_steal_pointer(&fsd->error));
+        else
+            g_task_return_boolean(task, TRUE);
+    }
+    g_object_unref(task);
+}
+
 static void
 _nm_client_get_settings_call_cb(GObject *source, GAsyncResult *result, gpointer user_data)
 {
     NMRemoteConnection        *remote_connection;
+    GTask                     *task;
     NMClient                  *self;
     gs_unref_variant GVariant *ret      = NULL;
     gs_free_error GError      *error    = NULL;
     gs_unref_variant GVariant *settings = NULL;
     NMLDBusObject             *dbobj;
 
-    ret = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
-    if (!ret && nm_utils_error_is_cancelled(error))
-        return;
+    nm_utils_user_data_unpack(user_data, &remote_connection, &task);
 
-    remote_connection = user_data;
+    ret = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+    if (!ret && nm_utils_error_is_cancelled(error)) {
+        /* the request was superseded by a newer one, or the connection is gone. */
+        g_clear_error(&error);
+        goto out;
+    }
 
     self = _nm_object_get_client(remote_connection);
 
@@ -3359,29 +3418,297 @@ _nm_client_get_settings_call_cb(GObject *source, GAsyncResult *result, gpointer
         g_variant_get(ret, "(@a{sa{sv}})", &settings);
     }
 
+    /* Like with GetConnectionSettings(), a connection that is not visible
+     * to the user has no settings, but that is no failure. */
+    if (g_error_matches(error, NM_SETTINGS_ERROR, NM_SETTINGS_ERROR_PERMISSION_DENIED))
+        g_clear_error(&error);
+
     _nm_remote_settings_get_settings_commit(remote_connection, settings);
 
     _dbus_handle_changes_commit(self, TRUE);
+
+out:
+    if (task)
+        _fetch_settings_task_release(task, error);
+}
+
+static void
+_get_settings_call_single(NMClient           *self,
+                          NMRemoteConnection *remote_connection,
+                          GCancellable       *cancellable,
+                          GTask              *task)
+{
+    _nm_client_dbus_call_simple(
+        self,
+        cancellable,
+        _nm_object_get_path(remote_connection),
+        NM_DBUS_INTERFACE_SETTINGS_CONNECTION,
+        "GetSettings",
+        g_variant_new("()"),
+        G_VARIANT_TYPE("(a{sa{sv}})"),
+        G_DBUS_CALL_FLAGS_NONE,
+        NM_DBUS_DEFAULT_TIMEOUT_MSEC,
+        _nm_client_get_settings_call_cb,
+        nm_utils_user_data_pack(remote_connection,
+                                task ? _fetch_settings_task_acquire(task) : NULL));
+}
+
+/* The maximum number of connections whose settings are requested with one
+ * GetConnectionSettings() call. */
+#define GET_SETTINGS_BATCH_MAX 256u
+
+typedef struct {
+    NMRemoteConnection *remote_connection;
+
+    /* the cancellable of the request from _nm_remote_settings_get_settings_prepare().
+     * It gets cancelled when the settings are requested anew, or when the
+     * connection goes away. */
+    GCancellable *cancellable;
+} GetSettingsBatchData;
+
+static void
+_get_settings_batch_data_clear(gpointer data)
+{
+    GetSettingsBatchData *d = data;
+
+    g_object_unref(d->remote_connection);
+    g_object_unref(d->cancellable);
+}
+
+static GArray *
+_get_settings_batch_new(void)
+{
+    GArray *batch;
+
+    batch = g_array_new(FALSE, FALSE, sizeof(GetSettingsBatchData));
+    g_array_set_clear_func(batch, _get_settings_batch_data_clear);
+    return batch;
+}
+
+static void
+_get_settings_batch_call_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    NMClient                      *self;
+    NMClientPrivate               *priv;
+    GTask                         *task;
+    gs_unref_array GArray         *batch    = NULL;
+    gs_unref_variant GVariant     *ret      = NULL;
+    gs_unref_variant GVariant     *settings = NULL;
+    gs_unref_hashtable GHashTable *idx      = NULL;
+    gs_free_error GError          *error    = NULL;
+    GVariantIter                   iter;
+    const char                    *path;
+    GVariant                      *s;
+    guint                          i;
+
+    nm_utils_user_data_unpack(user_data, &self, &batch, &task);
+
+    ret = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+    if (!ret && nm_utils_error_is_cancelled(error)) {
+        g_clear_error(&error);
+        goto out;
+    }
+
+    priv = NM_CLIENT_GET_PRIVATE(self);
+
+    if (!ret) {
+        if (g_error_matches(error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD)) {
+            /* An older NetworkManager. Fetch the settings one by one from now on. */
+            NML_NMCLIENT_LOG_D(self, "GetConnectionSettings() not supported, use GetSettings()");
+            priv->get_settings_batch.unsupported = TRUE;
+        } else {
+            /* The batch fails as a whole, for example on a timeout or when the
+             * reply is too large. Retry each connection on its own, so that the
+             * settings of the connections still get fetched. */
+            NML_NMCLIENT_LOG_T(self,
+                               "GetConnectionSettings() for %u connections completed with "
+                               "error: %s (retry with GetSettings())",
+                               batch->len,
+                               error->message);
+        }
+        for (i = 0; i < batch->len; i++) {
+            GetSettingsBatchData *d = &nm_g_array_index(batch, GetSettingsBatchData, i);
+
+            if (!g_cancellable_is_cancelled(d->cancellable))
+                _get_settings_call_single(self, d->remote_connection, d->cancellable, task);
+        }
+        /* the result of the task is that of the single requests. */
+        g_clear_error(&error);
+        goto out;
+    }
+
+    NML_NMCLIENT_LOG_T(self,
+                       "GetConnectionSettings() for %u connections completed with success",
+                       batch->len);
+
+    idx = g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, (GDestroyNotify) g_variant_unref);
+
+    settings = g_variant_get_child_value(ret, 0);
+    g_variant_iter_init(&iter, settings);
+    while (g_variant_iter_next(&iter, "{&o@a{sa{sv}}}", &path, &s))
+        g_hash_table_insert(idx, (gpointer) path, s);
+
+    for (i = 0; i < batch->len; i++) {
+        GetSettingsBatchData *d = &nm_g_array_index(batch, GetSettingsBatchData, i);
+
+        if (g_cancellable_is_cancelled(d->cancellable))
+            continue;
+
+        /* Like with GetSettings(), a connection without settings is not visible. */
+        _nm_remote_settings_get_settings_commit(
+            d->remote_connection,
+            g_hash_table_lookup(idx, _nm_object_get_path(d->remote_connection)));
+    }
+
+    _dbus_handle_changes_commit(self, TRUE);
+
+out:
+    if (task)
+        _fetch_settings_task_release(task, error);
+}
+
+static void
+_get_settings_batch_call_chunk(NMClient *self, GArray *batch_take, GTask *task)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+    GVariantBuilder  builder;
+    guint            i;
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("ao"));
+    for (i = 0; i < batch_take->len; i++) {
+        GetSettingsBatchData *d = &nm_g_array_index(batch_take, GetSettingsBatchData, i);
+
+        g_variant_builder_add(&builder, "o", _nm_object_get_path(d->remote_connection));
+    }
+
+    if (!priv->get_settings_batch.cancellable)
+        priv->get_settings_batch.cancellable = g_cancellable_new();
+
+    _nm_client_dbus_call_simple(
+        self,
+        priv->get_settings_batch.cancellable,
+        NM_DBUS_PATH_SETTINGS,
+        NM_DBUS_INTERFACE_SETTINGS,
+        "GetConnectionSettings",
+        g_variant_new("(ao)", &builder),
+        G_VARIANT_TYPE("(a{oa{sa{sv}}})"),
+        G_DBUS_CALL_FLAGS_NONE,
+        NM_DBUS_DEFAULT_TIMEOUT_MSEC,
+        _get_settings_batch_call_cb,
+        nm_utils_user_data_pack(self,
+                                batch_take,
+                                task ? _fetch_settings_task_acquire(task) : NULL));
+}
+
+static void
+_get_settings_batch_call(NMClient *self, GArray *batch_take, GTask *task)
+{
+    gs_unref_array GArray *batch = batch_take;
+    GArray                *chunk = NULL;
+    guint                  i;
+
+    /* The settings of all connections are returned in one D-Bus message. Split
+     * large batches, so that the reply stays well below the maximum message
+     * size and the daemon does not block for long while serializing it. */
+    for (i = 0; i < batch->len; i++) {
+        GetSettingsBatchData *d = &nm_g_array_index(batch, GetSettingsBatchData, i);
+
+        if (g_cancellable_is_cancelled(d->cancellable))
+            continue;
+
+        if (!chunk)
+            chunk = _get_settings_batch_new();
+        *nm_g_array_append_new(chunk, GetSettingsBatchData) = (GetSettingsBatchData) {
+            .remote_connection = g_object_ref(d->remote_connection),
+            .cancellable       = g_object_ref(d->cancellable),
+        };
+
+        if (chunk->len >= GET_SETTINGS_BATCH_MAX)
+            _get_settings_batch_call_chunk(self, g_steal_pointer(&chunk), task);
+    }
+
+    if (chunk)
+        _get_settings_batch_call_chunk(self, chunk, task);
+}
+
+static gboolean
+_get_settings_batch_idle_cb(gpointer user_data)
+{
+    NMClient              *self    = user_data;
+    NMClientPrivate       *priv    = NM_CLIENT_GET_PRIVATE(self);
+    gs_unref_array GArray *batch   = NULL;
+    guint                  n_paths = 0;
+    guint                  i;
+
+    nm_clear_g_source_inst(&priv->get_settings_batch.idle_source);
+
+    batch = g_steal_pointer(&priv->get_settings_batch.pending);
+    if (!batch)
+        return G_SOURCE_CONTINUE;
+
+    for (i = 0; i < batch->len; i++) {
+        GetSettingsBatchData *d = &nm_g_array_index(batch, GetSettingsBatchData, i);
+
+        if (!g_cancellable_is_cancelled(d->cancellable))
+            n_paths++;
+    }
+
+    if (n_paths <= 1) {
+        /* With only one connection, there is no benefit over GetSettings(). */
+        for (i = 0; i < batch->len; i++) {
+            GetSettingsBatchData *d = &nm_g_array_index(batch, GetSettingsBatchData, i);
+
+            if (!g_cancellable_is_cancelled(d->cancellable))
+                _get_settings_call_single(self, d->remote_connection, d->cancellable, NULL);
+        }
+        return G_SOURCE_CONTINUE;
+    }
+
+    _get_settings_batch_call(self, g_steal_pointer(&batch), NULL);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_get_settings_batch_clear(NMClient *self)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+
+    nm_clear_g_source_inst(&priv->get_settings_batch.idle_source);
+    nm_clear_pointer(&priv->get_settings_batch.pending, g_array_unref);
+    nm_clear_g_cancellable(&priv->get_settings_batch.cancellable);
+    priv->get_settings_batch.unsupported = FALSE;
 }
 
 void
 _nm_client_get_settings_call(NMClient *self, NMLDBusObject *dbobj)
 {
-    GCancellable *cancellable;
+    NMClientPrivate    *priv              = NM_CLIENT_GET_PRIVATE(self);
+    NMRemoteConnection *remote_connection = NM_REMOTE_CONNECTION(dbobj->nmobj);
+    GCancellable       *cancellable;
 
-    cancellable = _nm_remote_settings_get_settings_prepare(NM_REMOTE_CONNECTION(dbobj->nmobj));
+    /* This also cancels a previous request for the connection. */
+    cancellable = _nm_remote_settings_get_settings_prepare(remote_connection);
 
-    _nm_client_dbus_call_simple(self,
-                                cancellable,
-                                dbobj->dbus_path->str,
-                                NM_DBUS_INTERFACE_SETTINGS_CONNECTION,
-                                "GetSettings",
-                                g_variant_new("()"),
-                                G_VARIANT_TYPE("(a{sa{sv}})"),
-                                G_DBUS_CALL_FLAGS_NONE,
-                                NM_DBUS_DEFAULT_TIMEOUT_MSEC,
-                                _nm_client_get_settings_call_cb,
-                                dbobj->nmobj);
+    if (priv->get_settings_batch.unsupported) {
+        _get_settings_call_single(self, remote_connection, cancellable, NULL);
+        return;
+    }
+
+    /* Queue the request, so that the settings of all connections that appear
+     * (or get updated) together are fetched with one D-Bus call. */
+    if (!priv->get_settings_batch.pending)
+        priv->get_settings_batch.pending = _get_settings_batch_new();
+    *nm_g_array_append_new(priv->get_settings_batch.pending, GetSettingsBatchData) =
+        (GetSettingsBatchData) {
+            .remote_connection = g_object_ref(remote_connection),
+            .cancellable       = g_object_ref(cancellable),
+        };
+
+    if (!priv->get_settings_batch.idle_source) {
+        priv->get_settings_batch.idle_source =
+            nm_g_idle_source_new(G_PRIORITY_DEFAULT, _get_settings_batch_idle_cb, self, NULL);
+        g_source_attach(priv->get_settings_batch.idle_source, priv->dbus_context);
+    }
 }
 
 static void
@@ -3416,6 +3743,16 @@ _dbus_settings_updated_cb(GDBusConnection *connection,
         return;
     }
 
+    if (!_nm_remote_settings_get_settings_requested(NM_REMOTE_CONNECTION(dbobj->nmobj))) {
+        /* With NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_SETTINGS, nobody was interested
+         * in the settings of this profile so far. */
+        NML_NMCLIENT_LOG_T(self,
+                           "%s: [%s] ignore Updated signal for connection without settings",
+                           log_context,
+                           object_path);
+        return;
+    }
+
     NML_NMCLIENT_LOG_T(self, "%s: [%s] Updated signal received", log_context, object_path);
 
     _nm_client_get_settings_call(self, dbobj);
@@ -6149,6 +6486,126 @@ nm_client_reload_connections_finish(NMClient *client, GAsyncResult *result, GErr
 
 /*****************************************************************************/
 
+/**
+ * nm_client_fetch_connection_settings_async:
+ * @client: the #NMClient
+ * @connections: (element-type NMRemoteConnection) (nullable): the connections
+ *   for which to fetch the settings, or %NULL for all connections of
+ *   nm_client_get_connections().
+ * @cancellable: a #GCancellable, or %NULL
+ * @callback: (scope async) (closure user_data): callback to be called when the
+ *   settings are fetched
+ * @user_data: caller-specific data passed to @callback
+ *
+ * Fetches the settings of @connections with one D-Bus call. This is useful
+ * together with %NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_SETTINGS, where
+ * the #NMRemoteConnection instances have no settings until they are fetched.
+ * Once fetched, the settings of the connections are kept up to date.
+ *
+ * Connections which are not visible to the user have no settings
+ * afterwards, see nm_remote_connection_get_visible().
+ *
+ * The operation fails with the first error of the D-Bus calls that
+ * it made, after all of them completed. The settings of the other
+ * connections are still updated.
+ *
+ * Cancelling @cancellable only affects the result of the operation,
+ * the settings are still updated.
+ *
+ * Since: 1.60
+ **/
+void
+nm_client_fetch_connection_settings_async(NMClient           *client,
+                                          const GPtrArray    *connections,
+                                          GCancellable       *cancellable,
+                                          GAsyncReadyCallback callback,
+                                          gpointer            user_data)
+{
+    NMClientPrivate       *priv;
+    gs_unref_object GTask *task  = NULL;
+    gs_unref_array GArray *batch = NULL;
+    FetchSettingsData     *fsd;
+    guint                  i;
+
+    g_return_if_fail(NM_IS_CLIENT(client));
+    g_return_if_fail(!cancellable || G_IS_CANCELLABLE(cancellable));
+
+    priv = NM_CLIENT_GET_PRIVATE(client);
+
+    task = nm_g_task_new(client,
+                         cancellable,
+                         nm_client_fetch_connection_settings_async,
+                         callback,
+                         user_data);
+
+    /* Hold one request ourself until all requests are started. */
+    fsd  = g_slice_new(FetchSettingsData);
+    *fsd = (FetchSettingsData) {
+        .n_pending = 1,
+    };
+    g_task_set_task_data(task, fsd, _fetch_settings_data_free);
+
+    if (!connections)
+        connections = nm_client_get_connections(client);
+
+    batch = _get_settings_batch_new();
+    for (i = 0; i < connections->len; i++) {
+        NMRemoteConnection *remote_connection = connections->pdata[i];
+        GCancellable       *c;
+
+        nm_assert(NM_IS_REMOTE_CONNECTION(remote_connection));
+
+        if (_nm_object_get_client(remote_connection) != client) {
+            /* the connection is already gone. */
+            continue;
+        }
+
+        /* This also cancels a previous request for the connection. */
+        c = _nm_remote_settings_get_settings_prepare(remote_connection);
+
+        *nm_g_array_append_new(batch, GetSettingsBatchData) = (GetSettingsBatchData) {
+            .remote_connection = g_object_ref(remote_connection),
+            .cancellable       = g_object_ref(c),
+        };
+    }
+
+    if (priv->get_settings_batch.unsupported) {
+        for (i = 0; i < batch->len; i++) {
+            GetSettingsBatchData *d = &nm_g_array_index(batch, GetSettingsBatchData, i);
+
+            _get_settings_call_single(client, d->remote_connection, d->cancellable, task);
+        }
+    } else if (batch->len > 0)
+        _get_settings_batch_call(client, g_steal_pointer(&batch), task);
+
+    _fetch_settings_task_release(g_steal_pointer(&task), NULL);
+}
+
+/**
+ * nm_client_fetch_connection_settings_finish:
+ * @client: the #NMClient
+ * @result: the result passed to the #GAsyncReadyCallback
+ * @error: return location for #GError
+ *
+ * Gets the result of an nm_client_fetch_connection_settings_async() call.
+ *
+ * Returns: %TRUE on success, %FALSE on failure
+ *
+ * Since: 1.60
+ **/
+gboolean
+nm_client_fetch_connection_settings_finish(NMClient *client, GAsyncResult *result, GError **error)
+{
+    g_return_val_if_fail(NM_IS_CLIENT(client), FALSE);
+    g_return_val_if_fail(
+        nm_g_task_is_valid(result, client, nm_client_fetch_connection_settings_async),
+        FALSE);
+
+    return g_task_propagate_boolean(G_TASK(result), error);
+}
+
+/*****************************************************************************/
+
 /**
  * nm_client_get_dns_mode:
  * @client: the #NMClient
@@ -7051,6 +7508,7 @@ _init_release_all(NMClient *self)
 
     nm_clear_g_cancellable(&priv->permissions_cancellable);
     nm_clear_g_cancellable(&priv->get_managed_objects_cancellable);
+    _get_settings_batch_clear(self);
 
     nm_clear_g_dbus_connection_signal(priv->dbus_connection, &priv->dbsid_nm_object_manager);
     nm_clear_g_dbus_connection_signal(priv->dbus_connection,
@@ -8206,7 +8664,8 @@ const NMLDBusMetaIface _nml_dbus_meta_iface_nm_settings = NML_DBUS_META_IFACE_IN
             _priv.settings.connections,
             nm_remote_connection_get_type,
             .notify_changed_ao       = _property_ao_notify_changed_connections_cb,
-            .check_nmobj_visible_fcn = (gboolean (*)(GObject *)) nm_remote_connection_get_visible),
+            .check_nmobj_visible_fcn =
+                (gboolean (*)(GObject *)) _nm_remote_connection_get_visible_or_unfetched),
         NML_DBUS_META_PROPERTY_INIT_S("Hostname",
                                       PROP_HOSTNAME,
                                       NMClient,
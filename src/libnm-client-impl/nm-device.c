@@ -574,6 +574,7 @@ const NMLDBusMetaIface _nml_dbus_meta_iface_nm_device = NML_DBUS_META_IFACE_INIT
                                       PROP_IP4_CONNECTIVITY,
                                       NMDevicePrivate,
                                       ip4_connectivity),
+        NML_DBUS_META_PROPERTY_INIT_TODO("Ip4ConnectivityNextCheck", "x"),
         NML_DBUS_META_PROPERTY_INIT_O_PROP("Ip6Config",
                                            PROP_IP6_CONFIG,
                                            NMDevicePrivate,
@@ -583,6 +584,7 @@ const NMLDBusMetaIface _nml_dbus_meta_iface_nm_device = NML_DBUS_META_IFACE_INIT
                                       PROP_IP6_CONNECTIVITY,
                                       NMDevicePrivate,
                                       ip6_connectivity),
+        NML_DBUS_META_PROPERTY_INIT_TODO("Ip6ConnectivityNextCheck", "x"),
         NML_DBUS_META_PROPERTY_INIT_S("IpInterface",
                                       PROP_IP_INTERFACE,
                                       NMDevicePrivate,
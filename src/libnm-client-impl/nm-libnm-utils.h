@@ -235,10 +235,11 @@ typedef enum {
 
 /*****************************************************************************/
 
-#define NM_CLIENT_INSTANCE_FLAGS_ALL                                             \
-    ((NMClientInstanceFlags) (NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS \
-                              | NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_GOOD        \
-                              | NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD))
+#define NM_CLIENT_INSTANCE_FLAGS_ALL                                              \
+    ((NMClientInstanceFlags) (NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS  \
+                              | NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_GOOD         \
+                              | NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD          \
+                              | NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_SETTINGS))
 
 #define NM_CLIENT_INSTANCE_FLAGS_ALL_WRITABLE                                                       \
     ((NMClientInstanceFlags) (NM_CLIENT_INSTANCE_FLAGS_ALL                                          \
@@ -1047,6 +1048,10 @@ GCancellable *_nm_remote_settings_get_settings_prepare(NMRemoteConnection *self)
 
 void _nm_remote_settings_get_settings_commit(NMRemoteConnection *self, GVariant *settings);
 
+gboolean _nm_remote_settings_get_settings_requested(NMRemoteConnection *self);
+
+gboolean _nm_remote_connection_get_visible_or_unfetched(NMRemoteConnection *connection);
+
 /*****************************************************************************/
 
 void
@@ -44,6 +44,8 @@ typedef struct {
 
     bool visible : 1;
     bool is_initialized : 1;
+    bool settings_requested : 1;
+    bool settings_fetched : 1;
 } NMRemoteConnectionPrivate;
 
 struct _NMRemoteConnection {
@@ -644,6 +646,17 @@ nm_remote_connection_get_visible(NMRemoteConnection *connection)
     return NM_REMOTE_CONNECTION_GET_PRIVATE(connection)->visible;
 }
 
+gboolean
+_nm_remote_connection_get_visible_or_unfetched(NMRemoteConnection *connection)
+{
+    NMRemoteConnectionPrivate *priv = NM_REMOTE_CONNECTION_GET_PRIVATE(connection);
+
+    /* With NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_SETTINGS, we don't know
+     * whether a connection is visible before its settings are fetched.
+     * Such connections are still exposed by nm_client_get_connections(). */
+    return priv->visible || !priv->settings_fetched;
+}
+
 /*****************************************************************************/
 
 GCancellable *
@@ -653,9 +666,16 @@ _nm_remote_settings_get_settings_prepare(NMRemoteConnection *self)
 
     nm_clear_g_cancellable(&priv->get_settings_cancellable);
     priv->get_settings_cancellable = g_cancellable_new();
+    priv->settings_requested       = TRUE;
     return priv->get_settings_cancellable;
 }
 
+gboolean
+_nm_remote_settings_get_settings_requested(NMRemoteConnection *self)
+{
+    return NM_REMOTE_CONNECTION_GET_PRIVATE(self)->settings_requested;
+}
+
 void
 _nm_remote_settings_get_settings_commit(NMRemoteConnection *self, GVariant *settings)
 {
@@ -671,6 +691,11 @@ _nm_remote_settings_get_settings_commit(NMRemoteConnection *self, GVariant *sett
         priv->is_initialized = TRUE;
     }
 
+    if (!priv->settings_fetched) {
+        changed                = TRUE;
+        priv->settings_fetched = TRUE;
+    }
+
     if (settings) {
         if (!_nm_connection_replace_settings((NMConnection *) self,
                                              settings,
@@ -718,6 +743,15 @@ register_client(NMObject *nmobj, NMClient *client, NMLDBusObject *dbobj)
 {
     NM_OBJECT_CLASS(nm_remote_connection_parent_class)->register_client(nmobj, client, dbobj);
     _nm_connection_set_path_rstr(NM_CONNECTION(nmobj), dbobj->dbus_path);
+
+    if (NM_FLAGS_HAS(nm_client_get_instance_flags(client),
+                     NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_SETTINGS)) {
+        /* The connection is ready without settings. They get fetched by
+         * nm_client_fetch_connection_settings_async(). */
+        NM_REMOTE_CONNECTION_GET_PRIVATE(nmobj)->is_initialized = TRUE;
+        return;
+    }
+
     _nm_client_get_settings_call(client, dbobj);
 }
 
@@ -1352,6 +1352,101 @@ test_connection_invalid(void)
 
 /*****************************************************************************/
 
+static void
+_test_connection_fetch_settings_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    gs_free_error GError *error = NULL;
+    gboolean              success;
+
+    success = nm_client_fetch_connection_settings_finish(NM_CLIENT(source), result, &error);
+    nmtst_assert_success(success, error);
+    g_main_loop_quit(gl.loop);
+}
+
+static void
+test_connection_fetch_settings(void)
+{
+    NMTSTC_SERVICE_INFO_SETUP(my_sinfo);
+    gs_unref_object NMConnection *connection = NULL;
+    gs_unref_object NMClient     *client     = NULL;
+    gs_unref_ptrarray GPtrArray  *subset     = NULL;
+    gs_free_error GError         *error      = NULL;
+    NMSettingConnection          *s_con;
+    const GPtrArray              *connections;
+    gs_free char                 *path0 = NULL;
+    gs_free char                 *path1 = NULL;
+    guint                         i;
+
+    connection = nmtst_create_minimal_connection("test-connection-fetch-settings-0",
+                                                 NULL,
+                                                 NM_SETTING_WIRED_SETTING_NAME,
+                                                 &s_con);
+    nmtst_connection_normalize(connection);
+    nmtstc_service_add_connection(my_sinfo, connection, TRUE, &path0);
+
+    g_object_set(s_con,
+                 NM_SETTING_CONNECTION_ID,
+                 "test-connection-fetch-settings-1",
+                 NM_SETTING_CONNECTION_UUID,
+                 nmtst_uuid_generate(),
+                 NULL);
+    nmtstc_service_add_connection(my_sinfo, connection, TRUE, &path1);
+
+    client = g_initable_new(NM_TYPE_CLIENT,
+                            NULL,
+                            &error,
+                            NM_CLIENT_INSTANCE_FLAGS,
+                            (guint) NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_SETTINGS,
+                            NULL);
+    nmtst_assert_success(client, error);
+
+    /* The connections are there, but without settings. */
+    connections = nm_client_get_connections(client);
+    g_assert_cmpint(connections->len, ==, 2);
+    for (i = 0; i < connections->len; i++) {
+        g_assert(!nm_remote_connection_get_visible(connections->pdata[i]));
+        g_assert(!nm_connection_get_uuid(connections->pdata[i]));
+    }
+
+    /* Fetch the settings of one of them. */
+    subset = g_ptr_array_new_with_free_func(g_object_unref);
+    g_ptr_array_add(subset, g_object_ref(connections->pdata[0]));
+    nm_client_fetch_connection_settings_async(client,
+                                              subset,
+                                              NULL,
+                                              _test_connection_fetch_settings_cb,
+                                              NULL);
+    nmtst_main_loop_run_assert(gl.loop, 5000);
+
+    connections = nm_client_get_connections(client);
+    g_assert_cmpint(connections->len, ==, 2);
+    g_assert(connections->pdata[0] == subset->pdata[0]);
+    g_assert(nm_remote_connection_get_visible(connections->pdata[0]));
+    nmtst_assert_connection_verifies_without_normalization(connections->pdata[0]);
+    g_assert(!nm_remote_connection_get_visible(connections->pdata[1]));
+    g_assert(!nm_connection_get_uuid(connections->pdata[1]));
+
+    /* Fetch the settings of all connections. */
+    nm_client_fetch_connection_settings_async(client,
+                                              NULL,
+                                              NULL,
+                                              _test_connection_fetch_settings_cb,
+                                              NULL);
+    nmtst_main_loop_run_assert(gl.loop, 5000);
+
+    connections = nm_client_get_connections(client);
+    g_assert_cmpint(connections->len, ==, 2);
+    for (i = 0; i < connections->len; i++) {
+        const char *path = nm_connection_get_path(connections->pdata[i]);
+
+        g_assert(nm_streq0(path, path0) || nm_streq0(path, path1));
+        g_assert(nm_remote_connection_get_visible(connections->pdata[i]));
+        nmtst_assert_connection_verifies_without_normalization(connections->pdata[i]);
+    }
+}
+
+/*****************************************************************************/
+
 typedef struct {
     NMClient    *nmc;
     NMOptionBool completed;
@@ -1612,6 +1707,7 @@ main(int argc, char **argv)
                          test_activate_virtual_teardown);
     g_test_add_func("/libnm/device-connection-compatibility", test_device_connection_compatibility);
     g_test_add_func("/libnm/connection/invalid", test_connection_invalid);
+    g_test_add_func("/libnm/connection/fetch-settings", test_connection_fetch_settings);
     g_test_add_func("/libnm/test_client_wait_shutdown", test_client_wait_shutdown);
 
     return g_test_run();
@@ -29,6 +29,14 @@ G_BEGIN_DECLS
  * @NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD: like @NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_GOOD
  *   indicates that the instance completed initialization with failure. In that
  *   case the instance is unusable. Since: 1.42.
+ * @NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_SETTINGS: by default, NMClient
+ *   fetches the settings of all connection profiles via "GetSettings" and
+ *   refetches them when the profile emits the "Updated" signal. With this
+ *   flag, the #NMRemoteConnection instances are created without settings
+ *   and the settings are only fetched by nm_client_fetch_connection_settings_async().
+ *   Until then, accessors like nm_connection_get_uuid() return %NULL for
+ *   them. Afterwards, the fetched profiles are kept up to date as usual.
+ *   This flag can only be set during construction. Since: 1.60.
  *
  * Since: 1.24
  */
@@ -37,6 +45,7 @@ typedef enum /*< flags >*/ {
     NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS = 0x1,
     NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_GOOD          = 0x2,
     NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD           = 0x4,
+    NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_SETTINGS    = 0x8,
 } NMClientInstanceFlags;
 
 #define NM_TYPE_CLIENT            (nm_client_get_type())
@@ -414,6 +423,16 @@ void nm_client_reload_connections_async(NMClient           *client,
 gboolean
 nm_client_reload_connections_finish(NMClient *client, GAsyncResult *result, GError **error);
 
+NM_AVAILABLE_IN_1_60
+void nm_client_fetch_connection_settings_async(NMClient           *client,
+                                               const GPtrArray    *connections,
+                                               GCancellable       *cancellable,
+                                               GAsyncReadyCallback callback,
+                                               gpointer            user_data);
+NM_AVAILABLE_IN_1_60
+gboolean
+nm_client_fetch_connection_settings_finish(NMClient *client, GAsyncResult *result, GError **error);
+
 NM_AVAILABLE_IN_1_6
 const char *nm_client_get_dns_mode(NMClient *client);
 NM_AVAILABLE_IN_1_6
@@ -467,6 +467,20 @@
 #define NM_AVAILABLE_IN_1_58
 #endif
 
+#if NM_VERSION_MIN_REQUIRED >= NM_VERSION_1_60
+#define NM_DEPRECATED_IN_1_60        G_DEPRECATED
+#define NM_DEPRECATED_IN_1_60_FOR(f) G_DEPRECATED_FOR(f)
+#else
+#define NM_DEPRECATED_IN_1_60
+#define NM_DEPRECATED_IN_1_60_FOR(f)
+#endif
+
+#if NM_VERSION_MAX_ALLOWED < NM_VERSION_1_60
+#define NM_AVAILABLE_IN_1_60 G_UNAVAILABLE(1, 60)
+#else
+#define NM_AVAILABLE_IN_1_60
+#endif
+
 /*
  * Synchronous API for calling D-Bus in libnm is deprecated. See
  * https://networkmanager.dev/docs/libnm/latest/usage.html#sync-api
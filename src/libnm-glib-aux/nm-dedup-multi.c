@@ -26,14 +26,169 @@ typedef struct {
     bool                       lookup_head;
 } LookupEntry;
 
+/* DedupSet is an open-addressing hash set of pointers, used for the two
+ * dictionaries of NMDedupMultiIndex instead of GHashTable.
+ *
+ * Slots are probed linearly. Each slot stores the full hash next to the
+ * pointer, so that probing only calls the equal function on a real hash
+ * match, and resizing never needs to hash an element again. On deletion,
+ * the following elements of the probe sequence are shifted back, so there
+ * are no tombstones and lookups stay short even after many add/remove
+ * cycles. An empty slot has a %NULL key. */
+
+typedef struct {
+    guint         hash;
+    gconstpointer key;
+} DedupSetSlot;
+
+typedef struct {
+    DedupSetSlot *slots;
+    guint         mask;
+    guint         len;
+} DedupSet;
+
+#define DEDUP_SET_MIN_SIZE 16u
+
 struct _NMDedupMultiIndex {
-    int         ref_count;
-    GHashTable *idx_entries;
-    GHashTable *idx_objs;
+    int      ref_count;
+    DedupSet idx_entries;
+    DedupSet idx_objs;
 };
 
 /*****************************************************************************/
 
+static void
+_dedup_set_insert_slot(DedupSet *set, const DedupSetSlot *slot)
+{
+    guint i;
+
+    i = slot->hash & set->mask;
+    while (set->slots[i].key)
+        i = (i + 1u) & set->mask;
+    set->slots[i] = *slot;
+}
+
+static void
+_dedup_set_resize(DedupSet *set, guint n_slots)
+{
+    DedupSetSlot *old_slots   = set->slots;
+    guint         old_n_slots = old_slots ? set->mask + 1u : 0u;
+    guint         i;
+
+    nm_assert(nm_utils_is_power_of_two(n_slots));
+    nm_assert(set->len < n_slots);
+
+    set->slots = g_new0(DedupSetSlot, n_slots);
+    set->mask  = n_slots - 1u;
+    for (i = 0; i < old_n_slots; i++) {
+        if (old_slots[i].key)
+            _dedup_set_insert_slot(set, &old_slots[i]);
+    }
+    g_free(old_slots);
+}
+
+static inline gconstpointer
+_dedup_set_lookup(const DedupSet *set, guint hash, gconstpointer key, GEqualFunc equal)
+{
+    guint i;
+
+    if (!set->slots)
+        return NULL;
+
+    for (i = hash & set->mask;; i = (i + 1u) & set->mask) {
+        const DedupSetSlot *slot = &set->slots[i];
+
+        if (!slot->key)
+            return NULL;
+        if (slot->hash == hash && (slot->key == key || equal(slot->key, key)))
+            return slot->key;
+    }
+}
+
+static void
+_dedup_set_add(DedupSet *set, guint hash, gconstpointer key)
+{
+    const DedupSetSlot slot = {
+        .hash = hash,
+        .key  = key,
+    };
+
+    nm_assert(key);
+
+    /* keep the load factor below 3/4. */
+    if (!set->slots)
+        _dedup_set_resize(set, DEDUP_SET_MIN_SIZE);
+    else if (set->len + 1u > (set->mask + 1u) / 4u * 3u)
+        _dedup_set_resize(set, (set->mask + 1u) * 2u);
+
+    _dedup_set_insert_slot(set, &slot);
+    set->len++;
+}
+
+static gboolean
+_dedup_set_remove(DedupSet *set, guint hash, gconstpointer key)
+{
+    guint i;
+    guint j;
+
+    if (!set->slots)
+        return FALSE;
+
+    /* the key is removed by identity, no need to call the equal function. */
+    for (i = hash & set->mask;; i = (i + 1u) & set->mask) {
+        if (!set->slots[i].key)
+            return FALSE;
+        if (set->slots[i].key == key)
+            break;
+    }
+
+    /* Backward shift: move each following element of the cluster into the
+     * hole, unless the hole lies before its home slot. */
+    for (j = (i + 1u) & set->mask; set->slots[j].key; j = (j + 1u) & set->mask) {
+        guint home = set->slots[j].hash & set->mask;
+
+        if (((j - home) & set->mask) >= ((j - i) & set->mask)) {
+            set->slots[i] = set->slots[j];
+            i             = j;
+        }
+    }
+    set->slots[i] = (DedupSetSlot) {};
+
+    set->len--;
+    if (set->len == 0) {
+        nm_clear_g_free(&set->slots);
+        set->mask = 0;
+    } else if (set->mask + 1u > DEDUP_SET_MIN_SIZE && set->len < (set->mask + 1u) / 16u)
+        _dedup_set_resize(set, NM_MAX((set->mask + 1u) / 4u, DEDUP_SET_MIN_SIZE));
+
+    return TRUE;
+}
+
+static gconstpointer
+_dedup_set_get_any(const DedupSet *set)
+{
+    guint i;
+
+    if (set->len == 0)
+        return NULL;
+
+    for (i = 0; i <= set->mask; i++) {
+        if (set->slots[i].key)
+            return set->slots[i].key;
+    }
+    return nm_assert_unreachable_val(NULL);
+}
+
+static void
+_dedup_set_clear(DedupSet *set)
+{
+    nm_clear_g_free(&set->slots);
+    set->mask = 0;
+    set->len  = 0;
+}
+
+/*****************************************************************************/
+
 static void
 ASSERT_idx_type(const NMDedupMultiIdxType *idx_type)
 {
@@ -64,49 +219,6 @@ nm_dedup_multi_idx_type_init(NMDedupMultiIdxType *idx_type, const NMDedupMultiId
 
 /*****************************************************************************/
 
-static NMDedupMultiEntry *
-_entry_lookup_obj(const NMDedupMultiIndex   *self,
-                  const NMDedupMultiIdxType *idx_type,
-                  const NMDedupMultiObj     *obj)
-{
-    const LookupEntry stack_entry = {
-        .obj         = obj,
-        .idx_type    = idx_type,
-        .lookup_head = FALSE,
-    };
-
-    ASSERT_idx_type(idx_type);
-    return g_hash_table_lookup(self->idx_entries, &stack_entry);
-}
-
-static NMDedupMultiHeadEntry *
-_entry_lookup_head(const NMDedupMultiIndex   *self,
-                   const NMDedupMultiIdxType *idx_type,
-                   const NMDedupMultiObj     *obj)
-{
-    NMDedupMultiHeadEntry *head_entry;
-    const LookupEntry      stack_entry = {
-             .obj         = obj,
-             .idx_type    = idx_type,
-             .lookup_head = TRUE,
-    };
-
-    ASSERT_idx_type(idx_type);
-
-    if (!idx_type->klass->idx_obj_partition_equal) {
-        if (c_list_is_empty(&idx_type->lst_idx_head))
-            head_entry = NULL;
-        else {
-            nm_assert(c_list_length_is(&idx_type->lst_idx_head, 1));
-            head_entry = c_list_entry(idx_type->lst_idx_head.next, NMDedupMultiHeadEntry, lst_idx);
-        }
-        nm_assert(head_entry == g_hash_table_lookup(self->idx_entries, &stack_entry));
-        return head_entry;
-    }
-
-    return g_hash_table_lookup(self->idx_entries, &stack_entry);
-}
-
 static void
 _entry_unpack(const NMDedupMultiEntry    *entry,
               const NMDedupMultiIdxType **out_idx_type,
@@ -200,6 +312,73 @@ _dict_idx_entries_equal(const NMDedupMultiEntry *entry_a, const NMDedupMultiEntr
     return TRUE;
 }
 
+static gpointer
+_idx_entries_lookup(const NMDedupMultiIndex *self, gconstpointer entry)
+{
+    return (gpointer) _dedup_set_lookup(&self->idx_entries,
+                                        _dict_idx_entries_hash(entry),
+                                        entry,
+                                        (GEqualFunc) _dict_idx_entries_equal);
+}
+
+static void
+_idx_entries_add(NMDedupMultiIndex *self, gconstpointer entry)
+{
+    nm_assert(!_idx_entries_lookup(self, entry));
+
+    _dedup_set_add(&self->idx_entries, _dict_idx_entries_hash(entry), entry);
+}
+
+static void
+_idx_entries_remove(NMDedupMultiIndex *self, gconstpointer entry)
+{
+    if (!_dedup_set_remove(&self->idx_entries, _dict_idx_entries_hash(entry), entry))
+        nm_assert_not_reached();
+}
+
+static NMDedupMultiEntry *
+_entry_lookup_obj(const NMDedupMultiIndex   *self,
+                  const NMDedupMultiIdxType *idx_type,
+                  const NMDedupMultiObj     *obj)
+{
+    const LookupEntry stack_entry = {
+        .obj         = obj,
+        .idx_type    = idx_type,
+        .lookup_head = FALSE,
+    };
+
+    ASSERT_idx_type(idx_type);
+    return _idx_entries_lookup(self, &stack_entry);
+}
+
+static NMDedupMultiHeadEntry *
+_entry_lookup_head(const NMDedupMultiIndex   *self,
+                   const NMDedupMultiIdxType *idx_type,
+                   const NMDedupMultiObj     *obj)
+{
+    NMDedupMultiHeadEntry *head_entry;
+    const LookupEntry      stack_entry = {
+             .obj         = obj,
+             .idx_type    = idx_type,
+             .lookup_head = TRUE,
+    };
+
+    ASSERT_idx_type(idx_type);
+
+    if (!idx_type->klass->idx_obj_partition_equal) {
+        if (c_list_is_empty(&idx_type->lst_idx_head))
+            head_entry = NULL;
+        else {
+            nm_assert(c_list_length_is(&idx_type->lst_idx_head, 1));
+            head_entry = c_list_entry(idx_type->lst_idx_head.next, NMDedupMultiHeadEntry, lst_idx);
+        }
+        nm_assert(head_entry == _idx_entries_lookup(self, &stack_entry));
+        return head_entry;
+    }
+
+    return _idx_entries_lookup(self, &stack_entry);
+}
+
 /*****************************************************************************/
 
 static gboolean
@@ -353,11 +532,10 @@ _add(NMDedupMultiIndex        *self,
     idx_type->len++;
     head_entry->len++;
 
-    if (add_head_entry && !g_hash_table_add(self->idx_entries, head_entry))
-        nm_assert_not_reached();
+    if (add_head_entry)
+        _idx_entries_add(self, head_entry);
 
-    if (!g_hash_table_add(self->idx_entries, entry))
-        nm_assert_not_reached();
+    _idx_entries_add(self, entry);
 
     NM_SET_OUT(out_entry, entry);
     NM_SET_OUT(out_obj_old, NULL);
@@ -479,14 +657,14 @@ _remove_entry(NMDedupMultiIndex *self, NMDedupMultiEntry *entry, gboolean *out_h
     nm_assert(entry->obj);
     nm_assert(entry->head);
     nm_assert(!c_list_is_empty(&entry->lst_entries));
-    nm_assert(g_hash_table_lookup(self->idx_entries, entry) == entry);
+    nm_assert(_idx_entries_lookup(self, entry) == entry);
 
     head_entry = (NMDedupMultiHeadEntry *) entry->head;
     obj        = entry->obj;
 
     nm_assert(head_entry);
     nm_assert(head_entry->len > 0);
-    nm_assert(g_hash_table_lookup(self->idx_entries, head_entry) == head_entry);
+    nm_assert(_idx_entries_lookup(self, head_entry) == head_entry);
 
     idx_type = (NMDedupMultiIdxType *) head_entry->idx_type;
     ASSERT_idx_type(idx_type);
@@ -500,11 +678,10 @@ _remove_entry(NMDedupMultiIndex *self, NMDedupMultiEntry *entry, gboolean *out_h
 
     NM_SET_OUT(out_head_entry_removed, head_entry != NULL);
 
-    if (!g_hash_table_remove(self->idx_entries, entry))
-        nm_assert_not_reached();
+    _idx_entries_remove(self, entry);
 
-    if (head_entry && !g_hash_table_remove(self->idx_entries, head_entry))
-        nm_assert_not_reached();
+    if (head_entry)
+        _idx_entries_remove(self, head_entry);
 
     c_list_unlink_stale(&entry->lst_entries);
     g_slice_free(NMDedupMultiEntry, entry);
@@ -532,7 +709,7 @@ _remove_head(NMDedupMultiIndex     *self,
     nm_assert(head_entry);
     nm_assert(head_entry->len > 0);
     nm_assert(head_entry->len == c_list_length(&head_entry->lst_entries_head));
-    nm_assert(g_hash_table_lookup(self->idx_entries, head_entry) == head_entry);
+    nm_assert(_idx_entries_lookup(self, head_entry) == head_entry);
 
     n = 0;
     c_list_for_each_safe (iter_entry, iter_entry_safe, &head_entry->lst_entries_head) {
@@ -769,17 +946,26 @@ _dict_idx_objs_equal(const NMDedupMultiObj *obj_a, const NMDedupMultiObj *obj_b)
            || (obj_a->klass == obj_b->klass && obj_a->klass->obj_full_equal(obj_a, obj_b));
 }
 
+static const NMDedupMultiObj *
+_idx_objs_lookup(const NMDedupMultiIndex *self, const NMDedupMultiObj *obj)
+{
+    return _dedup_set_lookup(&self->idx_objs,
+                             _dict_idx_objs_hash(obj),
+                             obj,
+                             (GEqualFunc) _dict_idx_objs_equal);
+}
+
 void
 nm_dedup_multi_index_obj_release(NMDedupMultiIndex                          *self,
                                  /* const NMDedupMultiObj * */ gconstpointer obj)
 {
     nm_assert(self);
     nm_assert(obj);
-    nm_assert(g_hash_table_lookup(self->idx_objs, obj) == obj);
+    nm_assert(_idx_objs_lookup(self, obj) == obj);
     nm_assert(((const NMDedupMultiObj *) obj)->_multi_idx == self);
 
     ((NMDedupMultiObj *) obj)->_multi_idx = NULL;
-    if (!g_hash_table_remove(self->idx_objs, obj))
+    if (!_dedup_set_remove(&self->idx_objs, _dict_idx_objs_hash(obj), obj))
         nm_assert_not_reached();
 }
 
@@ -790,7 +976,7 @@ nm_dedup_multi_index_obj_find(NMDedupMultiIndex                          *self,
     g_return_val_if_fail(self, NULL);
     g_return_val_if_fail(obj, NULL);
 
-    return g_hash_table_lookup(self->idx_objs, obj);
+    return _idx_objs_lookup(self, obj);
 }
 
 gconstpointer
@@ -804,12 +990,12 @@ nm_dedup_multi_index_obj_intern(NMDedupMultiIndex                          *self
     nm_assert(obj_new);
 
     if (obj_new->_multi_idx == self) {
-        nm_assert(g_hash_table_lookup(self->idx_objs, obj_new) == obj_new);
+        nm_assert(_idx_objs_lookup(self, obj_new) == obj_new);
         nm_dedup_multi_obj_ref(obj_new);
         return obj_new;
     }
 
-    obj_old = g_hash_table_lookup(self->idx_objs, obj_new);
+    obj_old = _idx_objs_lookup(self, obj_new);
     nm_assert(obj_old != obj_new);
 
     if (obj_old) {
@@ -826,8 +1012,8 @@ nm_dedup_multi_index_obj_intern(NMDedupMultiIndex                          *self
     nm_assert(obj_new);
     nm_assert(!obj_new->_multi_idx);
 
-    if (!g_hash_table_add(self->idx_objs, (gpointer) obj_new))
-        nm_assert_not_reached();
+    nm_assert(!_idx_objs_lookup(self, obj_new));
+    _dedup_set_add(&self->idx_objs, _dict_idx_objs_hash(obj_new), obj_new);
 
     ((NMDedupMultiObj *) obj_new)->_multi_idx = self;
     return obj_new;
@@ -1006,11 +1192,7 @@ nm_dedup_multi_index_new(void)
 
     self  = g_slice_new(NMDedupMultiIndex);
     *self = (NMDedupMultiIndex) {
-        .ref_count   = 1,
-        .idx_entries = g_hash_table_new((GHashFunc) _dict_idx_entries_hash,
-                                        (GEqualFunc) _dict_idx_entries_equal),
-        .idx_objs =
-            g_hash_table_new((GHashFunc) _dict_idx_objs_hash, (GEqualFunc) _dict_idx_objs_equal),
+        .ref_count = 1,
     };
     return self;
 }
@@ -1029,10 +1211,9 @@ nm_dedup_multi_index_ref(NMDedupMultiIndex *self)
 NMDedupMultiIndex *
 nm_dedup_multi_index_unref(NMDedupMultiIndex *self)
 {
-    GHashTableIter             iter;
     const NMDedupMultiIdxType *idx_type;
-    NMDedupMultiEntry         *entry;
-    const NMDedupMultiObj     *obj;
+    const NMDedupMultiEntry   *entry;
+    guint                      i;
 
     g_return_val_if_fail(self, NULL);
     g_return_val_if_fail(self->ref_count > 0, NULL);
@@ -1040,28 +1221,26 @@ nm_dedup_multi_index_unref(NMDedupMultiIndex *self)
     if (--self->ref_count > 0)
         return NULL;
 
-more:
-    g_hash_table_iter_init(&iter, self->idx_entries);
-    while (g_hash_table_iter_next(&iter, (gpointer *) &entry, NULL)) {
+    while ((entry = _dedup_set_get_any(&self->idx_entries))) {
         if (entry->is_head)
             idx_type = ((NMDedupMultiHeadEntry *) entry)->idx_type;
         else
             idx_type = entry->head->idx_type;
         _remove_idx_entry(self, (NMDedupMultiIdxType *) idx_type, TRUE, FALSE);
-        goto more;
     }
 
-    nm_assert(g_hash_table_size(self->idx_entries) == 0);
+    nm_assert(self->idx_entries.len == 0);
+    nm_assert(!self->idx_entries.slots);
 
-    g_hash_table_iter_init(&iter, self->idx_objs);
-    while (g_hash_table_iter_next(&iter, (gpointer *) &obj, NULL)) {
-        nm_assert(obj->_multi_idx == self);
-        ((NMDedupMultiObj *) obj)->_multi_idx = NULL;
-    }
-    g_hash_table_remove_all(self->idx_objs);
+    for (i = 0; self->idx_objs.slots && i <= self->idx_objs.mask; i++) {
+        const NMDedupMultiObj *obj = self->idx_objs.slots[i].key;
 
-    g_hash_table_unref(self->idx_entries);
-    g_hash_table_unref(self->idx_objs);
+        if (obj) {
+            nm_assert(obj->_multi_idx == self);
+            ((NMDedupMultiObj *) obj)->_multi_idx = NULL;
+        }
+    }
+    _dedup_set_clear(&self->idx_objs);
 
     g_slice_free(NMDedupMultiIndex, self);
     return NULL;
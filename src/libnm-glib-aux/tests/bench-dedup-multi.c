@@ -0,0 +1,279 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "libnm-glib-aux/nm-default-glib-i18n-prog.h"
+
+#include "libnm-glib-aux/nm-dedup-multi.h"
+#include "libnm-glib-aux/tests/nm-bench-utils.h"
+#include "nm-dedup-multi-ghash.h"
+
+/*****************************************************************************/
+
+/* Microbenchmark for the hash tables of NMDedupMultiIndex.
+ *
+ * Usage: bench-dedup-multi [NUM...]
+ *
+ * For each NUM (by default 1000, 100000 and 1000000), it adds that many objects
+ * to a NMDedupMultiIndex, looks them up, removes them and finally adds and
+ * removes them repeatedly in random order ("churn"). The objects are
+ * partitioned into lists of 64 objects, like the platform cache partitions
+ * routes by ifindex.
+ *
+ * The same operations are measured on the previous implementation of
+ * NMDedupMultiIndex ("ghash", see nm-dedup-multi-ghash.c), which used
+ * GHashTables instead of its own open-addressing hash set. Both are called
+ * through the same function pointers, so that the numbers are comparable. */
+
+/*****************************************************************************/
+
+#define PARTITION_SIZE 64u
+#define N_CHURN        5u
+
+typedef struct {
+    NMDedupMultiObj parent;
+    guint           val;
+} BenchObj;
+
+static const NMDedupMultiObjClass bench_obj_class;
+
+static const NMDedupMultiObj *
+_bench_obj_clone(const NMDedupMultiObj *obj)
+{
+    BenchObj *o;
+
+    o                    = g_slice_new0(BenchObj);
+    o->parent.klass      = &bench_obj_class;
+    o->parent._ref_count = 1;
+    o->val               = ((const BenchObj *) obj)->val;
+    return (NMDedupMultiObj *) o;
+}
+
+static void
+_bench_obj_destroy(NMDedupMultiObj *obj)
+{
+    g_slice_free(BenchObj, (BenchObj *) obj);
+}
+
+static void
+_bench_obj_full_hash_update(const NMDedupMultiObj *obj, NMHashState *h)
+{
+    nm_hash_update_val(h, ((const BenchObj *) obj)->val);
+}
+
+static gboolean
+_bench_obj_full_equal(const NMDedupMultiObj *obj_a, const NMDedupMultiObj *obj_b)
+{
+    return ((const BenchObj *) obj_a)->val == ((const BenchObj *) obj_b)->val;
+}
+
+static const NMDedupMultiObjClass bench_obj_class = {
+    .obj_clone            = _bench_obj_clone,
+    .obj_destroy          = _bench_obj_destroy,
+    .obj_full_hash_update = _bench_obj_full_hash_update,
+    .obj_full_equal       = _bench_obj_full_equal,
+};
+
+static void
+_bench_idx_obj_id_hash_update(const NMDedupMultiIdxType *idx_type,
+                              const NMDedupMultiObj     *obj,
+                              NMHashState               *h)
+{
+    nm_hash_update_val(h, ((const BenchObj *) obj)->val);
+}
+
+static gboolean
+_bench_idx_obj_id_equal(const NMDedupMultiIdxType *idx_type,
+                        const NMDedupMultiObj     *obj_a,
+                        const NMDedupMultiObj     *obj_b)
+{
+    return ((const BenchObj *) obj_a)->val == ((const BenchObj *) obj_b)->val;
+}
+
+static void
+_bench_idx_obj_partition_hash_update(const NMDedupMultiIdxType *idx_type,
+                                     const NMDedupMultiObj     *obj,
+                                     NMHashState               *h)
+{
+    nm_hash_update_val(h, ((const BenchObj *) obj)->val / PARTITION_SIZE);
+}
+
+static gboolean
+_bench_idx_obj_partition_equal(const NMDedupMultiIdxType *idx_type,
+                               const NMDedupMultiObj     *obj_a,
+                               const NMDedupMultiObj     *obj_b)
+{
+    return (((const BenchObj *) obj_a)->val / PARTITION_SIZE)
+           == (((const BenchObj *) obj_b)->val / PARTITION_SIZE);
+}
+
+static const NMDedupMultiIdxTypeClass bench_idx_type_class = {
+    .idx_obj_id_hash_update        = _bench_idx_obj_id_hash_update,
+    .idx_obj_id_equal              = _bench_idx_obj_id_equal,
+    .idx_obj_partition_hash_update = _bench_idx_obj_partition_hash_update,
+    .idx_obj_partition_equal       = _bench_idx_obj_partition_equal,
+};
+
+/*****************************************************************************/
+
+typedef struct {
+    const char *name;
+    void (*idx_type_init)(NMDedupMultiIdxType *idx_type, const NMDedupMultiIdxTypeClass *klass);
+    NMDedupMultiIndex *(*index_new)(void);
+    NMDedupMultiIndex *(*index_unref)(NMDedupMultiIndex *self);
+    gboolean (*index_add)(NMDedupMultiIndex        *self,
+                          NMDedupMultiIdxType      *idx_type,
+                          gconstpointer             obj,
+                          NMDedupMultiIdxMode       mode,
+                          const NMDedupMultiEntry **out_entry,
+                          gpointer                  out_obj_old);
+    const NMDedupMultiEntry *(*index_lookup_obj)(const NMDedupMultiIndex   *self,
+                                                 const NMDedupMultiIdxType *idx_type,
+                                                 gconstpointer              obj);
+    guint (*index_remove_obj)(NMDedupMultiIndex   *self,
+                              NMDedupMultiIdxType *idx_type,
+                              gconstpointer        obj,
+                              gconstpointer       *out_obj);
+    guint (*index_remove_idx)(NMDedupMultiIndex *self, NMDedupMultiIdxType *idx_type);
+} BenchImpl;
+
+static const BenchImpl bench_impls[] = {
+    {
+        .name             = "ghash",
+        .idx_type_init    = nm_dedup_multi_ghash_idx_type_init,
+        .index_new        = nm_dedup_multi_ghash_index_new,
+        .index_unref      = nm_dedup_multi_ghash_index_unref,
+        .index_add        = nm_dedup_multi_ghash_index_add,
+        .index_lookup_obj = nm_dedup_multi_ghash_index_lookup_obj,
+        .index_remove_obj = nm_dedup_multi_ghash_index_remove_obj,
+        .index_remove_idx = nm_dedup_multi_ghash_index_remove_idx,
+    },
+    {
+        .name             = "dedup-index",
+        .idx_type_init    = nm_dedup_multi_idx_type_init,
+        .index_new        = nm_dedup_multi_index_new,
+        .index_unref      = nm_dedup_multi_index_unref,
+        .index_add        = nm_dedup_multi_index_add,
+        .index_lookup_obj = nm_dedup_multi_index_lookup_obj,
+        .index_remove_obj = nm_dedup_multi_index_remove_obj,
+        .index_remove_idx = nm_dedup_multi_index_remove_idx,
+    },
+};
+
+/*****************************************************************************/
+
+static void
+_shuffle(BenchObj **objs, guint n)
+{
+    guint i;
+
+    for (i = n; i > 1; i--) {
+        guint j = g_random_int_range(0, i);
+
+        NM_SWAP(&objs[i - 1], &objs[j]);
+    }
+}
+
+/*****************************************************************************/
+
+static void
+bench_impl(const BenchImpl *impl, BenchObj **objs, guint n)
+{
+    NMDedupMultiIndex  *multi_idx = impl->index_new();
+    NMDedupMultiIdxType idx_type;
+    gint64              start;
+    guint               r;
+    guint               i;
+
+    impl->idx_type_init(&idx_type, &bench_idx_type_class);
+
+    start = nm_bench_now_nsec();
+    for (i = 0; i < n; i++) {
+        if (!impl->index_add(multi_idx,
+                             &idx_type,
+                             objs[i],
+                             NM_DEDUP_MULTI_IDX_MODE_APPEND,
+                             NULL,
+                             NULL))
+            g_assert_not_reached();
+    }
+    nm_bench_print_timing(impl->name, n, "add", n, start);
+
+    _shuffle(objs, n);
+    start = nm_bench_now_nsec();
+    for (i = 0; i < n; i++) {
+        if (!impl->index_lookup_obj(multi_idx, &idx_type, objs[i]))
+            g_assert_not_reached();
+    }
+    nm_bench_print_timing(impl->name, n, "lookup", n, start);
+
+    _shuffle(objs, n);
+    start = nm_bench_now_nsec();
+    for (i = 0; i < n; i++) {
+        if (impl->index_remove_obj(multi_idx, &idx_type, objs[i], NULL) != 1)
+            g_assert_not_reached();
+    }
+    nm_bench_print_timing(impl->name, n, "remove", n, start);
+
+    start = nm_bench_now_nsec();
+    for (r = 0; r < N_CHURN; r++) {
+        _shuffle(objs, n);
+        for (i = 0; i < n; i++) {
+            impl->index_add(multi_idx,
+                            &idx_type,
+                            objs[i],
+                            NM_DEDUP_MULTI_IDX_MODE_APPEND,
+                            NULL,
+                            NULL);
+            if (i >= n / 2u)
+                impl->index_remove_obj(multi_idx, &idx_type, objs[i - n / 2u], NULL);
+        }
+        impl->index_remove_idx(multi_idx, &idx_type);
+    }
+    nm_bench_print_timing(impl->name, n, "churn", N_CHURN * n, start);
+
+    g_assert_cmpint(idx_type.len, ==, 0);
+    impl->index_unref(multi_idx);
+}
+
+static void
+bench(guint n)
+{
+    gs_free BenchObj **objs = g_new(BenchObj *, n);
+    guint              i;
+
+    for (i = 0; i < n; i++) {
+        const BenchObj o = {
+            .parent =
+                {
+                    .klass      = &bench_obj_class,
+                    ._ref_count = NM_OBJ_REF_COUNT_STACKINIT,
+                },
+            .val = i + 1u,
+        };
+
+        objs[i] = (BenchObj *) _bench_obj_clone(&o.parent);
+    }
+
+    for (i = 0; i < G_N_ELEMENTS(bench_impls); i++)
+        bench_impl(&bench_impls[i], objs, n);
+
+    for (i = 0; i < n; i++)
+        nm_dedup_multi_obj_unref(&objs[i]->parent);
+}
+
+/*****************************************************************************/
+
+int
+main(int argc, char **argv)
+{
+    gs_unref_array GArray *nums = NULL;
+    guint                  i;
+
+    nums = nm_bench_parse_nums(argc, argv, 2);
+    if (!nums)
+        return 1;
+
+    for (i = 0; i < nums->len; i++)
+        bench(nm_g_array_index(nums, guint, i));
+
+    return 0;
+}
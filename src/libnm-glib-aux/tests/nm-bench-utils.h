@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#ifndef __NM_BENCH_UTILS_H__
+#define __NM_BENCH_UTILS_H__
+
+#include <unistd.h>
+
+/*****************************************************************************/
+
+/* Helpers for the benchmarks ("bench-*.c"). They all run a set of workloads
+ * for a number of objects, given on the command line, and print one line of
+ * timings per operation. */
+
+static inline gint64
+nm_bench_now_nsec(void)
+{
+    struct timespec tp;
+
+    clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (((gint64) tp.tv_sec) * NM_UTILS_NSEC_PER_SEC) + tp.tv_nsec;
+}
+
+static inline gssize
+nm_bench_get_rss_bytes(void)
+{
+    gs_free char        *contents = NULL;
+    gs_free const char **tokens   = NULL;
+
+    if (!g_file_get_contents("/proc/self/statm", &contents, NULL, NULL))
+        return 0;
+    tokens = nm_strsplit_set(contents, " ");
+    if (NM_PTRARRAY_LEN(tokens) < 2)
+        return 0;
+    return _nm_utils_ascii_str_to_int64(tokens[1], 10, 0, G_MAXINT64, 0) * sysconf(_SC_PAGESIZE);
+}
+
+/* Prints the time since @start_nsec for @n_ops operations. @label and @n
+ * identify the workload. */
+static inline void
+nm_bench_print_timing(const char *label, guint n, const char *what, guint n_ops, gint64 start_nsec)
+{
+    gint64 d = NM_MAX(nm_bench_now_nsec() - start_nsec, (gint64) 1);
+
+    g_print("%-12s %8u  %-16s %10.1f ns/op  %12.0f op/s\n",
+            label,
+            n,
+            what,
+            ((double) d) / n_ops,
+            ((double) n_ops) * NM_UTILS_NSEC_PER_SEC / d);
+}
+
+/* Returns the numbers of objects from the command line, or the default
+ * 1000, 100000 and 1000000. On invalid arguments, it prints an error and
+ * returns NULL. */
+static inline GArray *
+nm_bench_parse_nums(int argc, char **argv, guint n_min)
+{
+    static const guint N_DEFAULT[] = {1000, 100000, 1000000};
+    gs_unref_array GArray *nums    = g_array_new(FALSE, FALSE, sizeof(guint));
+    int                    i;
+
+    for (i = 1; i < argc; i++) {
+        gint64 n;
+        guint  n32;
+
+        n = _nm_utils_ascii_str_to_int64(argv[i], 10, n_min, 16u * 1000u * 1000u, -1);
+        if (n < 0) {
+            g_printerr("invalid number of objects \"%s\"\n", argv[i]);
+            return NULL;
+        }
+        n32 = n;
+        g_array_append_val(nums, n32);
+    }
+    if (nums->len == 0)
+        g_array_append_vals(nums, N_DEFAULT, G_N_ELEMENTS(N_DEFAULT));
+
+    return g_steal_pointer(&nums);
+}
+
+#endif /* __NM_BENCH_UTILS_H__ */
@@ -0,0 +1,41 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#ifndef __NM_DEDUP_MULTI_GHASH_H__
+#define __NM_DEDUP_MULTI_GHASH_H__
+
+#include "libnm-glib-aux/nm-dedup-multi.h"
+
+/*****************************************************************************/
+
+/* The previous, GHashTable based implementation of NMDedupMultiIndex (see
+ * nm-dedup-multi-ghash.c). The functions behave like their nm_dedup_multi_*()
+ * counterparts, but an index must only be used with the functions of the
+ * implementation that created it. */
+
+void nm_dedup_multi_ghash_idx_type_init(NMDedupMultiIdxType            *idx_type,
+                                        const NMDedupMultiIdxTypeClass *klass);
+
+NMDedupMultiIndex *nm_dedup_multi_ghash_index_new(void);
+NMDedupMultiIndex *nm_dedup_multi_ghash_index_unref(NMDedupMultiIndex *self);
+
+gboolean nm_dedup_multi_ghash_index_add(NMDedupMultiIndex                         *self,
+                                        NMDedupMultiIdxType                       *idx_type,
+                                        /*const NMDedupMultiObj * */ gconstpointer obj,
+                                        NMDedupMultiIdxMode                        mode,
+                                        const NMDedupMultiEntry                  **out_entry,
+                                        /* const NMDedupMultiObj ** */ gpointer    out_obj_old);
+
+const NMDedupMultiEntry *
+nm_dedup_multi_ghash_index_lookup_obj(const NMDedupMultiIndex                   *self,
+                                      const NMDedupMultiIdxType                 *idx_type,
+                                      /*const NMDedupMultiObj * */ gconstpointer obj);
+
+guint nm_dedup_multi_ghash_index_remove_obj(NMDedupMultiIndex                           *self,
+                                            NMDedupMultiIdxType                         *idx_type,
+                                            /*const NMDedupMultiObj * */ gconstpointer   obj,
+                                            /*const NMDedupMultiObj ** */ gconstpointer *out_obj);
+
+guint nm_dedup_multi_ghash_index_remove_idx(NMDedupMultiIndex   *self,
+                                            NMDedupMultiIdxType *idx_type);
+
+#endif /* __NM_DEDUP_MULTI_GHASH_H__ */
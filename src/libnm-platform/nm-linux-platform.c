@@ -44,6 +44,7 @@
 #include "libnm-platform/nmp-ethtool.h"
 #include "libnm-platform/nmp-ethtool-ioctl.h"
 #include "libnm-platform/devlink/nm-devlink.h"
+#include "libnm-platform/wifi/nm-wifi-utils-nl80211.h"
 #include "libnm-platform/wifi/nm-wifi-utils-wext.h"
 #include "libnm-platform/wifi/nm-wifi-utils.h"
 #include "libnm-platform/wpan/nm-wpan-utils.h"
@@ -607,6 +608,39 @@ typedef struct {
 
     GenlFamilyData genl_family_data[_NMP_GENL_FAMILY_TYPE_NUM];
 
+    /* the nl80211 multicast group for scan events. sk_genl is only a member
+     * (genl_nl80211_scan_grp_joined_id) while there are users that watch
+     * the scan results. */
+    guint32 genl_nl80211_scan_grp_id;
+    guint32 genl_nl80211_scan_grp_joined_id;
+    guint   genl_nl80211_scan_grp_users;
+
+    /* After losing netlink events (ENOBUFS), we resynchronize the cache by
+     * dumping one object type after the other. */
+    struct {
+        /* the refresh-all actions that are yet to be requested. */
+        DelayedActionType pending;
+
+        /* zero if no resync is in progress. */
+        gint64 start_nsec;
+        gint64 step_start_nsec;
+
+        guint n_resyncs;
+        guint n_dumped;
+
+        /* the number of cache changes that were caused by the dump messages
+         * of the resync, or by pruning after the dumps. */
+        guint n_changed;
+    } resync;
+
+    /* Routes that are not tracked in the cache (see nm_platform_ip_route_set_ignore()).
+     * The arrays are NULL if there is nothing to ignore. */
+    struct {
+        GArray *tables;    /* guint32 */
+        GArray *protocols; /* guint32 */
+        GArray *ifindexes; /* guint32 */
+    } route_ignore;
+
 } NMLinuxPlatformPrivate;
 
 struct _NMLinuxPlatform {
@@ -714,6 +748,8 @@ delayed_action_schedule(NMPlatform *platform, DelayedActionType action_type, gpo
 static gboolean delayed_action_handle_all(NMPlatform *platform);
 static void do_request_link_no_delayed_actions(NMPlatform *platform, int ifindex, const char *name);
 static void do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action_type);
+static gboolean resync_handle_next(NMPlatform *platform);
+static void     resync_check_complete(NMPlatform *platform);
 static void cache_on_change(NMPlatform      *platform,
                             NMPCacheOpsType  cache_op,
                             const NMPObject *obj_old,
@@ -1425,6 +1461,10 @@ typedef struct {
      * the parsing as long as this flag stays TRUE and an object gets returned. */
     bool iter_more;
 
+    /* The message is a response to our RTM_GETROUTE request. The route
+     * ignore filter does not apply in that case. */
+    bool is_route_get;
+
     union {
         struct {
             guint next_multihop;
@@ -4064,9 +4104,44 @@ ip_route_is_tracked(guint8 proto, guint8 type)
     return TRUE;
 }
 
+static gboolean
+_route_ignore_has(const GArray *arr, guint32 val)
+{
+    guint i;
+
+    if (!arr)
+        return FALSE;
+
+    for (i = 0; i < arr->len; i++) {
+        if (nm_g_array_index(arr, guint32, i) == val)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static gboolean
+ip_route_is_ignored_table_protocol(NMPlatform *platform, guint32 table, guint8 proto)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    return _route_ignore_has(priv->route_ignore.tables, table)
+           || _route_ignore_has(priv->route_ignore.protocols, proto);
+}
+
+static gboolean
+ip_route_is_ignored_ifindex(NMPlatform *platform, int ifindex)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    return ifindex > 0 && _route_ignore_has(priv->route_ignore.ifindexes, ifindex);
+}
+
 /* Copied and heavily modified from libnl3's rtnl_route_parse() and parse_multipath(). */
 static NMPObject *
-_new_from_nl_route(const struct nlmsghdr *nlh, gboolean id_only, ParseNlmsgIter *parse_nlmsg_iter)
+_new_from_nl_route(NMPlatform            *platform,
+                   const struct nlmsghdr *nlh,
+                   gboolean               id_only,
+                   ParseNlmsgIter        *parse_nlmsg_iter)
 {
     static const struct nla_policy policy[] = {
         [RTA_TABLE]     = {.type = NLA_U32},
@@ -4087,6 +4162,8 @@ _new_from_nl_route(const struct nlmsghdr *nlh, gboolean id_only, ParseNlmsgIter
     gboolean                  IS_IPv4;
     nm_auto_nmpobj NMPObject *obj = NULL;
     int                       addr_len;
+    guint32                   table;
+    gboolean                  check_ignore;
     struct {
         gboolean found;
         gboolean has_more;
@@ -4151,6 +4228,15 @@ _new_from_nl_route(const struct nlmsghdr *nlh, gboolean id_only, ParseNlmsgIter
     if (nlmsg_parse_arr(nlh, sizeof(struct rtmsg), tb, policy) < 0)
         return NULL;
 
+    table = tb[RTA_TABLE] ? nla_get_u32(tb[RTA_TABLE]) : (guint32) rtm->rtm_table;
+
+    /* The user may configure to ignore more routes. Like above, messages with
+     * NLM_F_REPLACE must still be processed. The result of a route-get is also
+     * never ignored. */
+    check_ignore = !(nlh->nlmsg_flags & NLM_F_REPLACE) && !parse_nlmsg_iter->is_route_get;
+    if (check_ignore && ip_route_is_ignored_table_protocol(platform, table, rtm->rtm_protocol))
+        return NULL;
+
     /*****************************************************************/
 
     addr_len = nm_utils_addr_family_to_size(addr_family);
@@ -4344,6 +4430,9 @@ rta_multipath_done:
         }
     }
 
+    if (check_ignore && ip_route_is_ignored_ifindex(platform, nh.ifindex))
+        return NULL;
+
     /*****************************************************************/
 
     mss = 0;
@@ -4391,8 +4480,7 @@ rta_multipath_done:
     obj = nmp_object_new(IS_IPv4 ? NMP_OBJECT_TYPE_IP4_ROUTE : NMP_OBJECT_TYPE_IP6_ROUTE, NULL);
 
     obj->ip_route.type_coerced  = nm_platform_route_type_coerce(rtm->rtm_type);
-    obj->ip_route.table_coerced = nm_platform_route_table_coerce(
-        tb[RTA_TABLE] ? nla_get_u32(tb[RTA_TABLE]) : (guint32) rtm->rtm_table);
+    obj->ip_route.table_coerced = nm_platform_route_table_coerce(table);
 
     obj->ip_route.ifindex = nh.ifindex;
 
@@ -4953,7 +5041,7 @@ nmp_object_new_from_nl(NMPlatform               *platform,
     case RTM_NEWROUTE:
     case RTM_DELROUTE:
     case RTM_GETROUTE:
-        return _new_from_nl_route(msghdr, id_only, parse_nlmsg_iter);
+        return _new_from_nl_route(platform, msghdr, id_only, parse_nlmsg_iter);
     case RTM_NEWRULE:
     case RTM_DELRULE:
     case RTM_GETRULE:
@@ -5809,6 +5897,16 @@ ip_route_is_alive(const NMPlatformIPRoute *route)
     return ip_route_is_tracked(proto, type);
 }
 
+static gboolean
+ip_route_is_ignored(NMPlatform *platform, const NMPlatformIPRoute *route)
+{
+    return ip_route_is_ignored_table_protocol(
+               platform,
+               nm_platform_route_table_uncoerce(route->table_coerced, TRUE),
+               nmp_utils_ip_config_source_coerce_to_rtprot(route->rt_source))
+           || ip_route_is_ignored_ifindex(platform, route->ifindex);
+}
+
 /* Copied and modified from libnl3's build_route_msg() and rtnl_route_build_msg(). */
 static struct nl_msg *
 _nl_msg_new_route(uint16_t nlmsg_type, uint16_t nlmsg_flags, const NMPObject *obj)
@@ -7286,8 +7384,11 @@ delayed_action_handle_one(NMPlatform *platform)
     NMPNetlinkProtocol      netlink_protocol;
     DelayedActionType       iflags;
 
-    if (priv->delayed_action.flags == DELAYED_ACTION_TYPE_NONE)
-        return FALSE;
+    if (priv->delayed_action.flags == DELAYED_ACTION_TYPE_NONE) {
+        /* All other actions are done. That means, a pending resync can
+         * request the dump for the next object type. */
+        return resync_handle_next(platform);
+    }
 
     /* First process DELAYED_ACTION_TYPE_CONTROLLER_CONNECTED actions.
      * This type of action is entirely cache-internal and is here to resolve a
@@ -7405,6 +7506,8 @@ delayed_action_handle_all(NMPlatform *platform)
 
     cache_prune_all(platform);
 
+    resync_check_complete(platform);
+
     return any;
 }
 
@@ -7459,8 +7562,8 @@ delayed_action_schedule(NMPlatform *platform, DelayedActionType action_type, gpo
     }
 }
 
-static void
-delayed_action_schedule_refresh_all(NMPlatform *platform, NMPNetlinkProtocol netlink_protocol)
+static DelayedActionType
+delayed_action_refresh_all_get_type(NMPlatform *platform, NMPNetlinkProtocol netlink_protocol)
 {
     DelayedActionType action_type;
 
@@ -7480,7 +7583,121 @@ delayed_action_schedule_refresh_all(NMPlatform *platform, NMPNetlinkProtocol net
         action_type = DELAYED_ACTION_TYPE_REFRESH_ALL_GENL_FAMILIES;
     }
 
-    delayed_action_schedule(platform, action_type, NULL);
+    return action_type;
+}
+
+static void
+delayed_action_schedule_refresh_all(NMPlatform *platform, NMPNetlinkProtocol netlink_protocol)
+{
+    delayed_action_schedule(platform,
+                            delayed_action_refresh_all_get_type(platform, netlink_protocol),
+                            NULL);
+}
+
+/*****************************************************************************/
+
+static void
+resync_start(NMPlatform *platform, NMPNetlinkProtocol netlink_protocol)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    if (netlink_protocol != NMP_NETLINK_ROUTE) {
+        /* We only track a few genl families. Refresh them all at once. */
+        delayed_action_schedule_refresh_all(platform, netlink_protocol);
+        return;
+    }
+
+    /* Don't schedule all dumps at once. Instead, the next dump only gets
+     * requested after the previous one completed (see resync_handle_next()).
+     * That way, only one dump at a time fills the socket buffer.
+     *
+     * The cache is not cleared. Every object type gets marked as dirty when its
+     * dump starts. Objects that are unchanged only get their dirty mark cleared
+     * and don't emit a signal, and the remaining dirty ones get pruned when the
+     * dump completes. */
+    if (priv->resync.start_nsec == 0) {
+        priv->resync.start_nsec = nm_utils_get_monotonic_timestamp_nsec();
+        priv->resync.n_dumped   = 0;
+        priv->resync.n_changed  = 0;
+        priv->resync.n_resyncs++;
+    }
+    priv->resync.step_start_nsec = 0;
+    priv->resync.pending |= delayed_action_refresh_all_get_type(platform, NMP_NETLINK_ROUTE);
+}
+
+static gboolean
+resync_handle_next(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    DelayedActionType       action_type;
+    DelayedActionType       iflags;
+    gint64                  now_nsec;
+
+    nm_assert(priv->delayed_action.flags == DELAYED_ACTION_TYPE_NONE);
+
+    if (priv->resync.pending == DELAYED_ACTION_TYPE_NONE)
+        return FALSE;
+
+    now_nsec = nm_utils_get_monotonic_timestamp_nsec();
+    if (priv->resync.step_start_nsec != 0) {
+        _LOGD("netlink[rtnl]: resync #%u: previous dump completed after %" G_GINT64_FORMAT
+              " msec (%u objects dumped, %u changed so far)",
+              priv->resync.n_resyncs,
+              (now_nsec - priv->resync.step_start_nsec) / NM_UTILS_NSEC_PER_MSEC,
+              priv->resync.n_dumped,
+              priv->resync.n_changed);
+    }
+    priv->resync.step_start_nsec = now_nsec;
+
+    /* request the pending type with the lowest flag. */
+    iflags      = priv->resync.pending & (~priv->resync.pending + 1);
+    action_type = iflags;
+
+    /* routing rules for both address families are best requested together. See
+     * do_request_all_no_delayed_actions(). */
+    if (NM_FLAGS_ANY(action_type, DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_ROUTING_RULES_ALL)) {
+        action_type |=
+            (priv->resync.pending & DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_ROUTING_RULES_ALL);
+    }
+
+    priv->resync.pending &= ~action_type;
+
+    _LOGD("netlink[rtnl]: resync #%u: request %s%s",
+          priv->resync.n_resyncs,
+          delayed_action_to_string(iflags),
+          action_type != iflags ? " (and more)" : "");
+
+    do_request_all_no_delayed_actions(platform, action_type);
+    return TRUE;
+}
+
+static void
+resync_check_complete(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    if (priv->resync.start_nsec == 0 || priv->resync.pending != DELAYED_ACTION_TYPE_NONE)
+        return;
+
+    _LOGI("netlink[rtnl]: resync #%u completed after %" G_GINT64_FORMAT
+          " msec: %u objects dumped, %u changed",
+          priv->resync.n_resyncs,
+          (nm_utils_get_monotonic_timestamp_nsec() - priv->resync.start_nsec)
+              / NM_UTILS_NSEC_PER_MSEC,
+          priv->resync.n_dumped,
+          priv->resync.n_changed);
+
+    priv->resync.start_nsec      = 0;
+    priv->resync.step_start_nsec = 0;
+}
+
+static void
+resync_count_changed(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    if (priv->resync.start_nsec != 0)
+        priv->resync.n_changed++;
 }
 
 static void
@@ -7549,6 +7766,7 @@ cache_prune_one_type(NMPlatform *platform, const NMPLookup *lookup)
 
             cache_op = nmp_cache_remove(cache, obj, TRUE, TRUE, &obj_old);
             nm_assert(cache_op == NMP_CACHE_OPS_REMOVED);
+            resync_count_changed(platform);
             cache_on_change(platform, cache_op, obj_old, NULL);
             nm_platform_cache_update_emit_signal(platform, cache_op, obj_old, NULL);
         }
@@ -7560,6 +7778,7 @@ cache_prune_all(NMPlatform *platform)
 {
     NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
     RefreshAllType          refresh_all_type;
+    gboolean                pruned = FALSE;
 
     for (refresh_all_type = _REFRESH_ALL_TYPE_FIRST; refresh_all_type < _REFRESH_ALL_TYPE_NUM;
          refresh_all_type++) {
@@ -7575,6 +7794,13 @@ cache_prune_all(NMPlatform *platform)
             continue;
         refresh_all_type_init_lookup(refresh_all_type, &lookup);
         cache_prune_one_type(platform, &lookup);
+        pruned = TRUE;
+    }
+
+    if (pruned && _LOGD_ENABLED()) {
+        char sbuf[1024];
+
+        _LOGD("nmp-object pools: %s", nmp_object_pool_stats_to_string(sbuf, sizeof(sbuf)));
     }
 }
 
@@ -8196,6 +8422,11 @@ do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action
                 if (retry_count > 0) {
                     /* Try again previous protocol */
                     i--;
+                } else if (_route_ignore_has(priv->route_ignore.protocols,
+                                             ip_route_tracked_protocols[i])) {
+                    /* The dump is filtered by protocol in kernel (NETLINK_GET_STRICT_CHK).
+                     * We can skip the protocols we ignore altogether. */
+                    continue;
                 }
 
                 /* If we try to request a new dump while the previous is still
@@ -8357,6 +8588,29 @@ event_seq_check(NMPlatform             *platform,
     }
 }
 
+static gboolean
+_rtnl_msg_is_route_get_response(NMPlatform *platform, const struct nl_msg_lite *msg)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    guint                   i;
+
+    if (msg->nm_nlh->nlmsg_type != RTM_NEWROUTE)
+        return FALSE;
+
+    if (!NM_FLAGS_HAS(priv->delayed_action.flags, DELAYED_ACTION_TYPE_WAIT_FOR_RESPONSE_RTNL))
+        return FALSE;
+
+    for (i = 0; i < priv->delayed_action.list_wait_for_response_rtnl->len; i++) {
+        const DelayedActionWaitForNlResponseData *data =
+            delayed_action_get_list_wait_for_resonse(priv, NMP_NETLINK_ROUTE, i);
+
+        if (data->response_type == DELAYED_ACTION_RESPONSE_TYPE_ROUTE_GET
+            && data->seq_number == msg->nm_nlh->nlmsg_seq)
+            return TRUE;
+    }
+    return FALSE;
+}
+
 static void
 _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
 {
@@ -8386,7 +8640,8 @@ _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
     }
 
     parse_nlmsg_iter = (ParseNlmsgIter) {
-        .iter_more = FALSE,
+        .iter_more    = FALSE,
+        .is_route_get = _rtnl_msg_is_route_get_response(platform, msg),
     };
 
     obj = nmp_object_new_from_nl(platform, cache, msg, is_del, &parse_nlmsg_iter);
@@ -8407,6 +8662,11 @@ _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
         is_dump =
             delayed_action_refresh_all_in_progress(platform,
                                                    delayed_action_refresh_from_needle_object(obj));
+        if (is_dump) {
+            priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+            if (priv->resync.start_nsec != 0)
+                priv->resync.n_dumped++;
+        }
     }
 
     _LOGT("event-notification: %s%s: %s",
@@ -8430,6 +8690,8 @@ _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
         case RTM_NEWTFILTER:
             cache_op = nmp_cache_update_netlink(cache, obj, is_dump, &obj_old, &obj_new);
             if (cache_op != NMP_CACHE_OPS_UNCHANGED) {
+                if (is_dump)
+                    resync_count_changed(platform);
                 cache_on_change(platform, cache_op, obj_old, obj_new);
                 nm_platform_cache_update_emit_signal(platform, cache_op, obj_old, obj_new);
             }
@@ -8471,7 +8733,9 @@ _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
                 }
             }
 
-            route_is_alive = ip_route_is_alive(NMP_OBJECT_CAST_IP_ROUTE(obj));
+            route_is_alive = ip_route_is_alive(NMP_OBJECT_CAST_IP_ROUTE(obj))
+                             && (parse_nlmsg_iter.is_route_get
+                                 || !ip_route_is_ignored(platform, NMP_OBJECT_CAST_IP_ROUTE(obj)));
 
             cache_op = nmp_cache_update_netlink_route(cache,
                                                       obj,
@@ -8502,6 +8766,8 @@ _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
                     nm_dedup_multi_entry_set_dirty(entry_replace, TRUE);
                     only_dirty = TRUE;
                 }
+                if (is_dump)
+                    resync_count_changed(platform);
                 cache_on_change(platform, cache_op, obj_old, obj_new);
                 nm_platform_cache_update_emit_signal(platform, cache_op, obj_old, obj_new);
             }
@@ -8512,6 +8778,8 @@ _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
                 cache_op = nmp_cache_remove(cache, obj_replace, TRUE, only_dirty, NULL);
                 if (cache_op != NMP_CACHE_OPS_UNCHANGED) {
                     nm_assert(cache_op == NMP_CACHE_OPS_REMOVED);
+                    if (is_dump)
+                        resync_count_changed(platform);
                     cache_on_change(platform, cache_op, obj_replace, NULL);
                     nm_platform_cache_update_emit_signal(platform, cache_op, obj_replace, NULL);
                 }
@@ -8702,6 +8970,36 @@ do_add_addrroute(NMPlatform      *platform,
     return wait_for_nl_response_to_nmerr(seq_result);
 }
 
+static gboolean
+_delete_object_check_result(const NMPObject        *obj_id,
+                            WaitForNlResponseResult seq_result,
+                            const char            **out_log_detail)
+{
+    const char *log_detail = "";
+    gboolean    success    = TRUE;
+
+    if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK) {
+        /* ok */
+    } else if (NM_IN_SET(-((int) seq_result), ESRCH, ENOENT))
+        log_detail = ", meaning the object was already removed";
+    else if (NM_IN_SET(-((int) seq_result), ENXIO)
+             && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id), NMP_OBJECT_TYPE_IP6_ADDRESS)) {
+        /* On RHEL7 kernel, deleting a non existing address fails with ENXIO */
+        log_detail = ", meaning the address was already removed";
+    } else if (NM_IN_SET(-((int) seq_result), ENODEV)) {
+        log_detail = ", meaning the device was already removed";
+    } else if (NM_IN_SET(-((int) seq_result), EADDRNOTAVAIL)
+               && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id),
+                            NMP_OBJECT_TYPE_IP4_ADDRESS,
+                            NMP_OBJECT_TYPE_IP6_ADDRESS))
+        log_detail = ", meaning the address was already removed";
+    else
+        success = FALSE;
+
+    *out_log_detail = log_detail;
+    return success;
+}
+
 static gboolean
 do_delete_object(NMPlatform *platform, const NMPObject *obj_id, struct nl_msg *nlmsg)
 {
@@ -8732,24 +9030,7 @@ do_delete_object(NMPlatform *platform, const NMPObject *obj_id, struct nl_msg *n
 
         nm_assert(seq_result != WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN);
 
-        success = TRUE;
-        if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK) {
-            /* ok */
-        } else if (NM_IN_SET(-((int) seq_result), ESRCH, ENOENT))
-            log_detail = ", meaning the object was already removed";
-        else if (NM_IN_SET(-((int) seq_result), ENXIO)
-                 && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id), NMP_OBJECT_TYPE_IP6_ADDRESS)) {
-            /* On RHEL7 kernel, deleting a non existing address fails with ENXIO */
-            log_detail = ", meaning the address was already removed";
-        } else if (NM_IN_SET(-((int) seq_result), ENODEV)) {
-            log_detail = ", meaning the device was already removed";
-        } else if (NM_IN_SET(-((int) seq_result), EADDRNOTAVAIL)
-                   && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id),
-                                NMP_OBJECT_TYPE_IP4_ADDRESS,
-                                NMP_OBJECT_TYPE_IP6_ADDRESS))
-            log_detail = ", meaning the address was already removed";
-        else
-            success = FALSE;
+        success = _delete_object_check_result(obj_id, seq_result, &log_detail);
 
         _NMLOG(success ? LOGL_DEBUG : LOGL_WARN,
                "do-delete-%s[%s]: %s%s",
@@ -8779,6 +9060,279 @@ do_delete_object(NMPlatform *platform, const NMPObject *obj_id, struct nl_msg *n
     return success;
 }
 
+/*****************************************************************************/
+
+/* The number of requests that we send with one sendmsg() call, before collecting
+ * the responses. This limits the number of outstanding ACKs (and notifications)
+ * that pile up in the receive buffer. */
+#define ADDRROUTE_BATCH_SIZE 256u
+
+static struct nl_msg *
+_nl_msg_new_addrroute_op(const NMPlatformAddrRouteOp *op)
+{
+    const NMPObject *obj = op->obj;
+
+    switch (NMP_OBJECT_GET_TYPE(obj)) {
+    case NMP_OBJECT_TYPE_IP4_ADDRESS:
+    {
+        const NMPlatformIP4Address *a = NMP_OBJECT_CAST_IP4_ADDRESS(obj);
+
+        if (op->is_delete) {
+            return _nl_msg_new_address(RTM_DELADDR,
+                                       0,
+                                       AF_INET,
+                                       a->ifindex,
+                                       &a->address,
+                                       a->plen,
+                                       &a->peer_address,
+                                       0,
+                                       RT_SCOPE_NOWHERE,
+                                       NM_PLATFORM_LIFETIME_PERMANENT,
+                                       NM_PLATFORM_LIFETIME_PERMANENT,
+                                       0,
+                                       NULL);
+        }
+        return _nl_msg_new_address(RTM_NEWADDR,
+                                   NLM_F_CREATE | NLM_F_REPLACE,
+                                   AF_INET,
+                                   a->ifindex,
+                                   &a->address,
+                                   a->plen,
+                                   &a->peer_address,
+                                   op->ifa_flags,
+                                   nm_platform_ip4_address_get_scope(a->address),
+                                   op->lifetime,
+                                   op->preferred,
+                                   nm_platform_ip4_broadcast_address_from_addr(a),
+                                   a->label);
+    }
+    case NMP_OBJECT_TYPE_IP6_ADDRESS:
+    {
+        const NMPlatformIP6Address *a = NMP_OBJECT_CAST_IP6_ADDRESS(obj);
+
+        if (op->is_delete) {
+            return _nl_msg_new_address(RTM_DELADDR,
+                                       0,
+                                       AF_INET6,
+                                       a->ifindex,
+                                       &a->address,
+                                       a->plen,
+                                       NULL,
+                                       0,
+                                       RT_SCOPE_NOWHERE,
+                                       NM_PLATFORM_LIFETIME_PERMANENT,
+                                       NM_PLATFORM_LIFETIME_PERMANENT,
+                                       0,
+                                       NULL);
+        }
+        return _nl_msg_new_address(RTM_NEWADDR,
+                                   NLM_F_CREATE | NLM_F_REPLACE,
+                                   AF_INET6,
+                                   a->ifindex,
+                                   &a->address,
+                                   a->plen,
+                                   IN6_IS_ADDR_UNSPECIFIED(&a->peer_address) ? NULL
+                                                                             : &a->peer_address,
+                                   op->ifa_flags,
+                                   RT_SCOPE_UNIVERSE,
+                                   op->lifetime,
+                                   op->preferred,
+                                   0,
+                                   NULL);
+    }
+    case NMP_OBJECT_TYPE_IP4_ROUTE:
+    case NMP_OBJECT_TYPE_IP6_ROUTE:
+        if (op->is_delete)
+            return _nl_msg_new_route(RTM_DELROUTE, 0, obj);
+        return _nl_msg_new_route(RTM_NEWROUTE, op->nlmflags & NMP_NLM_FLAG_FMASK, obj);
+    default:
+        break;
+    }
+
+    g_return_val_if_reached(NULL);
+}
+
+static void
+_addrroute_batch_send(NMPlatform              *platform,
+                      NMPlatformAddrRouteOp   *ops,
+                      WaitForNlResponseResult *seq_results,
+                      const guint             *idxs,
+                      guint                    n_idxs)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    struct nl_msg          *nlmsgs[ADDRROUTE_BATCH_SIZE];
+    struct iovec            iov[ADDRROUTE_BATCH_SIZE];
+    guint                   idxs_sent[ADDRROUTE_BATCH_SIZE];
+    guint                   n_sent = 0;
+    guint                   j;
+    int                     nle;
+
+    nm_assert(n_idxs > 0);
+    nm_assert(n_idxs <= ADDRROUTE_BATCH_SIZE);
+
+    for (j = 0; j < n_idxs; j++) {
+        NMPlatformAddrRouteOp *op = &ops[idxs[j]];
+        struct nl_msg         *nlmsg;
+        struct nlmsghdr       *nlhdr;
+
+        seq_results[idxs[j]] = WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN;
+
+        nlmsg = _nl_msg_new_addrroute_op(op);
+        if (!nlmsg) {
+            op->result = -NME_BUG;
+            continue;
+        }
+
+        nlhdr            = nlmsg_hdr(nlmsg);
+        nlhdr->nlmsg_seq = _nlh_seq_next_get(priv, NMP_NETLINK_ROUTE);
+        nl_complete_msg(priv->sk_rtnl, nlmsg);
+
+        iov[n_sent] = (struct iovec) {
+            .iov_base = nlhdr,
+            .iov_len  = nlhdr->nlmsg_len,
+        };
+
+        nlmsgs[n_sent]    = nlmsg;
+        idxs_sent[n_sent] = idxs[j];
+        n_sent++;
+    }
+
+    if (n_sent == 0)
+        return;
+
+    /* Kernel processes all messages of one sendmsg() in order, and sends
+     * a separate ACK for each of them. */
+    nle = nl_send_iovec(priv->sk_rtnl, nlmsgs[0], iov, n_sent);
+    if (nle < 0) {
+        _LOGE("do-addrroute-batch: failure sending netlink request for %u objects \"%s\" (%d)",
+              n_sent,
+              nm_strerror(nle),
+              -nle);
+    }
+
+    for (j = 0; j < n_sent; j++) {
+        if (nle < 0)
+            ops[idxs_sent[j]].result = -NME_PL_NETLINK;
+        else {
+            delayed_action_schedule_WAIT_FOR_RESPONSE(platform,
+                                                      NMP_NETLINK_ROUTE,
+                                                      nlmsg_hdr(nlmsgs[j])->nlmsg_seq,
+                                                      &seq_results[idxs_sent[j]],
+                                                      &ops[idxs_sent[j]].extack_msg,
+                                                      DELAYED_ACTION_RESPONSE_TYPE_VOID,
+                                                      NULL);
+        }
+        nlmsg_free(nlmsgs[j]);
+    }
+}
+
+static void
+addrroute_batch(NMPlatform *platform, NMPlatformAddrRouteOp *ops, guint n_ops)
+{
+    char                             sbuf1[NM_UTILS_TO_STRING_BUFFER_SIZE];
+    char                             s_buf[256];
+    gs_free WaitForNlResponseResult *seq_results = NULL;
+    gs_free guint                   *pending     = NULL;
+    const NMPObject                 *refetch_obj = NULL;
+    guint                            n_pending   = n_ops;
+    int                              try_count   = 0;
+    guint                            i;
+    guint                            j;
+
+    if (n_ops == 0)
+        return;
+
+    seq_results = g_new(WaitForNlResponseResult, n_ops);
+    pending     = g_new(guint, n_ops);
+    for (i = 0; i < n_ops; i++) {
+        nm_assert(NM_IN_SET(NMP_OBJECT_GET_TYPE(ops[i].obj),
+                            NMP_OBJECT_TYPE_IP4_ADDRESS,
+                            NMP_OBJECT_TYPE_IP6_ADDRESS,
+                            NMP_OBJECT_TYPE_IP4_ROUTE,
+                            NMP_OBJECT_TYPE_IP6_ROUTE));
+        nm_assert(!ops[i].extack_msg);
+        pending[i] = i;
+    }
+
+    event_handler_read_netlink(platform, NMP_NETLINK_ROUTE, FALSE);
+
+    while (TRUE) {
+        guint n_retry = 0;
+
+        for (j = 0; j < n_pending; j += ADDRROUTE_BATCH_SIZE) {
+            _addrroute_batch_send(platform,
+                                  ops,
+                                  seq_results,
+                                  &pending[j],
+                                  NM_MIN(n_pending - j, ADDRROUTE_BATCH_SIZE));
+            delayed_action_handle_all(platform);
+        }
+
+        for (j = 0; j < n_pending; j++) {
+            NMPlatformAddrRouteOp        *op         = &ops[pending[j]];
+            const WaitForNlResponseResult seq_result = seq_results[pending[j]];
+            const char                   *log_detail = "";
+            gboolean                      success;
+
+            if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN) {
+                /* We failed to send the request. The result is already set. */
+                nm_assert(op->result < 0);
+                continue;
+            }
+
+            if (op->is_delete) {
+                success    = _delete_object_check_result(op->obj, seq_result, &log_detail);
+                op->result = success ? 0 : wait_for_nl_response_to_nmerr(seq_result);
+            } else {
+                success = (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK
+                           || (NM_FLAGS_HAS(op->nlmflags, NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE)
+                               && seq_result < 0));
+                op->result = wait_for_nl_response_to_nmerr(seq_result);
+            }
+
+            _NMLOG(success ? LOGL_DEBUG : LOGL_WARN,
+                   "do-%s-%s[%s]: %s%s",
+                   op->is_delete ? "delete" : "add",
+                   NMP_OBJECT_GET_CLASS(op->obj)->obj_type_name,
+                   nmp_object_to_string(op->obj, NMP_OBJECT_TO_STRING_ID, sbuf1, sizeof(sbuf1)),
+                   wait_for_nl_response_to_string(seq_result, op->extack_msg, s_buf, sizeof(s_buf)),
+                   log_detail);
+
+            if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_FAILED_RESYNC
+                && try_count + 1 < RESYNC_RETRIES) {
+                nm_clear_g_free(&op->extack_msg);
+                pending[n_retry++] = pending[j];
+            }
+        }
+
+        if (n_retry == 0)
+            break;
+        n_pending = n_retry;
+        try_count++;
+    }
+
+    for (i = 0; i < n_ops; i++) {
+        const NMPlatformAddrRouteOp *op = &ops[i];
+        gboolean                     in_cache;
+
+        if (NMP_OBJECT_GET_TYPE(op->obj) != NMP_OBJECT_TYPE_IP6_ADDRESS)
+            continue;
+
+        /* In rare cases, the address is not yet ready (or still there) as we
+         * received the ACK from kernel. Need to refetch. See do_add_addrroute()
+         * and do_delete_object().
+         *
+         * rh#1484434 */
+        in_cache = !!nmp_cache_lookup_obj(nm_platform_get_cache(platform), op->obj);
+        if (op->is_delete ? in_cache : !in_cache) {
+            refetch_obj = op->obj;
+            break;
+        }
+    }
+    if (refetch_obj)
+        do_request_one_type_by_needle_object(platform, refetch_obj);
+}
+
 static int
 do_change_link(NMPlatform           *platform,
                ChangeLinkType        change_link_type,
@@ -10378,6 +10932,14 @@ wifi_get_station(NMPlatform  *platform,
     return nm_wifi_utils_get_station(wifi_data, out_bssid, out_quality, out_rate);
 }
 
+static GArray *
+wifi_get_scan_results(NMPlatform *platform, int ifindex)
+{
+    WIFI_GET_WIFI_DATA_NETNS(wifi_data, platform, ifindex, NULL);
+
+    return nm_wifi_utils_get_scan_results(wifi_data);
+}
+
 static _NM80211Mode
 wifi_get_mode(NMPlatform *platform, int ifindex)
 {
@@ -10969,6 +11531,79 @@ ip_route_get(NMPlatform   *platform,
     return -NME_UNSPEC;
 }
 
+static gboolean
+_route_ignore_set(GArray **p_arr, const guint32 *values, guint n_values)
+{
+    GArray *arr = *p_arr;
+
+    if (n_values == 0) {
+        if (!arr)
+            return FALSE;
+        nm_clear_pointer(p_arr, g_array_unref);
+        return TRUE;
+    }
+
+    if (arr && arr->len == n_values && memcmp(arr->data, values, sizeof(guint32) * n_values) == 0)
+        return FALSE;
+
+    if (!arr)
+        *p_arr = arr = g_array_sized_new(FALSE, FALSE, sizeof(guint32), n_values);
+    g_array_set_size(arr, 0);
+    g_array_append_vals(arr, values, n_values);
+    return TRUE;
+}
+
+static void
+ip_route_set_ignore(NMPlatform    *platform,
+                    const guint32 *tables,
+                    guint          n_tables,
+                    const guint8  *protocols,
+                    guint          n_protocols,
+                    const int     *ifindexes,
+                    guint          n_ifindexes)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    gs_free guint32        *protocols_u32 = NULL;
+    gs_free guint32        *ifindexes_u32 = NULL;
+    gboolean                changed       = FALSE;
+    guint                   i;
+
+    if (n_protocols > 0) {
+        protocols_u32 = g_new(guint32, n_protocols);
+        for (i = 0; i < n_protocols; i++)
+            protocols_u32[i] = protocols[i];
+    }
+    if (n_ifindexes > 0) {
+        ifindexes_u32 = g_new(guint32, n_ifindexes);
+        for (i = 0; i < n_ifindexes; i++)
+            ifindexes_u32[i] = ifindexes[i];
+    }
+
+    if (_route_ignore_set(&priv->route_ignore.tables, tables, n_tables))
+        changed = TRUE;
+    if (_route_ignore_set(&priv->route_ignore.protocols, protocols_u32, n_protocols))
+        changed = TRUE;
+    if (_route_ignore_set(&priv->route_ignore.ifindexes, ifindexes_u32, n_ifindexes))
+        changed = TRUE;
+
+    if (!changed)
+        return;
+
+    _LOGD("route-ignore: ignore %u tables, %u protocols and %u interfaces",
+          n_tables,
+          n_protocols,
+          n_ifindexes);
+
+    /* Re-read all routes. Those that are now ignored don't get re-added and
+     * get pruned from the cache, while those that are no longer ignored get
+     * added. */
+    delayed_action_schedule(platform,
+                            DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_IP4_ROUTES
+                                | DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_IP6_ROUTES,
+                            NULL);
+    delayed_action_handle_all(platform);
+}
+
 /*****************************************************************************/
 
 static int
@@ -11209,6 +11844,99 @@ _genl_family_id_update(NMPlatform *platform, NMPGenlFamilyType family_type, guin
     return TRUE;
 }
 
+static void
+_genl_nl80211_scan_grp_sync(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    guint32                 grp_id;
+    int                     r;
+
+    grp_id = priv->genl_nl80211_scan_grp_users > 0 ? priv->genl_nl80211_scan_grp_id : 0u;
+    if (grp_id == priv->genl_nl80211_scan_grp_joined_id)
+        return;
+
+    if (priv->genl_nl80211_scan_grp_joined_id != 0) {
+        r = nl_socket_drop_memberships(priv->sk_genl,
+                                       (int) priv->genl_nl80211_scan_grp_joined_id,
+                                       0);
+        if (r < 0) {
+            _LOGD("genl:nl80211: failure to leave multicast group \"%s\" (%u): %s",
+                  NM_WIFI_UTILS_NL80211_MCGRP_SCAN,
+                  priv->genl_nl80211_scan_grp_joined_id,
+                  nm_strerror(r));
+        } else {
+            _LOGD("genl:nl80211: left multicast group \"%s\" (%u)",
+                  NM_WIFI_UTILS_NL80211_MCGRP_SCAN,
+                  priv->genl_nl80211_scan_grp_joined_id);
+        }
+        priv->genl_nl80211_scan_grp_joined_id = 0;
+    }
+
+    if (grp_id == 0)
+        return;
+
+    r = nl_socket_add_memberships(priv->sk_genl, (int) grp_id, 0);
+    if (r < 0) {
+        _LOGD("genl:nl80211: failure to join multicast group \"%s\" (%u): %s",
+              NM_WIFI_UTILS_NL80211_MCGRP_SCAN,
+              grp_id,
+              nm_strerror(r));
+        return;
+    }
+
+    _LOGD("genl:nl80211: joined multicast group \"%s\" (%u)",
+          NM_WIFI_UTILS_NL80211_MCGRP_SCAN,
+          grp_id);
+    priv->genl_nl80211_scan_grp_joined_id = grp_id;
+}
+
+static void
+_genl_nl80211_update_scan_grp(NMPlatform *platform, struct nlattr *mcast_groups)
+{
+    static const struct nla_policy grp_policy[] = {
+        [CTRL_ATTR_MCAST_GRP_NAME] = {.type = NLA_STRING},
+        [CTRL_ATTR_MCAST_GRP_ID]   = {.type = NLA_U32},
+    };
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    struct nlattr          *tb[G_N_ELEMENTS(grp_policy)];
+    struct nlattr          *grp;
+    int                     rem;
+
+    priv->genl_nl80211_scan_grp_id = 0;
+
+    nla_for_each_nested (grp, mcast_groups, rem) {
+        if (nla_parse_nested_arr(tb, grp, grp_policy) < 0)
+            continue;
+        if (!tb[CTRL_ATTR_MCAST_GRP_NAME] || !tb[CTRL_ATTR_MCAST_GRP_ID])
+            continue;
+        if (!nm_streq(nla_get_string(tb[CTRL_ATTR_MCAST_GRP_NAME]),
+                      NM_WIFI_UTILS_NL80211_MCGRP_SCAN))
+            continue;
+
+        priv->genl_nl80211_scan_grp_id = nla_get_u32(tb[CTRL_ATTR_MCAST_GRP_ID]);
+        break;
+    }
+
+    _genl_nl80211_scan_grp_sync(platform);
+}
+
+static void
+wifi_watch_scan_results(NMPlatform *platform, gboolean watch)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    /* NMDeviceWifi can read the scan results directly from nl80211. For that,
+     * we notify about completed scans, but only while somebody is interested. */
+    if (watch)
+        priv->genl_nl80211_scan_grp_users++;
+    else {
+        g_return_if_fail(priv->genl_nl80211_scan_grp_users > 0);
+        priv->genl_nl80211_scan_grp_users--;
+    }
+
+    _genl_nl80211_scan_grp_sync(platform);
+}
+
 static void
 _genl_handle_msg_ctrl(NMPlatform *platform, const struct nlmsghdr *hdr)
 {
@@ -11236,6 +11964,17 @@ _genl_handle_msg_ctrl(NMPlatform *platform, const struct nlmsghdr *hdr)
             family_id = nla_get_u16(tb[CTRL_ATTR_FAMILY_ID]);
 
         _genl_family_id_update(platform, family_type, family_id);
+
+        if (family_type == NMP_GENL_FAMILY_TYPE_NL80211) {
+            NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+            if (family_id == 0) {
+                /* the family is gone, and with it the membership in its groups. */
+                priv->genl_nl80211_scan_grp_id        = 0;
+                priv->genl_nl80211_scan_grp_joined_id = 0;
+            } else if (tb[CTRL_ATTR_MCAST_GROUPS])
+                _genl_nl80211_update_scan_grp(platform, tb[CTRL_ATTR_MCAST_GROUPS]);
+        }
     }
     }
 }
@@ -11243,13 +11982,26 @@ _genl_handle_msg_ctrl(NMPlatform *platform, const struct nlmsghdr *hdr)
 static void
 _genl_handle_msg(NMPlatform *platform, guint32 pktinfo_group, const struct nl_msg_lite *msg)
 {
-    const struct nlmsghdr *hdr = msg->nm_nlh;
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    const struct nlmsghdr  *hdr  = msg->nm_nlh;
 
     if (!genlmsg_valid_hdr(hdr, 0))
         return;
 
-    if (hdr->nlmsg_type == GENL_ID_CTRL)
+    if (hdr->nlmsg_type == GENL_ID_CTRL) {
         _genl_handle_msg_ctrl(platform, hdr);
+        return;
+    }
+
+    if (hdr->nlmsg_type == priv->genl_family_data[NMP_GENL_FAMILY_TYPE_NL80211].family_id) {
+        int ifindex;
+
+        ifindex = nm_wifi_utils_nl80211_parse_scan_event(hdr);
+        if (ifindex > 0) {
+            _LOGT("genl:nl80211: new scan results for ifindex %d", ifindex);
+            g_signal_emit_by_name(platform, NM_PLATFORM_WIFI_SCAN_RESULTS, ifindex);
+        }
+    }
 }
 
 /*****************************************************************************/
@@ -11581,7 +12333,7 @@ event_handler_read_netlink(NMPlatform        *platform,
                         platform,
                         netlink_protocol,
                         WAIT_FOR_NL_RESPONSE_RESULT_FAILED_RESYNC);
-                    delayed_action_schedule_refresh_all(platform, netlink_protocol);
+                    resync_start(platform, netlink_protocol);
                     break;
                 default:
                     _LOGE("netlink[%s]: read: failed to retrieve incoming events: %s (%d)",
@@ -12426,6 +13178,10 @@ finalize(GObject *object)
     g_array_unref(priv->delayed_action.list_wait_for_response_rtnl);
     g_array_unref(priv->delayed_action.list_wait_for_response_genl);
 
+    nm_clear_pointer(&priv->route_ignore.tables, g_array_unref);
+    nm_clear_pointer(&priv->route_ignore.protocols, g_array_unref);
+    nm_clear_pointer(&priv->route_ignore.ifindexes, g_array_unref);
+
     nm_clear_g_source_inst(&priv->event_source_genl);
     nm_clear_g_source_inst(&priv->event_source_rtnl);
 
@@ -12514,6 +13270,8 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->wifi_get_capabilities            = wifi_get_capabilities;
     platform_class->wifi_get_frequency               = wifi_get_frequency;
     platform_class->wifi_get_station                 = wifi_get_station;
+    platform_class->wifi_get_scan_results            = wifi_get_scan_results;
+    platform_class->wifi_watch_scan_results          = wifi_watch_scan_results;
     platform_class->wifi_get_mode                    = wifi_get_mode;
     platform_class->wifi_set_mode                    = wifi_set_mode;
     platform_class->wifi_set_powersave               = wifi_set_powersave;
@@ -12540,8 +13298,10 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->ip4_address_delete = ip4_address_delete;
     platform_class->ip6_address_delete = ip6_address_delete;
 
-    platform_class->ip_route_add = ip_route_add;
-    platform_class->ip_route_get = ip_route_get;
+    platform_class->ip_route_add        = ip_route_add;
+    platform_class->addrroute_batch     = addrroute_batch;
+    platform_class->ip_route_get        = ip_route_get;
+    platform_class->ip_route_set_ignore = ip_route_set_ignore;
 
     platform_class->routing_rule_add = routing_rule_add;
 
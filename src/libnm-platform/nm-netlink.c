@@ -1095,6 +1095,38 @@ nl_socket_add_memberships(struct nl_sock *sk, int group, ...)
     return 0;
 }
 
+int
+nl_socket_drop_memberships(struct nl_sock *sk, int group, ...)
+{
+    int     err;
+    va_list ap;
+
+    nm_assert_sk(sk);
+
+    va_start(ap, group);
+
+    while (group != 0) {
+        if (group < 0) {
+            va_end(ap);
+            g_return_val_if_reached(-NME_BUG);
+        }
+
+        err = setsockopt(sk->s_fd, SOL_NETLINK, NETLINK_DROP_MEMBERSHIP, &group, sizeof(group));
+        if (err < 0) {
+            int errsv = errno;
+
+            va_end(ap);
+            return -nm_errno_from_native(errsv);
+        }
+
+        group = va_arg(ap, int);
+    }
+
+    va_end(ap);
+
+    return 0;
+}
+
 /*****************************************************************************/
 
 int
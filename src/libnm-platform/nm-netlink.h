@@ -610,6 +610,8 @@ uint32_t nl_socket_get_local_port(const struct nl_sock *sk);
 
 int nl_socket_add_memberships(struct nl_sock *sk, int group, ...);
 
+int nl_socket_drop_memberships(struct nl_sock *sk, int group, ...);
+
 int nl_connect(struct nl_sock *sk, int protocol);
 
 int nl_recv(struct nl_sock     *sk,
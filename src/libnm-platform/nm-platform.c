@@ -3381,6 +3381,45 @@ nm_platform_wifi_get_station(NMPlatform  *self,
     return klass->wifi_get_station(self, ifindex, out_bssid, out_quality, out_rate);
 }
 
+/**
+ * nm_platform_wifi_get_scan_results:
+ * @self: the #NMPlatform
+ * @ifindex: the ifindex of the Wi-Fi interface
+ *
+ * Returns: (transfer full): a #GArray of #NMWifiScanResult with
+ *   the BSS that the kernel currently knows, or %NULL on failure.
+ */
+GArray *
+nm_platform_wifi_get_scan_results(NMPlatform *self, int ifindex)
+{
+    _CHECK_SELF(self, klass, NULL);
+
+    g_return_val_if_fail(ifindex > 0, NULL);
+
+    if (!klass->wifi_get_scan_results)
+        return NULL;
+
+    return klass->wifi_get_scan_results(self, ifindex);
+}
+
+/**
+ * nm_platform_wifi_watch_scan_results:
+ * @self: the #NMPlatform
+ * @watch: whether to start or to stop watching
+ *
+ * While there is at least one watcher, the platform listens to the scan
+ * events of the kernel and emits %NM_PLATFORM_WIFI_SCAN_RESULTS. Each
+ * call with @watch %TRUE must be balanced by one with %FALSE.
+ */
+void
+nm_platform_wifi_watch_scan_results(NMPlatform *self, gboolean watch)
+{
+    _CHECK_SELF_VOID(self, klass);
+
+    if (klass->wifi_watch_scan_results)
+        klass->wifi_watch_scan_results(self, watch);
+}
+
 _NM80211Mode
 nm_platform_wifi_get_mode(NMPlatform *self, int ifindex)
 {
@@ -4299,6 +4338,172 @@ ip6_address_scope_cmp_descending(gconstpointer p_a, gconstpointer p_b, gpointer
     return ip6_address_scope_cmp_ascending(p_b, p_a, NULL);
 }
 
+/*****************************************************************************/
+
+static void
+_addrroute_op_clear(NMPlatformAddrRouteOp *op)
+{
+    nm_clear_pointer(&op->obj, nmp_object_unref);
+    nm_clear_g_free(&op->extack_msg);
+}
+
+static NMPlatformAddrRouteOp *
+_addrroute_ops_append(GArray **p_ops, const NMPObject *obj, gboolean is_delete)
+{
+    NMPlatformAddrRouteOp *op;
+
+    if (!*p_ops) {
+        *p_ops = g_array_new(FALSE, TRUE, sizeof(NMPlatformAddrRouteOp));
+        g_array_set_clear_func(*p_ops, (GDestroyNotify) _addrroute_op_clear);
+    }
+
+    op            = nm_g_array_append_new(*p_ops, NMPlatformAddrRouteOp);
+    op->obj       = nmp_object_ref(obj);
+    op->is_delete = is_delete;
+    return op;
+}
+
+static void
+_addrroute_ops_append_route_add(GArray **p_ops, const NMPObject *obj, NMPNlmFlags nlmflags)
+{
+    nm_auto_nmpobj NMPObject *obj_normalized = NULL;
+
+    obj_normalized = nmp_object_clone(obj, FALSE);
+    nm_platform_ip_route_normalize(NMP_OBJECT_GET_ADDR_FAMILY(obj_normalized),
+                                   &obj_normalized->ip_route);
+
+    _addrroute_ops_append(p_ops, obj_normalized, FALSE)->nlmflags = nlmflags;
+}
+
+/**
+ * _addrroute_batch:
+ * @self: the #NMPlatform instance.
+ * @ops: (nullable): the #GArray of #NMPlatformAddrRouteOp to perform.
+ *
+ * Performs all operations in order. The platform implementation may
+ * send them all at once to kernel and collect the responses afterwards,
+ * instead of waiting for each response in turn. The result of each
+ * operation is reported in its "result" and "extack_msg" fields.
+ */
+static void
+_addrroute_batch(NMPlatform *self, GArray *ops)
+{
+    char  sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
+    int   ifindex;
+    guint i;
+
+    _CHECK_SELF_VOID(self, klass);
+
+    if (nm_g_array_len(ops) == 0)
+        return;
+
+    for (i = 0; i < ops->len; i++) {
+        const NMPlatformAddrRouteOp *op  = &nm_g_array_index(ops, NMPlatformAddrRouteOp, i);
+        const NMPObject             *obj = op->obj;
+
+        ifindex = NMP_OBJECT_CAST_OBJ_WITH_IFINDEX(obj)->ifindex;
+
+        if (_LOGD_ENABLED()) {
+            if (op->is_delete) {
+                _LOG3D("%s: delete %s",
+                       NMP_OBJECT_GET_CLASS(obj)->obj_type_name,
+                       nmp_object_to_string(obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)));
+            } else if (NM_IN_SET(NMP_OBJECT_GET_TYPE(obj),
+                                 NMP_OBJECT_TYPE_IP4_ROUTE,
+                                 NMP_OBJECT_TYPE_IP6_ROUTE)) {
+                _LOG3D("route: %-10s IPv%c route: %s",
+                       _nmp_nlm_flag_to_string(op->nlmflags & NMP_NLM_FLAG_FMASK),
+                       nm_utils_addr_family_to_char(NMP_OBJECT_GET_ADDR_FAMILY(obj)),
+                       nmp_object_to_string(obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)));
+            } else {
+                _LOG3D("address: adding or updating IPv%c address: %s",
+                       nm_utils_addr_family_to_char(NMP_OBJECT_GET_ADDR_FAMILY(obj)),
+                       nmp_object_to_string(obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)));
+            }
+        }
+
+        if (!op->is_delete && NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_IP6_ADDRESS)
+            nm_platform_ip6_dadfailed_set(self, ifindex, &obj->ip6_address.address, FALSE);
+    }
+
+    if (klass->addrroute_batch) {
+        klass->addrroute_batch(self, (NMPlatformAddrRouteOp *) ops->data, ops->len);
+        return;
+    }
+
+    for (i = 0; i < ops->len; i++) {
+        NMPlatformAddrRouteOp *op  = &nm_g_array_index(ops, NMPlatformAddrRouteOp, i);
+        const NMPObject       *obj = op->obj;
+        gboolean               success;
+
+        switch (NMP_OBJECT_GET_TYPE(obj)) {
+        case NMP_OBJECT_TYPE_IP4_ADDRESS:
+        {
+            const NMPlatformIP4Address *a = NMP_OBJECT_CAST_IP4_ADDRESS(obj);
+
+            if (op->is_delete) {
+                success = klass->ip4_address_delete(self,
+                                                    a->ifindex,
+                                                    a->address,
+                                                    a->plen,
+                                                    a->peer_address);
+            } else {
+                success = klass->ip4_address_add(self,
+                                                 a->ifindex,
+                                                 a->address,
+                                                 a->plen,
+                                                 a->peer_address,
+                                                 nm_platform_ip4_broadcast_address_from_addr(a),
+                                                 op->lifetime,
+                                                 op->preferred,
+                                                 op->ifa_flags,
+                                                 a->label,
+                                                 &op->extack_msg);
+            }
+            op->result = success ? 0 : -NME_UNSPEC;
+            break;
+        }
+        case NMP_OBJECT_TYPE_IP6_ADDRESS:
+        {
+            const NMPlatformIP6Address *a = NMP_OBJECT_CAST_IP6_ADDRESS(obj);
+
+            if (op->is_delete)
+                success = klass->ip6_address_delete(self, a->ifindex, a->address, a->plen);
+            else {
+                success = klass->ip6_address_add(self,
+                                                 a->ifindex,
+                                                 a->address,
+                                                 a->plen,
+                                                 a->peer_address,
+                                                 op->lifetime,
+                                                 op->preferred,
+                                                 op->ifa_flags,
+                                                 &op->extack_msg);
+            }
+            op->result = success ? 0 : -NME_UNSPEC;
+            break;
+        }
+        case NMP_OBJECT_TYPE_IP4_ROUTE:
+        case NMP_OBJECT_TYPE_IP6_ROUTE:
+            if (op->is_delete)
+                op->result = klass->object_delete(self, obj) ? 0 : -NME_UNSPEC;
+            else {
+                NMPObject obj_stack;
+
+                nmp_object_stackinit(&obj_stack, NMP_OBJECT_GET_TYPE(obj), &obj->ip_route);
+                if (NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_IP4_ROUTE)
+                    obj_stack._ip4_route.extra_nexthops = obj->_ip4_route.extra_nexthops;
+                op->result = klass->ip_route_add(self, op->nlmflags, &obj_stack, &op->extack_msg);
+            }
+            break;
+        default:
+            nm_assert_not_reached();
+            op->result = -NME_BUG;
+            break;
+        }
+    }
+}
+
 /**
  * nm_platform_ip_address_sync:
  * @self: platform instance
@@ -4338,6 +4543,7 @@ nm_platform_ip_address_sync(NMPlatform           *self,
     gs_unref_hashtable GHashTable *known_addresses_idx  = NULL;
     gs_unref_hashtable GHashTable *plat_addrs_to_delete = NULL;
     gs_unref_ptrarray GPtrArray   *plat_addresses       = NULL;
+    gs_unref_array GArray         *ops                  = NULL;
     gboolean                       success;
     guint                          i_plat;
     guint                          i_know;
@@ -4411,6 +4617,8 @@ nm_platform_ip_address_sync(NMPlatform           *self,
         known_addresses = NULL;
 
     if (nm_g_ptr_array_len(addresses_prune) > 0) {
+        gs_unref_array GArray *ops_prune = NULL;
+
         /* First delete addresses that we should prune (and which are no longer tracked
          * as @known_addresses. */
         for (i = 0; i < addresses_prune->len; i++) {
@@ -4419,15 +4627,15 @@ nm_platform_ip_address_sync(NMPlatform           *self,
             nm_assert(NM_IN_SET(NMP_OBJECT_GET_TYPE(prune_obj),
                                 NMP_OBJECT_TYPE_IP4_ADDRESS,
                                 NMP_OBJECT_TYPE_IP6_ADDRESS));
+            nm_assert(NMP_OBJECT_CAST_IP_ADDRESS(prune_obj)->ifindex == ifindex);
 
             if (nm_g_hash_table_contains(known_addresses_idx, prune_obj))
                 continue;
 
-            nm_platform_ip_address_delete(self,
-                                          addr_family,
-                                          ifindex,
-                                          NMP_OBJECT_CAST_IP_ADDRESS(prune_obj));
+            _addrroute_ops_append(&ops_prune, prune_obj, TRUE);
         }
+
+        _addrroute_batch(self, ops_prune);
     }
 
     /* ensure we have the platform cache up to date. */
@@ -4668,15 +4876,18 @@ next_plat:;
     if (!known_addresses)
         return TRUE;
 
-    success = TRUE;
-
     /* Add missing addresses. New addresses are added by kernel with top
      * priority.
+     *
+     * The requests are queued in @ops and sent at once. Kernel processes
+     * them in order, so the resulting order of the addresses is the same as
+     * if we waited for each response in turn.
      */
     for (i = 0; i < known_addresses->len; i++) {
         const NMPObject            *plat_obj;
         const NMPObject            *known_obj;
         const NMPlatformIPXAddress *known_address;
+        NMPlatformAddrRouteOp      *op;
         guint32                     lifetime;
         guint32                     preferred;
 
@@ -4708,10 +4919,7 @@ next_plat:;
         if (plat_obj && nm_g_hash_table_contains(plat_addrs_to_delete, plat_obj)) {
             /* This address exists, but it had the wrong priority earlier. We
              * cannot just update it, we need to remove it first. */
-            nm_platform_ip_address_delete(self,
-                                          addr_family,
-                                          ifindex,
-                                          NMP_OBJECT_CAST_IP_ADDRESS(plat_obj));
+            _addrroute_ops_append(&ops, plat_obj, TRUE);
             plat_obj = NULL;
         }
 
@@ -4731,40 +4939,31 @@ next_plat:;
             continue;
         }
 
+        op            = _addrroute_ops_append(&ops, known_obj, FALSE);
+        op->lifetime  = lifetime;
+        op->preferred = preferred;
         if (IS_IPv4) {
-            if (!nm_platform_ip4_address_add(
-                    self,
-                    ifindex,
-                    known_address->a4.address,
-                    known_address->a4.plen,
-                    known_address->a4.peer_address,
-                    nm_platform_ip4_broadcast_address_from_addr(&known_address->a4),
-                    lifetime,
-                    preferred,
-                    NM_FLAGS_HAS(flags, NMP_IP_ADDRESS_SYNC_FLAGS_WITH_NOPREFIXROUTE)
-                        ? IFA_F_NOPREFIXROUTE
-                        : 0,
-                    known_address->a4.label,
-                    NULL))
-                success = FALSE;
+            op->ifa_flags = NM_FLAGS_HAS(flags, NMP_IP_ADDRESS_SYNC_FLAGS_WITH_NOPREFIXROUTE)
+                                ? IFA_F_NOPREFIXROUTE
+                                : 0;
         } else {
-            if (!nm_platform_ip6_address_add(
-                    self,
-                    ifindex,
-                    known_address->a6.address,
-                    known_address->a6.plen,
-                    known_address->a6.peer_address,
-                    lifetime,
-                    preferred,
-                    (NM_FLAGS_HAS(flags, NMP_IP_ADDRESS_SYNC_FLAGS_WITH_NOPREFIXROUTE)
-                         ? IFA_F_NOPREFIXROUTE
-                         : 0)
-                        | known_address->a6.n_ifa_flags,
-                    NULL))
-                success = FALSE;
+            op->ifa_flags = (NM_FLAGS_HAS(flags, NMP_IP_ADDRESS_SYNC_FLAGS_WITH_NOPREFIXROUTE)
+                                 ? IFA_F_NOPREFIXROUTE
+                                 : 0)
+                            | known_address->a6.n_ifa_flags;
         }
     }
 
+    _addrroute_batch(self, ops);
+
+    success = TRUE;
+    for (i = 0; i < nm_g_array_len(ops); i++) {
+        const NMPlatformAddrRouteOp *op = &nm_g_array_index(ops, NMPlatformAddrRouteOp, i);
+
+        if (!op->is_delete && op->result < 0)
+            success = FALSE;
+    }
+
     return success;
 }
 
@@ -5173,7 +5372,10 @@ nm_platform_ip_route_sync(NMPlatform *self,
 {
     const int                      IS_IPv4 = NM_IS_IPv4(addr_family);
     const NMPlatformVTableRoute   *vt;
-    gs_unref_hashtable GHashTable *routes_idx = NULL;
+    gs_unref_hashtable GHashTable *routes_idx  = NULL;
+    gs_unref_array GArray         *ops         = NULL;
+    gs_unref_ptrarray GPtrArray   *ops_conf    = NULL;
+    gs_unref_array GArray         *ops_prune   = NULL;
     const NMPObject               *conf_o;
     const NMDedupMultiEntry       *plat_entry;
     guint                          i;
@@ -5187,11 +5389,14 @@ nm_platform_ip_route_sync(NMPlatform *self,
 
     vt = &nm_platform_vtable_route.vx[IS_IPv4];
 
+    /* We don't wait for kernel to acknowledge each route in turn. Instead, we queue
+     * all requests in @ops and send them at once. Kernel handles them in order, so
+     * the device routes are still added before the gateway routes. @ops_conf tracks
+     * the @routes that correspond to each operation, or %NULL for deletions. */
+    ops_conf = g_ptr_array_new();
+
     for (i_type = 0; routes && i_type < 2; i_type++) {
         for (i = 0; i < routes->len; i++) {
-            gs_free char *extack_msg = NULL;
-            int           r;
-
             conf_o = routes->pdata[i];
 
             /* User space cannot add IPv6 routes with metric 0. However, kernel can, and we might track such
@@ -5240,66 +5445,76 @@ nm_platform_ip_route_sync(NMPlatform *self,
                     continue;
 
                 /* we need to replace the existing route with a (slightly) different
-                 * one. Delete it first. */
-                if (!nm_platform_object_delete(self, plat_o)) {
-                    /* ignore error. */
-                }
+                 * one. Delete it first. We ignore errors. */
+                _addrroute_ops_append(&ops, plat_o, TRUE);
+                g_ptr_array_add(ops_conf, NULL);
             }
 
-            r = nm_platform_ip_route_add(self,
-                                         NMP_NLM_FLAG_APPEND
-                                             | NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE,
-                                         conf_o,
-                                         &extack_msg);
-            if (r == 0) {
-                /* success */
-            } else if (r == -EEXIST) {
-                /* Don't fail for EEXIST. It's not clear that the existing route
-                 * is identical to the one that we were about to add. However,
-                 * above we should have deleted conflicting (non-identical) routes. */
-                if (_LOGD_ENABLED()) {
-                    plat_entry =
-                        nm_platform_lookup_entry(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, conf_o);
-                    if (!plat_entry) {
-                        _LOG3D("route-sync: adding route %s failed with EEXIST, however we "
-                               "cannot find such a route",
-                               nmp_object_to_string(conf_o,
-                                                    NMP_OBJECT_TO_STRING_PUBLIC,
-                                                    sbuf1,
-                                                    sizeof(sbuf1)));
-                    } else if (vt->route_cmp(NMP_OBJECT_CAST_IPX_ROUTE(conf_o),
-                                             NMP_OBJECT_CAST_IPX_ROUTE(plat_entry->obj),
-                                             NM_PLATFORM_IP_ROUTE_CMP_TYPE_SEMANTICALLY)
-                               != 0) {
-                        _LOG3D("route-sync: adding route %s failed due to existing "
-                               "(different!) route %s",
-                               nmp_object_to_string(conf_o,
-                                                    NMP_OBJECT_TO_STRING_PUBLIC,
-                                                    sbuf1,
-                                                    sizeof(sbuf1)),
-                               nmp_object_to_string(plat_entry->obj,
-                                                    NMP_OBJECT_TO_STRING_PUBLIC,
-                                                    sbuf2,
-                                                    sizeof(sbuf2)));
-                    }
+            _addrroute_ops_append_route_add(&ops,
+                                            conf_o,
+                                            NMP_NLM_FLAG_APPEND
+                                                | NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE);
+            g_ptr_array_add(ops_conf, (gpointer) conf_o);
+        }
+    }
+
+    _addrroute_batch(self, ops);
+
+    for (i = 0; i < nm_g_array_len(ops); i++) {
+        const NMPlatformAddrRouteOp *op = &nm_g_array_index(ops, NMPlatformAddrRouteOp, i);
+        int                          r;
+
+        conf_o = ops_conf->pdata[i];
+        if (!conf_o)
+            continue;
+
+        r = op->result;
+        if (r == 0) {
+            /* success */
+        } else if (r == -EEXIST) {
+            /* Don't fail for EEXIST. It's not clear that the existing route
+             * is identical to the one that we were about to add. However,
+             * above we should have deleted conflicting (non-identical) routes. */
+            if (_LOGD_ENABLED()) {
+                plat_entry = nm_platform_lookup_entry(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, conf_o);
+                if (!plat_entry) {
+                    _LOG3D("route-sync: adding route %s failed with EEXIST, however we "
+                           "cannot find such a route",
+                           nmp_object_to_string(conf_o,
+                                                NMP_OBJECT_TO_STRING_PUBLIC,
+                                                sbuf1,
+                                                sizeof(sbuf1)));
+                } else if (vt->route_cmp(NMP_OBJECT_CAST_IPX_ROUTE(conf_o),
+                                         NMP_OBJECT_CAST_IPX_ROUTE(plat_entry->obj),
+                                         NM_PLATFORM_IP_ROUTE_CMP_TYPE_SEMANTICALLY)
+                           != 0) {
+                    _LOG3D("route-sync: adding route %s failed due to existing "
+                           "(different!) route %s",
+                           nmp_object_to_string(conf_o,
+                                                NMP_OBJECT_TO_STRING_PUBLIC,
+                                                sbuf1,
+                                                sizeof(sbuf1)),
+                           nmp_object_to_string(plat_entry->obj,
+                                                NMP_OBJECT_TO_STRING_PUBLIC,
+                                                sbuf2,
+                                                sizeof(sbuf2)));
                 }
-            } else {
-                _LOG3D(
-                    "route-sync: failure to add IPv%c route: %s: %s%s%s%s",
-                    vt->is_ip4 ? '4' : '6',
-                    nmp_object_to_string(conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof(sbuf1)),
-                    nm_strerror(r),
-                    NM_PRINT_FMT_QUOTED(extack_msg, " (", extack_msg, ")", ""));
-
-                success = FALSE;
-
-                if (out_routes_failed) {
-                    if (!*out_routes_failed) {
-                        *out_routes_failed =
-                            g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
-                    }
-                    g_ptr_array_add(*out_routes_failed, (gpointer) nmp_object_ref(conf_o));
+            }
+        } else {
+            _LOG3D("route-sync: failure to add IPv%c route: %s: %s%s%s%s",
+                   vt->is_ip4 ? '4' : '6',
+                   nmp_object_to_string(conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof(sbuf1)),
+                   nm_strerror(r),
+                   NM_PRINT_FMT_QUOTED(op->extack_msg, " (", op->extack_msg, ")", ""));
+
+            success = FALSE;
+
+            if (out_routes_failed) {
+                if (!*out_routes_failed) {
+                    *out_routes_failed =
+                        g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
                 }
+                g_ptr_array_add(*out_routes_failed, (gpointer) nmp_object_ref(conf_o));
             }
         }
     }
@@ -5321,10 +5536,11 @@ nm_platform_ip_route_sync(NMPlatform *self,
             if (!nm_platform_lookup_entry(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, prune_o))
                 continue;
 
-            if (!nm_platform_object_delete(self, prune_o)) {
-                /* ignore error... */
-            }
+            _addrroute_ops_append(&ops_prune, prune_o, TRUE);
         }
+
+        /* ignore errors... */
+        _addrroute_batch(self, ops_prune);
     }
 
     return success;
@@ -5703,6 +5919,53 @@ nm_platform_ip_route_get(NMPlatform   *self,
     return result;
 }
 
+/**
+ * nm_platform_ip_route_set_ignore:
+ * @self: the #NMPlatform
+ * @tables: (nullable): the route tables to ignore.
+ * @n_tables: the number of entries in @tables.
+ * @protocols: (nullable): the route protocols (RTPROT_*) to ignore.
+ * @n_protocols: the number of entries in @protocols.
+ * @ifindexes: (nullable): ignore routes whose (first) next hop is one of
+ *   these interfaces.
+ * @n_ifindexes: the number of entries in @ifindexes.
+ *
+ * Routes matching any of these are not tracked in the platform cache.
+ * This is useful on hosts with routing daemons that keep huge routing
+ * tables we don't care about. The filter applies before the netlink
+ * message gets parsed into an object, so ignored routes cost almost
+ * nothing.
+ *
+ * Note that NetworkManager will not be able to see (or prune) routes
+ * that it ignores.
+ */
+void
+nm_platform_ip_route_set_ignore(NMPlatform    *self,
+                                const guint32 *tables,
+                                guint          n_tables,
+                                const guint8  *protocols,
+                                guint          n_protocols,
+                                const int     *ifindexes,
+                                guint          n_ifindexes)
+{
+    _CHECK_SELF_VOID(self, klass);
+
+    g_return_if_fail(n_tables == 0 || tables);
+    g_return_if_fail(n_protocols == 0 || protocols);
+    g_return_if_fail(n_ifindexes == 0 || ifindexes);
+
+    if (!klass->ip_route_set_ignore)
+        return;
+
+    klass->ip_route_set_ignore(self,
+                               tables,
+                               n_tables,
+                               protocols,
+                               n_protocols,
+                               ifindexes,
+                               n_ifindexes);
+}
+
 /*****************************************************************************/
 
 #define IP4_DEV_ROUTE_BLACKLIST_TIMEOUT_MS ((int) 1500)
@@ -10412,4 +10675,15 @@ nm_platform_class_init(NMPlatformClass *platform_class)
            log_routing_rule);
     SIGNAL(NM_PLATFORM_SIGNAL_ID_QDISC, NM_PLATFORM_SIGNAL_QDISC_CHANGED, log_qdisc);
     SIGNAL(NM_PLATFORM_SIGNAL_ID_TFILTER, NM_PLATFORM_SIGNAL_TFILTER_CHANGED, log_tfilter);
+
+    g_signal_new(NM_PLATFORM_WIFI_SCAN_RESULTS,
+                 G_OBJECT_CLASS_TYPE(object_class),
+                 G_SIGNAL_RUN_FIRST,
+                 0,
+                 NULL,
+                 NULL,
+                 NULL,
+                 G_TYPE_NONE,
+                 1,
+                 G_TYPE_INT /* ifindex */);
 }
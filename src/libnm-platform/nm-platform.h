@@ -1144,6 +1144,34 @@ NMPGenlFamilyType nmp_genl_family_type_from_name(const char *name);
 
 /*****************************************************************************/
 
+/* A queued request to add or delete an IP address or route. A list of such
+ * operations is sent to kernel at once, and the responses are collected
+ * afterwards. See nm_platform_ip_address_sync() and nm_platform_ip_route_sync(). */
+typedef struct {
+    /* an IP address or route object. The operation holds a reference.
+     * Routes to be added must already be normalized. */
+    const NMPObject *obj;
+
+    /* for adding routes, the NMPNlmFlags. */
+    NMPNlmFlags nlmflags;
+
+    /* for adding addresses, the lifetimes (relative to now) and the IFA_F_* flags. */
+    guint32 lifetime;
+    guint32 preferred;
+    guint32 ifa_flags;
+
+    bool is_delete : 1;
+
+    /* out: zero on success or a negative error code. For deletes, an object that
+     * was already gone counts as success. */
+    int result;
+
+    /* out: the extended ack message from kernel, if any. */
+    char *extack_msg;
+} NMPlatformAddrRouteOp;
+
+/*****************************************************************************/
+
 struct _NMPlatformPrivate;
 
 struct _NMPlatform {
@@ -1286,6 +1314,8 @@ typedef struct {
                                  NMEtherAddr *out_bssid,
                                  int         *out_quality,
                                  guint32     *out_rate);
+    GArray *(*wifi_get_scan_results)(NMPlatform *self, int ifindex);
+    void (*wifi_watch_scan_results)(NMPlatform *self, gboolean watch);
     gboolean (*wifi_get_bssid)(NMPlatform *self, int ifindex, guint8 *bssid);
     guint32 (*wifi_get_frequency)(NMPlatform *self, int ifindex);
     int (*wifi_get_quality)(NMPlatform *self, int ifindex);
@@ -1350,6 +1380,8 @@ typedef struct {
                         NMPObject  *obj_stack,
                         char      **out_extack_msg);
 
+    void (*addrroute_batch)(NMPlatform *self, NMPlatformAddrRouteOp *ops, guint n_ops);
+
     int (*ip_route_get)(NMPlatform   *self,
                         int           addr_family,
                         gconstpointer address,
@@ -1357,6 +1389,14 @@ typedef struct {
                         int           oif_ifindex,
                         NMPObject   **out_route);
 
+    void (*ip_route_set_ignore)(NMPlatform    *self,
+                                const guint32 *tables,
+                                guint          n_tables,
+                                const guint8  *protocols,
+                                guint          n_protocols,
+                                const int     *ifindexes,
+                                guint          n_ifindexes);
+
     int (*routing_rule_add)(NMPlatform                  *self,
                             NMPNlmFlags                  flags,
                             const NMPlatformRoutingRule *routing_rule);
@@ -1401,6 +1441,12 @@ typedef struct {
 #define NM_PLATFORM_SIGNAL_QDISC_CHANGED        "qdisc-changed"
 #define NM_PLATFORM_SIGNAL_TFILTER_CHANGED      "tfilter-changed"
 
+/* Emitted with the ifindex (int), when the kernel completed a scan of
+ * a Wi-Fi interface. Use nm_platform_wifi_get_scan_results() to read
+ * the results. Only emitted while somebody called
+ * nm_platform_wifi_watch_scan_results(). */
+#define NM_PLATFORM_WIFI_SCAN_RESULTS "wifi-scan-results"
+
 const char *nm_platform_signal_change_type_to_string(NMPlatformSignalChangeType change_type);
 
 /*****************************************************************************/
@@ -2252,6 +2298,8 @@ gboolean     nm_platform_wifi_get_station(NMPlatform  *self,
                                           NMEtherAddr *out_bssid,
                                           int         *out_quality,
                                           guint32     *out_rate);
+GArray      *nm_platform_wifi_get_scan_results(NMPlatform *self, int ifindex);
+void         nm_platform_wifi_watch_scan_results(NMPlatform *self, gboolean watch);
 _NM80211Mode nm_platform_wifi_get_mode(NMPlatform *self, int ifindex);
 void         nm_platform_wifi_set_mode(NMPlatform *self, int ifindex, _NM80211Mode mode);
 void         nm_platform_wifi_set_powersave(NMPlatform *self, int ifindex, guint32 powersave);
@@ -2495,6 +2543,14 @@ int nm_platform_ip_route_get(NMPlatform   *self,
                              int           oif_ifindex,
                              NMPObject   **out_route);
 
+void nm_platform_ip_route_set_ignore(NMPlatform    *self,
+                                     const guint32 *tables,
+                                     guint          n_tables,
+                                     const guint8  *protocols,
+                                     guint          n_protocols,
+                                     const int     *ifindexes,
+                                     guint          n_ifindexes);
+
 int nm_platform_routing_rule_add(NMPlatform                  *self,
                                  NMPNlmFlags                  flags,
                                  const NMPlatformRoutingRule *routing_rule);
@@ -8,6 +8,7 @@
 #include "nmp-object.h"
 
 #include <unistd.h>
+#include <sys/mman.h>
 #include <linux/rtnetlink.h>
 #include <linux/if.h>
 #include <libudev.h>
@@ -779,12 +780,305 @@ _NMP_OBJECT_STRUCT_SIZE(const NMPClass *klass)
     return klass->sizeof_data + G_STRUCT_OFFSET(NMPObject, object);
 }
 
+/*****************************************************************************/
+
+/* NMPObjects are allocated from per-type pools. With many routes, the
+ * platform cache creates and destroys a large number of small objects of
+ * the same size. The pool allocates chunks of objects at once and keeps
+ * released objects on a per-chunk free list for reuse.
+ *
+ * The chunks are mapped with mmap() and aligned to their size, so that the
+ * chunk of an object is found by masking its address. When the last object
+ * of a chunk is freed, each pool keeps one such empty chunk around, so that
+ * a pool with few (or short-lived) objects does not map and unmap a chunk
+ * over and over. Further empty chunks get unmapped, which returns the memory
+ * to the system.
+ *
+ * Like the reference counting of NMPObject, the pools are not thread-safe.
+ * NMPObjects must only be used from one thread. */
+
+#define POOL_CHUNK_SIZE_MIN ((gsize) 16384u)
+
+typedef struct _PoolFreeObj {
+    struct _PoolFreeObj *next;
+} PoolFreeObj;
+
+typedef struct {
+    /* Linked in Pool.chunks_lst_head while the chunk has free objects. */
+    CList chunks_lst;
+
+    PoolFreeObj *free_list;
+
+    guint n_in_use;
+
+    /* The number of objects that were handed out from the chunk so far.
+     * The objects after that are not yet on the free list, so that their
+     * pages are not touched before they are needed. */
+    guint n_carved;
+
+    /* followed by the objects. */
+    union {
+        gpointer _align_ptr;
+        gint64   _align_i64;
+        double   _align_d;
+    } data[];
+} PoolChunk;
+
+typedef struct {
+    CList chunks_lst_head;
+
+    /* An empty chunk that is kept instead of being unmapped. It is linked
+     * at the tail of chunks_lst_head, so that it only gets used once the
+     * other chunks are full. */
+    PoolChunk *empty_chunk;
+
+    guint              n_per_chunk;
+    NMPObjectPoolStats stats;
+} Pool;
+
+static struct {
+    gsize chunk_size;
+    int   enabled;
+    Pool  pools[NMP_OBJECT_TYPE_MAX];
+} _pool_global = {
+    .enabled = -1,
+};
+
+static gboolean
+_pool_enabled(void)
+{
+    if (G_UNLIKELY(_pool_global.enabled == -1)) {
+        NMPObjectType obj_type;
+
+#if defined(__SANITIZE_ADDRESS__)
+        _pool_global.enabled = FALSE;
+#else
+        /* Honor the same environment variable as g_slice, so that valgrind
+         * can track the objects. */
+        _pool_global.enabled = !strstr(g_getenv("G_SLICE") ?: "", "always-malloc");
+#endif
+
+        /* The chunks are unmapped individually, so they must be a multiple
+         * of the page size. */
+        _pool_global.chunk_size = NM_MAX(POOL_CHUNK_SIZE_MIN, (gsize) sysconf(_SC_PAGESIZE));
+        nm_assert(nm_utils_is_power_of_two(_pool_global.chunk_size));
+
+        for (obj_type = 1; obj_type <= NMP_OBJECT_TYPE_MAX; obj_type++)
+            c_list_init(&_pool_global.pools[obj_type - 1].chunks_lst_head);
+    }
+
+    return _pool_global.enabled;
+}
+
+static gsize
+_pool_obj_size(const NMPClass *klass)
+{
+    gsize size = _NMP_OBJECT_STRUCT_SIZE(klass);
+
+    G_STATIC_ASSERT_EXPR(sizeof(((PoolChunk *) NULL)->data[0]) >= sizeof(PoolFreeObj));
+
+    return NM_ALIGN_TO(size, sizeof(((PoolChunk *) NULL)->data[0]));
+}
+
+static PoolChunk *
+_pool_chunk_from_obj(gconstpointer mem)
+{
+    return (PoolChunk *) (((uintptr_t) mem) & ~((uintptr_t) (_pool_global.chunk_size - 1u)));
+}
+
+static PoolChunk *
+_pool_chunk_new(void)
+{
+    const gsize chunk_size = _pool_global.chunk_size;
+    char       *mem;
+    char       *chunk;
+
+    /* mmap() only aligns to the page size. Map twice the size and unmap the
+     * parts before and after the aligned chunk. */
+    mem = mmap(NULL, 2u * chunk_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+        g_error("nmp-object: failed to allocate %zu bytes", 2u * chunk_size);
+
+    chunk = (char *) _pool_chunk_from_obj(mem + chunk_size - 1u);
+    if (chunk != mem)
+        munmap(mem, chunk - mem);
+    munmap(chunk + chunk_size, (mem + chunk_size) - chunk);
+
+    /* the mapping is zero initialized, which is a valid empty chunk. */
+    c_list_init(&((PoolChunk *) chunk)->chunks_lst);
+    return (PoolChunk *) chunk;
+}
+
+static gpointer
+_pool_alloc(const NMPClass *klass)
+{
+    Pool      *pool = &_pool_global.pools[klass->obj_type - 1];
+    PoolChunk *chunk;
+    gpointer   mem;
+
+    chunk = c_list_first_entry(&pool->chunks_lst_head, PoolChunk, chunks_lst);
+    if (G_UNLIKELY(!chunk)) {
+        if (pool->n_per_chunk == 0) {
+            pool->stats.obj_size = _pool_obj_size(klass);
+            pool->n_per_chunk =
+                (_pool_global.chunk_size - G_STRUCT_OFFSET(PoolChunk, data)) / pool->stats.obj_size;
+            nm_assert(pool->n_per_chunk >= 8u);
+        }
+
+        chunk = _pool_chunk_new();
+        c_list_link_front(&pool->chunks_lst_head, &chunk->chunks_lst);
+
+        pool->stats.chunk_bytes += _pool_global.chunk_size;
+        pool->stats.n_chunk_allocs++;
+        pool->stats.n_free += pool->n_per_chunk;
+    } else if (chunk == pool->empty_chunk)
+        pool->empty_chunk = NULL;
+
+    if (chunk->free_list) {
+        mem              = chunk->free_list;
+        chunk->free_list = chunk->free_list->next;
+    } else {
+        nm_assert(chunk->n_carved < pool->n_per_chunk);
+        mem = ((char *) chunk->data) + (chunk->n_carved * pool->stats.obj_size);
+        chunk->n_carved++;
+    }
+
+    chunk->n_in_use++;
+    if (chunk->n_in_use == pool->n_per_chunk) {
+        /* the chunk is full. */
+        c_list_unlink(&chunk->chunks_lst);
+    }
+
+    pool->stats.n_free--;
+    pool->stats.n_in_use++;
+    pool->stats.n_allocs++;
+
+    return mem;
+}
+
+static void
+_pool_free(const NMPClass *klass, gpointer mem)
+{
+    Pool        *pool     = &_pool_global.pools[klass->obj_type - 1];
+    PoolChunk   *chunk    = _pool_chunk_from_obj(mem);
+    PoolFreeObj *free_obj = mem;
+
+    nm_assert(chunk->n_in_use > 0);
+    nm_assert(pool->stats.n_in_use > 0);
+
+    if (chunk->n_in_use == pool->n_per_chunk) {
+        /* the chunk was full. Prefer it for the next allocation, so that
+         * the objects stay packed in few chunks. */
+        c_list_link_front(&pool->chunks_lst_head, &chunk->chunks_lst);
+    }
+
+    pool->stats.n_free++;
+    pool->stats.n_in_use--;
+
+    chunk->n_in_use--;
+    if (chunk->n_in_use == 0) {
+        c_list_unlink(&chunk->chunks_lst);
+
+        if (!pool->empty_chunk) {
+            /* Keep the chunk. Start carving it anew, so that the objects get
+             * handed out in order. */
+            chunk->free_list = NULL;
+            chunk->n_carved  = 0;
+            c_list_link_tail(&pool->chunks_lst_head, &chunk->chunks_lst);
+            pool->empty_chunk = chunk;
+            return;
+        }
+
+        munmap(chunk, _pool_global.chunk_size);
+        pool->stats.chunk_bytes -= _pool_global.chunk_size;
+        pool->stats.n_free -= pool->n_per_chunk;
+        return;
+    }
+
+    free_obj->next   = chunk->free_list;
+    chunk->free_list = free_obj;
+}
+
+/**
+ * nmp_object_pool_get_stats:
+ * @obj_type: the object type.
+ * @out_stats: (out): the current statistics of the pool.
+ *
+ * Returns: %FALSE if object pools are disabled (for example, because
+ *   G_SLICE=always-malloc is set).
+ */
+gboolean
+nmp_object_pool_get_stats(NMPObjectType obj_type, NMPObjectPoolStats *out_stats)
+{
+    const NMPClass *klass = nmp_class_from_type(obj_type);
+
+    nm_assert(out_stats);
+
+    if (!_pool_enabled()) {
+        *out_stats = (NMPObjectPoolStats) {
+            .obj_size = _NMP_OBJECT_STRUCT_SIZE(klass),
+        };
+        return FALSE;
+    }
+
+    *out_stats          = _pool_global.pools[obj_type - 1].stats;
+    out_stats->obj_size = _pool_obj_size(klass);
+    return TRUE;
+}
+
+const char *
+nmp_object_pool_stats_to_string(char *buf, gsize buf_size)
+{
+    char         *buf0 = buf;
+    NMPObjectType obj_type;
+
+    nm_assert(buf);
+    nm_assert(buf_size > 0);
+
+    buf[0] = '\0';
+
+    if (!_pool_enabled()) {
+        nm_strbuf_append_str(&buf, &buf_size, "disabled");
+        return buf0;
+    }
+
+    for (obj_type = 1; obj_type <= NMP_OBJECT_TYPE_MAX; obj_type++) {
+        NMPObjectPoolStats stats;
+
+        nmp_object_pool_get_stats(obj_type, &stats);
+
+        if (stats.n_in_use == 0)
+            continue;
+
+        nm_strbuf_append(&buf,
+                         &buf_size,
+                         "%s%s %u/%u (%zu KiB, %" G_GUINT64_FORMAT " allocs, %" G_GUINT64_FORMAT
+                         " chunks)",
+                         buf0[0] ? ", " : "",
+                         nmp_class_from_type(obj_type)->obj_type_name,
+                         stats.n_in_use,
+                         stats.n_in_use + stats.n_free,
+                         stats.chunk_bytes / 1024u,
+                         stats.n_allocs,
+                         stats.n_chunk_allocs);
+    }
+
+    return buf0;
+}
+
+/*****************************************************************************/
+
 static NMPObject *
 _nmp_object_new_from_class(const NMPClass *klass)
 {
     NMPObject *obj;
 
-    obj                    = g_slice_alloc0(_NMP_OBJECT_STRUCT_SIZE(klass));
+    if (_pool_enabled()) {
+        obj = _pool_alloc(klass);
+        memset(obj, 0, _NMP_OBJECT_STRUCT_SIZE(klass));
+    } else
+        obj = g_slice_alloc0(_NMP_OBJECT_STRUCT_SIZE(klass));
+
     obj->_class            = klass;
     obj->parent._ref_count = 1;
     return obj;
@@ -1992,7 +2286,11 @@ _vt_dedup_obj_destroy(NMDedupMultiObj *obj)
     klass = o->_class;
     if (klass->cmd_obj_dispose)
         klass->cmd_obj_dispose(o);
-    g_slice_free1(_NMP_OBJECT_STRUCT_SIZE(klass), o);
+
+    if (_pool_enabled())
+        _pool_free(klass, o);
+    else
+        g_slice_free1(_NMP_OBJECT_STRUCT_SIZE(klass), o);
 }
 
 static const NMDedupMultiObj *
@@ -747,6 +747,26 @@ nmp_object_ref_set_up_cast(gpointer pp, gconstpointer obj)
 NMPObject *nmp_object_new(NMPObjectType obj_type, gconstpointer plobj);
 NMPObject *nmp_object_new_link(int ifindex);
 
+typedef struct {
+    /* the size of one object in the pool. */
+    gsize obj_size;
+
+    /* the number of bytes currently allocated for chunks. */
+    gsize chunk_bytes;
+
+    /* the total number of objects handed out and chunks allocated. */
+    guint64 n_allocs;
+    guint64 n_chunk_allocs;
+
+    /* the number of objects currently in use, and currently on the free list. */
+    guint n_in_use;
+    guint n_free;
+} NMPObjectPoolStats;
+
+gboolean nmp_object_pool_get_stats(NMPObjectType obj_type, NMPObjectPoolStats *out_stats);
+
+const char *nmp_object_pool_stats_to_string(char *buf, gsize buf_size);
+
 const NMPObject *nmp_object_stackinit(NMPObject *obj, NMPObjectType obj_type, gconstpointer plobj);
 
 static inline NMPObject *
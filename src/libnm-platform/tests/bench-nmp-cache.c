@@ -0,0 +1,343 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "libnm-glib-aux/nm-default-glib-i18n-prog.h"
+
+#include <linux/rtnetlink.h>
+
+#include "libnm-platform/nm-platform-utils.h"
+#include "libnm-platform/nmp-object.h"
+#include "libnm-glib-aux/tests/nm-bench-utils.h"
+
+/*****************************************************************************/
+
+/* Benchmark for the platform cache (NMPCache) and the NMDedupMultiIndex that
+ * backs it.
+ *
+ * Usage: bench-nmp-cache [NUM...]
+ *
+ * For each NUM (by default 1000, 100000 and 1000000), it creates that many IPv4/IPv6
+ * routes and addresses and measures the time to insert them into the cache (like
+ * during a netlink dump), to look them up, to process them again unchanged (like
+ * during a resync) and to delete them. The objects are created directly, the
+ * same way as the netlink parser in nm-linux-platform would create them.
+ *
+ * It also prints the memory per object and the length of hash collision chains.
+ *
+ * This requires no root privileges and does not touch the system. */
+
+/*****************************************************************************/
+
+static const NMPObjectType OBJ_TYPES[] = {
+    NMP_OBJECT_TYPE_IP4_ROUTE,
+    NMP_OBJECT_TYPE_IP6_ROUTE,
+    NMP_OBJECT_TYPE_IP4_ADDRESS,
+    NMP_OBJECT_TYPE_IP6_ADDRESS,
+};
+
+static NMPObject *
+_obj_new(NMPObjectType obj_type, guint i)
+{
+    const int     ifindex = 1 + (i % 64u);
+    const guint32 metric  = 100 + (i % 7u);
+
+    switch (obj_type) {
+    case NMP_OBJECT_TYPE_IP4_ROUTE:
+    {
+        const NMPlatformIP4Route r = {
+            .ifindex    = ifindex,
+            .rt_source  = nmp_utils_ip_config_source_from_rtprot(RTPROT_BOOT),
+            .network    = htonl(0x0A000000u + (i << 8)),
+            .plen       = 24,
+            .metric     = metric,
+            .n_nexthops = 1,
+        };
+
+        return nmp_object_new(obj_type, &r);
+    }
+    case NMP_OBJECT_TYPE_IP6_ROUTE:
+    {
+        NMPlatformIP6Route r = {
+            .ifindex   = ifindex,
+            .rt_source = nmp_utils_ip_config_source_from_rtprot(RTPROT_BOOT),
+            .plen      = 64,
+            .metric    = metric,
+        };
+
+        r.network.s6_addr32[0] = htonl(0x20010db8u);
+        r.network.s6_addr32[1] = htonl(i);
+        return nmp_object_new(obj_type, &r);
+    }
+    case NMP_OBJECT_TYPE_IP4_ADDRESS:
+    {
+        const NMPlatformIP4Address a = {
+            .ifindex      = ifindex,
+            .address      = htonl(0x0A000000u + i),
+            .peer_address = htonl(0x0A000000u + i),
+            .plen         = 8,
+            .lifetime     = NM_PLATFORM_LIFETIME_PERMANENT,
+            .preferred    = NM_PLATFORM_LIFETIME_PERMANENT,
+        };
+
+        return nmp_object_new(obj_type, &a);
+    }
+    case NMP_OBJECT_TYPE_IP6_ADDRESS:
+    {
+        NMPlatformIP6Address a = {
+            .ifindex   = ifindex,
+            .plen      = 64,
+            .lifetime  = NM_PLATFORM_LIFETIME_PERMANENT,
+            .preferred = NM_PLATFORM_LIFETIME_PERMANENT,
+        };
+
+        a.address.s6_addr32[0] = htonl(0x20010db8u);
+        a.address.s6_addr32[3] = htonl(i);
+        return nmp_object_new(obj_type, &a);
+    }
+    default:
+        return nm_assert_unreachable_val(NULL);
+    }
+}
+
+static NMPCacheOpsType
+_cache_update(NMPCache *cache, NMPObject *obj)
+{
+    nm_auto_nmpobj const NMPObject *obj_old = NULL;
+    nm_auto_nmpobj const NMPObject *obj_new = NULL;
+
+    if (NM_IN_SET(NMP_OBJECT_GET_TYPE(obj), NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE)) {
+        nm_auto_nmpobj const NMPObject *obj_replace = NULL;
+        gboolean                        resync_required;
+
+        return nmp_cache_update_netlink_route(cache,
+                                              obj,
+                                              TRUE,
+                                              NLM_F_MULTI,
+                                              TRUE,
+                                              &obj_old,
+                                              &obj_new,
+                                              &obj_replace,
+                                              &resync_required);
+    }
+
+    return nmp_cache_update_netlink(cache, obj, TRUE, &obj_old, &obj_new);
+}
+
+/*****************************************************************************/
+
+static int
+_cmp_guint(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    NM_CMP_DIRECT(*((const guint *) a), *((const guint *) b));
+    return 0;
+}
+
+static void
+_print_hash_chains(const char *obj_type_name, NMPObject **objs, guint n)
+{
+    gs_free guint *hashes  = g_new(guint, n);
+    gs_free guint *buckets = NULL;
+    guint          n_buckets;
+    guint          n_used     = 0;
+    guint          max_chain  = 0;
+    guint          collisions = 0;
+    guint          i;
+
+    /* Assume a hash table with a power of two number of buckets, at most
+     * as many buckets as entries. */
+    n_buckets = 1;
+    while (n_buckets * 2 <= n)
+        n_buckets *= 2;
+    buckets = g_new0(guint, n_buckets);
+
+    for (i = 0; i < n; i++) {
+        guint b;
+
+        hashes[i] = nmp_object_id_hash(objs[i]);
+        b         = hashes[i] & (n_buckets - 1);
+        if (buckets[b]++ == 0)
+            n_used++;
+        max_chain = NM_MAX(max_chain, buckets[b]);
+    }
+
+    /* full 32 bit collisions. */
+    g_qsort_with_data(hashes, n, sizeof(guint), _cmp_guint, NULL);
+    for (i = 1; i < n; i++) {
+        if (hashes[i] == hashes[i - 1])
+            collisions++;
+    }
+
+    g_print("%-12s %8u  hash: %u buckets, %u used, %.2f avg chain, %u max chain, %u full "
+            "collisions\n",
+            obj_type_name,
+            n,
+            n_buckets,
+            n_used,
+            ((double) n) / NM_MAX(n_used, 1u),
+            max_chain,
+            collisions);
+}
+
+/*****************************************************************************/
+
+static void
+_idx_obj_id_hash_update(const NMDedupMultiIdxType *idx_type,
+                        const NMDedupMultiObj     *obj,
+                        NMHashState               *h)
+{
+    nmp_object_id_hash_update((NMPObject *) obj, h);
+}
+
+static gboolean
+_idx_obj_id_equal(const NMDedupMultiIdxType *idx_type,
+                  const NMDedupMultiObj     *obj_a,
+                  const NMDedupMultiObj     *obj_b)
+{
+    return nmp_object_id_equal((NMPObject *) obj_a, (NMPObject *) obj_b);
+}
+
+static void
+bench_dedup_multi_index(NMPObjectType obj_type, NMPObject **objs, guint n)
+{
+    static const NMDedupMultiIdxTypeClass idx_type_class = {
+        .idx_obj_id_hash_update = _idx_obj_id_hash_update,
+        .idx_obj_id_equal       = _idx_obj_id_equal,
+    };
+    nm_auto_unref_dedup_multi_index NMDedupMultiIndex *multi_idx = nm_dedup_multi_index_new();
+    NMDedupMultiIdxType                                idx_type;
+    const char                                        *name;
+    gint64                                             start;
+    guint                                              i;
+
+    name = nmp_class_from_type(obj_type)->obj_type_name;
+
+    nm_dedup_multi_idx_type_init(&idx_type, &idx_type_class);
+
+    start = nm_bench_now_nsec();
+    for (i = 0; i < n; i++) {
+        if (!nm_dedup_multi_index_add_full(multi_idx,
+                                           &idx_type,
+                                           objs[i],
+                                           NM_DEDUP_MULTI_IDX_MODE_APPEND,
+                                           NULL,
+                                           NM_DEDUP_MULTI_ENTRY_MISSING,
+                                           NULL,
+                                           NULL,
+                                           NULL))
+            g_error("failure to add object #%u to the index", i);
+    }
+    nm_bench_print_timing(name, n, "idx-add", n, start);
+
+    start = nm_bench_now_nsec();
+    for (i = 0; i < n; i++) {
+        if (!nm_dedup_multi_index_lookup_obj(multi_idx, &idx_type, objs[i]))
+            g_error("failure to lookup object #%u in the index", i);
+    }
+    nm_bench_print_timing(name, n, "idx-lookup", n, start);
+
+    start = nm_bench_now_nsec();
+    for (i = 0; i < n; i++) {
+        if (nm_dedup_multi_index_remove_obj(multi_idx, &idx_type, objs[i], NULL) != 1)
+            g_error("failure to remove object #%u from the index", i);
+    }
+    nm_bench_print_timing(name, n, "idx-remove", n, start);
+}
+
+static void
+bench_cache(NMPObjectType obj_type, guint n)
+{
+    nm_auto_unref_dedup_multi_index NMDedupMultiIndex *multi_idx = nm_dedup_multi_index_new();
+    gs_free NMPObject                                **objs      = g_new(NMPObject *, n);
+    const char                                        *name;
+    NMPObjectPoolStats                                 pool_stats;
+    NMPCache                                          *cache;
+    gssize                                             rss_before;
+    gssize                                             rss_objs;
+    gssize                                             rss_cache;
+    gint64                                             start;
+    guint                                              i;
+
+    name  = nmp_class_from_type(obj_type)->obj_type_name;
+    cache = nmp_cache_new(multi_idx, FALSE);
+
+    rss_before = nm_bench_get_rss_bytes();
+
+    start = nm_bench_now_nsec();
+    for (i = 0; i < n; i++)
+        objs[i] = _obj_new(obj_type, i);
+    nm_bench_print_timing(name, n, "create", n, start);
+
+    rss_objs = nm_bench_get_rss_bytes();
+
+    start = nm_bench_now_nsec();
+    for (i = 0; i < n; i++) {
+        if (_cache_update(cache, objs[i]) != NMP_CACHE_OPS_ADDED)
+            g_error("failure to add object #%u to the cache", i);
+    }
+    nm_bench_print_timing(name, n, "cache-add", n, start);
+
+    rss_cache = nm_bench_get_rss_bytes();
+
+    start = nm_bench_now_nsec();
+    for (i = 0; i < n; i++) {
+        if (nmp_cache_lookup_obj(cache, objs[i]) != objs[i])
+            g_error("failure to lookup object #%u in the cache", i);
+    }
+    nm_bench_print_timing(name, n, "cache-lookup", n, start);
+
+    start = nm_bench_now_nsec();
+    for (i = 0; i < n; i++) {
+        nm_auto_nmpobj NMPObject *obj = _obj_new(obj_type, i);
+
+        if (_cache_update(cache, obj) != NMP_CACHE_OPS_UNCHANGED)
+            g_error("unexpected change of object #%u in the cache", i);
+    }
+    nm_bench_print_timing(name, n, "cache-unchanged", n, start);
+
+    start = nm_bench_now_nsec();
+    for (i = 0; i < n; i++) {
+        nm_auto_nmpobj const NMPObject *obj_old = NULL;
+
+        if (nmp_cache_remove(cache, objs[i], FALSE, FALSE, &obj_old) != NMP_CACHE_OPS_REMOVED)
+            g_error("failure to remove object #%u from the cache", i);
+    }
+    nm_bench_print_timing(name, n, "cache-remove", n, start);
+
+    nmp_object_pool_get_stats(obj_type, &pool_stats);
+    g_print("%-12s %8u  memory: %zu bytes per object, %.1f bytes per object (RSS), %.1f bytes "
+            "per cache entry (RSS)\n",
+            name,
+            n,
+            pool_stats.obj_size,
+            ((double) (rss_objs - rss_before)) / n,
+            ((double) (rss_cache - rss_objs)) / n);
+
+    _print_hash_chains(name, objs, n);
+
+    bench_dedup_multi_index(obj_type, objs, n);
+
+    nmp_cache_free(cache);
+
+    for (i = 0; i < n; i++)
+        nmp_object_unref(objs[i]);
+}
+
+/*****************************************************************************/
+
+int
+main(int argc, char **argv)
+{
+    gs_unref_array GArray *nums = NULL;
+    guint                  i;
+    guint                  j;
+
+    nums = nm_bench_parse_nums(argc, argv, 1);
+    if (!nums)
+        return 1;
+
+    for (i = 0; i < nums->len; i++) {
+        for (j = 0; j < G_N_ELEMENTS(OBJ_TYPES); j++)
+            bench_cache(OBJ_TYPES[j], nm_g_array_index(nums, guint, i));
+    }
+
+    return 0;
+}
@@ -535,6 +535,164 @@ wifi_nl80211_get_station(NMWifiUtils *data,
     return TRUE;
 }
 
+/**
+ * nm_wifi_utils_nl80211_parse_scan_event:
+ * @hdr: a generic netlink message of the nl80211 family
+ *
+ * Returns: the ifindex, if @hdr is a NL80211_CMD_NEW_SCAN_RESULTS
+ *   notification that the scan of the interface completed. Otherwise, 0.
+ */
+int
+nm_wifi_utils_nl80211_parse_scan_event(const struct nlmsghdr *hdr)
+{
+    struct nlattr           *tb[NL80211_ATTR_MAX + 1];
+    const struct genlmsghdr *gnlh;
+
+    if (!genlmsg_valid_hdr(hdr, 0))
+        return 0;
+
+    gnlh = genlmsg_hdr(hdr);
+    if (gnlh->cmd != NL80211_CMD_NEW_SCAN_RESULTS)
+        return 0;
+
+    if (nla_parse_arr(tb, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL) < 0)
+        return 0;
+
+    /* The replies to NL80211_CMD_GET_SCAN use the same command, but they
+     * carry a BSS. */
+    if (tb[NL80211_ATTR_BSS] || !tb[NL80211_ATTR_IFINDEX])
+        return 0;
+
+    return NM_MAX((int) nla_get_u32(tb[NL80211_ATTR_IFINDEX]), 0);
+}
+
+/**
+ * nm_wifi_utils_nl80211_parse_scan_result:
+ * @hdr: a generic netlink message of the nl80211 family
+ * @out_ifindex: (out) (optional): the ifindex of the scan result
+ * @out_result: (out): the parsed scan result. On success, the caller
+ *   must clear it with nm_wifi_scan_result_clear().
+ *
+ * Parses one BSS from the reply of a NL80211_CMD_GET_SCAN dump.
+ *
+ * Returns: %TRUE if @hdr contained a valid BSS.
+ */
+gboolean
+nm_wifi_utils_nl80211_parse_scan_result(const struct nlmsghdr *hdr,
+                                        int                   *out_ifindex,
+                                        NMWifiScanResult      *out_result)
+{
+    static const struct nla_policy bss_policy[] = {
+        [NL80211_BSS_BSSID]                = {.minlen = ETH_ALEN},
+        [NL80211_BSS_FREQUENCY]            = {.type = NLA_U32},
+        [NL80211_BSS_CAPABILITY]           = {.type = NLA_U16},
+        [NL80211_BSS_INFORMATION_ELEMENTS] = {.type = NLA_UNSPEC},
+        [NL80211_BSS_SIGNAL_MBM]           = {.type = NLA_U32},
+        [NL80211_BSS_SIGNAL_UNSPEC]        = {.type = NLA_U8},
+        [NL80211_BSS_STATUS]               = {.type = NLA_U32},
+        [NL80211_BSS_SEEN_MS_AGO]          = {.type = NLA_U32},
+        [NL80211_BSS_BEACON_IES]           = {.type = NLA_UNSPEC},
+    };
+    struct nlattr           *tb[NL80211_ATTR_MAX + 1];
+    struct nlattr           *bss[G_N_ELEMENTS(bss_policy)];
+    const struct genlmsghdr *gnlh;
+    struct nlattr           *ies;
+
+    nm_assert(out_result);
+
+    if (!genlmsg_valid_hdr(hdr, 0))
+        return FALSE;
+
+    gnlh = genlmsg_hdr(hdr);
+    if (gnlh->cmd != NL80211_CMD_NEW_SCAN_RESULTS)
+        return FALSE;
+
+    if (nla_parse_arr(tb, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), NULL) < 0)
+        return FALSE;
+
+    if (!tb[NL80211_ATTR_BSS])
+        return FALSE;
+
+    if (nla_parse_nested_arr(bss, tb[NL80211_ATTR_BSS], bss_policy) < 0)
+        return FALSE;
+
+    if (!bss[NL80211_BSS_BSSID])
+        return FALSE;
+
+    *out_result = (NMWifiScanResult) {};
+    memcpy(&out_result->bssid, nla_data(bss[NL80211_BSS_BSSID]), ETH_ALEN);
+
+    if (bss[NL80211_BSS_FREQUENCY])
+        out_result->frequency = nla_get_u32(bss[NL80211_BSS_FREQUENCY]);
+
+    if (bss[NL80211_BSS_CAPABILITY])
+        out_result->capability = nla_get_u16(bss[NL80211_BSS_CAPABILITY]);
+
+    if (bss[NL80211_BSS_SEEN_MS_AGO])
+        out_result->seen_ms_ago = nla_get_u32(bss[NL80211_BSS_SEEN_MS_AGO]);
+
+    if (bss[NL80211_BSS_SIGNAL_MBM]) {
+        /* mBm is dBm * 100 */
+        out_result->signal_level = nla_get_s32(bss[NL80211_BSS_SIGNAL_MBM]) / 100;
+        out_result->signal_valid = TRUE;
+    } else if (bss[NL80211_BSS_SIGNAL_UNSPEC]) {
+        out_result->signal_level = NM_MIN(nla_get_u8(bss[NL80211_BSS_SIGNAL_UNSPEC]), 100);
+        out_result->signal_valid = TRUE;
+    }
+
+    if (bss[NL80211_BSS_STATUS]) {
+        out_result->associated =
+            (nla_get_u32(bss[NL80211_BSS_STATUS]) == NL80211_BSS_STATUS_ASSOCIATED);
+    }
+
+    /* Prefer the IEs of the probe response, they are more complete than the
+     * ones from the beacon. For example, the SSID of a hidden network is only
+     * in the probe response. */
+    ies = bss[NL80211_BSS_INFORMATION_ELEMENTS] ?: bss[NL80211_BSS_BEACON_IES];
+    if (ies && nla_len(ies) > 0)
+        out_result->ies = g_bytes_new(nla_data(ies), nla_len(ies));
+
+    if (out_ifindex) {
+        *out_ifindex =
+            tb[NL80211_ATTR_IFINDEX] ? (int) nla_get_u32(tb[NL80211_ATTR_IFINDEX]) : 0;
+    }
+    return TRUE;
+}
+
+static int
+nl80211_scan_dump_handler(const struct nl_msg *msg, void *arg)
+{
+    GArray          *results = arg;
+    NMWifiScanResult result;
+
+    if (nm_wifi_utils_nl80211_parse_scan_result(nlmsg_hdr(msg), NULL, &result))
+        g_array_append_val(results, result);
+
+    return NL_SKIP;
+}
+
+static GArray *
+wifi_nl80211_get_scan_results(NMWifiUtils *data)
+{
+    NMWifiUtilsNl80211          *self    = (NMWifiUtilsNl80211 *) data;
+    nm_auto_nlmsg struct nl_msg *msg     = NULL;
+    gs_unref_array GArray       *results = NULL;
+    int                          err;
+
+    results = g_array_new(FALSE, FALSE, sizeof(NMWifiScanResult));
+    g_array_set_clear_func(results, (GDestroyNotify) nm_wifi_scan_result_clear);
+
+    msg = nl80211_alloc_msg(self, NL80211_CMD_GET_SCAN, NLM_F_DUMP);
+
+    err = nl80211_send_and_recv(self, msg, nl80211_scan_dump_handler, results);
+    if (err < 0) {
+        _LOGD("NL80211_CMD_GET_SCAN request failed: %s", nm_strerror(err));
+        return NULL;
+    }
+
+    return g_steal_pointer(&results);
+}
+
 static gboolean
 wifi_nl80211_indicate_addressing_running(NMWifiUtils *data, gboolean running)
 {
@@ -847,6 +1005,7 @@ nm_wifi_utils_nl80211_class_init(NMWifiUtilsNl80211Class *klass)
     wifi_utils_class->get_freq                    = wifi_nl80211_get_freq;
     wifi_utils_class->find_freq                   = wifi_nl80211_find_freq;
     wifi_utils_class->get_station                 = wifi_nl80211_get_station;
+    wifi_utils_class->get_scan_results            = wifi_nl80211_get_scan_results;
     wifi_utils_class->indicate_addressing_running = wifi_nl80211_indicate_addressing_running;
     wifi_utils_class->get_mesh_channel            = wifi_nl80211_get_mesh_channel;
     wifi_utils_class->set_mesh_channel            = wifi_nl80211_set_mesh_channel;
@@ -26,4 +26,13 @@ GType nm_wifi_utils_nl80211_get_type(void);
 
 NMWifiUtils *nm_wifi_utils_nl80211_new(struct nl_sock *genl, guint16 genl_family_id, int ifindex);
 
+/* The nl80211 multicast group for scan events */
+#define NM_WIFI_UTILS_NL80211_MCGRP_SCAN "scan"
+
+int nm_wifi_utils_nl80211_parse_scan_event(const struct nlmsghdr *hdr);
+
+gboolean nm_wifi_utils_nl80211_parse_scan_result(const struct nlmsghdr *hdr,
+                                                 int                   *out_ifindex,
+                                                 NMWifiScanResult      *out_result);
+
 #endif /* __WIFI_UTILS_NL80211_H__ */
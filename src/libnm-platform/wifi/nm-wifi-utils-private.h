@@ -43,6 +43,9 @@ typedef struct {
                             int         *out_quality,
                             guint32     *out_rate);
 
+    /* Return a GArray of NMWifiScanResult */
+    GArray *(*get_scan_results)(NMWifiUtils *data);
+
     /* OLPC Mesh-only functions */
 
     guint32 (*get_mesh_channel)(NMWifiUtils *data);
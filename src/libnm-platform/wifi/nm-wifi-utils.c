@@ -143,6 +143,23 @@ nm_wifi_utils_get_station(NMWifiUtils *data,
     return NM_WIFI_UTILS_GET_CLASS(data)->get_station(data, out_bssid, out_quality, out_rate);
 }
 
+void
+nm_wifi_scan_result_clear(NMWifiScanResult *result)
+{
+    nm_clear_pointer(&result->ies, g_bytes_unref);
+}
+
+GArray *
+nm_wifi_utils_get_scan_results(NMWifiUtils *data)
+{
+    NMWifiUtilsClass *klass;
+
+    g_return_val_if_fail(data != NULL, NULL);
+
+    klass = NM_WIFI_UTILS_GET_CLASS(data);
+    return klass->get_scan_results ? klass->get_scan_results(data) : NULL;
+}
+
 gboolean
 nm_wifi_utils_is_wifi(int dirfd, const char *ifname)
 {
@@ -12,6 +12,33 @@
 
 typedef struct NMWifiUtils NMWifiUtils;
 
+/* A BSS from the kernel's scan results. */
+typedef struct _NMWifiScanResult {
+    /* the information elements of the last probe response or beacon */
+    GBytes *ies;
+
+    NMEtherAddr bssid;
+
+    /* in MHz */
+    guint32 frequency;
+
+    /* how long ago the BSS was last seen, relative to when the scan results
+     * were read. */
+    guint32 seen_ms_ago;
+
+    /* the signal level, either in dBm (negative) or as percentage, in the
+     * form that nm_wifi_utils_level_to_quality() accepts. */
+    gint32 signal_level;
+
+    /* the capability field of the beacon */
+    guint16 capability;
+
+    bool signal_valid : 1;
+    bool associated : 1;
+} NMWifiScanResult;
+
+void nm_wifi_scan_result_clear(NMWifiScanResult *result);
+
 #define NM_TYPE_WIFI_UTILS (nm_wifi_utils_get_type())
 #define NM_WIFI_UTILS(obj) (_NM_G_TYPE_CHECK_INSTANCE_CAST((obj), NM_TYPE_WIFI_UTILS, NMWifiUtils))
 #define NM_WIFI_UTILS_CLASS(klass) \
@@ -53,6 +80,10 @@ gboolean nm_wifi_utils_get_station(NMWifiUtils *data,
                                    int         *out_quality,
                                    guint32     *out_rate);
 
+/* Returns a #GArray of #NMWifiScanResult with the scan results of the kernel,
+ * or %NULL on failure or if not supported. */
+GArray *nm_wifi_utils_get_scan_results(NMWifiUtils *data);
+
 /* Tells the driver DHCP or SLAAC is running */
 gboolean nm_wifi_utils_indicate_addressing_running(NMWifiUtils *data, gboolean running);
 
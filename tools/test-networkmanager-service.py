@@ -2358,6 +2358,20 @@ class Settings(ExportedObj):
     def ListConnections(self):
         return self.get_connection_paths()
 
+    @dbus.service.method(
+        dbus_interface=IFACE_SETTINGS, in_signature="ao", out_signature="a{oa{sa{sv}}}"
+    )
+    def GetConnectionSettings(self, paths):
+        if not paths:
+            paths = self.get_connection_paths()
+        result = dbus.Dictionary({}, signature="oa{sa{sv}}")
+        for path in paths:
+            con = self.connections.get(path)
+            if con is None or not con.visible:
+                continue
+            result[path] = con.con_hash
+        return result
+
     @dbus.service.method(
         dbus_interface=IFACE_SETTINGS, in_signature="a{sa{sv}}", out_signature="o"
     )